@@ -135,6 +135,23 @@ export declare const enum ESceneDupType {
     PrivateRefs = 2,
     PrivateCopy = 3
 }
+export declare const enum ETransitionPrepareState {
+    None = 0,
+    Preparing = 1,
+    Ready = 2,
+    TimedOut = 3,
+    Expired = 4
+}
+export declare const enum EMediaState {
+    None = 0,
+    Playing = 1,
+    Opening = 2,
+    Buffering = 3,
+    Paused = 4,
+    Stopped = 5,
+    Ended = 6,
+    Error = 7
+}
 export declare const enum ESourceType {
     Input = 0,
     Filter = 1,
@@ -302,6 +319,7 @@ export interface IGlobal {
     startup(locale: string, path?: string): void;
     shutdown(): void;
     getOutputFlagsFromId(id: string): number;
+    getTypeCatalog(knownFingerprint?: string): ITypeCatalog;
     setOutputSource(channel: number, input: ISource): void;
     getOutputSource(channel: number): ISource;
     readonly totalFrames: number;
@@ -311,6 +329,19 @@ export interface IGlobal {
     multipleRendering: boolean;
     readonly version: number;
 }
+export interface ITypeCatalog {
+    fingerprint: string;
+    unchanged: boolean;
+    types: ITypeCatalogEntry[];
+}
+export interface ITypeCatalogEntry {
+    id: string;
+    type: ESourceType;
+    displayName: string;
+    outputFlags: number;
+    defaults: ISettings;
+    propertiesHash: string;
+}
 export interface IBooleanProperty extends IProperty {
 }
 export interface IColorProperty extends IProperty {
@@ -395,6 +426,8 @@ export interface IFilter extends ISource {
 export interface IInputFactory extends IFactoryTypes {
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): IInput;
     createPrivate(id: string, name: string, settings?: ISettings): IInput;
+    createBatch(sources: SourceInfo[]): IInput[];
+    getMediaStates(inputs: IInput[]): IMediaState[];
     fromName(name: string): IInput;
     getPublicSources(): IInput[];
 }
@@ -440,6 +473,16 @@ export interface ISceneItemInfo {
     y: number;
     rotation: number;
 }
+export interface IMediaState {
+    state: EMediaState;
+    time: number;
+    duration: number;
+}
+export interface IFilterChainLink {
+    filter: IFilter;
+    enabled?: boolean;
+    settings?: ISettings;
+}
 export interface IInput extends ISource {
     volume: number;
     syncOffset: ITimeSpec;
@@ -459,6 +502,7 @@ export interface IInput extends ISource {
     sendKeyClick(eventData: IKeyEvent, keyUp: boolean): void;
     setFilterOrder(filter: IFilter, movement: EOrderMovement): void;
     setFilterOrder(filter: IFilter, movement: EOrderMovement): void;
+    setFilterChain(chain: IFilterChainLink[]): void;
     readonly filters: IFilter[];
     readonly width: number;
     readonly height: number;
@@ -468,6 +512,9 @@ export interface IInput extends ISource {
     pause(): void;
     restart(): void;
     stop(): void;
+    getMediaState(): EMediaState;
+    watchMediaState(callback: (state: IMediaState) => void, granularityMs?: number): boolean;
+    unwatchMediaState(): boolean;
 }
 export interface ISceneFactory {
     create(name: string): IScene;
@@ -483,6 +530,28 @@ export interface IScene extends ISource {
     findItem(id: string | number): ISceneItem;
     getItemAtIdx(idx: number): ISceneItem;
     getItems(): ISceneItem[];
+    hitTest(x: number, y: number): ISceneItem;
+    queryRect(x: number, y: number, width: number, height: number): ISceneItem[];
+    snapCandidates(item: ISceneItem, distance: number): ISnapCandidate[];
+    connect(callback: (events: ISceneEvents) => void): boolean;
+    disconnect(): boolean;
+}
+export interface ISceneEvents {
+    reordered: boolean;
+    added: number[];
+    removed: number[];
+    visible: {
+        id: number;
+        visible: boolean;
+    }[];
+    transformed: number[];
+}
+export interface ISnapCandidate {
+    item: ISceneItem;
+    left: number;
+    top: number;
+    right: number;
+    bottom: number;
 }
 export interface ISceneItem {
     readonly source: IInput;
@@ -521,6 +590,10 @@ export interface ITransition extends ISource {
     clear(): void;
     set(input: ISource): void;
     start(ms: number, input: ISource): void;
+    prepare(input: IScene, timeoutMs?: number): void;
+    readonly prepareState: ETransitionPrepareState;
+    watchPrepareState(callback: (state: ETransitionPrepareState) => void): boolean;
+    unwatchPrepareState(): boolean;
 }
 export interface IConfigurable {
     update(settings: ISettings): void;
@@ -650,6 +723,34 @@ export interface ISourceSize {
     outputFlags: number;
 }
 export declare function getSourcesSize(sourcesNames: string[]): ISourceSize[];
+export interface IOutputPerformance {
+    kind: number;
+    active: boolean;
+    totalFrames: number;
+    droppedFrames: number;
+    congestion: number;
+    totalBytes: number;
+}
+export interface IProfilerEntry {
+    depth: number;
+    name: string;
+    calls: number;
+    totalTime: number;
+    minTime: number;
+    maxTime: number;
+}
+export interface IPerformanceSnapshot {
+    version: number;
+    timestamp: number;
+    profiling: boolean;
+    renderedFrames: number;
+    laggedFrames: number;
+    videoFrames: number;
+    skippedFrames: number;
+    outputs: IOutputPerformance[];
+    entries: IProfilerEntry[];
+}
+export declare function decodePerformanceSnapshot(buffer: Buffer): IPerformanceSnapshot;
 export interface IServiceFactory {
     types(): string[];
     create(id: string, name: string, settings?: ISettings): IService;
@@ -1,6 +1,6 @@
 "use strict";
 Object.defineProperty(exports, "__esModule", { value: true });
-exports.NodeObs = exports.getSourcesSize = exports.createSources = exports.addItems = exports.ServiceFactory = exports.IPC = exports.ModuleFactory = exports.FaderFactory = exports.VolmeterFactory = exports.DisplayFactory = exports.TransitionFactory = exports.FilterFactory = exports.SceneFactory = exports.InputFactory = exports.Video = exports.Global = exports.DefaultPluginDataPath = exports.DefaultPluginPath = exports.DefaultDataPath = exports.DefaultBinPath = exports.DefaultDrawPluginPath = exports.DefaultOpenGLPath = exports.DefaultD3D11Path = void 0;
+exports.NodeObs = exports.decodePerformanceSnapshot = exports.getSourcesSize = exports.createSources = exports.addItems = exports.ServiceFactory = exports.IPC = exports.ModuleFactory = exports.FaderFactory = exports.VolmeterFactory = exports.DisplayFactory = exports.TransitionFactory = exports.FilterFactory = exports.SceneFactory = exports.InputFactory = exports.Video = exports.Global = exports.DefaultPluginDataPath = exports.DefaultPluginPath = exports.DefaultDataPath = exports.DefaultBinPath = exports.DefaultDrawPluginPath = exports.DefaultOpenGLPath = exports.DefaultD3D11Path = void 0;
 const obs = require('./obs_studio_client.node');
 const path = require("path");
 const fs = require("fs");
@@ -40,29 +40,10 @@ function addItems(scene, sceneItems) {
 }
 exports.addItems = addItems;
 function createSources(sources) {
-    const items = [];
-    if (Array.isArray(sources)) {
-        sources.forEach(function (source) {
-            const newSource = obs.Input.create(source.type, source.name, source.settings);
-            if (newSource.audioMixers) {
-                newSource.muted = (source.muted != null) ? source.muted : false;
-                newSource.volume = (source.volume != null) ? source.volume : 1;
-                newSource.syncOffset =
-                    (source.syncOffset != null) ? source.syncOffset : { sec: 0, nsec: 0 };
-            }
-            items.push(newSource);
-            const filters = source.filters;
-            if (Array.isArray(filters)) {
-                filters.forEach(function (filter) {
-                    const ObsFilter = obs.Filter.create(filter.type, filter.name, filter.settings);
-                    ObsFilter.enabled = (filter.enabled != null) ? filter.enabled : true;
-                    newSource.addFilter(ObsFilter);
-                    ObsFilter.release();
-                });
-            }
-        });
+    if (!Array.isArray(sources) || sources.length === 0) {
+        return [];
     }
-    return items;
+    return obs.Input.createBatch(sources);
 }
 exports.createSources = createSources;
 function getSourcesSize(sourcesNames) {
@@ -78,6 +59,54 @@ function getSourcesSize(sourcesNames) {
     return sourcesSize;
 }
 exports.getSourcesSize = getSourcesSize;
+function decodePerformanceSnapshot(buffer) {
+    let offset = 0;
+    const readUInt8 = () => { const v = buffer.readUInt8(offset); offset += 1; return v; };
+    const readUInt16 = () => { const v = buffer.readUInt16LE(offset); offset += 2; return v; };
+    const readUInt32 = () => { const v = buffer.readUInt32LE(offset); offset += 4; return v; };
+    const readInt32 = () => { const v = buffer.readInt32LE(offset); offset += 4; return v; };
+    const readFloat = () => { const v = buffer.readFloatLE(offset); offset += 4; return v; };
+    const readUInt64 = () => { const lo = readUInt32(); const hi = readUInt32(); return hi * 4294967296 + lo; };
+    const snapshot = {
+        version: readUInt32(),
+        timestamp: readUInt64(),
+        profiling: readUInt8() != 0,
+        renderedFrames: readUInt32(),
+        laggedFrames: readUInt32(),
+        videoFrames: readUInt32(),
+        skippedFrames: readUInt32(),
+        outputs: [],
+        entries: []
+    };
+    const outputCount = readUInt32();
+    for (let i = 0; i < outputCount; i++) {
+        snapshot.outputs.push({
+            kind: readUInt8(),
+            active: readUInt8() != 0,
+            totalFrames: readInt32(),
+            droppedFrames: readInt32(),
+            congestion: readFloat(),
+            totalBytes: readUInt64()
+        });
+    }
+    const entryCount = readUInt32();
+    for (let i = 0; i < entryCount; i++) {
+        const depth = readUInt16();
+        const length = readUInt16();
+        const name = buffer.toString('utf8', offset, offset + length);
+        offset += length;
+        snapshot.entries.push({
+            depth: depth,
+            name: name,
+            calls: readUInt64(),
+            totalTime: readUInt64(),
+            minTime: readUInt64(),
+            maxTime: readUInt64()
+        });
+    }
+    return snapshot;
+}
+exports.decodePerformanceSnapshot = decodePerformanceSnapshot;
 if (fs.existsSync(path.resolve(__dirname, `obs64`).replace('app.asar', 'app.asar.unpacked'))) {
     obs.IPC.setServerPath(path.resolve(__dirname, `obs64`).replace('app.asar', 'app.asar.unpacked'), path.resolve(__dirname).replace('app.asar', 'app.asar.unpacked'));
 }
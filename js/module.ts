@@ -188,6 +188,31 @@ export const enum ESceneDupType {
     PrivateCopy
 }
 
+/**
+ * Readiness of the scene given to ITransition.prepare
+ */
+export const enum ETransitionPrepareState {
+    None,
+    Preparing,
+    Ready,
+    TimedOut,
+    Expired
+}
+
+/**
+ * Playback state of a media source, obs_media_state
+ */
+export const enum EMediaState {
+    None,
+    Playing,
+    Opening,
+    Buffering,
+    Paused,
+    Stopped,
+    Ended,
+    Error
+}
+
 /**
  * Describes the type of source
  */
@@ -444,6 +469,13 @@ export interface IGlobal {
      */
     getOutputFlagsFromId(id: string): number;
 
+    /**
+     * Every registered input, filter and transition type, collected once after the modules are loaded
+     * @param knownFingerprint - Fingerprint of a catalog kept from an earlier session
+     * @returns - The catalog, without its types if knownFingerprint is still current
+     */
+    getTypeCatalog(knownFingerprint?: string): ITypeCatalog;
+
     /**
      * Output channels are useful in that we can attach multiple
      * sources for output. For the most part, you're generally only
@@ -501,6 +533,30 @@ export interface IGlobal {
     readonly version: number;
 }
 
+/**
+ * Source types returned by getTypeCatalog
+ */
+export interface ITypeCatalog {
+    /**
+     * Stays the same across sessions as long as the types and their defaults do
+     */
+    fingerprint: string,
+    unchanged: boolean,
+    types: ITypeCatalogEntry[]
+}
+
+export interface ITypeCatalogEntry {
+    id: string,
+    type: ESourceType,
+    displayName: string,
+    outputFlags: number,
+    defaults: ISettings,
+    /**
+     * Hash of the property schema of the type with its default settings
+     */
+    propertiesHash: string
+}
+
 export interface IBooleanProperty extends IProperty {
 
 }
@@ -700,6 +756,20 @@ export interface IInputFactory extends IFactoryTypes {
      */
     createPrivate(id: string, name: string, settings?: ISettings): IInput;
 
+    /**
+     * Create several input sources with their audio state and filters in one call
+     * @param sources - Sources to create
+     * @returns - The created instances in the same order, undefined where creation failed
+     */
+    createBatch(sources: SourceInfo[]): IInput[];
+
+    /**
+     * Get the playback state of several media sources in one call
+     * @param inputs - Media sources to query
+     * @returns - The states in the same order, undefined where the source is gone
+     */
+    getMediaStates(inputs: IInput[]): IMediaState[];
+
     /**
      * Create an instance of an ObsInput by fetching the source by name.
      * @param name - Name of the source to look for
@@ -761,6 +831,40 @@ export interface ISceneItemInfo {
     rotation: number
 }
 
+/**
+ * A filter of the chain given to IInput.setFilterChain
+ */
+export interface IFilterChainLink {
+    filter: IFilter;
+
+    /**
+     * Enables or disables the filter, left as it is when not given
+     */
+    enabled?: boolean;
+
+    /**
+     * Settings to update the filter with, left as they are when not given
+     */
+    settings?: ISettings;
+}
+
+/**
+ * Playback state of a media source
+ */
+export interface IMediaState {
+    state: EMediaState;
+
+    /**
+     * Play position in milliseconds
+     */
+    time: number;
+
+    /**
+     * Duration of the media in milliseconds
+     */
+    duration: number;
+}
+
 /**
  * Class representing a source
  * 
@@ -825,6 +929,13 @@ export interface IInput extends ISource {
      */
     setFilterOrder(filter: IFilter, movement: EOrderMovement): void;
 
+    /**
+     * Replace the filter list in one call. Filters missing from the chain are
+     * removed, new ones are added and the order is reached with as few moves
+     * as possible, the chain is only rendered once it is complete.
+     * @param chain - The filters in the order of the filters list.
+     */
+    setFilterChain(chain: IFilterChainLink[]): void;
 
     /**
      * Obtain a list of all filters associated with the input source
@@ -870,6 +981,25 @@ export interface IInput extends ISource {
      * stop media source
      */
     stop(): void;
+
+    /**
+     * get the playback state of the media source
+     */
+    getMediaState(): EMediaState;
+
+    /**
+     * Call back with the playback state whenever it changes, requires the
+     * global source callback to be registered. The state is checked at the
+     * interval of the global callback.
+     * @param callback - Called with the new state
+     * @param granularityMs - How far the play position must move before it is reported again, 1000 by default
+     */
+    watchMediaState(callback: (state: IMediaState) => void, granularityMs?: number): boolean;
+
+    /**
+     * Stop calling back the function given to watchMediaState
+     */
+    unwatchMediaState(): boolean;
 }
 
 export interface ISceneFactory {
@@ -957,6 +1087,71 @@ export interface IScene extends ISource {
      * @returns - The array of item instances
      */
     getItems(): ISceneItem[];
+
+    /**
+     * Find the topmost visible item under a point
+     * @param x - Horizontal position in the scene
+     * @param y - Vertical position in the scene
+     * @returns - The item instance or undefined if there is none
+     */
+    hitTest(x: number, y: number): ISceneItem;
+
+    /**
+     * Fetch the visible items whose bounds intersect a rectangle
+     * @returns - The array of item instances, topmost first
+     */
+    queryRect(x: number, y: number, width: number, height: number): ISceneItem[];
+
+    /**
+     * Fetch the visible items an item may snap to
+     * @param item - Item being moved or resized
+     * @param distance - Snapping distance in scene units
+     * @returns - The items whose bounds lie within distance of the bounds of item, topmost first
+     */
+    snapCandidates(item: ISceneItem, distance: number): ISnapCandidate[];
+
+    /**
+     * Call back with the item changes of the scene, requires the global
+     * source callback to be registered. Changes are batched at the interval
+     * of the global callback, each item shows up once per batch.
+     * @param callback - Called with the changes since the previous batch
+     */
+    connect(callback: (events: ISceneEvents) => void): boolean;
+
+    /**
+     * Stop calling back the function given to connect
+     */
+    disconnect(): boolean;
+}
+
+/**
+ * Item changes of a scene passed to the callback given to IScene.connect,
+ * items are given by their ISceneItem.id
+ */
+export interface ISceneEvents {
+    /**
+     * Items were added, removed or moved within the list
+     */
+    reordered: boolean,
+    added: number[],
+    removed: number[],
+    visible: { id: number, visible: boolean }[],
+
+    /**
+     * Items whose position, scale, rotation, bounds or crop changed
+     */
+    transformed: number[]
+}
+
+/**
+ * Bounds of an item, in scene units, returned by snapCandidates
+ */
+export interface ISnapCandidate {
+    item: ISceneItem,
+    left: number,
+    top: number,
+    right: number,
+    bottom: number
 }
 
 /**
@@ -1106,6 +1301,33 @@ export interface ITransition extends ISource {
      * @param input - Source to transition to
      */
     start(ms: number, input: ISource): void;
+
+    /**
+     * Shows a scene ahead of a transition to it, so its media and capture sources
+     * open and decode their first frames before start is called. Dropped once the
+     * transition starts or is cleared, when another scene is prepared, when either
+     * source is released or removed, when the first frames time out, or when the
+     * transition doesn't start within 10 seconds of being ready.
+     * @param input - Scene that will be transitioned to
+     * @param timeoutMs - How long to wait for the first frames, 3000 by default
+     */
+    prepare(input: IScene, timeoutMs?: number): void;
+
+    /**
+     * Whether the scene given to prepare is ready to be shown
+     */
+    readonly prepareState: ETransitionPrepareState;
+
+    /**
+     * Calls back with the new state when the prepared scene becomes ready, times out or expires
+     * @param callback - Function called with the new state
+     */
+    watchPrepareState(callback: (state: ETransitionPrepareState) => void): boolean;
+
+    /**
+     * Stop calling back the function given to watchPrepareState
+     */
+    unwatchPrepareState(): boolean;
 }
 
 export interface IConfigurable { 
@@ -1433,29 +1655,10 @@ export interface SourceInfo {
     syncOffset: SyncOffset
 }
 export function createSources(sources: SourceInfo[]): IInput[] {
-    const items: IInput[] = [];
-    if (Array.isArray(sources)) {
-        sources.forEach(function (source) {
-            const newSource = obs.Input.create(source.type, source.name, source.settings);
-            if (newSource.audioMixers) {
-                newSource.muted = (source.muted != null) ? source.muted : false;
-                newSource.volume = (source.volume != null) ? source.volume : 1;
-                newSource.syncOffset =
-                (source.syncOffset != null) ? source.syncOffset : {sec: 0, nsec: 0};
-            }
-            items.push(newSource);
-            const filters = source.filters;
-            if (Array.isArray(filters)) {
-                    filters.forEach(function (filter) {
-                    const ObsFilter = obs.Filter.create(filter.type, filter.name, filter.settings);
-                    ObsFilter.enabled = (filter.enabled != null) ? filter.enabled : true;
-                    newSource.addFilter(ObsFilter);
-                    ObsFilter.release();
-                });
-            }
-        });
+    if (!Array.isArray(sources) || sources.length === 0) {
+        return [];
     }
-    return items;
+    return obs.Input.createBatch(sources);
 }
 export interface ISourceSize {
     name: string,
@@ -1475,6 +1678,91 @@ export function getSourcesSize(sourcesNames: string[]): ISourceSize[] {
     }
     return sourcesSize;
 }
+export interface IOutputPerformance {
+    /** 0 = streaming, 1 = recording, 2 = replay buffer */
+    kind: number,
+    active: boolean,
+    totalFrames: number,
+    /** Frames dropped by the output (network) */
+    droppedFrames: number,
+    congestion: number,
+    totalBytes: number
+}
+export interface IProfilerEntry {
+    depth: number,
+    name: string,
+    calls: number,
+    /** Times are in microseconds, totalTime is cumulative since profiling started */
+    totalTime: number,
+    minTime: number,
+    maxTime: number
+}
+export interface IPerformanceSnapshot {
+    version: number,
+    timestamp: number,
+    profiling: boolean,
+    renderedFrames: number,
+    /** Frames the render thread missed its deadline on */
+    laggedFrames: number,
+    videoFrames: number,
+    /** Frames skipped because encoders could not keep up */
+    skippedFrames: number,
+    outputs: IOutputPerformance[],
+    entries: IProfilerEntry[]
+}
+/**
+ * Decode the binary snapshot returned by NodeObs.OBS_API_getPerformanceSnapshot
+ */
+export function decodePerformanceSnapshot(buffer: Buffer): IPerformanceSnapshot {
+    let offset = 0;
+    const readUInt8 = () => { const v = buffer.readUInt8(offset); offset += 1; return v; };
+    const readUInt16 = () => { const v = buffer.readUInt16LE(offset); offset += 2; return v; };
+    const readUInt32 = () => { const v = buffer.readUInt32LE(offset); offset += 4; return v; };
+    const readInt32 = () => { const v = buffer.readInt32LE(offset); offset += 4; return v; };
+    const readFloat = () => { const v = buffer.readFloatLE(offset); offset += 4; return v; };
+    const readUInt64 = () => { const lo = readUInt32(); const hi = readUInt32(); return hi * 4294967296 + lo; };
+
+    const snapshot: IPerformanceSnapshot = {
+        version: readUInt32(),
+        timestamp: readUInt64(),
+        profiling: readUInt8() != 0,
+        renderedFrames: readUInt32(),
+        laggedFrames: readUInt32(),
+        videoFrames: readUInt32(),
+        skippedFrames: readUInt32(),
+        outputs: [],
+        entries: []
+    };
+
+    const outputCount = readUInt32();
+    for (let i = 0; i < outputCount; i++) {
+        snapshot.outputs.push({
+            kind: readUInt8(),
+            active: readUInt8() != 0,
+            totalFrames: readInt32(),
+            droppedFrames: readInt32(),
+            congestion: readFloat(),
+            totalBytes: readUInt64()
+        });
+    }
+
+    const entryCount = readUInt32();
+    for (let i = 0; i < entryCount; i++) {
+        const depth = readUInt16();
+        const length = readUInt16();
+        const name = buffer.toString('utf8', offset, offset + length);
+        offset += length;
+        snapshot.entries.push({
+            depth: depth,
+            name: name,
+            calls: readUInt64(),
+            totalTime: readUInt64(),
+            minTime: readUInt64(),
+            maxTime: readUInt64()
+        });
+    }
+    return snapshot;
+}
 export interface IServiceFactory {
     types(): string[];
     create(id: string, name: string, settings?: ISettings): IService;
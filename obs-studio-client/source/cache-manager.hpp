@@ -39,8 +39,11 @@ struct SourceDataInfo
 	std::string setting         = "";
 	bool        settingsChanged = true;
 
-	osn::property_map_t properties;
-	bool                propertiesChanged = true;
+	// Only the values are kept, the schema is shared by the sources of the type
+	std::weak_ptr<osn::property_map_t> properties;
+	std::vector<char>                  propertyValues;
+	uint64_t                           propertiesHash    = 0;
+	bool                               propertiesChanged = true;
 
 	uint32_t audioMixers        = UINT32_MAX;
 	bool     audioMixersChanged = true;
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "callback-manager.hpp"
+#include "cache-manager.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "utility-v8.hpp"
@@ -36,6 +37,12 @@ Napi::ThreadSafeFunction globalCallback::js_thread;
 bool globalCallback::m_all_workers_stop = false;
 std::mutex globalCallback::mtx_volmeters;
 std::map<uint64_t, Napi::ThreadSafeFunction> globalCallback::volmeters;
+std::mutex globalCallback::mtx_media_states;
+std::map<uint64_t, Napi::ThreadSafeFunction> globalCallback::media_states;
+std::mutex globalCallback::mtx_scene_events;
+std::map<uint64_t, Napi::ThreadSafeFunction> globalCallback::scene_events;
+std::mutex globalCallback::mtx_prepare_states;
+std::map<uint64_t, Napi::ThreadSafeFunction> globalCallback::prepare_states;
 
 void globalCallback::Init(Napi::Env env, Napi::Object exports)
 {
@@ -138,6 +145,79 @@ void globalCallback::worker()
 		delete data;
 	};
 
+	auto media_state_callback = []( Napi::Env env, Napi::Function jsCallback, MediaStateData* data ) {
+		try {
+			Napi::Object state = Napi::Object::New(env);
+			state.Set("state", Napi::Number::New(env, data->state));
+			state.Set("time", Napi::Number::New(env, double(data->time)));
+			state.Set("duration", Napi::Number::New(env, double(data->duration)));
+			jsCallback.Call({ state });
+		} catch (...) {}
+		delete data;
+	};
+
+	auto scene_events_callback = []( Napi::Env env, Napi::Function jsCallback, SceneEventsData* data ) {
+		try {
+			// Drop what the cache holds about the changed items before the UI reads them again
+			SceneInfo* si = CacheManager<SceneInfo*>::getInstance().Retrieve(data->scene);
+			if (si && (data->reordered || data->added.size() || data->removed.size()))
+				si->itemsOrderCached = false;
+
+			for (auto& item : data->visible) {
+				SceneItemData* sid = CacheManager<SceneItemData*>::getInstance().Retrieve(item.uid);
+				if (sid) {
+					sid->isVisible      = item.visible;
+					sid->visibleChanged = false;
+				}
+			}
+			for (auto& item : data->transformed) {
+				SceneItemData* sid = CacheManager<SceneItemData*>::getInstance().Retrieve(item.uid);
+				if (sid) {
+					sid->posChanged      = true;
+					sid->scaleChanged    = true;
+					sid->rotationChanged = true;
+					sid->cropChanged     = true;
+				}
+			}
+
+			auto ids = [env](const std::vector<SceneItemEvent>& items) {
+				Napi::Array array = Napi::Array::New(env, items.size());
+				for (size_t i = 0; i < items.size(); i++)
+					array.Set(i, Napi::Number::New(env, double(items[i].id)));
+				return array;
+			};
+
+			Napi::Object events = Napi::Object::New(env);
+			events.Set("reordered", Napi::Boolean::New(env, data->reordered));
+			events.Set("added", ids(data->added));
+			events.Set("transformed", ids(data->transformed));
+
+			Napi::Array removed = Napi::Array::New(env, data->removed.size());
+			for (size_t i = 0; i < data->removed.size(); i++)
+				removed.Set(i, Napi::Number::New(env, double(data->removed[i])));
+			events.Set("removed", removed);
+
+			Napi::Array visible = Napi::Array::New(env, data->visible.size());
+			for (size_t i = 0; i < data->visible.size(); i++) {
+				Napi::Object item = Napi::Object::New(env);
+				item.Set("id", Napi::Number::New(env, double(data->visible[i].id)));
+				item.Set("visible", Napi::Boolean::New(env, data->visible[i].visible));
+				visible.Set(i, item);
+			}
+			events.Set("visible", visible);
+
+			jsCallback.Call({ events });
+		} catch (...) {}
+		delete data;
+	};
+
+	auto prepare_state_callback = []( Napi::Env env, Napi::Function jsCallback, PrepareStateData* data ) {
+		try {
+			jsCallback.Call({ Napi::Number::New(env, data->state) });
+		} catch (...) {}
+		delete data;
+	};
+
 	size_t totalSleepMS = 0;
 
 	while (!worker_stop && !m_all_workers_stop) {
@@ -216,6 +296,100 @@ void globalCallback::worker()
 				}
 			}
 
+			// Watched media sources that changed since the last query
+			if (index < response.size()) {
+				std::unique_lock<std::mutex> lck(mtx_media_states);
+				uint32_t changes = response[index++].value_union.ui32;
+				for (uint32_t n = 0; n < changes && index + 4 <= response.size(); n++, index += 4) {
+					auto found = media_states.find(response[index].value_union.ui64);
+					if (found == media_states.end())
+						continue;
+
+					MediaStateData* data = new MediaStateData{
+						response[index + 1].value_union.ui32,
+						response[index + 2].value_union.i64,
+						response[index + 3].value_union.i64};
+					napi_status status = found->second.NonBlockingCall(data, media_state_callback);
+					if (status != napi_ok) {
+						delete data;
+					}
+				}
+			}
+
+			// Batched item changes of the connected scenes
+			if (index < response.size()) {
+				std::unique_lock<std::mutex> lck(mtx_scene_events);
+				uint32_t batches = response[index++].value_union.ui32;
+				for (uint32_t n = 0; n < batches && index + 2 < response.size(); n++) {
+					SceneEventsData* data = new SceneEventsData;
+					data->scene     = response[index++].value_union.ui64;
+					data->reordered = response[index++].value_union.ui32 != 0;
+
+					// False if the response ends before the batch does
+					auto read_items = [&](std::vector<SceneItemEvent>& items, bool withVisible) {
+						if (index >= response.size())
+							return false;
+						uint32_t count = response[index++].value_union.ui32;
+						size_t   size  = withVisible ? 3 : 2;
+						for (uint32_t i = 0; i < count; i++) {
+							if (index + size > response.size())
+								return false;
+							SceneItemEvent item = {};
+							item.id  = response[index++].value_union.i64;
+							item.uid = response[index++].value_union.ui64;
+							if (withVisible)
+								item.visible = response[index++].value_union.ui32 != 0;
+							items.push_back(item);
+						}
+						return true;
+					};
+					auto read_removed = [&](std::vector<int64_t>& items) {
+						if (index >= response.size())
+							return false;
+						uint32_t count = response[index++].value_union.ui32;
+						for (uint32_t i = 0; i < count; i++) {
+							if (index >= response.size())
+								return false;
+							items.push_back(response[index++].value_union.i64);
+						}
+						return true;
+					};
+
+					if (!read_items(data->added, false) || !read_removed(data->removed)
+					    || !read_items(data->visible, true) || !read_items(data->transformed, false)) {
+						delete data;
+						break;
+					}
+
+					auto found = scene_events.find(data->scene);
+					if (found == scene_events.end()) {
+						delete data;
+						continue;
+					}
+					napi_status status = found->second.NonBlockingCall(data, scene_events_callback);
+					if (status != napi_ok) {
+						delete data;
+					}
+				}
+			}
+
+			// Transitions whose prepared target became ready, timed out or expired
+			if (index < response.size()) {
+				std::unique_lock<std::mutex> lck(mtx_prepare_states);
+				uint32_t changes = response[index++].value_union.ui32;
+				for (uint32_t n = 0; n < changes && index + 3 <= response.size(); n++, index += 3) {
+					auto found = prepare_states.find(response[index].value_union.ui64);
+					if (found == prepare_states.end())
+						continue;
+
+					PrepareStateData* data = new PrepareStateData{response[index + 1].value_union.ui32};
+					napi_status status = found->second.NonBlockingCall(data, prepare_state_callback);
+					if (status != napi_ok) {
+						delete data;
+					}
+				}
+			}
+
 		}
 
 	do_sleep:
@@ -248,4 +422,73 @@ void globalCallback::remove_volmeter(uint64_t id)
 	
 	volmeters[id].Release();
 	volmeters.erase(id);
-}
\ No newline at end of file
+}
+
+void globalCallback::add_media_state(napi_env env, uint64_t id, Napi::Function cb)
+{
+	remove_media_state(id);
+
+	Napi::ThreadSafeFunction media_thread = Napi::ThreadSafeFunction::New(
+      env,
+      cb,
+      "MediaState",
+      0,
+      1,
+      []( Napi::Env ) {} );
+	media_states.insert(std::make_pair(id, media_thread));
+}
+
+void globalCallback::remove_media_state(uint64_t id)
+{
+	if (media_states.find(id) == media_states.end())
+		return;
+
+	media_states[id].Release();
+	media_states.erase(id);
+}
+
+void globalCallback::add_scene_events(napi_env env, uint64_t id, Napi::Function cb)
+{
+	remove_scene_events(id);
+
+	Napi::ThreadSafeFunction scene_thread = Napi::ThreadSafeFunction::New(
+      env,
+      cb,
+      "SceneEvents",
+      0,
+      1,
+      []( Napi::Env ) {} );
+	scene_events.insert(std::make_pair(id, scene_thread));
+}
+
+void globalCallback::remove_scene_events(uint64_t id)
+{
+	if (scene_events.find(id) == scene_events.end())
+		return;
+
+	scene_events[id].Release();
+	scene_events.erase(id);
+}
+
+void globalCallback::add_prepare_state(napi_env env, uint64_t id, Napi::Function cb)
+{
+	remove_prepare_state(id);
+
+	Napi::ThreadSafeFunction prepare_thread = Napi::ThreadSafeFunction::New(
+      env,
+      cb,
+      "PrepareState",
+      0,
+      1,
+      []( Napi::Env ) {} );
+	prepare_states.insert(std::make_pair(id, prepare_thread));
+}
+
+void globalCallback::remove_prepare_state(uint64_t id)
+{
+	if (prepare_states.find(id) == prepare_states.end())
+		return;
+
+	prepare_states[id].Release();
+	prepare_states.erase(id);
+}
@@ -35,6 +35,35 @@ struct SourceSizeInfoData
 	std::vector<SourceSizeInfo*> items;
 };
 
+struct MediaStateData
+{
+	uint32_t state;
+	int64_t  time;
+	int64_t  duration;
+};
+
+struct PrepareStateData
+{
+	uint32_t state;
+};
+
+struct SceneItemEvent
+{
+	int64_t  id;
+	uint64_t uid; // UINT64_MAX if the item was never fetched
+	bool     visible;
+};
+
+struct SceneEventsData
+{
+	uint64_t                    scene;
+	bool                        reordered;
+	std::vector<SceneItemEvent> added;
+	std::vector<int64_t>        removed;
+	std::vector<SceneItemEvent> visible;
+	std::vector<SceneItemEvent> transformed;
+};
+
 namespace globalCallback
 {
 	extern bool isWorkerRunning;
@@ -47,6 +76,15 @@ namespace globalCallback
 	extern std::mutex mtx_volmeters;
 	extern std::map<uint64_t, Napi::ThreadSafeFunction> volmeters;
 
+	extern std::mutex mtx_media_states;
+	extern std::map<uint64_t, Napi::ThreadSafeFunction> media_states;
+
+	extern std::mutex mtx_scene_events;
+	extern std::map<uint64_t, Napi::ThreadSafeFunction> scene_events;
+
+	extern std::mutex mtx_prepare_states;
+	extern std::map<uint64_t, Napi::ThreadSafeFunction> prepare_states;
+
 	void worker(void);
 	void start_worker(napi_env env, Napi::Function async_callback);
 	void stop_worker(void);
@@ -54,6 +92,15 @@ namespace globalCallback
 	void add_volmeter(napi_env env, uint64_t id, Napi::Function cb);
 	void remove_volmeter(uint64_t id);
 
+	void add_media_state(napi_env env, uint64_t id, Napi::Function cb);
+	void remove_media_state(uint64_t id);
+
+	void add_scene_events(napi_env env, uint64_t id, Napi::Function cb);
+	void remove_scene_events(uint64_t id);
+
+	void add_prepare_state(napi_env env, uint64_t id, Napi::Function cb);
+	void remove_prepare_state(uint64_t id);
+
 	void Init(Napi::Env env, Napi::Object exports);
 
 	Napi::Value RegisterGlobalCallback(const Napi::CallbackInfo& info);
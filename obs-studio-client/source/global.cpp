@@ -18,6 +18,7 @@
 
 #include "global.hpp"
 #include <condition_variable>
+#include <inttypes.h>
 #include <ipc-value.hpp>
 #include <mutex>
 #include "controller.hpp"
@@ -38,6 +39,7 @@ Napi::Object osn::Global::Init(Napi::Env env, Napi::Object exports) {
 			StaticMethod("getOutputSource", &osn::Global::getOutputSource),
 			StaticMethod("setOutputSource", &osn::Global::setOutputSource),
 			StaticMethod("getOutputFlagsFromId", &osn::Global::getOutputFlagsFromId),
+			StaticMethod("getTypeCatalog", &osn::Global::getTypeCatalog),
 
 			StaticAccessor("laggedFrames", &osn::Global::laggedFrames, nullptr),
 			StaticAccessor("totalFrames", &osn::Global::totalFrames, nullptr),
@@ -204,3 +206,87 @@ void osn::Global::setMultipleRendering(const Napi::CallbackInfo& info, const Nap
 
 	conn->call("Global", "SetMultipleRendering", {ipc::value(value.ToBoolean().Value())});
 }
+
+struct TypeCatalogEntry
+{
+	std::string id;
+	uint32_t    type;
+	std::string displayName;
+	uint32_t    outputFlags;
+	std::string defaults;
+	uint64_t    propertiesHash;
+};
+
+// Last catalog received, the server only sends it again when its fingerprint changes
+static uint64_t                      typeCatalogFingerprint = 0;
+static std::vector<TypeCatalogEntry> typeCatalog;
+
+static std::string HashToString(uint64_t hash)
+{
+	char text[17];
+	snprintf(text, sizeof(text), "%016" PRIx64, hash);
+	return text;
+}
+
+Napi::Value osn::Global::getTypeCatalog(const Napi::CallbackInfo& info)
+{
+	// A fingerprint kept from an earlier session, the types are left out if it still matches
+	uint64_t knownFingerprint = typeCatalogFingerprint;
+	bool     callerKnows      = info.Length() > 0 && info[0].IsString();
+	if (callerKnows)
+		knownFingerprint = strtoull(info[0].ToString().Utf8Value().c_str(), nullptr, 16);
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Global", "GetTypeCatalog", {ipc::value(knownFingerprint)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	uint64_t fingerprint = response[1].value_union.ui64;
+	bool     unchanged   = !!response[2].value_union.ui32;
+	uint32_t count       = response[3].value_union.ui32;
+
+	if (!unchanged || fingerprint != typeCatalogFingerprint) {
+		typeCatalog.clear();
+		size_t index = 4;
+		for (uint32_t idx = 0; idx < count && index + 6 <= response.size(); idx++, index += 6) {
+			TypeCatalogEntry entry;
+			entry.id             = response[index].value_str;
+			entry.type           = response[index + 1].value_union.ui32;
+			entry.displayName    = response[index + 2].value_str;
+			entry.outputFlags    = response[index + 3].value_union.ui32;
+			entry.defaults       = response[index + 4].value_str;
+			entry.propertiesHash = response[index + 5].value_union.ui64;
+			typeCatalog.push_back(std::move(entry));
+		}
+		typeCatalogFingerprint = unchanged ? 0 : fingerprint;
+	}
+
+	Napi::Object json  = info.Env().Global().Get("JSON").As<Napi::Object>();
+	Napi::Function parse = json.Get("parse").As<Napi::Function>();
+
+	Napi::Array types = Napi::Array::New(info.Env());
+	if (!(unchanged && callerKnows)) {
+		for (uint32_t idx = 0; idx < typeCatalog.size(); idx++) {
+			auto&        entry = typeCatalog[idx];
+			Napi::Object type  = Napi::Object::New(info.Env());
+			type.Set("id", Napi::String::New(info.Env(), entry.id));
+			type.Set("type", Napi::Number::New(info.Env(), entry.type));
+			type.Set("displayName", Napi::String::New(info.Env(), entry.displayName));
+			type.Set("outputFlags", Napi::Number::New(info.Env(), entry.outputFlags));
+			type.Set("defaults", parse.Call(json, {Napi::String::New(info.Env(), entry.defaults)}));
+			type.Set("propertiesHash", Napi::String::New(info.Env(), HashToString(entry.propertiesHash)));
+			types.Set(idx, type);
+		}
+	}
+
+	Napi::Object catalog = Napi::Object::New(info.Env());
+	catalog.Set("fingerprint", Napi::String::New(info.Env(), HashToString(fingerprint)));
+	catalog.Set("unchanged", Napi::Boolean::New(info.Env(), unchanged && callerKnows));
+	catalog.Set("types", types);
+	return catalog;
+}
@@ -22,6 +22,7 @@
 #include <string>
 #include <algorithm>
 #include <iterator>
+#include "callback-manager.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "filter.hpp"
@@ -40,6 +41,8 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports) {
 			StaticMethod("types", &osn::Input::Types),
 			StaticMethod("create", &osn::Input::Create),
 			StaticMethod("createPrivate", &osn::Input::CreatePrivate),
+			StaticMethod("createBatch", &osn::Input::CreateBatch),
+			StaticMethod("getMediaStates", &osn::Input::GetMediaStates),
 			StaticMethod("fromName", &osn::Input::FromName),
 			StaticMethod("getPublicSources", &osn::Input::GetPublicSources),
 
@@ -47,6 +50,7 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports) {
 			InstanceMethod("addFilter", &osn::Input::AddFilter),
 			InstanceMethod("removeFilter", &osn::Input::RemoveFilter),
 			InstanceMethod("setFilterOrder", &osn::Input::SetFilterOrder),
+			InstanceMethod("setFilterChain", &osn::Input::SetFilterChain),
 			InstanceMethod("findFilter", &osn::Input::FindFilter),
 			InstanceMethod("copyFilters", &osn::Input::CopyFilters),
 
@@ -92,6 +96,8 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports) {
 			InstanceMethod("restart", &osn::Input::Restart),
 			InstanceMethod("stop", &osn::Input::Stop),
 			InstanceMethod("getMediaState", &osn::Input::GetMediaState),
+			InstanceMethod("watchMediaState", &osn::Input::WatchMediaState),
+			InstanceMethod("unwatchMediaState", &osn::Input::UnwatchMediaState),
 			InstanceMethod("callHandler", &osn::Input::CallCallHandler)
 		});
 	exports.Set("Input", func);
@@ -198,6 +204,53 @@ Napi::Value osn::Input::Create(const Napi::CallbackInfo& info)
     return instance;
 }
 
+Napi::Value osn::Input::CreateBatch(const Napi::CallbackInfo& info)
+{
+	Napi::Array sources = info[0].As<Napi::Array>();
+
+	Napi::Object   json      = info.Env().Global().Get("JSON").As<Napi::Object>();
+	Napi::Function stringify = json.Get("stringify").As<Napi::Function>();
+	std::string    request   = stringify.Call(json, {sources}).As<Napi::String>().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Input", "CreateBatch", {ipc::value(request)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	// uid, settings, audio mixers and muted per source, in the order they were given
+	Napi::Array array = Napi::Array::New(info.Env(), sources.Length());
+	for (uint32_t index = 0; index < sources.Length() && 4 * index + 4 < response.size(); index++) {
+		size_t   offset = 4 * index + 1;
+		uint64_t uid    = response[offset].value_union.ui64;
+		if (uid == UINT64_MAX) {
+			array.Set(index, info.Env().Undefined());
+			continue;
+		}
+
+		Napi::Object source = sources.Get(index).ToObject();
+
+		SourceDataInfo* sdi = new SourceDataInfo;
+		sdi->name           = source.Get("name").ToString().Utf8Value();
+		sdi->obs_sourceId   = source.Get("type").ToString().Utf8Value();
+		sdi->id             = uid;
+		sdi->setting        = response[offset + 1].value_str;
+		sdi->audioMixers    = response[offset + 2].value_union.ui32;
+		sdi->isMuted        = (bool)response[offset + 3].value_union.i32;
+		sdi->mutedChanged   = false;
+
+		CacheManager<SourceDataInfo*>::getInstance().Store(uid, sdi->name, sdi);
+
+		array.Set(index, osn::Input::constructor.New({Napi::Number::New(info.Env(), uid)}));
+	}
+
+	return array;
+}
+
 Napi::Value osn::Input::CreatePrivate(const Napi::CallbackInfo& info)
 {
 	std::string type = info[0].ToString().Utf8Value();
@@ -675,6 +728,54 @@ Napi::Value osn::Input::SetFilterOrder(const Napi::CallbackInfo& info)
 	return info.Env().Undefined();
 }
 
+Napi::Value osn::Input::SetFilterChain(const Napi::CallbackInfo& info)
+{
+	Napi::Array chain = info[0].As<Napi::Array>();
+
+	// Filter objects are sent as their ids, enabled and settings as given
+	Napi::Array links = Napi::Array::New(info.Env(), chain.Length());
+	for (uint32_t index = 0; index < chain.Length(); index++) {
+		Napi::Object entry     = chain.Get(index).ToObject();
+		osn::Filter* objfilter = Napi::ObjectWrap<osn::Filter>::Unwrap(entry.Get("filter").ToObject());
+
+		Napi::Object link = Napi::Object::New(info.Env());
+		link.Set("id", Napi::Number::New(info.Env(), double(objfilter->sourceId)));
+		if (entry.Has("enabled") && !entry.Get("enabled").IsUndefined())
+			link.Set("enabled", entry.Get("enabled").ToBoolean());
+		if (entry.Has("settings") && entry.Get("settings").IsObject())
+			link.Set("settings", entry.Get("settings"));
+		links.Set(index, link);
+	}
+
+	Napi::Object   json      = info.Env().Global().Get("JSON").As<Napi::Object>();
+	Napi::Function stringify = json.Get("stringify").As<Napi::Function>();
+	std::string    request   = stringify.Call(json, {links}).As<Napi::String>().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Input", "SetFilterChain", {ipc::value(this->sourceId), ipc::value(request)});
+
+	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(this->sourceId);
+	if (!ValidateResponse(info, response)) {
+		if (sdi)
+			sdi->filtersOrderChanged = true;
+		return info.Env().Undefined();
+	}
+
+	// The reply is the resulting chain, no need to ask for it again
+	if (sdi) {
+		sdi->filters->clear();
+		for (size_t idx = 1; idx < response.size(); idx++)
+			sdi->filters->push_back(response[idx].value_union.ui64);
+		sdi->filtersOrderChanged = false;
+	}
+
+	return info.Env().Undefined();
+}
+
 Napi::Value osn::Input::FindFilter(const Napi::CallbackInfo& info)
 {
 	std::string name = info[0].ToString().Utf8Value();
@@ -799,6 +900,10 @@ void osn::Input::CallSetEnabled(const Napi::CallbackInfo& info, const Napi::Valu
 
 Napi::Value osn::Input::CallRelease(const Napi::CallbackInfo& info)
 {
+	{
+		std::unique_lock<std::mutex> lck(globalCallback::mtx_media_states);
+		globalCallback::remove_media_state(this->sourceId);
+	}
 	osn::ISource::Release(info, this->sourceId);
 
 	return info.Env().Undefined();
@@ -811,6 +916,10 @@ Napi::Value osn::Input::CallCallHandler(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Input::CallRemove(const Napi::CallbackInfo& info)
 {
+	{
+		std::unique_lock<std::mutex> lck(globalCallback::mtx_media_states);
+		globalCallback::remove_media_state(this->sourceId);
+	}
 	osn::ISource::Remove(info, this->sourceId);
 	this->sourceId = UINT64_MAX;
 
@@ -971,4 +1080,80 @@ Napi::Value osn::Input::GetMediaState(const Napi::CallbackInfo& info)
 		return info.Env().Undefined();
 
 	return Napi::Number::New(info.Env(), response[1].value_union.ui64);
+}
+
+Napi::Value osn::Input::GetMediaStates(const Napi::CallbackInfo& info)
+{
+	Napi::Array inputs = info[0].As<Napi::Array>();
+
+	std::vector<char> uids(sizeof(uint64_t) * inputs.Length());
+	for (uint32_t index = 0; index < inputs.Length(); index++) {
+		osn::Input* input = Napi::ObjectWrap<osn::Input>::Unwrap(inputs.Get(index).ToObject());
+		memcpy(uids.data() + index * sizeof(uint64_t), &input->sourceId, sizeof(uint64_t));
+	}
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetMediaStates", {ipc::value(uids)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	// State, time and duration per input, in the order they were given
+	Napi::Array array = Napi::Array::New(info.Env(), inputs.Length());
+	for (uint32_t index = 0; index < inputs.Length() && 3 * index + 3 < response.size(); index++) {
+		size_t offset = 3 * index + 1;
+		if (response[offset].value_union.ui32 == UINT32_MAX) {
+			array.Set(index, info.Env().Undefined());
+			continue;
+		}
+
+		Napi::Object state = Napi::Object::New(info.Env());
+		state.Set("state", Napi::Number::New(info.Env(), response[offset].value_union.ui32));
+		state.Set("time", Napi::Number::New(info.Env(), double(response[offset + 1].value_union.i64)));
+		state.Set("duration", Napi::Number::New(info.Env(), double(response[offset + 2].value_union.i64)));
+		array.Set(index, state);
+	}
+	return array;
+}
+
+Napi::Value osn::Input::WatchMediaState(const Napi::CallbackInfo& info)
+{
+	std::unique_lock<std::mutex> lck(globalCallback::mtx_media_states);
+	Napi::Function async_callback = info[0].As<Napi::Function>();
+	uint32_t       granularity    = info.Length() > 1 ? info[1].ToNumber().Uint32Value() : 1000;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Source", "WatchMediaState", {ipc::value(this->sourceId), ipc::value(granularity)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	globalCallback::add_media_state(info.Env(), this->sourceId, async_callback);
+
+	return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value osn::Input::UnwatchMediaState(const Napi::CallbackInfo& info)
+{
+	std::unique_lock<std::mutex> lck(globalCallback::mtx_media_states);
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Source", "UnwatchMediaState", {ipc::value(this->sourceId)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	globalCallback::remove_media_state(this->sourceId);
+
+	return Napi::Boolean::New(info.Env(), true);
 }
\ No newline at end of file
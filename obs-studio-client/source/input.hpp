@@ -36,6 +36,8 @@ namespace osn
 		static Napi::Value Types(const Napi::CallbackInfo& info);
 		static Napi::Value Create(const Napi::CallbackInfo& info);
 		static Napi::Value CreatePrivate(const Napi::CallbackInfo& info);
+		static Napi::Value CreateBatch(const Napi::CallbackInfo& info);
+		static Napi::Value GetMediaStates(const Napi::CallbackInfo& info);
 		static Napi::Value FromName(const Napi::CallbackInfo& info);
 		static Napi::Value GetPublicSources(const Napi::CallbackInfo& info);
 
@@ -43,6 +45,7 @@ namespace osn
 		Napi::Value AddFilter(const Napi::CallbackInfo& info);
 		Napi::Value RemoveFilter(const Napi::CallbackInfo& info);
 		Napi::Value SetFilterOrder(const Napi::CallbackInfo& info);
+		Napi::Value SetFilterChain(const Napi::CallbackInfo& info);
 		Napi::Value FindFilter(const Napi::CallbackInfo& info);
 		Napi::Value CopyFilters(const Napi::CallbackInfo& info);
 
@@ -102,6 +105,8 @@ namespace osn
 		void Restart(const Napi::CallbackInfo& info);
 		void Stop(const Napi::CallbackInfo& info);
 		Napi::Value GetMediaState(const Napi::CallbackInfo& info);
+		Napi::Value WatchMediaState(const Napi::CallbackInfo& info);
+		Napi::Value UnwatchMediaState(const Napi::CallbackInfo& info);
 
 		Napi::Value CallCallHandler(const Napi::CallbackInfo& info);
 	};
@@ -20,6 +20,7 @@
 #include <error.hpp>
 #include <functional>
 #include "controller.hpp"
+#include "property-schema-cache.hpp"
 #include "shared.hpp"
 #include "utility-v8.hpp"
 #include "utility.hpp"
@@ -64,6 +65,14 @@ Napi::Value osn::ISource::IsConfigurable(const Napi::CallbackInfo& info, uint64_
 	return Napi::Boolean::New(info.Env(), (bool)response[1].value_union.i32);
 }
 
+static PropertySchemaCache propertySchemas;
+
+static Napi::Value NewProperties(const Napi::CallbackInfo& info, std::shared_ptr<osn::property_map_t> properties, uint64_t id)
+{
+	auto prop_ptr = Napi::External<std::shared_ptr<osn::property_map_t>>::New(info.Env(), &properties);
+	return osn::Properties::constructor.New({prop_ptr, Napi::Number::New(info.Env(), (uint32_t)id)});
+}
+
 Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo& info, uint64_t id)
 {
 	osn::ISource* source =
@@ -74,44 +83,60 @@ Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo& info, uint64_t
 	SourceDataInfo* sdi =
 		CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
 
-	if (sdi && !sdi->propertiesChanged && sdi->properties.size() > 0) {
-		std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(sdi->properties);
-		auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
-		auto instance =
-			osn::Properties::constructor.New({
-				prop_ptr,
-				Napi::Number::New(info.Env(), (uint32_t)id)
-				});
-		return instance;
+	if (sdi && !sdi->propertiesChanged && sdi->propertiesHash) {
+		// Shared while a Properties object of the source is alive, rebuilt from the values otherwise
+		std::shared_ptr<property_map_t> properties = sdi->properties.lock();
+		if (!properties) {
+			obs::PropertySchema::List props;
+			if (propertySchemas.Load(sdi->obs_sourceId, sdi->propertiesHash, sdi->propertyValues, props)) {
+				properties      = std::make_shared<property_map_t>(osn::ProcessProperties(props));
+				sdi->properties = properties;
+			}
+		}
+		if (properties && properties->size() > 0)
+			return NewProperties(info, properties, id);
 	}
 
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
 
+	// Schemas are shared by type id, ask the server for it rather than share the "" key
+	if (sdi && sdi->obs_sourceId.empty()) {
+		std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetId", {ipc::value(id)});
+		if (!ValidateResponse(info, response))
+			return info.Env().Undefined();
+		sdi->obs_sourceId = response[1].value_str;
+	}
+
+	// Sources of the same type mostly share their schema, only the values are sent back then
+	uint64_t knownHash = sdi ? propertySchemas.KnownHash(sdi->obs_sourceId) : 0;
+
 	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "GetProperties", {ipc::value(id)});
+	    conn->call_synchronous_helper("Source", "GetProperties", {ipc::value(id), ipc::value(knownHash)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	if (response.size() == 1)
-		return info.Env().Null();
-
-	osn::property_map_t pmap = osn::ProcessProperties(response, 1);
-
+	std::shared_ptr<property_map_t> properties;
 	if (sdi) {
-		sdi->properties        = pmap;
+		obs::PropertySchema::List props;
+		sdi->propertiesHash =
+		    propertySchemas.Store(sdi->obs_sourceId, response[1].value_bin, props, sdi->propertyValues);
+		if (!sdi->propertiesHash)
+			return info.Env().Undefined();
+
+		properties             = std::make_shared<property_map_t>(osn::ProcessProperties(props));
+		sdi->properties        = properties;
 		sdi->propertiesChanged = false;
+	} else {
+		properties = std::make_shared<property_map_t>(osn::ProcessProperties(response, 1));
 	}
-	std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(pmap);
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
-	auto instance =
-		osn::Properties::constructor.New({
-			prop_ptr,
-			Napi::Number::New(info.Env(), (uint32_t)id)
-			});
-	return instance;
+
+	if (properties->empty())
+		return info.Env().Null();
+
+	return NewProperties(info, properties, id);
 }
 
 Napi::Value osn::ISource::GetSlowUncachedSettings(const Napi::CallbackInfo& info, uint64_t id)
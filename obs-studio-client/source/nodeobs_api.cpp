@@ -19,6 +19,7 @@
 #include "controller.hpp"
 #include "error.hpp"
 #include "nodeobs_api.hpp"
+#include <cstring>
 #include <sstream>
 #include <string>
 #include "shared.hpp"
@@ -142,6 +143,106 @@ Napi::Value api::OBS_API_getPerformanceStatistics(const Napi::CallbackInfo& info
 	return statistics;
 }
 
+Napi::Value api::OBS_API_setProfilingEnabled(const Napi::CallbackInfo& info)
+{
+	bool enabled;
+
+	ASSERT_GET_VALUE(info, info[0], enabled);
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("API", "OBS_API_setProfilingEnabled", {ipc::value((int32_t)enabled)});
+
+	ValidateResponse(info, response);
+
+	return info.Env().Undefined();
+}
+
+Napi::Value api::OBS_API_getPerformanceSnapshot(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("API", "OBS_API_getPerformanceSnapshot", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	const std::vector<char>& snapshot = response[1].value_bin;
+	return Napi::Buffer<char>::Copy(info.Env(), snapshot.data(), snapshot.size());
+}
+
+Napi::Value api::GetCallStats(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("System", "GetCallStats", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	uint32_t    count = response[1].value_union.ui32;
+	Napi::Array stats = Napi::Array::New(info.Env(), count);
+
+	size_t index = 2;
+	for (uint32_t i = 0; i < count && index + 8 <= response.size(); i++) {
+		Napi::Object call = Napi::Object::New(info.Env());
+		call.Set("collection", Napi::String::New(info.Env(), response[index++].value_str));
+		call.Set("function", Napi::String::New(info.Env(), response[index++].value_str));
+		call.Set("calls", Napi::Number::New(info.Env(), response[index++].value_union.ui64));
+		call.Set("totalTimeNs", Napi::Number::New(info.Env(), response[index++].value_union.ui64));
+		call.Set("maxTimeNs", Napi::Number::New(info.Env(), response[index++].value_union.ui64));
+		call.Set("bytesIn", Napi::Number::New(info.Env(), response[index++].value_union.ui64));
+		call.Set("bytesOut", Napi::Number::New(info.Env(), response[index++].value_union.ui64));
+
+		const std::vector<char>& buffer    = response[index++].value_bin;
+		size_t                   buckets   = buffer.size() / sizeof(uint64_t);
+		Napi::Array              histogram = Napi::Array::New(info.Env(), buckets);
+		for (size_t bucket = 0; bucket < buckets; bucket++) {
+			uint64_t value = *reinterpret_cast<const uint64_t*>(buffer.data() + bucket * sizeof(uint64_t));
+			histogram.Set(bucket, Napi::Number::New(info.Env(), value));
+		}
+		call.Set("histogram", histogram);
+
+		stats.Set(i, call);
+	}
+
+	return stats;
+}
+
+Napi::Value api::GetMediaCacheStats(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("System", "GetMediaCacheStats", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Object stats = Napi::Object::New(info.Env());
+	stats.Set("allowedCachedSize", Napi::Number::New(info.Env(), response[1].value_union.ui64));
+	stats.Set("cachedSize", Napi::Number::New(info.Env(), response[2].value_union.ui64));
+	stats.Set("memoryLoad", Napi::Number::New(info.Env(), response[3].value_union.ui32));
+	stats.Set("sources", Napi::Number::New(info.Env(), response[4].value_union.ui32));
+	stats.Set("cachedSources", Napi::Number::New(info.Env(), response[5].value_union.ui32));
+	stats.Set("events", Napi::Number::New(info.Env(), response[6].value_union.ui64));
+	stats.Set("coalescedEvents", Napi::Number::New(info.Env(), response[7].value_union.ui64));
+	stats.Set("cached", Napi::Number::New(info.Env(), response[8].value_union.ui64));
+	stats.Set("uncached", Napi::Number::New(info.Env(), response[9].value_union.ui64));
+	stats.Set("evicted", Napi::Number::New(info.Env(), response[10].value_union.ui64));
+	stats.Set("evictedUnderPressure", Napi::Number::New(info.Env(), response[11].value_union.ui64));
+	stats.Set("rejected", Napi::Number::New(info.Env(), response[12].value_union.ui64));
+	return stats;
+}
+
 Napi::Value api::SetWorkingDirectory(const Napi::CallbackInfo& info)
 {
 	std::string path = info[0].ToString().Utf8Value();
@@ -170,6 +271,17 @@ Napi::Value api::InitShutdownSequence(const Napi::CallbackInfo& info)
 	return info.Env().Undefined();
 }
 
+static Napi::Object HotkeyToObject(Napi::Env env, const std::vector<ipc::value>& response, size_t responseIndex)
+{
+	Napi::Object object = Napi::Object::New(env);
+	object.Set(Napi::String::New(env, "ObjectName"), Napi::String::New(env, response[responseIndex + 0].value_str));
+	object.Set(Napi::String::New(env, "ObjectType"), Napi::Number::New(env, response[responseIndex + 1].value_union.ui32));
+	object.Set(Napi::String::New(env, "HotkeyName"), Napi::String::New(env, response[responseIndex + 2].value_str));
+	object.Set(Napi::String::New(env, "HotkeyDesc"), Napi::String::New(env, response[responseIndex + 3].value_str));
+	object.Set(Napi::String::New(env, "HotkeyId"), Napi::Number::New(env, response[responseIndex + 4].value_union.ui64));
+	return object;
+}
+
 Napi::Value api::OBS_API_QueryHotkeys(const Napi::CallbackInfo& info)
 {
 	auto conn = GetConnection(info);
@@ -184,43 +296,76 @@ Napi::Value api::OBS_API_QueryHotkeys(const Napi::CallbackInfo& info)
 	Napi::Array hotkeyInfos = Napi::Array::New(info.Env());
 
 	// For each hotkey info that we need to fill
-	for (int i = 0; i < (response.size() - 1) / 5; i++) {
-		int                   responseIndex = i * 5 + 1;
-		Napi::Object object     = Napi::Object::New(info.Env());
-		std::string  objectName = response[responseIndex + 0].value_str;
-		uint32_t     objectType = response[responseIndex + 1].value_union.ui32;
-		std::string  hotkeyName = response[responseIndex + 2].value_str;
-		std::string  hotkeyDesc = response[responseIndex + 3].value_str;
-		uint64_t     hotkeyId   = response[responseIndex + 4].value_union.ui64;
-
-		object.Set(
-			Napi::String::New(info.Env(), "ObjectName"),
-			Napi::String::New(info.Env(), objectName));
-
-		object.Set(
-			Napi::String::New(info.Env(), "ObjectType"),
-			Napi::Number::New(info.Env(), objectType));
-
-		object.Set(
-			Napi::String::New(info.Env(), "HotkeyName"),
-			Napi::String::New(info.Env(), hotkeyName));
-
-		object.Set(
-			Napi::String::New(info.Env(), "HotkeyDesc"),
-			Napi::String::New(info.Env(), hotkeyDesc));
-
-		object.Set(
-			Napi::String::New(info.Env(), "HotkeyId"),
-			Napi::Number::New(info.Env(), hotkeyId));
-
-		hotkeyInfos.Set(i, object);
-	}
+	for (uint32_t i = 0; i < (response.size() - 1) / 5; i++)
+		hotkeyInfos.Set(i, HotkeyToObject(info.Env(), response, i * 5 + 1));
 
 	return hotkeyInfos;
 }
 
+Napi::Value api::OBS_API_QueryHotkeysSince(const Napi::CallbackInfo& info)
+{
+	uint64_t version = 0;
+	if (info.Length() > 0 && info[0].IsNumber())
+		version = info[0].ToNumber().Int64Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("API", "OBS_API_QueryHotkeysSince", {ipc::value(version)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	uint64_t    changedCount = response[3].value_union.ui64;
+	Napi::Array changed      = Napi::Array::New(info.Env());
+	Napi::Array removed      = Napi::Array::New(info.Env());
+
+	size_t responseIndex = 4;
+	for (uint32_t i = 0; i < changedCount; i++, responseIndex += 5)
+		changed.Set(i, HotkeyToObject(info.Env(), response, responseIndex));
+	for (uint32_t i = 0; responseIndex < response.size(); i++, responseIndex++)
+		removed.Set(i, Napi::Number::New(info.Env(), response[responseIndex].value_union.ui64));
+
+	Napi::Object delta = Napi::Object::New(info.Env());
+	delta.Set("Version", Napi::Number::New(info.Env(), response[1].value_union.ui64));
+	delta.Set("Full", Napi::Boolean::New(info.Env(), response[2].value_union.ui32 != 0));
+	delta.Set("Changed", changed);
+	delta.Set("Removed", removed);
+	return delta;
+}
+
 Napi::Value api::OBS_API_ProcessHotkeyStatus(const Napi::CallbackInfo& info)
 {
+	// A batch is an array of [hotkeyId, pressed] pairs
+	if (info.Length() > 0 && info[0].IsArray()) {
+		Napi::Array           pairs = info[0].As<Napi::Array>();
+		std::vector<uint64_t> batch;
+		batch.reserve(pairs.Length() * 2);
+		for (uint32_t i = 0; i < pairs.Length(); i++) {
+			Napi::Value pair = pairs.Get(i);
+			if (!pair.IsArray() || pair.As<Napi::Array>().Length() < 2) {
+				Napi::TypeError::New(info.Env(), "Expected [hotkeyId, pressed] pairs").ThrowAsJavaScriptException();
+				return info.Env().Undefined();
+			}
+			batch.push_back(pair.As<Napi::Array>().Get(uint32_t(0)).ToNumber().Int64Value());
+			batch.push_back(pair.As<Napi::Array>().Get(uint32_t(1)).ToBoolean().Value());
+		}
+
+		std::vector<char> buffer(batch.size() * sizeof(uint64_t));
+		if (!batch.empty())
+			memcpy(buffer.data(), batch.data(), buffer.size());
+
+		auto conn = GetConnection(info);
+		if (!conn)
+			return info.Env().Undefined();
+
+		conn->call("API", "OBS_API_ProcessHotkeyStatusBatch", {ipc::value(buffer)});
+
+		return info.Env().Undefined();
+	}
+
 	uint64_t    hotkeyId;
 	bool        press;
 
@@ -320,9 +465,14 @@ void api::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(Napi::String::New(env, "OBS_API_initAPI"), Napi::Function::New(env, api::OBS_API_initAPI));
 	exports.Set(Napi::String::New(env, "OBS_API_destroyOBS_API"), Napi::Function::New(env, api::OBS_API_destroyOBS_API));
 	exports.Set(Napi::String::New(env, "OBS_API_getPerformanceStatistics"), Napi::Function::New(env, api::OBS_API_getPerformanceStatistics));
+	exports.Set(Napi::String::New(env, "OBS_API_setProfilingEnabled"), Napi::Function::New(env, api::OBS_API_setProfilingEnabled));
+	exports.Set(Napi::String::New(env, "OBS_API_getPerformanceSnapshot"), Napi::Function::New(env, api::OBS_API_getPerformanceSnapshot));
+	exports.Set(Napi::String::New(env, "GetCallStats"), Napi::Function::New(env, api::GetCallStats));
+	exports.Set(Napi::String::New(env, "GetMediaCacheStats"), Napi::Function::New(env, api::GetMediaCacheStats));
 	exports.Set(Napi::String::New(env, "SetWorkingDirectory"), Napi::Function::New(env, api::SetWorkingDirectory));
 	exports.Set(Napi::String::New(env, "InitShutdownSequence"), Napi::Function::New(env, api::InitShutdownSequence));
 	exports.Set(Napi::String::New(env, "OBS_API_QueryHotkeys"), Napi::Function::New(env, api::OBS_API_QueryHotkeys));
+	exports.Set(Napi::String::New(env, "OBS_API_QueryHotkeysSince"), Napi::Function::New(env, api::OBS_API_QueryHotkeysSince));
 	exports.Set(Napi::String::New(env, "OBS_API_ProcessHotkeyStatus"), Napi::Function::New(env, api::OBS_API_ProcessHotkeyStatus));
 	exports.Set(Napi::String::New(env, "SetUsername"), Napi::Function::New(env, api::SetUsername));
 	exports.Set(Napi::String::New(env, "GetPermissionsStatus"), Napi::Function::New(env, api::GetPermissionsStatus));
@@ -34,9 +34,14 @@ namespace api
 	Napi::Value OBS_API_initAPI(const Napi::CallbackInfo& info);
 	Napi::Value OBS_API_destroyOBS_API(const Napi::CallbackInfo& info);
 	Napi::Value OBS_API_getPerformanceStatistics(const Napi::CallbackInfo& info);
+	Napi::Value OBS_API_setProfilingEnabled(const Napi::CallbackInfo& info);
+	Napi::Value OBS_API_getPerformanceSnapshot(const Napi::CallbackInfo& info);
+	Napi::Value GetCallStats(const Napi::CallbackInfo& info);
+	Napi::Value GetMediaCacheStats(const Napi::CallbackInfo& info);
 	Napi::Value SetWorkingDirectory(const Napi::CallbackInfo& info);
 	Napi::Value InitShutdownSequence(const Napi::CallbackInfo& info);
 	Napi::Value OBS_API_QueryHotkeys(const Napi::CallbackInfo& info);
+	Napi::Value OBS_API_QueryHotkeysSince(const Napi::CallbackInfo& info);
 	Napi::Value OBS_API_ProcessHotkeyStatus(const Napi::CallbackInfo& info);
 	Napi::Value SetUsername(const Napi::CallbackInfo& info);
 	Napi::Value GetPermissionsStatus(const Napi::CallbackInfo& info);
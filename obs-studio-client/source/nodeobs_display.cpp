@@ -264,6 +264,45 @@ Napi::Value display::OBS_content_setDrawGuideLines(const Napi::CallbackInfo& inf
 	return info.Env().Undefined();
 }
 
+Napi::Value display::OBS_content_setDisplayMaxFps(const Napi::CallbackInfo& info)
+{
+	std::string key    = info[0].ToString().Utf8Value();
+	uint32_t    maxFps = info[1].ToNumber().Uint32Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("Display", "OBS_content_setDisplayMaxFps", {ipc::value(key), ipc::value(maxFps)});
+	return info.Env().Undefined();
+}
+
+Napi::Value display::OBS_content_setDisplayOverlayCache(const Napi::CallbackInfo& info)
+{
+	std::string key     = info[0].ToString().Utf8Value();
+	bool        enabled = info[1].ToBoolean().Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("Display", "OBS_content_setDisplayOverlayCache", {ipc::value(key), ipc::value(enabled)});
+	return info.Env().Undefined();
+}
+
+Napi::Value display::OBS_content_setDisplayPaused(const Napi::CallbackInfo& info)
+{
+	std::string key    = info[0].ToString().Utf8Value();
+	bool        paused = info[1].ToBoolean().Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("Display", "OBS_content_setDisplayPaused", {ipc::value(key), ipc::value(paused)});
+	return info.Env().Undefined();
+}
+
 Napi::Value display::OBS_content_createIOSurface(const Napi::CallbackInfo& info)
 {
 	std::string key = info[0].ToString().Utf8Value();
@@ -316,6 +355,15 @@ void display::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(
 		Napi::String::New(env, "OBS_content_setDrawGuideLines"),
 		Napi::Function::New(env, display::OBS_content_setDrawGuideLines));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_setDisplayMaxFps"),
+		Napi::Function::New(env, display::OBS_content_setDisplayMaxFps));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_setDisplayOverlayCache"),
+		Napi::Function::New(env, display::OBS_content_setDisplayOverlayCache));
+	exports.Set(
+		Napi::String::New(env, "OBS_content_setDisplayPaused"),
+		Napi::Function::New(env, display::OBS_content_setDisplayPaused));
 	exports.Set(
 		Napi::String::New(env, "OBS_content_createIOSurface"),
 		Napi::Function::New(env, display::OBS_content_createIOSurface));
@@ -221,6 +221,107 @@ Napi::Value service::OBS_service_getLastRecording(const Napi::CallbackInfo& info
 	return Napi::String::New(info.Env(), response.at(1).value_str);
 }
 
+Napi::Value service::OBS_service_addStreamingDestination(const Napi::CallbackInfo& info)
+{
+	std::string name     = info[0].ToString().Utf8Value();
+	std::string type     = info[1].ToString().Utf8Value();
+	std::string settings = info[2].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "NodeOBS_Service",
+	    "OBS_service_addStreamingDestination",
+	    {ipc::value(name), ipc::value(type), ipc::value(settings)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value service::OBS_service_removeStreamingDestination(const Napi::CallbackInfo& info)
+{
+	std::string name = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("NodeOBS_Service", "OBS_service_removeStreamingDestination", {ipc::value(name)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value service::OBS_service_startStreamingDestination(const Napi::CallbackInfo& info)
+{
+	std::string name = info[0].ToString().Utf8Value();
+
+	if (!isWorkerRunning) {
+		start_worker(info.Env(), cb.Value());
+		isWorkerRunning = true;
+	}
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("NodeOBS_Service", "OBS_service_startStreamingDestination", {ipc::value(name)});
+	return info.Env().Undefined();
+}
+
+Napi::Value service::OBS_service_stopStreamingDestination(const Napi::CallbackInfo& info)
+{
+	std::string name      = info[0].ToString().Utf8Value();
+	bool        forceStop = info[1].ToBoolean().Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("NodeOBS_Service", "OBS_service_stopStreamingDestination", {ipc::value(name), ipc::value(forceStop)});
+	return info.Env().Undefined();
+}
+
+Napi::Value service::OBS_service_getStreamingDestinations(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("NodeOBS_Service", "OBS_service_getStreamingDestinations", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	uint32_t    count        = response[1].value_union.ui32;
+	Napi::Array destinations = Napi::Array::New(info.Env(), count);
+
+	size_t index = 2;
+	for (uint32_t i = 0; i < count && index + 9 <= response.size(); i++) {
+		Napi::Object destination = Napi::Object::New(info.Env());
+		destination.Set("name", Napi::String::New(info.Env(), response[index++].value_str));
+		destination.Set("active", Napi::Boolean::New(info.Env(), response[index++].value_union.ui32));
+		destination.Set("reconnecting", Napi::Boolean::New(info.Env(), response[index++].value_union.ui32));
+		destination.Set("bytesSent", Napi::Number::New(info.Env(), response[index++].value_union.ui64));
+		destination.Set("totalFrames", Napi::Number::New(info.Env(), response[index++].value_union.i32));
+		destination.Set("droppedFrames", Napi::Number::New(info.Env(), response[index++].value_union.i32));
+		destination.Set("congestion", Napi::Number::New(info.Env(), response[index++].value_union.fp64));
+		destination.Set("kbitsPerSec", Napi::Number::New(info.Env(), response[index++].value_union.fp64));
+		destination.Set("connectTimeMs", Napi::Number::New(info.Env(), response[index++].value_union.i32));
+		destinations.Set(i, destination);
+	}
+
+	return destinations;
+}
+
 void service::worker()
 {
 	const static int maximum_signals_in_queue = 100;
@@ -240,6 +341,16 @@ void service::worker()
 			result.Set(
 				Napi::String::New(env, "error"),
 				Napi::String::New(env, data->errorMessage));
+			if (!data->destination.empty()) {
+				result.Set(
+					Napi::String::New(env, "destination"),
+					Napi::String::New(env, data->destination));
+			}
+			if (!data->path.empty()) {
+				result.Set(
+					Napi::String::New(env, "path"),
+					Napi::String::New(env, data->path));
+			}
 
 			jsCallback.Call({ result });
 		} catch (...) {
@@ -258,7 +369,7 @@ void service::worker()
 		auto conn = Controller::GetInstance().GetConnection();
 		if (conn) {
 			std::vector<ipc::value> response = conn->call_synchronous_helper("NodeOBS_Service", "Query", {});
-			if (response.size() && (response.size() == 5) && signalsList.size() < maximum_signals_in_queue) {
+			if (response.size() && (response.size() >= 5 && response.size() <= 7) && signalsList.size() < maximum_signals_in_queue) {
 				ErrorCode error = (ErrorCode)response[0].value_union.ui64;
 				if (error == ErrorCode::Ok) {
 					SignalInfo* data = new SignalInfo{ "", "", 0, ""};
@@ -266,6 +377,10 @@ void service::worker()
 					data->signal       = response[2].value_str;
 					data->code         = response[3].value_union.i32;
 					data->errorMessage = response[4].value_str;
+					if (response.size() >= 6)
+						data->destination = response[5].value_str;
+					if (response.size() == 7)
+						data->path = response[6].value_str;
 					data->sent         = false;
 					data->tosend       = true;
 					signalsList.push_back(data);
@@ -491,6 +606,21 @@ void service::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(
 		Napi::String::New(env, "OBS_service_stopVirtualWebcam"),
 		Napi::Function::New(env, service::OBS_service_stopVirtualWebcam));
+	exports.Set(
+		Napi::String::New(env, "OBS_service_addStreamingDestination"),
+		Napi::Function::New(env, service::OBS_service_addStreamingDestination));
+	exports.Set(
+		Napi::String::New(env, "OBS_service_removeStreamingDestination"),
+		Napi::Function::New(env, service::OBS_service_removeStreamingDestination));
+	exports.Set(
+		Napi::String::New(env, "OBS_service_startStreamingDestination"),
+		Napi::Function::New(env, service::OBS_service_startStreamingDestination));
+	exports.Set(
+		Napi::String::New(env, "OBS_service_stopStreamingDestination"),
+		Napi::Function::New(env, service::OBS_service_stopStreamingDestination));
+	exports.Set(
+		Napi::String::New(env, "OBS_service_getStreamingDestinations"),
+		Napi::Function::New(env, service::OBS_service_getStreamingDestinations));
 	exports.Set(
 		Napi::String::New(env, "OBS_service_installVirtualCamPlugin"),
 		Napi::Function::New(env, service::OBS_service_installVirtualCamPlugin));
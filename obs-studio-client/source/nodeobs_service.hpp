@@ -27,6 +27,8 @@ struct SignalInfo
 	std::string signal;
 	int         code;
 	std::string errorMessage;
+	std::string destination;
+	std::string path;
 	bool        sent;
 	bool        tosend;
 };
@@ -67,6 +69,11 @@ namespace service
 	Napi::Value OBS_service_removeVirtualWebcam(const Napi::CallbackInfo& info);
 	Napi::Value OBS_service_startVirtualWebcam(const Napi::CallbackInfo& info);
 	Napi::Value OBS_service_stopVirtualWebcam(const Napi::CallbackInfo& info);
+	Napi::Value OBS_service_addStreamingDestination(const Napi::CallbackInfo& info);
+	Napi::Value OBS_service_removeStreamingDestination(const Napi::CallbackInfo& info);
+	Napi::Value OBS_service_startStreamingDestination(const Napi::CallbackInfo& info);
+	Napi::Value OBS_service_stopStreamingDestination(const Napi::CallbackInfo& info);
+	Napi::Value OBS_service_getStreamingDestinations(const Napi::CallbackInfo& info);
 	Napi::Value OBS_service_installVirtualCamPlugin(const Napi::CallbackInfo& info);
 	Napi::Value OBS_service_uninstallVirtualCamPlugin(const Napi::CallbackInfo& info);
 	Napi::Value OBS_service_isVirtualCamPluginInstalled(const Napi::CallbackInfo& info);
@@ -510,6 +510,37 @@ Napi::Value settings::OBS_settings_getVideoDevices(const Napi::CallbackInfo& inf
 	return devices_to_js(info, response);
 }
 
+Napi::Value settings::OBS_settings_invalidateDevices(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Settings", "OBS_settings_invalidateDevices", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	// Generation of the device lists, it changes whenever one of them does
+	return Napi::Number::New(info.Env(), double(response[1].value_union.ui64));
+}
+
+Napi::Value settings::OBS_settings_rescanDevices(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Settings", "OBS_settings_rescanDevices", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::Number::New(info.Env(), double(response[1].value_union.ui64));
+}
+
 void settings::Init(Napi::Env env, Napi::Object exports)
 {
 	exports.Set(
@@ -536,4 +567,12 @@ void settings::Init(Napi::Env env, Napi::Object exports)
 		Napi::String::New(env, "OBS_settings_getVideoDevices"),
 		Napi::Function::New(env, settings::OBS_settings_getVideoDevices)
 		);
+	exports.Set(
+		Napi::String::New(env, "OBS_settings_invalidateDevices"),
+		Napi::Function::New(env, settings::OBS_settings_invalidateDevices)
+		);
+	exports.Set(
+		Napi::String::New(env, "OBS_settings_rescanDevices"),
+		Napi::Function::New(env, settings::OBS_settings_rescanDevices)
+		);
 }
\ No newline at end of file
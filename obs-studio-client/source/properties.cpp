@@ -47,7 +47,7 @@ osn::Properties::Properties(const Napi::CallbackInfo& info)
     : Napi::ObjectWrap<osn::Properties>(info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
-	this->properties = std::make_shared<property_map_t>(*info[0].As<const Napi::External<property_map_t>>().Data());
+	this->properties = *info[0].As<const Napi::External<std::shared_ptr<property_map_t>>>().Data();
 	this->sourceId = (uint64_t)info[1].ToNumber().Uint32Value();
 }
 
@@ -201,7 +201,7 @@ Napi::Value osn::PropertyObject::Next(const Napi::CallbackInfo& info)
 	if (iter == parent->GetProperties()->end())
 		return info.Env().Undefined();
 
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), parent->properties.get());
+	auto prop_ptr = Napi::External<std::shared_ptr<property_map_t>>::New(info.Env(), &parent->properties);
 	auto obj = osn::Properties::constructor.New( {prop_ptr, Napi::Number::New(info.Env(), (uint32_t)parent->sourceId) });
 
 	auto instance =
@@ -643,10 +643,18 @@ Napi::Value osn::PropertyObject::ButtonClicked(const Napi::CallbackInfo& info)
 }
 
 osn::property_map_t osn::ProcessProperties(const std::vector<ipc::value> data, size_t index)
+{
+	obs::PropertySchema::List props;
+	if (index >= data.size() || !obs::PropertySchema::decode(data[index].value_bin, props))
+		return osn::property_map_t();
+	return ProcessProperties(props);
+}
+
+osn::property_map_t osn::ProcessProperties(const obs::PropertySchema::List& props)
 {
 	osn::property_map_t pmap;
-	for (size_t idx = index; idx < data.size(); ++idx) {
-		auto raw_property = obs::Property::deserialize(data[idx].value_bin);
+	for (size_t idx = 0; idx < props.size(); ++idx) {
+		auto& raw_property = props[idx];
 
 		std::shared_ptr<osn::Property> pr;
 
@@ -828,7 +836,7 @@ osn::property_map_t osn::ProcessProperties(const std::vector<ipc::value> data, s
 			pr->enabled          = raw_property->enabled;
 			pr->visible          = raw_property->visible;
 
-			pmap.emplace(idx - 1, pr);
+			pmap.emplace(idx, pr);
 		}
 	}
 	return pmap;
@@ -22,6 +22,7 @@
 #include <math.h>
 #include <napi.h>
 #include <unordered_map>
+#include "obs-property-schema.hpp"
 #include "utility-v8.hpp"
 
 namespace osn
@@ -199,6 +200,7 @@ namespace osn
 	class Properties : public Napi::ObjectWrap<osn::Properties>
 	{
 		public:
+		// Shared with the source cache and the other objects of the same list
 		std::shared_ptr<property_map_t> properties;
 		uint64_t sourceId;
 
@@ -244,5 +246,7 @@ namespace osn
 		Napi::Value ButtonClicked(const Napi::CallbackInfo& info);
 	};
 
+	// Decodes the obs::PropertySchema blob at data[index]
 	property_map_t ProcessProperties(const std::vector<ipc::value> data, size_t index);
+	property_map_t ProcessProperties(const obs::PropertySchema::List& props);
 }
@@ -0,0 +1,92 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "property-schema-cache.hpp"
+
+uint64_t PropertySchemaCache::KnownHash(const std::string& typeId)
+{
+	auto found = m_latest.find(typeId);
+	return found != m_latest.end() ? found->second : 0;
+}
+
+uint64_t PropertySchemaCache::Store(
+    const std::string&         typeId,
+    const std::vector<char>&   blob,
+    obs::PropertySchema::List& props,
+    std::vector<char>&         values)
+{
+	uint64_t hash      = 0;
+	bool     hasSchema = false;
+	if (!obs::PropertySchema::peek(blob, hash, hasSchema))
+		return 0;
+
+	if (!hasSchema) {
+		if (!Load(typeId, hash, blob, props))
+			return 0;
+		values = blob;
+		return hash;
+	}
+
+	m_stats.misses++;
+	props.clear();
+	if (!obs::PropertySchema::decode(blob, props))
+		return 0;
+
+	if (m_schemas.size() >= MaxSchemas) {
+		m_schemas.clear();
+		m_latest.clear();
+	}
+	m_schemas[Key(typeId, hash)] = props;
+	m_latest[typeId]             = hash;
+	obs::PropertySchema::encodeValues(props, hash, values);
+	return hash;
+}
+
+bool PropertySchemaCache::Load(
+    const std::string&         typeId,
+    uint64_t                   hash,
+    const std::vector<char>&   values,
+    obs::PropertySchema::List& props)
+{
+	uint64_t valuesHash = 0;
+	bool     hasSchema  = false;
+	if (!obs::PropertySchema::peek(values, valuesHash, hasSchema) || valuesHash != hash)
+		return false;
+
+	auto found = m_schemas.find(Key(typeId, hash));
+	if (found == m_schemas.end())
+		return false;
+
+	props = found->second;
+	if (!obs::PropertySchema::decode(values, props))
+		return false;
+	m_stats.hits++;
+	return true;
+}
+
+void PropertySchemaCache::Clear()
+{
+	m_schemas.clear();
+	m_latest.clear();
+}
+
+PropertySchemaCache::Stats PropertySchemaCache::GetStats()
+{
+	m_stats.schemas = m_schemas.size();
+	return m_stats;
+}
@@ -0,0 +1,69 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "obs-property-schema.hpp"
+
+// Property schemas of source types, shared by every source of a type. A type
+// can have several, as dynamic properties change the schema with the settings;
+// each is keyed by the type id and the schema hash. A source only keeps the
+// values part of its GetProperties blob and is rebuilt from it on demand.
+class PropertySchemaCache
+{
+	public:
+	struct Stats
+	{
+		uint64_t hits;
+		uint64_t misses;
+		size_t   schemas;
+	};
+
+	// Hash of the last schema seen for the type, 0 if none
+	uint64_t KnownHash(const std::string& typeId);
+
+	// Takes the GetProperties blob of a source of the type. Keeps its schema if it carries
+	// one, fills props and the values to keep for the source. Returns the schema hash, 0 if
+	// the blob is invalid or its schema isn't cached.
+	uint64_t Store(
+	    const std::string&         typeId,
+	    const std::vector<char>&   blob,
+	    obs::PropertySchema::List& props,
+	    std::vector<char>&         values);
+
+	// Rebuilds the properties of a source from its values, false if the schema was evicted
+	bool Load(const std::string& typeId, uint64_t hash, const std::vector<char>& values, obs::PropertySchema::List& props);
+
+	void  Clear();
+	Stats GetStats();
+
+	// Schemas kept before the cache is emptied
+	static const size_t MaxSchemas = 256;
+
+	private:
+	typedef std::pair<std::string, uint64_t> Key;
+
+	// The cached properties double as scratch space for the values being decoded, the
+	// lists filled by Store and Load are only valid until the next call
+	std::map<Key, obs::PropertySchema::List> m_schemas;
+	std::map<std::string, uint64_t>          m_latest;
+	Stats                                    m_stats = {};
+};
@@ -20,6 +20,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <string>
+#include "callback-manager.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "input.hpp"
@@ -50,6 +51,11 @@ Napi::Object osn::Scene::Init(Napi::Env env, Napi::Object exports) {
 			InstanceMethod("getItemAtIdx", &osn::Scene::GetItemAtIndex),
 			InstanceMethod("getItems", &osn::Scene::GetItems),
 			InstanceMethod("getItemsInRange", &osn::Scene::GetItemsInRange),
+			InstanceMethod("hitTest", &osn::Scene::HitTest),
+			InstanceMethod("queryRect", &osn::Scene::QueryRect),
+			InstanceMethod("snapCandidates", &osn::Scene::SnapCandidates),
+			InstanceMethod("connect", &osn::Scene::Connect),
+			InstanceMethod("disconnect", &osn::Scene::Disconnect),
 
 			InstanceAccessor("configurable", &osn::Scene::CallIsConfigurable, nullptr),
 			InstanceAccessor("properties", &osn::Scene::CallGetProperties, nullptr),
@@ -197,6 +203,11 @@ Napi::Value osn::Scene::FromName(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Scene::Release(const Napi::CallbackInfo& info)
 {
+	{
+		std::unique_lock<std::mutex> lck(globalCallback::mtx_scene_events);
+		globalCallback::remove_scene_events(this->sourceId);
+	}
+
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
@@ -207,6 +218,11 @@ Napi::Value osn::Scene::Release(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Scene::Remove(const Napi::CallbackInfo& info)
 {
+	{
+		std::unique_lock<std::mutex> lck(globalCallback::mtx_scene_events);
+		globalCallback::remove_scene_events(this->sourceId);
+	}
+
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
@@ -602,6 +618,130 @@ Napi::Value osn::Scene::GetItemsInRange(const Napi::CallbackInfo& info)
 	return array;
 }
 
+Napi::Value osn::Scene::HitTest(const Napi::CallbackInfo& info)
+{
+	double x = info[0].ToNumber().DoubleValue();
+	double y = info[1].ToNumber().DoubleValue();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Scene", "HitTest", std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(x), ipc::value(y)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	// Nothing under the point
+	if (response.size() < 3)
+		return info.Env().Undefined();
+
+	return osn::SceneItem::constructor.New({Napi::Number::New(info.Env(), response[1].value_union.ui64)});
+}
+
+Napi::Value osn::Scene::QueryRect(const Napi::CallbackInfo& info)
+{
+	double x      = info[0].ToNumber().DoubleValue();
+	double y      = info[1].ToNumber().DoubleValue();
+	double width  = info[2].ToNumber().DoubleValue();
+	double height = info[3].ToNumber().DoubleValue();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Scene",
+	    "QueryRect",
+	    std::vector<ipc::value>{
+	        ipc::value(this->sourceId), ipc::value(x), ipc::value(y), ipc::value(width), ipc::value(height)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Array array = Napi::Array::New(info.Env(), (response.size() - 1) / 2);
+	size_t      index = 0;
+	for (size_t i = 1; i + 1 < response.size(); i += 2) {
+		auto instance = osn::SceneItem::constructor.New({Napi::Number::New(info.Env(), response[i].value_union.ui64)});
+		array.Set(uint32_t(index++), instance);
+	}
+
+	return array;
+}
+
+Napi::Value osn::Scene::SnapCandidates(const Napi::CallbackInfo& info)
+{
+	osn::SceneItem* item     = Napi::ObjectWrap<osn::SceneItem>::Unwrap(info[0].ToObject());
+	double          distance = info[1].ToNumber().DoubleValue();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Scene",
+	    "SnapCandidates",
+	    std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(item->itemId), ipc::value(distance)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	// uid, item id and the bounds of each candidate
+	Napi::Array array = Napi::Array::New(info.Env(), (response.size() - 1) / 6);
+	size_t      index = 0;
+	for (size_t i = 1; i + 5 < response.size(); i += 6) {
+		Napi::Object candidate = Napi::Object::New(info.Env());
+		candidate.Set(
+		    "item", osn::SceneItem::constructor.New({Napi::Number::New(info.Env(), response[i].value_union.ui64)}));
+		candidate.Set("left", Napi::Number::New(info.Env(), response[i + 2].value_union.fp64));
+		candidate.Set("top", Napi::Number::New(info.Env(), response[i + 3].value_union.fp64));
+		candidate.Set("right", Napi::Number::New(info.Env(), response[i + 4].value_union.fp64));
+		candidate.Set("bottom", Napi::Number::New(info.Env(), response[i + 5].value_union.fp64));
+		array.Set(uint32_t(index++), candidate);
+	}
+
+	return array;
+}
+
+Napi::Value osn::Scene::Connect(const Napi::CallbackInfo& info)
+{
+	std::unique_lock<std::mutex> lck(globalCallback::mtx_scene_events);
+	Napi::Function async_callback = info[0].As<Napi::Function>();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Scene", "Connect", {ipc::value(this->sourceId)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	globalCallback::add_scene_events(info.Env(), this->sourceId, async_callback);
+
+	return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value osn::Scene::Disconnect(const Napi::CallbackInfo& info)
+{
+	std::unique_lock<std::mutex> lck(globalCallback::mtx_scene_events);
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Scene", "Disconnect", {ipc::value(this->sourceId)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	globalCallback::remove_scene_events(this->sourceId);
+
+	return Napi::Boolean::New(info.Env(), true);
+}
+
 Napi::Value osn::Scene::CallIsConfigurable(const Napi::CallbackInfo& info)
 {
 	return osn::ISource::IsConfigurable(info, this->sourceId);
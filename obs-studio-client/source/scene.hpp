@@ -50,6 +50,11 @@ namespace osn
 		Napi::Value GetItemAtIndex(const Napi::CallbackInfo& info);
 		Napi::Value GetItems(const Napi::CallbackInfo& info);
 		Napi::Value GetItemsInRange(const Napi::CallbackInfo& info);
+		Napi::Value HitTest(const Napi::CallbackInfo& info);
+		Napi::Value QueryRect(const Napi::CallbackInfo& info);
+		Napi::Value SnapCandidates(const Napi::CallbackInfo& info);
+		Napi::Value Connect(const Napi::CallbackInfo& info);
+		Napi::Value Disconnect(const Napi::CallbackInfo& info);
 
 		Napi::Value CallIsConfigurable(const Napi::CallbackInfo& info);
 		Napi::Value CallGetProperties(const Napi::CallbackInfo& info);
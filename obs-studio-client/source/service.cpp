@@ -199,13 +199,12 @@ Napi::Value osn::Service::GetProperties(const Napi::CallbackInfo& info) {
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	if (response.size() == 1)
-		return info.Env().Null();
-
 	osn::property_map_t pmap = osn::ProcessProperties(response, 1);
+	if (pmap.empty())
+		return info.Env().Null();
 
-	std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(pmap);
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
+	std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(std::move(pmap));
+	auto prop_ptr = Napi::External<std::shared_ptr<property_map_t>>::New(info.Env(), &pSomeObject);
 	auto instance =
 		osn::Properties::constructor.New({
 			prop_ptr,
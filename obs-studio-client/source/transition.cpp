@@ -20,6 +20,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <string>
+#include "callback-manager.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "ipc-value.hpp"
@@ -41,6 +42,10 @@ Napi::Object osn::Transition::Init(Napi::Env env, Napi::Object exports) {
 
 			InstanceMethod("getActiveSource", &osn::Transition::GetActiveSource),
 			InstanceMethod("start", &osn::Transition::Start),
+			InstanceMethod("prepare", &osn::Transition::Prepare),
+			InstanceAccessor("prepareState", &osn::Transition::GetPrepareState, nullptr),
+			InstanceMethod("watchPrepareState", &osn::Transition::WatchPrepareState),
+			InstanceMethod("unwatchPrepareState", &osn::Transition::UnwatchPrepareState),
 			InstanceMethod("set", &osn::Transition::Set),
 			InstanceMethod("clear", &osn::Transition::Clear),
 
@@ -301,6 +306,54 @@ Napi::Value osn::Transition::Start(const Napi::CallbackInfo& info)
 	return Napi::Boolean::New(info.Env(), !!response[1].value_union.i32);
 }
 
+Napi::Value osn::Transition::Prepare(const Napi::CallbackInfo& info)
+{
+	osn::Scene* scene   = Napi::ObjectWrap<osn::Scene>::Unwrap(info[0].ToObject());
+	uint32_t    timeout = info.Length() > 1 && info[1].IsNumber() ? info[1].ToNumber().Uint32Value() : 3000;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	auto params = std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(scene->sourceId), ipc::value(timeout)};
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "Prepare", {std::move(params)});
+
+	ValidateResponse(info, response);
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Transition::GetPrepareState(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Transition", "GetPrepareState", {ipc::value(this->sourceId)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+	return Napi::Number::New(info.Env(), response[1].value_union.ui32);
+}
+
+Napi::Value osn::Transition::WatchPrepareState(const Napi::CallbackInfo& info)
+{
+	// The server reports every change with the global callbacks, nothing to ask it for
+	std::unique_lock<std::mutex> lck(globalCallback::mtx_prepare_states);
+	globalCallback::add_prepare_state(info.Env(), this->sourceId, info[0].As<Napi::Function>());
+
+	return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value osn::Transition::UnwatchPrepareState(const Napi::CallbackInfo& info)
+{
+	std::unique_lock<std::mutex> lck(globalCallback::mtx_prepare_states);
+	globalCallback::remove_prepare_state(this->sourceId);
+
+	return Napi::Boolean::New(info.Env(), true);
+}
+
 Napi::Value osn::Transition::CallIsConfigurable(const Napi::CallbackInfo& info)
 {
 	return osn::ISource::IsConfigurable(info, this->sourceId);
@@ -385,6 +438,10 @@ void osn::Transition::CallSetEnabled(const Napi::CallbackInfo& info, const Napi:
 
 Napi::Value osn::Transition::CallRelease(const Napi::CallbackInfo& info)
 {
+	{
+		std::unique_lock<std::mutex> lck(globalCallback::mtx_prepare_states);
+		globalCallback::remove_prepare_state(this->sourceId);
+	}
 	osn::ISource::Release(info, this->sourceId);
 
 	return info.Env().Undefined();
@@ -397,6 +454,10 @@ Napi::Value osn::Transition::CallCallHandler(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Transition::CallRemove(const Napi::CallbackInfo& info)
 {
+	{
+		std::unique_lock<std::mutex> lck(globalCallback::mtx_prepare_states);
+		globalCallback::remove_prepare_state(this->sourceId);
+	}
 	osn::ISource::Remove(info, this->sourceId);
 	this->sourceId = UINT64_MAX;
 
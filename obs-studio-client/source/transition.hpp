@@ -44,6 +44,10 @@ namespace osn
 		Napi::Value Clear(const Napi::CallbackInfo& info);
 		Napi::Value Set(const Napi::CallbackInfo& info);
 		Napi::Value Start(const Napi::CallbackInfo& info);
+		Napi::Value Prepare(const Napi::CallbackInfo& info);
+		Napi::Value GetPrepareState(const Napi::CallbackInfo& info);
+		Napi::Value WatchPrepareState(const Napi::CallbackInfo& info);
+		Napi::Value UnwatchPrepareState(const Napi::CallbackInfo& info);
 
 		Napi::Value CallIsConfigurable(const Napi::CallbackInfo& info);
 		Napi::Value CallGetProperties(const Napi::CallbackInfo& info);
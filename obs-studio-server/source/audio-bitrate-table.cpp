@@ -0,0 +1,106 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "audio-bitrate-table.h"
+
+AudioBitrateTable::AudioBitrateTable(Enumerator enumerator) : m_enumerator(enumerator) {}
+
+void AudioBitrateTable::SetEncoders(const std::vector<std::string>& encoders, const std::string& fingerprint)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	if (fingerprint != m_fingerprint) {
+		m_entries.clear();
+		m_failed.clear();
+	}
+
+	m_encoders    = encoders;
+	m_fingerprint = fingerprint;
+	m_maps.clear();
+}
+
+std::string AudioBitrateTable::GetFingerprint()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	return m_fingerprint;
+}
+
+const AudioBitrateTable::Bitrates&
+    AudioBitrateTable::FindLocked(const std::string& encoderId, const std::string& layout, uint32_t sampleRate)
+{
+	Key  key(encoderId, layout, sampleRate);
+	auto found = m_entries.find(key);
+	if (found != m_entries.end())
+		return found->second;
+
+	// Encoders that fail are kept with no bitrates, so they aren't asked again this session
+	Bitrates bitrates;
+	if (!m_enumerator(encoderId, layout, sampleRate, bitrates)) {
+		bitrates.clear();
+		m_failed.insert(key);
+	}
+
+	m_revision++;
+	return m_entries.emplace(key, std::move(bitrates)).first->second;
+}
+
+void AudioBitrateTable::Find(const std::string& encoderId, const std::string& layout, uint32_t sampleRate, Bitrates& bitrates)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	bitrates = FindLocked(encoderId, layout, sampleRate);
+}
+
+const AudioBitrateTable::BitrateMap& AudioBitrateTable::GetBitrateMap(const std::string& layout, uint32_t sampleRate)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	MapKey                       key(layout, sampleRate);
+	auto                         found = m_maps.find(key);
+	if (found != m_maps.end())
+		return found->second;
+
+	BitrateMap map;
+	for (auto& encoder : m_encoders) {
+		for (int bitrate : FindLocked(encoder, layout, sampleRate))
+			map[bitrate] = encoder.c_str();
+	}
+
+	return m_maps.emplace(key, std::move(map)).first->second;
+}
+
+void AudioBitrateTable::Insert(const Entry& entry)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_entries[Key(entry.encoderId, entry.layout, entry.sampleRate)] = entry.bitrates;
+}
+
+std::vector<AudioBitrateTable::Entry> AudioBitrateTable::GetEntries()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	std::vector<Entry>           entries;
+	for (auto& entry : m_entries) {
+		if (m_failed.count(entry.first))
+			continue;
+		entries.push_back({std::get<0>(entry.first), std::get<1>(entry.first), std::get<2>(entry.first), entry.second});
+	}
+	return entries;
+}
+
+uint64_t AudioBitrateTable::GetRevision()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	return m_revision;
+}
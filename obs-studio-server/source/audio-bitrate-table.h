@@ -0,0 +1,87 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Bitrates each audio encoder accepts for a channel layout and sample rate.
+// Getting them means asking the encoder for its properties, so every entry
+// is enumerated once and kept, along with the merged bitrate to encoder
+// maps built from them. Entries belong to a fingerprint of the loaded
+// plugins, they can be saved and loaded again as long as it stays the same.
+class AudioBitrateTable
+{
+	public:
+	typedef std::vector<int>           Bitrates;
+	typedef std::map<int, const char*>   BitrateMap;
+
+	// Lists the bitrates of an encoder in ascending order, returns false if its properties can't be read
+	typedef std::function<bool(const std::string& encoderId, const std::string& layout, uint32_t sampleRate, Bitrates& bitrates)>
+	    Enumerator;
+
+	struct Entry
+	{
+		std::string encoderId;
+		std::string layout;
+		uint32_t    sampleRate;
+		Bitrates    bitrates;
+	};
+
+	AudioBitrateTable(Enumerator enumerator);
+
+	// Encoders in the order bitrate maps are built, the last one listing a bitrate gets it. Drops
+	// every entry if the fingerprint changed; maps returned before are no longer valid then.
+	void SetEncoders(const std::vector<std::string>& encoders, const std::string& fingerprint);
+	std::string GetFingerprint();
+
+	// Bitrates of one encoder, enumerated on the first request
+	void Find(const std::string& encoderId, const std::string& layout, uint32_t sampleRate, Bitrates& bitrates);
+
+	// Bitrate to encoder id map of every encoder, built on the first request
+	const BitrateMap& GetBitrateMap(const std::string& layout, uint32_t sampleRate);
+
+	// Adds an entry saved earlier for the current fingerprint, before any map is requested
+	void Insert(const Entry& entry);
+	// Entries worth saving, encoders that failed are left out so the next session asks them again
+	std::vector<Entry> GetEntries();
+
+	// Grows each time an entry is enumerated, to know when the entries should be saved again
+	uint64_t GetRevision();
+
+	private:
+	typedef std::tuple<std::string, std::string, uint32_t> Key;
+	typedef std::pair<std::string, uint32_t>               MapKey;
+
+	const Bitrates& FindLocked(const std::string& encoderId, const std::string& layout, uint32_t sampleRate);
+
+	Enumerator                   m_enumerator;
+	std::mutex                   m_mutex;
+	std::vector<std::string>     m_encoders;
+	std::string                  m_fingerprint;
+	std::map<Key, Bitrates>      m_entries;
+	std::set<Key>                m_failed;
+	std::map<MapKey, BitrateMap> m_maps;
+	uint64_t                     m_revision = 0;
+};
@@ -24,6 +24,8 @@
 #include "error.hpp"
 #include "shared.hpp"
 #include "osn-source.hpp"
+#include "osn-scene.hpp"
+#include "osn-transition.hpp"
 #include "osn-volmeter.hpp"
 
 std::mutex                             sources_sizes_mtx;
@@ -93,6 +95,15 @@ void CallbackManager::GlobalQuery(
 		index += sizeof(uint64_t);
 	}
 
+	// Watched media sources that changed, after the volmeters
+	osn::Source::PollMediaStates(rval);
+
+	// Batched item changes of the connected scenes
+	osn::Scene::PollEvents(rval);
+
+	// Transitions whose prepared target became ready, timed out or expired
+	osn::Transition::PollPrepareStates(rval);
+
 	AUTO_DEBUG;
 }
 
@@ -0,0 +1,105 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "device-registry.h"
+
+DeviceRegistry::DeviceRegistry(Enumerator enumerator, std::chrono::milliseconds maxAge)
+    : m_enumerator(enumerator), m_maxAge(maxAge)
+{}
+
+uint64_t DeviceRegistry::Get(const std::string& sourceId, const std::string& property, DeviceList& devices)
+{
+	Key key(sourceId, property);
+	{
+		std::unique_lock<std::mutex> ulock(m_mutex);
+		auto                         found = m_devices.find(key);
+		if (found == m_devices.end()) {
+			m_stats.misses++;
+		} else if (std::chrono::steady_clock::now() - found->second.enumerated < m_maxAge) {
+			m_stats.hits++;
+			devices = found->second.devices;
+			return m_stats.generation;
+		} else {
+			m_stats.refreshes++;
+		}
+	}
+
+	// Enumerating instantiates a source, which must not block the other types
+	DeviceList enumerated;
+	if (!m_enumerator(sourceId, property, enumerated)) {
+		devices.clear();
+		std::unique_lock<std::mutex> ulock(m_mutex);
+		if (m_devices.erase(key))
+			m_stats.generation++;
+		return m_stats.generation;
+	}
+
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	Entry&                       entry = m_devices[key];
+	if (entry.enumerated == std::chrono::steady_clock::time_point() || entry.devices != enumerated) {
+		entry.devices = std::move(enumerated);
+		m_stats.generation++;
+	}
+	entry.enumerated = std::chrono::steady_clock::now();
+	devices          = entry.devices;
+	return m_stats.generation;
+}
+
+uint64_t DeviceRegistry::Invalidate()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_devices.clear();
+	return ++m_stats.generation;
+}
+
+uint64_t DeviceRegistry::Rescan()
+{
+	std::vector<Key> keys;
+	{
+		std::unique_lock<std::mutex> ulock(m_mutex);
+		for (auto& entry : m_devices)
+			keys.push_back(entry.first);
+		m_stats.rescans++;
+	}
+
+	for (auto& key : keys) {
+		DeviceList enumerated;
+		if (!m_enumerator(key.first, key.second, enumerated))
+			continue;
+
+		// Types invalidated meanwhile stay out until they are asked for again
+		std::unique_lock<std::mutex> ulock(m_mutex);
+		auto                         found = m_devices.find(key);
+		if (found == m_devices.end())
+			continue;
+		found->second.enumerated = std::chrono::steady_clock::now();
+		if (found->second.devices == enumerated)
+			continue;
+		found->second.devices = std::move(enumerated);
+		m_stats.generation++;
+	}
+
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	return m_stats.generation;
+}
+
+DeviceRegistry::Stats DeviceRegistry::GetStats()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	return m_stats;
+}
@@ -0,0 +1,84 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Caches the devices listed by the device property of a source type. Listing
+// them means instantiating a source of that type, so each type is enumerated
+// once and served from the cache until Invalidate is called, a Rescan finds a
+// different list or the list gets older than the maximum age. An outdated list
+// is enumerated again by the next Get, so plugged devices show up without the
+// client asking. Every change bumps the generation, which the client compares
+// to tell whether its lists are still current.
+class DeviceRegistry
+{
+	public:
+	// Description and id of each device, in the order of the property
+	typedef std::vector<std::pair<std::string, std::string>> DeviceList;
+
+	// Lists the devices of a source type, returns false if the type or property doesn't exist
+	typedef std::function<bool(const std::string& sourceId, const std::string& property, DeviceList& devices)>
+	    Enumerator;
+
+	struct Stats
+	{
+		uint64_t generation;
+		uint64_t hits;
+		uint64_t misses;
+		uint64_t rescans;
+		uint64_t refreshes;
+	};
+
+	DeviceRegistry(Enumerator enumerator, std::chrono::milliseconds maxAge = std::chrono::seconds(10));
+
+	// Fills devices, enumerating the type on a miss or when its list is outdated.
+	// Returns the generation the list belongs to.
+	uint64_t Get(const std::string& sourceId, const std::string& property, DeviceList& devices);
+
+	// Forgets every list, the next Get of each type enumerates again. Returns the new generation.
+	uint64_t Invalidate();
+
+	// Enumerates every cached type again and keeps the lists that changed. Instantiates
+	// sources, so it runs on the thread that creates the others. Returns the generation.
+	uint64_t Rescan();
+
+	Stats GetStats();
+
+	private:
+	typedef std::pair<std::string, std::string> Key;
+
+	struct Entry
+	{
+		DeviceList                            devices;
+		std::chrono::steady_clock::time_point enumerated;
+	};
+
+	Enumerator                m_enumerator;
+	std::chrono::milliseconds m_maxAge;
+	std::mutex                m_mutex;
+	std::map<Key, Entry>      m_devices;
+	Stats                     m_stats = {};
+};
@@ -0,0 +1,688 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "disk-replay-buffer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <obs.h>
+#include <util/pipe.h>
+#include <util/platform.h>
+#include "ffmpeg-mux.h"
+#include "nodeobs_api.h"
+#include "replay-ring-index.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Memory mapped file used as a byte ring. Positions are logical and grow forever,
+// the physical offset is the position modulo the file size.
+class RingFile
+{
+	public:
+	~RingFile()
+	{
+		Close();
+	}
+
+	bool Open(const std::string& path, uint64_t size);
+	void Close(void);
+
+	bool IsOpen(void) const
+	{
+		return view != nullptr;
+	}
+	uint64_t Size(void) const
+	{
+		return size;
+	}
+
+	void Write(uint64_t pos, const uint8_t* data, size_t len);
+	void Read(uint64_t pos, uint8_t* data, size_t len);
+
+	// Drops the pages of [pos, pos + len) from the working set, the data stays in the file
+	void Release(uint64_t pos, uint64_t len);
+
+	private:
+	void ReleaseRange(uint64_t offset, uint64_t len);
+
+	uint8_t* view     = nullptr;
+	uint64_t size     = 0;
+	uint64_t pageSize = 4096;
+#ifdef WIN32
+	HANDLE file    = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#else
+	int fd = -1;
+#endif
+};
+
+bool RingFile::Open(const std::string& path, uint64_t ringSize)
+{
+	Close();
+	size = ringSize;
+
+#ifdef WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	pageSize = info.dwAllocationGranularity;
+
+	wchar_t* wpath = nullptr;
+	os_utf8_to_wcs_ptr(path.c_str(), 0, &wpath);
+	file = CreateFileW(
+	    wpath,
+	    GENERIC_READ | GENERIC_WRITE,
+	    0,
+	    nullptr,
+	    CREATE_ALWAYS,
+	    FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+	    nullptr);
+	bfree(wpath);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	// Reserve the whole ring up front so writes never have to grow the file
+	LARGE_INTEGER end;
+	end.QuadPart = LONGLONG(size);
+	if (!SetFilePointerEx(file, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+		Close();
+		return false;
+	}
+
+	mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, DWORD(size >> 32), DWORD(size & 0xFFFFFFFF), nullptr);
+	if (mapping)
+		view = reinterpret_cast<uint8_t*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+#else
+	pageSize = uint64_t(sysconf(_SC_PAGESIZE));
+
+	fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+	if (fd < 0)
+		return false;
+
+	// The file only lives as long as the mapping
+	unlink(path.c_str());
+
+#ifdef __linux__
+	bool allocated = posix_fallocate(fd, 0, off_t(size)) == 0;
+#else
+	bool allocated = ftruncate(fd, off_t(size)) == 0;
+#endif
+	if (allocated) {
+		void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (ptr != MAP_FAILED)
+			view = reinterpret_cast<uint8_t*>(ptr);
+	}
+#endif
+
+	if (!view) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void RingFile::Close(void)
+{
+#ifdef WIN32
+	if (view)
+		UnmapViewOfFile(view);
+	if (mapping)
+		CloseHandle(mapping);
+	if (file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+	mapping = nullptr;
+	file    = INVALID_HANDLE_VALUE;
+#else
+	if (view)
+		munmap(view, size);
+	if (fd >= 0)
+		close(fd);
+	fd = -1;
+#endif
+	view = nullptr;
+}
+
+void RingFile::Write(uint64_t pos, const uint8_t* data, size_t len)
+{
+	uint64_t offset = pos % size;
+	size_t   first  = size_t(std::min<uint64_t>(len, size - offset));
+	memcpy(view + offset, data, first);
+	if (len > first)
+		memcpy(view, data + first, len - first);
+}
+
+void RingFile::Read(uint64_t pos, uint8_t* data, size_t len)
+{
+	uint64_t offset = pos % size;
+	size_t   first  = size_t(std::min<uint64_t>(len, size - offset));
+	memcpy(data, view + offset, first);
+	if (len > first)
+		memcpy(data + first, view, len - first);
+}
+
+void RingFile::Release(uint64_t pos, uint64_t len)
+{
+	if (!view || !len)
+		return;
+
+	len             = std::min(len, size);
+	uint64_t offset = pos % size;
+	uint64_t first  = std::min(len, size - offset);
+	ReleaseRange(offset, first);
+	if (len > first)
+		ReleaseRange(0, len - first);
+}
+
+void RingFile::ReleaseRange(uint64_t offset, uint64_t len)
+{
+	uint64_t begin = offset / pageSize * pageSize;
+	uint64_t end   = std::min(size, (offset + len + pageSize - 1) / pageSize * pageSize);
+	if (end <= begin)
+		return;
+
+#ifdef WIN32
+	// Unlocking pages that were never locked removes them from the working set
+	VirtualUnlock(view + begin, SIZE_T(end - begin));
+#else
+	// Dirty pages of a shared file mapping are kept in the page cache and written back
+	msync(view + begin, end - begin, MS_ASYNC);
+	madvise(view + begin, end - begin, MADV_DONTNEED);
+#endif
+}
+
+struct ReplayOutput
+{
+	obs_output_t* output = nullptr;
+	obs_hotkey_id hotkey = OBS_INVALID_HOTKEY_ID;
+
+	// Guards the settings, the ring and the packet index
+	std::mutex mtx;
+
+	std::string directory;
+	std::string format;
+	std::string extension;
+	bool        allowSpaces     = true;
+	int64_t     maxTimeUsec     = 0;
+	uint64_t    maxSizeBytes    = 0;
+	uint64_t    memoryHeadBytes = 0;
+
+	RingFile        ring;
+	ReplayRingIndex index;
+	std::string     lastFile;
+
+	// Guards saveThread, which is started from hotkey/proc callbacks and joined on stop
+	std::mutex        saveMtx;
+	std::thread       saveThread;
+	std::atomic<bool> saving{false};
+};
+
+static void SignalOutput(obs_output_t* output, const char* signal)
+{
+	calldata_t cd = {0};
+	calldata_set_ptr(&cd, "output", output);
+	signal_handler_signal(obs_output_get_signal_handler(output), signal, &cd);
+	calldata_free(&cd);
+}
+
+// Encoders without a bitrate (CQP, CRF, lossless) are sized at this many bits per pixel
+static const double EstimatedBitsPerPixel = 0.25;
+
+static uint64_t EncoderKbps(obs_encoder_t* encoder)
+{
+	obs_data_t* settings = obs_encoder_get_settings(encoder);
+	long long   kbps     = obs_data_get_int(settings, "bitrate");
+	if (kbps <= 0)
+		kbps = obs_data_get_int(settings, "max_bitrate");
+	obs_data_release(settings);
+	return uint64_t(std::max<long long>(0, kbps));
+}
+
+// Bitrate the replay window is written at, estimated from the output size when the
+// video encoder has no bitrate of its own
+static uint64_t ReplayKbps(ReplayOutput* replay)
+{
+	uint64_t       kbps  = 0;
+	obs_encoder_t* video = obs_output_get_video_encoder(replay->output);
+	if (video) {
+		uint64_t videoKbps = EncoderKbps(video);
+		if (!videoKbps) {
+			const video_output_info* info = video_output_get_info(obs_output_video(replay->output));
+			double fps    = info && info->fps_den ? double(info->fps_num) / double(info->fps_den) : 60.0;
+			double pixels = double(obs_output_get_width(replay->output)) * obs_output_get_height(replay->output);
+			videoKbps     = uint64_t(pixels * fps * EstimatedBitsPerPixel / 1000.0);
+		}
+		kbps += videoKbps;
+	}
+	for (size_t idx = 0; idx < MAX_AUDIO_MIXES; idx++) {
+		obs_encoder_t* audio = obs_output_get_audio_encoder(replay->output, idx);
+		if (audio)
+			kbps += EncoderKbps(audio);
+	}
+	return kbps;
+}
+
+// The ring is deleted on close and never part of the recordings, it goes to the temp directory
+static std::string RingDirectory(ReplayOutput* replay)
+{
+#ifdef WIN32
+	wchar_t wpath[MAX_PATH + 1];
+	DWORD   len = GetTempPathW(MAX_PATH + 1, wpath);
+	if (len && len <= MAX_PATH) {
+		char* path = nullptr;
+		os_wcs_to_utf8_ptr(wpath, len, &path);
+		std::string directory = path ? path : "";
+		bfree(path);
+		if (!directory.empty())
+			return directory;
+	}
+#else
+	const char* directory = getenv("TMPDIR");
+	if (directory && *directory)
+		return directory;
+	if (os_file_exists("/tmp"))
+		return "/tmp";
+#endif
+	return replay->directory;
+}
+
+// Fails when the output lost its video, the frame rate of the track is unknown then
+static bool MuxCommandLine(
+    obs_output_t*                      output,
+    obs_encoder_t*                     video,
+    const std::vector<obs_encoder_t*>& audio,
+    const std::string&                 path,
+    std::string&                       commandLine)
+{
+#ifdef WIN32
+	std::string executable = g_moduleDirectory + "/obs-ffmpeg-mux.exe";
+#else
+	std::string executable = g_moduleDirectory + "/obs-ffmpeg-mux";
+#endif
+
+	FFmpegMux::VideoTrack videoTrack = {};
+	if (video) {
+		const video_output_info* info = video_output_get_info(obs_output_video(output));
+		if (!info)
+			return false;
+
+		videoTrack.codec              = obs_encoder_get_codec(video);
+		videoTrack.bitrate            = int64_t(EncoderKbps(video));
+		videoTrack.width              = obs_output_get_width(output);
+		videoTrack.height             = obs_output_get_height(output);
+		videoTrack.fpsNum             = info->fps_num;
+		videoTrack.fpsDen             = info->fps_den;
+	}
+
+	std::vector<FFmpegMux::AudioTrack> audioTracks;
+	for (obs_encoder_t* encoder : audio) {
+		audioTracks.push_back({obs_encoder_get_name(encoder),
+		                       int64_t(EncoderKbps(encoder)),
+		                       obs_encoder_get_sample_rate(encoder),
+		                       uint32_t(audio_output_get_channels(obs_output_audio(output)))});
+	}
+
+	obs_data_t* settings      = obs_output_get_settings(output);
+	std::string muxerSettings = obs_data_get_string(settings, "muxer_settings");
+	obs_data_release(settings);
+
+	commandLine = FFmpegMux::CommandLine(
+	    executable,
+	    path,
+	    video ? &videoTrack : nullptr,
+	    audio.empty() ? "" : obs_encoder_get_codec(audio.front()),
+	    audioTracks,
+	    muxerSettings);
+	return true;
+}
+
+static bool WriteMuxPacket(os_process_pipe_t* pipe, const FFmpegMux::PacketInfo& info, const uint8_t* data)
+{
+	if (os_process_pipe_write(pipe, reinterpret_cast<const uint8_t*>(&info), sizeof(info)) != sizeof(info))
+		return false;
+	return !info.size || os_process_pipe_write(pipe, data, info.size) == info.size;
+}
+
+static bool WriteReplay(ReplayOutput* replay, const std::vector<ReplayRingIndex::Packet>& packets, const std::string& path)
+{
+	obs_encoder_t*              video = obs_output_get_video_encoder(replay->output);
+	std::vector<obs_encoder_t*> audio;
+	for (size_t idx = 0; idx < MAX_AUDIO_MIXES; idx++) {
+		obs_encoder_t* encoder = obs_output_get_audio_encoder(replay->output, idx);
+		if (!encoder)
+			break;
+		audio.push_back(encoder);
+	}
+
+	std::string commandLine;
+	if (!MuxCommandLine(replay->output, video, audio, path, commandLine)) {
+		blog(LOG_ERROR, "Disk replay buffer: no video information to mux %s", path.c_str());
+		return false;
+	}
+
+	os_process_pipe_t* pipe = os_process_pipe_create(commandLine.c_str(), "w");
+	if (!pipe) {
+		blog(LOG_ERROR, "Disk replay buffer: failed to start the muxer for %s", path.c_str());
+		return false;
+	}
+
+	// Codec headers first, video then one per audio track
+	bool     ok    = true;
+	uint8_t* extra = nullptr;
+	size_t   size  = 0;
+	if (video) {
+		obs_encoder_get_extra_data(video, &extra, &size);
+		ok = WriteMuxPacket(pipe, FFmpegMux::PacketInfo{0, 0, uint32_t(size), 0, FFmpegMux::Video, true}, extra);
+	}
+	for (uint32_t idx = 0; ok && idx < audio.size(); idx++) {
+		extra = nullptr;
+		size  = 0;
+		obs_encoder_get_extra_data(audio[idx], &extra, &size);
+		ok = WriteMuxPacket(pipe, FFmpegMux::PacketInfo{0, 0, uint32_t(size), idx, FFmpegMux::Audio, false}, extra);
+	}
+
+	// Timestamps are rebased on the first keyframe so the file starts at zero
+	int64_t              startUsec = packets.front().dtsUsec;
+	std::vector<uint8_t> buffer;
+	uint64_t             readFrom = packets.front().position;
+	for (const ReplayRingIndex::Packet& record : packets) {
+		if (!ok)
+			break;
+		if (record.dtsUsec < startUsec)
+			continue;
+
+		buffer.resize(record.size);
+		{
+			std::unique_lock<std::mutex> ulock(replay->mtx);
+			if (replay->index.Overwritten(record)) {
+				blog(LOG_ERROR, "Disk replay buffer: packets were overwritten while saving, the ring is too small");
+				ok = false;
+				break;
+			}
+			replay->ring.Read(record.position, buffer.data(), record.size);
+
+			ReplayRingIndex::Range release;
+			if (replay->index.ReleaseRead(readFrom, record.position + record.size, release))
+				replay->ring.Release(release.position, release.size);
+		}
+
+		int64_t offset = startUsec * record.timebaseDen / (int64_t(record.timebaseNum) * 1000000);
+		FFmpegMux::PacketInfo info = {};
+		info.pts                   = record.pts - offset;
+		info.dts                   = record.dts - offset;
+		info.size                  = record.size;
+		info.index                 = record.track;
+		info.type                  = record.video ? FFmpegMux::Video : FFmpegMux::Audio;
+		info.keyframe              = record.keyframe;
+		ok                         = WriteMuxPacket(pipe, info, buffer.data());
+	}
+
+	int code = os_process_pipe_destroy(pipe);
+	if (ok && code != 0)
+		blog(LOG_ERROR, "Disk replay buffer: muxer exited with code %d for %s", code, path.c_str());
+	return ok && code == 0;
+}
+
+static void SaveReplay(ReplayOutput* replay)
+{
+	if (!obs_output_active(replay->output))
+		return;
+
+	if (replay->saving.exchange(true)) {
+		blog(LOG_WARNING, "Disk replay buffer: a replay is already being saved");
+		return;
+	}
+
+	std::unique_lock<std::mutex> slock(replay->saveMtx);
+
+	// The previous save thread already finished, it cleared 'saving' as its last step
+	if (replay->saveThread.joinable())
+		replay->saveThread.join();
+
+	std::vector<ReplayRingIndex::Packet> packets;
+	std::string                          path;
+	{
+		std::unique_lock<std::mutex> ulock(replay->mtx);
+		packets = replay->index.Window();
+
+		char* filename = os_generate_formatted_filename(replay->extension.c_str(), replay->allowSpaces, replay->format.c_str());
+		path           = replay->directory + "/" + filename;
+		bfree(filename);
+	}
+
+	if (packets.empty()) {
+		blog(LOG_WARNING, "Disk replay buffer: no keyframe buffered yet, nothing to save");
+		SignalOutput(replay->output, "writing_error");
+		replay->saving = false;
+		return;
+	}
+
+	SignalOutput(replay->output, "writing");
+	replay->saveThread = std::thread([replay, packets = std::move(packets), path]() {
+		uint64_t start   = os_gettime_ns();
+		bool     success = WriteReplay(replay, packets, path);
+		if (success) {
+			std::unique_lock<std::mutex> ulock(replay->mtx);
+			replay->lastFile = path;
+		}
+		blog(
+		    LOG_INFO,
+		    "Disk replay buffer: %s %s in %llu ms",
+		    success ? "saved" : "failed to save",
+		    path.c_str(),
+		    (unsigned long long)((os_gettime_ns() - start) / 1000000));
+
+		SignalOutput(replay->output, success ? "wrote" : "writing_error");
+		replay->saving = false;
+	});
+}
+
+static const char* ReplayGetName(void*)
+{
+	return "Disk Replay Buffer";
+}
+
+static void ReplayUpdate(void* data, obs_data_t* settings)
+{
+	ReplayOutput*                replay = reinterpret_cast<ReplayOutput*>(data);
+	std::unique_lock<std::mutex> ulock(replay->mtx);
+
+	replay->directory       = obs_data_get_string(settings, "directory");
+	replay->format          = obs_data_get_string(settings, "format");
+	replay->extension       = obs_data_get_string(settings, "extension");
+	replay->allowSpaces     = obs_data_get_bool(settings, "allow_spaces");
+	replay->maxTimeUsec     = obs_data_get_int(settings, "max_time_sec") * 1000000LL;
+	replay->maxSizeBytes    = uint64_t(obs_data_get_int(settings, "max_size_mb")) * 1024 * 1024;
+	replay->memoryHeadBytes = uint64_t(obs_data_get_int(settings, "memory_head_mb")) * 1024 * 1024;
+}
+
+static void ReplayDefaults(obs_data_t* settings)
+{
+	obs_data_set_default_string(settings, "extension", "mp4");
+	obs_data_set_default_bool(settings, "allow_spaces", true);
+	obs_data_set_default_int(settings, "max_time_sec", 15);
+	obs_data_set_default_int(settings, "memory_head_mb", DiskReplayBuffer::DefaultMemoryHeadMB);
+}
+
+static void ReplayHotkey(void* data, obs_hotkey_id, obs_hotkey_t*, bool pressed)
+{
+	if (pressed)
+		SaveReplay(reinterpret_cast<ReplayOutput*>(data));
+}
+
+static void ReplaySaveProc(void* data, calldata_t*)
+{
+	SaveReplay(reinterpret_cast<ReplayOutput*>(data));
+}
+
+static void ReplayLastFileProc(void* data, calldata_t* cd)
+{
+	ReplayOutput*                replay = reinterpret_cast<ReplayOutput*>(data);
+	std::unique_lock<std::mutex> ulock(replay->mtx);
+	calldata_set_string(cd, "path", replay->lastFile.c_str());
+}
+
+static void* ReplayCreate(obs_data_t* settings, obs_output_t* output)
+{
+	ReplayOutput* replay = new ReplayOutput();
+	replay->output       = output;
+	ReplayUpdate(replay, settings);
+
+	replay->hotkey = obs_hotkey_register_output(output, "ReplayBuffer.Save", "Save replay", ReplayHotkey, replay);
+
+	proc_handler_t* ph = obs_output_get_proc_handler(output);
+	proc_handler_add(ph, "void save()", ReplaySaveProc, replay);
+	proc_handler_add(ph, "void get_last_file(out string path)", ReplayLastFileProc, replay);
+
+	signal_handler_t* sh = obs_output_get_signal_handler(output);
+	signal_handler_add(sh, "void writing(ptr output)");
+	signal_handler_add(sh, "void wrote(ptr output)");
+	signal_handler_add(sh, "void writing_error(ptr output)");
+	return replay;
+}
+
+static void ReplayDestroy(void* data)
+{
+	ReplayOutput* replay = reinterpret_cast<ReplayOutput*>(data);
+	if (replay->hotkey != OBS_INVALID_HOTKEY_ID)
+		obs_hotkey_unregister(replay->hotkey);
+	{
+		std::unique_lock<std::mutex> slock(replay->saveMtx);
+		if (replay->saveThread.joinable())
+			replay->saveThread.join();
+	}
+	delete replay;
+}
+
+static bool ReplayStart(void* data)
+{
+	ReplayOutput* replay = reinterpret_cast<ReplayOutput*>(data);
+
+	if (!obs_output_can_begin_data_capture(replay->output, 0))
+		return false;
+	if (!obs_output_initialize_encoders(replay->output, 0))
+		return false;
+
+	{
+		std::unique_lock<std::mutex> ulock(replay->mtx);
+		if (!replay->memoryHeadBytes)
+			replay->memoryHeadBytes = DiskReplayBuffer::DefaultMemoryHeadMB * 1024 * 1024;
+
+		uint64_t size = ReplayRingIndex::RingSize(
+		    ReplayKbps(replay), replay->maxTimeUsec / 1000000, replay->maxSizeBytes, replay->memoryHeadBytes);
+		std::string path = RingDirectory(replay) + "/obs-replay-buffer-" + std::to_string(os_gettime_ns()) + ".ring";
+		if (!replay->ring.Open(path, size)) {
+			blog(LOG_ERROR, "Disk replay buffer: failed to create %llu MB ring at %s", (unsigned long long)(size >> 20), path.c_str());
+			obs_output_set_last_error(replay->output, "Failed to create the replay buffer file.");
+			return false;
+		}
+
+		replay->index.Reset(size, replay->maxTimeUsec, replay->memoryHeadBytes);
+		blog(
+		    LOG_INFO,
+		    "Disk replay buffer: %llu MB ring at %s, %llu MB resident",
+		    (unsigned long long)(size >> 20),
+		    path.c_str(),
+		    (unsigned long long)(replay->memoryHeadBytes >> 20));
+	}
+
+	obs_output_begin_data_capture(replay->output, 0);
+	return true;
+}
+
+static void ReplayStop(void* data, uint64_t)
+{
+	ReplayOutput* replay = reinterpret_cast<ReplayOutput*>(data);
+	obs_output_end_data_capture(replay->output);
+
+	// A save in progress still reads from the ring
+	{
+		std::unique_lock<std::mutex> slock(replay->saveMtx);
+		if (replay->saveThread.joinable())
+			replay->saveThread.join();
+	}
+
+	std::unique_lock<std::mutex> ulock(replay->mtx);
+	replay->index.Reset(0, 0, 0);
+	replay->ring.Close();
+}
+
+static void ReplayEncodedPacket(void* data, encoder_packet* packet)
+{
+	ReplayOutput* replay = reinterpret_cast<ReplayOutput*>(data);
+	if (!packet) {
+		obs_output_signal_stop(replay->output, OBS_OUTPUT_ENCODE_ERROR);
+		return;
+	}
+
+	std::unique_lock<std::mutex> ulock(replay->mtx);
+	if (!replay->ring.IsOpen())
+		return;
+
+	ReplayRingIndex::Packet record = {0,
+	                                  uint32_t(packet->size),
+	                                  packet->pts,
+	                                  packet->dts,
+	                                  packet->dts_usec,
+	                                  packet->timebase_num,
+	                                  packet->timebase_den,
+	                                  uint32_t(packet->track_idx),
+	                                  packet->type == OBS_ENCODER_VIDEO,
+	                                  packet->keyframe};
+	ReplayRingIndex::Range release;
+	if (!replay->index.Append(record, release))
+		return;
+
+	replay->ring.Write(record.position, packet->data, packet->size);
+
+	// Keep only the memory head resident
+	if (release.size)
+		replay->ring.Release(release.position, release.size);
+}
+
+static uint64_t ReplayTotalBytes(void* data)
+{
+	ReplayOutput*                replay = reinterpret_cast<ReplayOutput*>(data);
+	std::unique_lock<std::mutex> ulock(replay->mtx);
+	return replay->index.TotalBytes();
+}
+
+void DiskReplayBuffer::Register(void)
+{
+	obs_output_info info = {};
+	info.id              = Id;
+	info.flags           = OBS_OUTPUT_AV | OBS_OUTPUT_ENCODED | OBS_OUTPUT_MULTI_TRACK;
+	info.get_name        = ReplayGetName;
+	info.create          = ReplayCreate;
+	info.destroy         = ReplayDestroy;
+	info.start           = ReplayStart;
+	info.stop            = ReplayStop;
+	info.encoded_packet  = ReplayEncodedPacket;
+	info.get_total_bytes = ReplayTotalBytes;
+	info.get_defaults    = ReplayDefaults;
+	info.update          = ReplayUpdate;
+	obs_register_output(&info);
+}
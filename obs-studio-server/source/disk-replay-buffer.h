@@ -0,0 +1,44 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Replay buffer output that keeps encoded packets in a preallocated memory mapped
+// ring file in the temp directory instead of RAM. The ring is sized from the
+// encoder bitrates and the replay length. Only the most recently written part of
+// the ring (the "memory head") stays resident, older pages are handed back to the
+// OS and read again from disk when a replay is saved. Saving remuxes straight from the ring
+// through obs-ffmpeg-mux, the same helper the libobs file outputs use.
+//
+// The output is a drop-in replacement for "replay_buffer": same settings
+// (directory, format, extension, allow_spaces, max_time_sec, max_size_mb), same
+// "ReplayBuffer.Save" hotkey, "save"/"get_last_file" procs and
+// "writing"/"wrote"/"writing_error" signals.
+class DiskReplayBuffer
+{
+	public:
+	static constexpr const char* Id = "disk_replay_buffer";
+
+	// Size of the resident part of the ring when "memory_head_mb" isn't set
+	static const uint64_t DefaultMemoryHeadMB = 16;
+
+	// Registers the output type, must be called once after obs_startup
+	static void Register(void);
+};
@@ -0,0 +1,178 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "encoder-registry.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include "encoder-share-table.h"
+
+static std::mutex                           registryMutex;
+static EncoderShareTable                    table;
+static std::map<void*, obs_weak_encoder_t*> weakEncoders;
+
+static EncoderShareTable::Key MakeKey(obs_encoder_t* encoder, uint64_t trackIndex, int renderingMode)
+{
+	obs_data_t* settings = obs_encoder_get_settings(encoder);
+	size_t      hash     = EncoderShareTable::SettingsHash(settings ? obs_data_get_json(settings) : nullptr);
+	obs_data_release(settings);
+	return {obs_encoder_get_id(encoder), trackIndex, renderingMode, hash};
+}
+
+static void PruneExpired(void)
+{
+	for (auto it = weakEncoders.begin(); it != weakEncoders.end();) {
+		obs_encoder_t* encoder = obs_weak_encoder_get_encoder(it->second);
+		if (encoder) {
+			obs_encoder_release(encoder);
+			it++;
+		} else {
+			table.Erase(it->first);
+			obs_weak_encoder_release(it->second);
+			it = weakEncoders.erase(it);
+		}
+	}
+
+	table.Prune([](const void* slot, void* encoder) {
+		return *reinterpret_cast<obs_encoder_t* const*>(slot) == encoder;
+	});
+}
+
+static void Track(obs_encoder_t* encoder, const EncoderShareTable::Key& key)
+{
+	table.Set(encoder, key);
+	if (weakEncoders.find(encoder) == weakEncoders.end())
+		weakEncoders[encoder] = obs_encoder_get_weak_encoder(encoder);
+}
+
+void EncoderRegistry::Share(obs_encoder_t** dst, obs_encoder_t* src, uint64_t trackIndex, int renderingMode)
+{
+	if (!src)
+		return;
+
+	std::unique_lock<std::mutex> ulock(registryMutex);
+	PruneExpired();
+
+	EncoderShareTable::Key key    = MakeKey(src, trackIndex, renderingMode);
+	void*                  found  = table.Find(key);
+	obs_encoder_t*         shared = found ? obs_weak_encoder_get_encoder(weakEncoders[found]) : nullptr;
+	if (shared) {
+		if (*dst == shared) {
+			// Already holding it, drop the reference we just took
+			obs_encoder_release(shared);
+		} else {
+			if (*dst)
+				obs_encoder_release(*dst);
+			*dst = shared;
+		}
+		table.Hold(dst, shared);
+		return;
+	}
+
+	// Same codec, track and rendering mode but diverging settings: reconfigure the
+	// encoder we already hold rather than spinning up another instance, as long as
+	// no other output holds it
+	EncoderShareTable::Key current;
+	if (*dst && table.KeyOf(*dst, current) && current.codec == key.codec && current.track == trackIndex
+	    && current.renderingMode == renderingMode && table.Holders(*dst) <= 1 && !obs_encoder_active(*dst)) {
+		obs_data_t* settings = obs_encoder_get_settings(src);
+		obs_encoder_update(*dst, settings);
+		obs_data_release(settings);
+		table.Set(*dst, key);
+		table.Hold(dst, *dst);
+		blog(LOG_INFO, "Encoder registry: updated '%s' in place", obs_encoder_get_name(*dst));
+		return;
+	}
+
+	std::string name = obs_encoder_get_name(src);
+	name += "-shared";
+
+	obs_data_t*    settings = obs_encoder_get_settings(src);
+	obs_encoder_t* encoder  = nullptr;
+	if (obs_encoder_get_type(src) == OBS_ENCODER_AUDIO) {
+		encoder = obs_audio_encoder_create(obs_encoder_get_id(src), name.c_str(), settings, trackIndex, nullptr);
+	} else if (obs_encoder_get_type(src) == OBS_ENCODER_VIDEO) {
+		encoder = obs_video_encoder_create(obs_encoder_get_id(src), name.c_str(), settings, nullptr);
+	}
+	obs_data_release(settings);
+
+	if (!encoder)
+		return;
+
+	if (*dst)
+		obs_encoder_release(*dst);
+	*dst = encoder;
+
+	Track(encoder, key);
+	table.Hold(dst, encoder);
+	blog(LOG_INFO, "Encoder registry: created '%s' for track %llu", name.c_str(), (unsigned long long)trackIndex);
+}
+
+void EncoderRegistry::Register(obs_encoder_t** slot, uint64_t trackIndex, int renderingMode)
+{
+	std::unique_lock<std::mutex> ulock(registryMutex);
+	PruneExpired();
+
+	if (!*slot) {
+		table.Drop(slot);
+		return;
+	}
+
+	Track(*slot, MakeKey(*slot, trackIndex, renderingMode));
+	table.Hold(slot, *slot);
+}
+
+bool EncoderRegistry::Update(obs_encoder_t* encoder, obs_data_t* settings)
+{
+	if (!encoder)
+		return false;
+
+	std::unique_lock<std::mutex> ulock(registryMutex);
+	PruneExpired();
+
+	if (table.Holders(encoder) > 1 && obs_encoder_active(encoder)) {
+		blog(
+		    LOG_WARNING,
+		    "Encoder registry: '%s' is shared by a running output, settings left unchanged",
+		    obs_encoder_get_name(encoder));
+		return false;
+	}
+
+	obs_encoder_update(encoder, settings);
+
+	EncoderShareTable::Key key;
+	if (table.KeyOf(encoder, key))
+		table.Set(encoder, MakeKey(encoder, key.track, key.renderingMode));
+	return true;
+}
+
+size_t EncoderRegistry::Holders(obs_encoder_t* encoder)
+{
+	std::unique_lock<std::mutex> ulock(registryMutex);
+	PruneExpired();
+	return table.Holders(encoder);
+}
+
+void EncoderRegistry::Clear(void)
+{
+	std::unique_lock<std::mutex> ulock(registryMutex);
+	for (auto& entry : weakEncoders)
+		obs_weak_encoder_release(entry.second);
+	weakEncoders.clear();
+	table.Clear();
+}
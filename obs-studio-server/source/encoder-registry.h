@@ -0,0 +1,53 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <obs.h>
+
+// Hands out encoders shared by every output that needs an encoder with the same
+// codec, settings, track and rendering mode. The registry only keeps weak
+// references, callers own a regular reference and release it with
+// obs_encoder_release, so an encoder lives as long as one output still uses it.
+//
+// Encoders are held through the variables they are stored in (the slots). A slot
+// that is reassigned or released outside the registry stops counting as a holder
+// on the next call.
+class EncoderRegistry
+{
+	public:
+	// Makes *dst hold an encoder equivalent to src for the given track and rendering
+	// mode, reusing a registered one when possible. If *dst already is such an encoder
+	// nothing changes; if it only differs by its settings, is idle and nothing else
+	// holds it, it's updated in place instead of being recreated.
+	static void Share(obs_encoder_t** dst, obs_encoder_t* src, uint64_t trackIndex, int renderingMode);
+
+	// Registers the encoder held by *slot so later Share calls can hand it out
+	static void Register(obs_encoder_t** slot, uint64_t trackIndex, int renderingMode);
+
+	// Updates the settings of an encoder. Refused while it is active and held by more
+	// than one slot, the other holders would switch settings mid output.
+	static bool Update(obs_encoder_t* encoder, obs_data_t* settings);
+
+	// Number of slots holding the encoder
+	static size_t Holders(obs_encoder_t* encoder);
+
+	// Drops the weak references, called on shutdown after the outputs released their encoders
+	static void Clear(void);
+};
@@ -0,0 +1,119 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#include "encoder-share-table.h"
+#include <tuple>
+
+bool EncoderShareTable::Key::operator<(const Key& other) const
+{
+	return std::tie(codec, track, renderingMode, settingsHash)
+	       < std::tie(other.codec, other.track, other.renderingMode, other.settingsHash);
+}
+
+bool EncoderShareTable::Key::operator==(const Key& other) const
+{
+	return codec == other.codec && track == other.track && renderingMode == other.renderingMode
+	       && settingsHash == other.settingsHash;
+}
+
+size_t EncoderShareTable::SettingsHash(const char* json)
+{
+	return std::hash<std::string>()(json ? json : "");
+}
+
+void* EncoderShareTable::Find(const Key& key) const
+{
+	auto found = m_keys.find(key);
+	return found != m_keys.end() ? found->second : nullptr;
+}
+
+void EncoderShareTable::Set(void* encoder, const Key& key)
+{
+	auto current = m_encoders.find(encoder);
+	if (current != m_encoders.end()) {
+		auto previous = m_keys.find(current->second);
+		if (previous != m_keys.end() && previous->second == encoder)
+			m_keys.erase(previous);
+	}
+	m_encoders[encoder] = key;
+	m_keys[key]         = encoder;
+}
+
+bool EncoderShareTable::KeyOf(void* encoder, Key& key) const
+{
+	auto found = m_encoders.find(encoder);
+	if (found == m_encoders.end())
+		return false;
+	key = found->second;
+	return true;
+}
+
+void EncoderShareTable::Hold(const void* slot, void* encoder)
+{
+	m_holders[slot] = encoder;
+}
+
+void EncoderShareTable::Drop(const void* slot)
+{
+	m_holders.erase(slot);
+}
+
+size_t EncoderShareTable::Holders(void* encoder) const
+{
+	size_t holders = 0;
+	for (auto& holder : m_holders) {
+		if (holder.second == encoder)
+			holders++;
+	}
+	return holders;
+}
+
+void EncoderShareTable::Erase(void* encoder)
+{
+	auto current = m_encoders.find(encoder);
+	if (current != m_encoders.end()) {
+		auto key = m_keys.find(current->second);
+		if (key != m_keys.end() && key->second == encoder)
+			m_keys.erase(key);
+		m_encoders.erase(current);
+	}
+	for (auto it = m_holders.begin(); it != m_holders.end();) {
+		if (it->second == encoder)
+			it = m_holders.erase(it);
+		else
+			it++;
+	}
+}
+
+void EncoderShareTable::Prune(const std::function<bool(const void* slot, void* encoder)>& stillHolds)
+{
+	for (auto it = m_holders.begin(); it != m_holders.end();) {
+		if (stillHolds(it->first, it->second))
+			it++;
+		else
+			it = m_holders.erase(it);
+	}
+}
+
+void EncoderShareTable::Clear(void)
+{
+	m_keys.clear();
+	m_encoders.clear();
+	m_holders.clear();
+}
@@ -0,0 +1,71 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+
+// Bookkeeping of EncoderRegistry, free of libobs. Encoders are opaque pointers and
+// their holders are the variables the registry stored them in, so an encoder is
+// shared when more than one variable holds it.
+class EncoderShareTable
+{
+	public:
+	struct Key
+	{
+		std::string codec;
+		uint64_t    track;
+		int         renderingMode;
+		size_t      settingsHash;
+
+		bool operator<(const Key& other) const;
+		bool operator==(const Key& other) const;
+	};
+
+	// Hash of the json of the user set values, defaults are the same for every encoder of a codec
+	static size_t SettingsHash(const char* json);
+
+	// Encoder registered under the key, nullptr if none
+	void* Find(const Key& key) const;
+
+	// Registers the encoder under the key, replacing its previous key
+	void Set(void* encoder, const Key& key);
+	bool KeyOf(void* encoder, Key& key) const;
+
+	// The slot now holds the encoder and stops holding the one it held before
+	void   Hold(const void* slot, void* encoder);
+	void   Drop(const void* slot);
+	size_t Holders(void* encoder) const;
+
+	// Forgets the encoder and every slot holding it
+	void Erase(void* encoder);
+
+	// Drops the holders for which stillHolds is false
+	void Prune(const std::function<bool(const void* slot, void* encoder)>& stillHolds);
+
+	void Clear(void);
+
+	private:
+	std::map<Key, void*>         m_keys;
+	std::map<void*, Key>         m_encoders;
+	std::map<const void*, void*> m_holders;
+};
@@ -0,0 +1,64 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "ffmpeg-mux.h"
+#include <sstream>
+
+// Quotes are doubled inside quoted paths and names
+static std::string Quote(std::string value)
+{
+	size_t pos = 0;
+	while ((pos = value.find('"', pos)) != std::string::npos) {
+		value.insert(pos, "\"");
+		pos += 2;
+	}
+	return "\"" + value + "\"";
+}
+
+std::string FFmpegMux::CommandLine(
+    const std::string&             executable,
+    const std::string&             path,
+    const VideoTrack*              video,
+    const std::string&             audioCodec,
+    const std::vector<AudioTrack>& audio,
+    const std::string&             muxerSettings)
+{
+	std::ostringstream cmd;
+	cmd << Quote(executable) << " " << Quote(path) << " " << (video ? 1 : 0) << " " << audio.size() << " ";
+
+	if (video) {
+		cmd << video->codec << " " << video->bitrate << " " << video->width << " " << video->height << " "
+		    << video->fpsNum << " " << video->fpsDen << " ";
+	}
+
+	if (!audio.empty()) {
+		cmd << audioCodec << " ";
+		for (const AudioTrack& track : audio)
+			cmd << Quote(track.name) << " " << track.bitrate << " " << track.sampleRate << " " << track.channels << " ";
+	}
+
+	// Muxer settings escape quotes with a backslash instead
+	std::string settings = muxerSettings;
+	size_t      pos      = 0;
+	while ((pos = settings.find('"', pos)) != std::string::npos) {
+		settings.insert(pos, "\\");
+		pos += 2;
+	}
+	cmd << "\"" << settings << "\" ";
+	return cmd.str();
+}
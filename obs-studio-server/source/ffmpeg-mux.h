@@ -0,0 +1,73 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Arguments and packet framing of obs-ffmpeg-mux, the remux helper process of the libobs
+// file outputs. Both follow build_command_line and struct ffm_packet_info in
+// obs-ffmpeg-mux of the libobs version in azure-pipelines.yml, check them when it changes.
+class FFmpegMux
+{
+	public:
+	enum PacketType : int32_t
+	{
+		Video = 0,
+		Audio = 1
+	};
+
+	// Header written in front of every packet
+	struct PacketInfo
+	{
+		int64_t  pts;
+		int64_t  dts;
+		uint32_t size;
+		uint32_t index;
+		int32_t  type;
+		bool     keyframe;
+	};
+
+	struct VideoTrack
+	{
+		std::string codec;
+		int64_t     bitrate;
+		uint32_t    width;
+		uint32_t    height;
+		uint32_t    fpsNum;
+		uint32_t    fpsDen;
+	};
+
+	struct AudioTrack
+	{
+		std::string name;
+		int64_t     bitrate;
+		uint32_t    sampleRate;
+		uint32_t    channels;
+	};
+
+	// Every audio track shares the codec of the first one, as in the libobs outputs
+	static std::string CommandLine(
+	    const std::string&             executable,
+	    const std::string&             path,
+	    const VideoTrack*              video,
+	    const std::string&             audioCodec,
+	    const std::vector<AudioTrack>& audio,
+	    const std::string&             muxerSettings);
+};
@@ -0,0 +1,95 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#include "filter-chain-plan.h"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+bool FilterChainPlan::Make(
+    const std::vector<uint64_t>& current,
+    const std::vector<uint64_t>& desired,
+    std::vector<Step>&           steps)
+{
+	steps.clear();
+
+	std::unordered_set<uint64_t> wanted(desired.begin(), desired.end());
+	if (wanted.size() != desired.size())
+		return false;
+
+	// Filters that stay, in their current order, followed by the new ones
+	std::vector<uint64_t> order;
+	for (uint64_t filter : current) {
+		if (wanted.count(filter)) {
+			order.push_back(filter);
+		} else {
+			steps.push_back({Action::Remove, filter});
+		}
+	}
+
+	std::unordered_set<uint64_t> present(order.begin(), order.end());
+	for (uint64_t filter : desired) {
+		if (!present.count(filter)) {
+			steps.push_back({Action::Add, filter});
+			order.push_back(filter);
+		}
+	}
+
+	std::unordered_map<uint64_t, size_t> position;
+	for (size_t idx = 0; idx < order.size(); idx++)
+		position[order[idx]] = idx;
+
+	// The longest run of desired that is already in order doesn't move, what
+	// comes before it goes to the front and what comes after it to the back
+	size_t first = 0, last = 0;
+	for (size_t start = 0, idx = 0; idx < desired.size(); idx++) {
+		if (idx > 0 && position[desired[idx]] < position[desired[idx - 1]])
+			start = idx;
+		if (idx + 1 - start > last - first) {
+			first = start;
+			last  = idx + 1;
+		}
+	}
+
+	for (size_t idx = last; idx < desired.size(); idx++)
+		steps.push_back({Action::MoveToBack, desired[idx]});
+	for (size_t idx = first; idx > 0; idx--)
+		steps.push_back({Action::MoveToFront, desired[idx - 1]});
+
+	return true;
+}
+
+void FilterChainPlan::Apply(const Step& step, std::vector<uint64_t>& order)
+{
+	auto found = std::find(order.begin(), order.end(), step.filter);
+	if (found != order.end())
+		order.erase(found);
+
+	switch (step.action) {
+	case Action::Remove:
+		break;
+	case Action::Add:
+	case Action::MoveToBack:
+		order.push_back(step.filter);
+		break;
+	case Action::MoveToFront:
+		order.insert(order.begin(), step.filter);
+		break;
+	}
+}
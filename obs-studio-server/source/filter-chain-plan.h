@@ -0,0 +1,51 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Works out how to turn the filter chain of a source into another one with as
+// few changes as possible. Every change relinks the chain and signals the
+// client, so a preset applied filter by filter goes through as many
+// intermediate chains as it has steps. Orders are the order GetFilters
+// reports: filters are added at the back and can only be moved to either end.
+class FilterChainPlan
+{
+	public:
+	enum class Action : uint32_t
+	{
+		Remove,
+		Add,
+		MoveToFront,
+		MoveToBack,
+	};
+
+	struct Step
+	{
+		Action   action;
+		uint64_t filter;
+	};
+
+	// Steps turning current into desired, false if desired lists a filter twice
+	static bool Make(const std::vector<uint64_t>& current, const std::vector<uint64_t>& desired, std::vector<Step>& steps);
+
+	// What a step does to an order
+	static void Apply(const Step& step, std::vector<uint64_t>& order);
+};
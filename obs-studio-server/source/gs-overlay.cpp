@@ -0,0 +1,272 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "gs-overlay.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// Layout of resources/roboto.png, a 4x4 grid of glyphs
+static const char*  GlyphTable = "1234567890px";
+static const float  GlyphUV    = 1.0f / 4.0f;
+
+static const float HandlePositions[GS::OverlayGeometry::HandleCount][2] = {
+    {0.0f, 0.0f},
+    {1.0f, 0.0f},
+    {0.0f, 1.0f},
+    {1.0f, 1.0f},
+    {0.5f, 0.0f},
+    {0.5f, 1.0f},
+    {0.0f, 0.5f},
+    {1.0f, 0.5f},
+};
+
+static inline void Transform(const GS::OverlayTransform& box, float u, float v, float& x, float& y)
+{
+	x = box.originX + u * box.axisXx + v * box.axisYx;
+	y = box.originY + u * box.axisXy + v * box.axisYy;
+}
+
+void GS::OverlayGeometry::Reset(const OverlayStyle& style)
+{
+	m_style = style;
+	m_triangles.clear();
+	m_lines.clear();
+	m_glyphs.clear();
+}
+
+void GS::OverlayGeometry::AddItem(const OverlayTransform& box)
+{
+	m_triangles.reserve(m_triangles.size() + TriangleVerticesPerItem);
+	m_lines.reserve(m_lines.size() + LineVerticesPerItem);
+
+	// Outline
+	float corners[4][2];
+	Transform(box, 0, 0, corners[0][0], corners[0][1]);
+	Transform(box, 1, 0, corners[1][0], corners[1][1]);
+	Transform(box, 1, 1, corners[2][0], corners[2][1]);
+	Transform(box, 0, 1, corners[3][0], corners[3][1]);
+	for (size_t n = 0; n < 4; n++) {
+		size_t next = (n + 1) % 4;
+		AddLine(corners[n][0], corners[n][1], corners[next][0], corners[next][1], m_style.outlineColor);
+	}
+
+	// Resize handles
+	for (size_t n = 0; n < HandleCount; n++) {
+		float x, y;
+		Transform(box, HandlePositions[n][0], HandlePositions[n][1], x, y);
+		AddHandle(x, y);
+	}
+
+	if (!m_style.drawGuideLines)
+		return;
+
+	// Guidelines and distance labels, from the edge centers to the scene borders
+	float centerX, centerY;
+	Transform(box, 0.5f, 0.5f, centerX, centerY);
+
+	float edges[4][2];
+	Transform(box, 0.0f, 0.5f, edges[0][0], edges[0][1]);
+	Transform(box, 0.5f, 0.0f, edges[1][0], edges[1][1]);
+	Transform(box, 1.0f, 0.5f, edges[2][0], edges[2][1]);
+	Transform(box, 0.5f, 1.0f, edges[3][0], edges[3][1]);
+
+	for (size_t n = 0; n < 4; n++)
+		AddGuideline(edges[n][0], edges[n][1], centerX, centerY);
+
+	float pt = m_style.glyphSize;
+	for (size_t n = 0; n < 4; n++) {
+		float x = edges[n][0], y = edges[n][1];
+		if (x < 0 || x >= m_style.sceneWidth || y < 0 || y >= m_style.sceneHeight)
+			continue;
+
+		float dx = x - centerX, dy = y - centerY;
+		float length = std::sqrt(dx * dx + dy * dy);
+		if (length <= 0)
+			continue;
+
+		float left = -dx / length, top = -dy / length;
+		if (left > 0.5f) {
+			float dist = x;
+			if (dist > pt * 4)
+				AddLabel(x / 2, y - pt * 2, true, uint32_t(dist));
+		} else if (left < -0.5f) {
+			float dist = m_style.sceneWidth - x;
+			if (dist > pt * 4)
+				AddLabel(x + dist / 2, y - pt * 2, true, uint32_t(dist));
+		} else if (top > 0.5f) {
+			float dist = y;
+			if (dist > pt)
+				AddLabel(x, y - dist / 2 - pt, false, uint32_t(dist));
+		} else if (top < -0.5f) {
+			float dist = m_style.sceneHeight - y;
+			if (dist > pt * 4)
+				AddLabel(x, y + dist / 2 - pt, false, uint32_t(dist));
+		}
+	}
+}
+
+const std::vector<GS::OverlayVertex>& GS::OverlayGeometry::Triangles() const
+{
+	return m_triangles;
+}
+
+const std::vector<GS::OverlayVertex>& GS::OverlayGeometry::Lines() const
+{
+	return m_lines;
+}
+
+const std::vector<GS::OverlayVertex>& GS::OverlayGeometry::Glyphs() const
+{
+	return m_glyphs;
+}
+
+bool GS::OverlayGeometry::Empty() const
+{
+	return m_triangles.empty() && m_lines.empty() && m_glyphs.empty();
+}
+
+uint64_t GS::OverlayGeometry::Signature() const
+{
+	// FNV-1a over the vertices, list sizes included so moving a vertex from one
+	// list to the other changes the result
+	uint64_t hash = 14695981039346656037ull;
+	auto     add  = [&hash](const void* data, size_t size) {
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+		for (size_t n = 0; n < size; n++) {
+			hash ^= bytes[n];
+			hash *= 1099511628211ull;
+		}
+	};
+
+	for (auto list : {&m_triangles, &m_lines, &m_glyphs}) {
+		uint64_t count = list->size();
+		add(&count, sizeof(count));
+		for (auto& vertex : *list) {
+			add(&vertex.x, sizeof(float) * 4);
+			add(&vertex.color, sizeof(vertex.color));
+		}
+	}
+	return hash;
+}
+
+void GS::OverlayGeometry::AddLine(float x0, float y0, float x1, float y1, uint32_t color)
+{
+	m_lines.push_back({x0, y0, 0, 0, color});
+	m_lines.push_back({x1, y1, 0, 0, color});
+}
+
+void GS::OverlayGeometry::AddHandle(float x, float y)
+{
+	float    left = x - m_style.handleRadiusX, right = x + m_style.handleRadiusX;
+	float    top = y - m_style.handleRadiusY, bottom = y + m_style.handleRadiusY;
+	uint32_t inner = m_style.resizeInnerColor;
+
+	m_triangles.push_back({left, top, 0, 0, inner});
+	m_triangles.push_back({right, top, 0, 0, inner});
+	m_triangles.push_back({left, bottom, 0, 0, inner});
+	m_triangles.push_back({right, top, 0, 0, inner});
+	m_triangles.push_back({left, bottom, 0, 0, inner});
+	m_triangles.push_back({right, bottom, 0, 0, inner});
+
+	AddLine(left, top, right, top, m_style.resizeOuterColor);
+	AddLine(right, top, right, bottom, m_style.resizeOuterColor);
+	AddLine(right, bottom, left, bottom, m_style.resizeOuterColor);
+	AddLine(left, bottom, left, top, m_style.resizeOuterColor);
+}
+
+void GS::OverlayGeometry::AddGuideline(float x, float y, float centerX, float centerY)
+{
+	// The guideline points away from the item along the dominant axis of the edge
+	float dx = centerX - x, dy = centerY - y;
+	float length = std::sqrt(dx * dx + dy * dy);
+	if (length > 0) {
+		dx /= length;
+		dy /= length;
+	}
+
+	float dirX = 1.0f, dirY = 0.0f;
+	if (dy > 0.5f) {
+		dirX = 0.0f;
+		dirY = -1.0f;
+	} else if (dy < -0.5f) {
+		dirX = 0.0f;
+		dirY = 1.0f;
+	} else if (dx < -0.5f) {
+		dirX = 1.0f;
+	} else if (dx > 0.5f) {
+		dirX = -1.0f;
+	}
+
+	// Clip to the scene instead of relying on a scissor rect
+	float width = m_style.sceneWidth, height = m_style.sceneHeight;
+	if (dirY == 0.0f) {
+		if (y < 0 || y > height)
+			return;
+
+		float endX = dirX > 0 ? width : 0.0f;
+		float startX = std::min(std::max(x, 0.0f), width);
+		if (startX == endX)
+			return;
+		AddLine(startX, y, endX, y, m_style.guidelineColor);
+	} else {
+		if (x < 0 || x > width)
+			return;
+
+		float endY = dirY > 0 ? height : 0.0f;
+		float startY = std::min(std::max(y, 0.0f), height);
+		if (startY == endY)
+			return;
+		AddLine(x, startY, x, endY, m_style.guidelineColor);
+	}
+}
+
+void GS::OverlayGeometry::AddLabel(float x, float y, bool centered, uint32_t distance)
+{
+	char   buf[16];
+	int    written = snprintf(buf, sizeof(buf), "%u px", distance);
+	size_t len     = std::min(size_t(std::max(written, 0)), sizeof(buf) - 1);
+	float  pt      = m_style.glyphSize;
+
+	if (centered)
+		x -= pt * len / 2.0f;
+
+	m_glyphs.reserve(m_glyphs.size() + len * 6);
+	for (size_t p = 0; p < len; p++)
+		AddGlyph(x + p * pt, y, buf[p]);
+}
+
+void GS::OverlayGeometry::AddGlyph(float x, float y, char glyph)
+{
+	const char* entry = glyph ? strchr(GlyphTable, glyph) : nullptr;
+	if (!entry)
+		return;
+
+	size_t   index = entry - GlyphTable;
+	float    u = (index % 4) * GlyphUV, v = (index / 4) * GlyphUV;
+	float    pt    = m_style.glyphSize;
+	uint32_t color = m_style.guidelineColor;
+
+	m_glyphs.push_back({x, y, u, v, color});
+	m_glyphs.push_back({x + pt, y, u + GlyphUV, v, color});
+	m_glyphs.push_back({x, y + pt * 2, u, v + GlyphUV, color});
+	m_glyphs.push_back({x + pt, y, u + GlyphUV, v, color});
+	m_glyphs.push_back({x, y + pt * 2, u, v + GlyphUV, color});
+	m_glyphs.push_back({x + pt, y + pt * 2, u + GlyphUV, v + GlyphUV, color});
+}
@@ -0,0 +1,114 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <vector>
+
+namespace GS
+{
+	struct OverlayVertex
+	{
+		float    x, y;
+		float    u, v;
+		uint32_t color;
+	};
+
+	/*!
+	* \brief Maps the unit square of a scene item to scene space
+	* A point (u, v) lands on origin + u * axisX + v * axisY, which is what the
+	* box transform of a scene item does in 2D.
+	*/
+	struct OverlayTransform
+	{
+		float originX, originY;
+		float axisXx, axisXy;
+		float axisYx, axisYy;
+	};
+
+	struct OverlayStyle
+	{
+		// Colors are packed as 0xAABBGGRR, like the vertex colors of libobs
+		uint32_t outlineColor;
+		uint32_t guidelineColor;
+		uint32_t resizeOuterColor;
+		uint32_t resizeInnerColor;
+
+		// Half size of a resize handle and size of a label glyph, in scene units
+		float handleRadiusX;
+		float handleRadiusY;
+		float glyphSize;
+
+		float sceneWidth;
+		float sceneHeight;
+
+		bool drawGuideLines;
+	};
+
+	/*!
+	* \brief CPU side geometry of the selection overlay of a display
+	* All selected items of a frame are appended to the same three lists so the
+	* overlay can be drawn with one GS_TRIS and one GS_LINES call on untextured
+	* vertex colored geometry, plus one GS_TRIS call for the distance labels.
+	*/
+	class OverlayGeometry
+	{
+		public:
+		// Resize handles around an item: corners and edge centers
+		static const uint32_t HandleCount = 8;
+
+		static const uint32_t TriangleVerticesPerItem = HandleCount * 6;
+		static const uint32_t LineVerticesPerItem     = 4 * 2 + HandleCount * 4 * 2 + 4 * 2;
+
+		/*!
+		* \brief Drop the geometry of the previous frame and set the style of the next one
+		* The lists keep their capacity, so a steady selection doesn't allocate.
+		*/
+		void Reset(const OverlayStyle& style);
+
+		/*!
+		* \brief Append outline, resize handles, guidelines and distance labels of one item
+		*/
+		void AddItem(const OverlayTransform& box);
+
+		const std::vector<OverlayVertex>& Triangles() const;
+		const std::vector<OverlayVertex>& Lines() const;
+		const std::vector<OverlayVertex>& Glyphs() const;
+
+		bool Empty() const;
+
+		/*!
+		* \brief Hash of the generated geometry
+		* Two frames with the same signature produce the same pixels, which lets a
+		* display keep the overlay it drew before.
+		*/
+		uint64_t Signature() const;
+
+		private:
+		void AddLine(float x0, float y0, float x1, float y1, uint32_t color);
+		void AddHandle(float x, float y);
+		void AddGuideline(float x, float y, float centerX, float centerY);
+		void AddLabel(float x, float y, bool centered, uint32_t distance);
+		void AddGlyph(float x, float y, char glyph);
+
+		OverlayStyle               m_style = {};
+		std::vector<OverlayVertex> m_triangles;
+		std::vector<OverlayVertex> m_lines;
+		std::vector<OverlayVertex> m_glyphs;
+	};
+} // namespace GS
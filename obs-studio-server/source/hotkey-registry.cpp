@@ -0,0 +1,89 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "hotkey-registry.h"
+
+void HotkeyRegistry::MarkDirty()
+{
+	m_dirty = true;
+}
+
+bool HotkeyRegistry::ConsumeDirty()
+{
+	return m_dirty.exchange(false);
+}
+
+void HotkeyRegistry::Update(std::vector<Hotkey> hotkeys)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	std::map<uint64_t, Hotkey>   updated;
+
+	for (auto& hotkey : hotkeys) {
+		auto previous = m_hotkeys.find(hotkey.id);
+		if (previous != m_hotkeys.end() && previous->second.objectType == hotkey.objectType
+		    && previous->second.objectName == hotkey.objectName && previous->second.hotkeyName == hotkey.hotkeyName
+		    && previous->second.hotkeyDesc == hotkey.hotkeyDesc) {
+			hotkey.version = previous->second.version;
+		} else {
+			hotkey.version = ++m_version;
+		}
+		updated.emplace(hotkey.id, std::move(hotkey));
+	}
+
+	for (auto& previous : m_hotkeys) {
+		if (updated.find(previous.first) == updated.end())
+			m_removed.emplace_back(++m_version, previous.first);
+	}
+	while (m_removed.size() > MaxRemoved) {
+		m_forgotten = m_removed.front().first;
+		m_removed.pop_front();
+	}
+
+	m_hotkeys.swap(updated);
+}
+
+void HotkeyRegistry::Since(uint64_t version, Delta& delta)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+
+	delta.version = m_version;
+	delta.full    = version == 0 || version < m_forgotten || version > m_version;
+	delta.changed.clear();
+	delta.removed.clear();
+
+	for (auto& hotkey : m_hotkeys) {
+		if (delta.full || hotkey.second.version > version)
+			delta.changed.push_back(hotkey.second);
+	}
+	if (delta.full)
+		return;
+
+	for (auto& removed : m_removed) {
+		if (removed.first > version && m_hotkeys.find(removed.second) == m_hotkeys.end())
+			delta.removed.push_back(removed.second);
+	}
+}
+
+void HotkeyRegistry::Clear()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_hotkeys.clear();
+	m_removed.clear();
+	m_forgotten = m_version;
+	m_dirty     = true;
+}
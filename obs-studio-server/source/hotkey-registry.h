@@ -0,0 +1,81 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Keeps the last known list of hotkeys and a version for each change to it, so
+// clients can ask for what was added, removed or renamed since the version
+// they already have. The list is replaced with Update whenever the hotkeys
+// were marked dirty, which happens on register, unregister and rename events.
+// Descriptions a plugin changes without one of these events are not noticed
+// until a forced Update, which the full hotkey query does.
+class HotkeyRegistry
+{
+	public:
+	struct Hotkey
+	{
+		uint64_t    id;
+		uint32_t    objectType;
+		std::string objectName;
+		std::string hotkeyName;
+		std::string hotkeyDesc;
+		// Version of the last change to this hotkey
+		uint64_t version;
+	};
+
+	struct Delta
+	{
+		uint64_t version;
+		// The client's version is too old for the removals we still remember, changed holds every hotkey
+		bool                  full;
+		std::vector<Hotkey>   changed;
+		std::vector<uint64_t> removed;
+	};
+
+	void MarkDirty();
+
+	// Returns true and clears the flag if the list must be enumerated again
+	bool ConsumeDirty();
+
+	// Replaces the list, hotkeys that are new or differ from the previous list get a new version
+	void Update(std::vector<Hotkey> hotkeys);
+
+	// Fills delta with the changes made after version, 0 asks for every hotkey
+	void Since(uint64_t version, Delta& delta);
+
+	void Clear();
+
+	private:
+	// Removals older than these are forgotten, clients that missed them get a full list
+	static const size_t MaxRemoved = 4096;
+
+	std::mutex                                m_mutex;
+	std::map<uint64_t, Hotkey>                m_hotkeys;
+	std::deque<std::pair<uint64_t, uint64_t>> m_removed;
+	uint64_t                                  m_version   = 0;
+	uint64_t                                  m_forgotten = 0;
+	std::atomic<bool>                         m_dirty{true};
+};
@@ -45,8 +45,10 @@
 #include "osn-video.hpp"
 #include "osn-volmeter.hpp"
 #include "callback-manager.h"
+#include "memory-manager.h"
 #include "osn-service.hpp"
 
+#include "util-callstats.h"
 #include "util-crashmanager.h"
 #include "shared.hpp"
 
@@ -218,6 +220,10 @@ int main(int argc, char* argv[])
 		std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("System");
 		cls->register_function(
 		    std::make_shared<ipc::function>("Shutdown", std::vector<ipc::type>{}, System::Shutdown, &doShutdown));
+		cls->register_function(
+		    std::make_shared<ipc::function>("GetCallStats", std::vector<ipc::type>{}, util::CallStats::GetCallStats));
+		cls->register_function(
+		    std::make_shared<ipc::function>("GetMediaCacheStats", std::vector<ipc::type>{}, MemoryManager::GetCacheStats));
 		myServer.register_collection(cls);
 	};
 
@@ -0,0 +1,77 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#include "media-state-tracker.h"
+
+MediaStateTracker::MediaStateTracker(Reader reader) : m_reader(reader) {}
+
+void MediaStateTracker::Watch(uint64_t source, uint32_t granularityMs)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+
+	Entry entry;
+	entry.granularityMs = granularityMs;
+	m_entries[source]   = entry;
+}
+
+void MediaStateTracker::Unwatch(uint64_t source)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_entries.erase(source);
+}
+
+void MediaStateTracker::Poll(std::vector<Change>& changes)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+
+	for (auto item = m_entries.begin(); item != m_entries.end();) {
+		Entry& entry = item->second;
+		Sample sample;
+		if (!m_reader(item->first, sample)) {
+			item = m_entries.erase(item);
+			continue;
+		}
+		m_stats.samples++;
+
+		int64_t moved = sample.time - entry.last.time;
+		if (moved < 0)
+			moved = -moved;
+
+		if (!entry.reported || sample.state != entry.last.state || sample.duration != entry.last.duration
+		    || (moved > 0 && moved >= int64_t(entry.granularityMs))) {
+			entry.reported = true;
+			entry.last     = sample;
+			changes.emplace_back(item->first, sample);
+			m_stats.reported++;
+		}
+		item++;
+	}
+}
+
+void MediaStateTracker::Clear()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_entries.clear();
+}
+
+MediaStateTracker::Stats MediaStateTracker::GetStats()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	return m_stats;
+}
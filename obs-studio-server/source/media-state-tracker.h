@@ -0,0 +1,82 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Media state of the sources a client watches, sampled with every global
+// callback query and reported only when it changes. The play position is
+// reported once it moved by at least the granularity of the source, so a
+// progress bar can ask for a second while a scrubber asks for a frame.
+class MediaStateTracker
+{
+	public:
+	struct Sample
+	{
+		uint32_t state; // obs_media_state
+		int64_t  time;
+		int64_t  duration;
+
+		bool operator==(const Sample& other) const
+		{
+			return state == other.state && time == other.time && duration == other.duration;
+		}
+	};
+
+	using Change = std::pair<uint64_t, Sample>;
+
+	// Reads the media state of a source, false once the source is gone
+	using Reader = std::function<bool(uint64_t source, Sample& sample)>;
+
+	struct Stats
+	{
+		uint64_t samples;
+		uint64_t reported;
+	};
+
+	MediaStateTracker(Reader reader);
+
+	// The next poll reports the source whatever its state
+	void Watch(uint64_t source, uint32_t granularityMs);
+	void Unwatch(uint64_t source);
+
+	// Samples every watched source and appends those worth reporting, sources that are gone stop being watched
+	void Poll(std::vector<Change>& changes);
+
+	void  Clear();
+	Stats GetStats();
+
+	private:
+	struct Entry
+	{
+		uint32_t granularityMs;
+		bool     reported = false;
+		Sample   last     = {};
+	};
+
+	Reader                    m_reader;
+	std::mutex                m_mutex;
+	std::map<uint64_t, Entry> m_entries;
+	Stats                     m_stats = {};
+};
@@ -17,9 +17,42 @@
 ******************************************************************************/
 
 #include "memory-manager.h"
+#include "error.hpp"
+
+#if defined(__linux__)
+#include <fstream>
+#include <sstream>
+
+static bool readMemInfo(uint64_t& total, uint64_t& available)
+{
+	std::ifstream meminfo("/proc/meminfo");
+	if (!meminfo.is_open())
+		return false;
+
+	total     = 0;
+	available = 0;
+
+	std::string line;
+	while (std::getline(meminfo, line) && (!total || !available)) {
+		std::istringstream stream(line);
+		std::string        key;
+		uint64_t           value = 0;
+		stream >> key >> value;
+
+		// Values are reported in kB
+		if (key == "MemTotal:")
+			total = value * 1024;
+		else if (key == "MemAvailable:")
+			available = value * 1024;
+	}
+	return total != 0;
+}
+#endif
 
 MemoryManager::MemoryManager()
 {
+	current_cached_size = 0;
+
 #ifdef WIN32
 	MEMORYSTATUSEX statex;
 	statex.dwLength = sizeof(statex);
@@ -34,6 +67,14 @@ MemoryManager::MemoryManager()
 #elif __APPLE__
 	available_memory = g_util_osx->getTotalPhysicalMemory();
 	allowed_cached_size = std::min((uint64_t)LIMIT, (uint64_t)available_memory / 2);
+#elif defined(__linux__)
+	uint64_t free_memory = 0;
+	if (readMemInfo(available_memory, free_memory)) {
+		allowed_cached_size = std::min((uint64_t)LIMIT, (uint64_t)available_memory / 2);
+	} else {
+		available_memory    = 0;
+		allowed_cached_size = LIMIT;
+	}
 #endif
 }
 
@@ -117,122 +158,178 @@ void updateSource(obs_source_t* source, bool caching)
 	obs_data_release(settings);
 }
 
-void MemoryManager::addCachedMemory(source_info* si)
+bool MemoryManager::makeRoom(source_info* si)
 {
-	std::unique_lock<std::mutex> ulock(si->mtx);
+	// Only sources that are cached but not currently shown can be evicted, walking
+	// from the least recently used end until the new source fits in the budget.
+	uint64_t reclaimable = 0;
+	for (auto it = lru.rbegin(); it != lru.rend(); it++) {
+		if (*it != si && !obs_source_showing((*it)->source))
+			reclaimable += (*it)->size;
+	}
 
-	if (!si->size || si->cached || current_cached_size + si->size > allowed_cached_size)
-		return;
+	if (current_cached_size - std::min(current_cached_size, reclaimable) + si->size > allowed_cached_size)
+		return false;
 
-	int32_t retry = MAX_POOLS;
+	auto it = lru.end();
+	while (it != lru.begin() && current_cached_size + si->size > allowed_cached_size) {
+		source_info* candidate = *(--it);
+		if (candidate == si || obs_source_showing(candidate->source))
+			continue;
 
-	proc_handler_t* ph = obs_source_get_proc_handler(si->source);
-	bool            playing = false;
-	while (retry > 0) {
-		calldata_t      cd = {0};
-		proc_handler_call(ph, "get_playing", &cd);
-		playing = calldata_bool(&cd, "playing");
-		if (playing)
-			break;
+		it = std::next(it);
+		removeCachedMemory(candidate, false);
+		metrics.evicted++;
+	}
+	return current_cached_size + si->size <= allowed_cached_size;
+}
 
-		retry--;
-		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+bool MemoryManager::addCachedMemory(source_info* si, uint32_t retry)
+{
+	if (!si->size || si->cached)
+		return false;
+
+	if (metrics.memoryLoad >= UPPER_LIMIT) {
+		metrics.rejected++;
+		return false;
 	}
 
-	if (!playing)
-		return;
+	calldata_t      cd = {0};
+	proc_handler_t* ph = obs_source_get_proc_handler(si->source);
+	proc_handler_call(ph, "get_playing", &cd);
+	bool playing = calldata_bool(&cd, "playing");
+	calldata_free(&cd);
+
+	if (!playing) {
+		// Check again later instead of blocking the worker
+		if (retry < MAX_POOLS)
+			pushEvent(event_type::PlayingRetry, si->source, retry + 1, std::chrono::milliseconds(100));
+		return false;
+	}
+
+	if (current_cached_size + si->size > allowed_cached_size && !makeRoom(si)) {
+		metrics.rejected++;
+		return false;
+	}
 
 	blog(LOG_INFO, "adding %dMB, source: %s", si->size / 1000000, obs_source_get_name(si->source));
 	current_cached_size += si->size;
 	si->cached          =  true;
+	si->lru             =  lru.insert(lru.begin(), si);
+	metrics.cached++;
 
 	updateSource(si->source, true);
+	return true;
 }
 
 void MemoryManager::removeCachedMemory(source_info* si, bool cacheNewFiles)
 {
-	std::unique_lock<std::mutex> ulock(si->mtx);
 	if (!si->cached)
 		return;
 
 	blog(LOG_INFO, "removing %dMB, source: %s", si->size / 1000000, obs_source_get_name(si->source));
 	current_cached_size -= si->size;
 	si->cached          =  false;
+	lru.erase(si->lru);
+	metrics.uncached++;
 
 	updateSource(si->source, false);
 
 	if (!cacheNewFiles || current_cached_size >= allowed_cached_size)
 		return;
 
-
 	for (auto data : sources) {
-		if (strcmp(obs_source_get_name(si->source), data.first) != 0 && shouldCacheSource(data.second))
-			addCachedMemory(data.second);
+		if (data.second != si && !data.second->cached && shouldCacheSource(data.second))
+			addCachedMemory(data.second, 0);
 	}
 }
 
-void MemoryManager::sourceManager(source_info* si)
+void MemoryManager::sourceManager(source_info* si, uint32_t retry)
 {
-	si->mtx.lock();
-	obs_data_t*                  settings = obs_source_get_settings(si->source);
+	obs_data_t* settings = obs_source_get_settings(si->source);
 
 	bool looping    = obs_data_get_bool(settings, "looping");
 	bool local_file = obs_data_get_bool(settings, "is_local_file");
 
 	obs_data_release(settings);
 	if (!looping || !local_file) {
-		si->mtx.unlock();
+		removeCachedMemory(si, true);
 		return;
 	}
-	si->mtx.unlock();
 
 	if (si->size == 0) {
-		uint32_t retry = MAX_POOLS;
-		while (retry > 0) {
-			mtx.lock();
-			si->mtx.lock();
-			calculateRawSize(si);
-
-			if (si->size || !si->have_video) {
-				si->mtx.unlock();
-				mtx.unlock();
-				break;
-			}
-			si->mtx.unlock();
-			mtx.unlock();
+		calculateRawSize(si);
 
-			retry--;
-			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		if (!si->size) {
+			// The media may not be opened yet, check again later
+			if (si->have_video && retry < MAX_POOLS)
+				pushEvent(event_type::SizeRetry, si->source, retry + 1, std::chrono::milliseconds(500));
+			return;
 		}
 	}
-	std::unique_lock<std::mutex> ulock(mtx);
-	si->mtx.lock();
-	if (!si->size) {
-		si->mtx.unlock();
+
+	if (!shouldCacheSource(si)) {
+		removeCachedMemory(si, true);
 		return;
 	}
-	bool should_cache = shouldCacheSource(si);
-	si->mtx.unlock();
 
-	if (should_cache)
-		addCachedMemory(si);
-	else
-		removeCachedMemory(si, true);
+	if (si->cached) {
+		// Mark as most recently used
+		lru.splice(lru.begin(), lru, si->lru);
+		return;
+	}
+
+	addCachedMemory(si, 0);
 }
 
-void MemoryManager::updateSettings(obs_source_t * source)
+void MemoryManager::processEvent(const event& ev)
 {
-	auto it = sources.find(obs_source_get_name(source));
+	std::unique_lock<std::mutex> ulock(mtx);
 
+	// The source may have been unregistered while the event was queued
+	auto it = sources.find(ev.source);
 	if (it == sources.end())
 		return;
 
-	it->second->workers.push_back(std::thread(&MemoryManager::sourceManager, this, it->second));
+	metrics.events++;
+
+	switch (ev.type) {
+	case event_type::Update:
+	case event_type::SizeRetry:
+		sourceManager(it->second, ev.retry);
+		break;
+	case event_type::PlayingRetry:
+		if (shouldCacheSource(it->second))
+			addCachedMemory(it->second, ev.retry);
+		break;
+	}
+}
+
+void MemoryManager::pushEvent(event_type type, obs_source_t* source, uint32_t retry, std::chrono::milliseconds delay)
+{
+	{
+		std::unique_lock<std::mutex> ulock(watcher.mtx);
+		if (type == event_type::Update) {
+			if (!watcher.pending.insert(source).second) {
+				metrics.coalesced++;
+				return;
+			}
+		}
+		watcher.events.emplace(std::chrono::steady_clock::now() + delay, event{type, source, retry});
+	}
+	watcher.cv.notify_one();
+}
+
+void MemoryManager::updateSettings(obs_source_t* source)
+{
+	pushEvent(event_type::Update, source, 0, std::chrono::milliseconds(0));
 }
 
 void MemoryManager::updateSourceCache(obs_source_t* source)
 {
-	std::unique_lock<std::mutex> ulock(mtx);
+	const char* source_id = source ? obs_source_get_id(source) : nullptr;
+	if (!source_id || strcmp(source_id, "ffmpeg_source") != 0)
+		return;
 
 	updateSettings(source);
 }
@@ -242,7 +339,7 @@ void MemoryManager::updateSourcesCache(void)
 	std::unique_lock<std::mutex> ulock(mtx);
 
 	for (auto data : sources)
-		updateSettings(data.second->source);
+		updateSettings(data.first);
 }
 
 void MemoryManager::registerSource(obs_source_t* source)
@@ -254,16 +351,19 @@ void MemoryManager::registerSource(obs_source_t* source)
 	if (!source_id || strcmp(obs_source_get_id(source), "ffmpeg_source"))
 		return;
 
+	std::unique_lock<std::mutex> llock(watcher.lifecycle);
 	std::unique_lock<std::mutex> ulock(mtx);
 
 	source_info* si = new source_info;
 	si->cached      = false;
 	si->size        = 0;
 	si->source      = source;
-	sources.emplace(obs_source_get_name(source), si);
+	si->have_video  = false;
+	sources.emplace(source, si);
 	updateSource(source, false);
 	if (!watcher.running) {
 		watcher.running = true;
+		watcher.stop    = false;
 		watcher.worker  = std::thread(&MemoryManager::monitorMemory, this);
 	}
 }
@@ -278,84 +378,166 @@ void MemoryManager::unregisterSource(obs_source_t * source)
 	if (strcmp(source_id, "ffmpeg_source") != 0)
 		return;
 
-	mtx.lock();
-
-	auto it = sources.find(obs_source_get_name(source));
-
-	if (it == sources.end()) {
-		mtx.unlock();
-		return;
+	{
+		std::unique_lock<std::mutex> ulock(watcher.mtx);
+		watcher.pending.erase(source);
+		for (auto it = watcher.events.begin(); it != watcher.events.end();) {
+			if (it->second.source == source)
+				it = watcher.events.erase(it);
+			else
+				it++;
+		}
 	}
-	mtx.unlock();
 
-	for (auto& worker : it->second->workers) {
-		if (worker.joinable())
-			worker.join();
-	}
+	std::unique_lock<std::mutex> llock(watcher.lifecycle);
+	std::unique_lock<std::mutex> ulock(mtx);
 
-	mtx.lock();
-	
-	it->second->workers.clear();
-	removeCachedMemory(it->second, true);
+	auto it = sources.find(source);
+	if (it == sources.end())
+		return;
 
-	free(it->second);
-	sources.erase(obs_source_get_name(source));
+	source_info* si = it->second;
+	sources.erase(it);
+	removeCachedMemory(si, true);
+	delete si;
 
 	if (!sources.size() && watcher.running) {
-		watcher.stop    = true;
-		mtx.unlock();
+		{
+			std::unique_lock<std::mutex> wlock(watcher.mtx);
+			watcher.stop = true;
+		}
+		watcher.cv.notify_one();
+		ulock.unlock();
+
 		if (watcher.worker.joinable())
 			watcher.worker.join();
 
 		watcher.running = false;
-	} else {
-		mtx.unlock();
 	}
+}
+
+bool MemoryManager::getMemoryLoad(uint32_t& load)
+{
+	uint64_t total     = 0;
+	uint64_t available = 0;
+
+#ifdef WIN32
+	MEMORYSTATUSEX statex;
+	statex.dwLength = sizeof(statex);
+	if (!GlobalMemoryStatusEx(&statex))
+		return false;
 
+	total     = statex.ullTotalPhys;
+	available = statex.ullAvailPhys;
+#elif __APPLE__
+	total     = g_util_osx->getTotalPhysicalMemory();
+	available = g_util_osx->getAvailableMemory();
+#elif defined(__linux__)
+	if (!readMemInfo(total, available))
+		return false;
+#endif
+
+	if (!total || available > total)
+		return false;
+
+	load = uint32_t((total - available) * 100 / total);
+	return true;
+}
+
+void MemoryManager::relieveMemoryPressure(uint32_t load)
+{
+	std::unique_lock<std::mutex> ulock(mtx);
+	metrics.memoryLoad = load;
+
+	if (load >= UPPER_LIMIT && available_memory) {
+		// Evict least recently used sources first until the estimated load is
+		// back under the upper limit with some headroom.
+		uint64_t target = available_memory / 100 * (UPPER_LIMIT - 10);
+		uint64_t in_use = available_memory / 100 * load;
+		while (!lru.empty() && in_use > target) {
+			source_info* si = lru.back();
+			in_use -= std::min(in_use, si->size);
+			removeCachedMemory(si, false);
+			metrics.pressure++;
+			throttled = true;
+		}
+		metrics.memoryLoad = uint32_t(in_use * 100 / available_memory);
+	} else if (load < LOWER_LIMIT && throttled) {
+		throttled = false;
+		for (auto data : sources) {
+			if (!data.second->cached && shouldCacheSource(data.second))
+				addCachedMemory(data.second, 0);
+		}
+	}
 }
 
 void MemoryManager::monitorMemory()
 {
-// #ifdef WIN32
-// 	while (!watcher.stop) {
-// 		MEMORYSTATUSEX statex;
-// 		statex.dwLength = sizeof(statex);
-
-// 		if (!GlobalMemoryStatusEx(&statex))
-// 			return;
-
-// 		uint64_t memory_in_use               = statex.ullTotalPhys - statex.ullAvailPhys;
-// 		uint64_t memory_in_use_without_cache = memory_in_use - current_cached_size;
-// 		uint64_t totalMeory                  = statex.ullTotalPhys;
-// #ifdef __APPLE__
-// 		uint64_t totalMeory = g_util_osx->getTotalPhysicalMemory();
-// 		uint64_t availableMemory = g_util_osx->getAvailableMemory();
-// 		uint64_t memory_in_use = totalMeory - availableMemory;
-// 		uint64_t memory_in_use_without_cache =
-// 			memory_in_use - current_cached_size;
-// #endif
-// 		std::unique_lock<std::mutex> ulock(mtx);
-
-// 		float memory_load =
-// 			(float)(memory_in_use_without_cache + current_cached_size) / (float)totalMeory * 100;
-// 		auto it = sources.begin();
-// 		if (memory_load >= UPPER_LIMIT) {
-// 			while (memory_load >= (UPPER_LIMIT - 10) && it != sources.end()) {
-// 				removeCachedMemory(it->second, false);
-// 				memory_load =
-// 					(float)(memory_in_use_without_cache + current_cached_size) / (float)totalMeory * 100;
-// 				it++;
-// 			}
-// 		} else if (memory_load < LOWER_LIMIT) {
-// 			while (memory_load < (LOWER_LIMIT + 10) && it != sources.end()) {
-// 				if (shouldCacheSource(it->second))
-// 					addCachedMemory(it->second);
-// 				memory_load =
-// 					(float)(memory_in_use_without_cache + current_cached_size) / (float)totalMeory * 100;
-// 				it++;
-// 			}
-// 		}
-// 		std::this_thread::sleep_for(std::chrono::milliseconds(500));
-// 	}
-// #endif
+	// Single worker for all media sources: processes cache events in the order
+	// they become due and samples the system memory load in between.
+	const auto pressureInterval = std::chrono::milliseconds(500);
+	auto       nextPressureCheck = std::chrono::steady_clock::now();
+
+	std::unique_lock<std::mutex> ulock(watcher.mtx);
+	while (!watcher.stop) {
+		auto now = std::chrono::steady_clock::now();
+
+		if (now >= nextPressureCheck) {
+			nextPressureCheck = now + pressureInterval;
+			ulock.unlock();
+			uint32_t load = 0;
+			if (getMemoryLoad(load))
+				relieveMemoryPressure(load);
+			ulock.lock();
+			continue;
+		}
+
+		if (!watcher.events.empty() && watcher.events.begin()->first <= now) {
+			event ev = watcher.events.begin()->second;
+			watcher.events.erase(watcher.events.begin());
+			if (ev.type == event_type::Update)
+				watcher.pending.erase(ev.source);
+
+			ulock.unlock();
+			processEvent(ev);
+			ulock.lock();
+			continue;
+		}
+
+		auto wake = nextPressureCheck;
+		if (!watcher.events.empty())
+			wake = std::min(wake, watcher.events.begin()->first);
+		watcher.cv.wait_until(ulock, wake);
+	}
+}
+
+void MemoryManager::GetCacheStats(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	MemoryManager& mm        = MemoryManager::GetInstance();
+	uint64_t       coalesced = 0;
+	{
+		std::unique_lock<std::mutex> wlock(mm.watcher.mtx);
+		coalesced = mm.metrics.coalesced;
+	}
+
+	std::unique_lock<std::mutex> ulock(mm.mtx);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(mm.allowed_cached_size));
+	rval.push_back(ipc::value(mm.current_cached_size));
+	rval.push_back(ipc::value(mm.metrics.memoryLoad));
+	rval.push_back(ipc::value((uint32_t)mm.sources.size()));
+	rval.push_back(ipc::value((uint32_t)mm.lru.size()));
+	rval.push_back(ipc::value(mm.metrics.events));
+	rval.push_back(ipc::value(coalesced));
+	rval.push_back(ipc::value(mm.metrics.cached));
+	rval.push_back(ipc::value(mm.metrics.uncached));
+	rval.push_back(ipc::value(mm.metrics.evicted));
+	rval.push_back(ipc::value(mm.metrics.pressure));
+	rval.push_back(ipc::value(mm.metrics.rejected));
+	AUTO_DEBUG;
 }
@@ -22,6 +22,10 @@
 #include <map>
 #include <mutex>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <set>
 #include <vector>
 #include <thread>
 #include <shared.hpp>
@@ -41,9 +45,10 @@ struct source_info
 	bool          cached;
 	uint64_t      size;
 	obs_source_t* source;
-	std::vector<std::thread> workers;
-	std::mutex    mtx;
 	bool          have_video;
+
+	// Position in the LRU list, only valid while the source is cached
+	std::list<source_info*>::iterator lru;
 };
 
 class MemoryManager {
@@ -62,7 +67,23 @@ class MemoryManager {
 	void operator=(MemoryManager const&) = delete;
 
 	private:
-	std::map<const char*, source_info*> sources;
+	enum class event_type
+	{
+		Update,
+		SizeRetry,
+		PlayingRetry
+	};
+
+	struct event
+	{
+		event_type    type;
+		obs_source_t* source;
+		uint32_t      retry;
+	};
+
+	std::map<obs_source_t*, source_info*> sources;
+	// Cached sources, most recently used first
+	std::list<source_info*> lru;
 
 	std::mutex mtx;
 	uint64_t   available_memory;
@@ -71,11 +92,36 @@ class MemoryManager {
 
 	struct
 	{
-		std::thread worker;
-		bool        stop = false;
-		bool        running = false;
+		std::thread             worker;
+		// Serializes starting and stopping the worker, never taken by the worker itself
+		std::mutex              lifecycle;
+		std::mutex              mtx;
+		std::condition_variable cv;
+		// Pending events ordered by the time they are due
+		std::multimap<std::chrono::steady_clock::time_point, event> events;
+		// Sources with an Update already queued, further updates are coalesced
+		std::set<obs_source_t*> pending;
+		bool                    stop    = false;
+		bool                    running = false;
 	} watcher;
 
+	struct
+	{
+		uint64_t events     = 0;
+		// Guarded by watcher.mtx, everything else by mtx
+		uint64_t coalesced  = 0;
+		uint64_t cached     = 0;
+		uint64_t uncached   = 0;
+		uint64_t evicted    = 0;
+		uint64_t pressure   = 0;
+		uint64_t rejected   = 0;
+		uint32_t memoryLoad = 0;
+	} metrics;
+
+	// Set once sources were evicted because of memory pressure, they are
+	// reconsidered when the system load drops below LOWER_LIMIT
+	bool throttled = false;
+
 	public:
 	void registerSource(obs_source_t* source);
 	void unregisterSource(obs_source_t* source);
@@ -83,14 +129,25 @@ class MemoryManager {
 	void updateSourceCache(obs_source_t* source);
 	void updateSourcesCache(void);
 
+	static void GetCacheStats(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
+
 	private:
 	void calculateRawSize(source_info* si);
 	bool shouldCacheSource(source_info* si);
 	void updateSettings(obs_source_t* source);
 
-	void addCachedMemory(source_info* si);
+	bool addCachedMemory(source_info* si, uint32_t retry);
 	void removeCachedMemory(source_info* si, bool cacheNewFiles);
+	bool makeRoom(source_info* si);
 
-	void sourceManager(source_info* si);
+	void pushEvent(event_type type, obs_source_t* source, uint32_t retry, std::chrono::milliseconds delay);
+	void processEvent(const event& ev);
+	void sourceManager(source_info* si, uint32_t retry);
 	void monitorMemory(void);
+	bool getMemoryLoad(uint32_t& load);
+	void relieveMemoryPressure(uint32_t load);
 };
@@ -17,6 +17,10 @@
 ******************************************************************************/
 
 #include "nodeobs_api.h"
+#include "disk-replay-buffer.h"
+#include "encoder-registry.h"
+#include "hotkey-registry.h"
+#include "nodeobs_settings.h"
 #include "osn-source.hpp"
 #include "osn-scene.hpp"
 #include "osn-sceneitem.hpp"
@@ -25,8 +29,11 @@
 #include "osn-filter.hpp"
 #include "osn-volmeter.hpp"
 #include "osn-fader.hpp"
+#include "osn-global.hpp"
 #include "nodeobs_autoconfig.h"
 #include "util/lexer.h"
+#include "util/profiler.h"
+#include "util-callstats.h"
 #include "util-crashmanager.h"
 #include "util-metricsprovider.h"
 
@@ -79,6 +86,7 @@
 #include "error.hpp"
 #include "shared.hpp"
 
+#include <algorithm>
 #include <fstream>
 
 #define BUFFSIZE 512
@@ -125,15 +133,23 @@ void OBS_API::Register(ipc::server& srv)
 	    std::make_shared<ipc::function>("OBS_API_destroyOBS_API", std::vector<ipc::type>{}, OBS_API_destroyOBS_API));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_API_getPerformanceStatistics", std::vector<ipc::type>{}, OBS_API_getPerformanceStatistics));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_API_setProfilingEnabled", std::vector<ipc::type>{ipc::type::Int32}, OBS_API_setProfilingEnabled));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_API_getPerformanceSnapshot", std::vector<ipc::type>{}, OBS_API_getPerformanceSnapshot));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "SetWorkingDirectory", std::vector<ipc::type>{ipc::type::String}, SetWorkingDirectory));
 	cls->register_function(
 	    std::make_shared<ipc::function>("StopCrashHandler", std::vector<ipc::type>{}, StopCrashHandler));
 	cls->register_function(std::make_shared<ipc::function>("OBS_API_QueryHotkeys", std::vector<ipc::type>{}, QueryHotkeys));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_API_QueryHotkeysSince", std::vector<ipc::type>{ipc::type::UInt64}, QueryHotkeysSince));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_API_ProcessHotkeyStatus",
 	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32},
 	    ProcessHotkeyStatus));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_API_ProcessHotkeyStatusBatch", std::vector<ipc::type>{ipc::type::Binary}, ProcessHotkeyStatusBatch));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "SetUsername", std::vector<ipc::type>{ipc::type::String}, SetUsername));
 
@@ -165,6 +181,24 @@ void OBS_API::SetWorkingDirectory(
 	AUTO_DEBUG;
 }
 
+static HotkeyRegistry hotkeyRegistry;
+
+static void hotkeys_changed_cb(void* data, calldata_t* cd)
+{
+	hotkeyRegistry.MarkDirty();
+}
+
+static void connectHotkeySignals(bool connect)
+{
+	signal_handler_t* sh = obs_get_signal_handler();
+	for (const char* signal : {"hotkey_register", "hotkey_unregister", "source_rename"}) {
+		if (connect)
+			signal_handler_connect(sh, signal, hotkeys_changed_cb, nullptr);
+		else
+			signal_handler_disconnect(sh, signal, hotkeys_changed_cb, nullptr);
+	}
+}
+
 #ifdef _WIN32
 static void SetPrivilegeForGPUPriority(void)
 {
@@ -750,22 +784,25 @@ void OBS_API::OBS_API_initAPI(
 		}
    }
 
-#ifdef WIN32
-	// Register the pre and post server callbacks to log the data into the crashmanager
-	g_server->set_pre_callback([](std::string cname, std::string fname, const std::vector<ipc::value>& args, void* data)
-	{ 
-		util::CrashManager& crashManager = *static_cast<util::CrashManager*>(data);
-		crashManager.ProcessPreServerCall(cname, fname, args);
+#endif
 
-	}, &crashManager);
-	g_server->set_post_callback([](std::string cname, std::string fname, const std::vector<ipc::value>& args, void* data)
+	// Register the pre and post server callbacks to collect per call statistics and log the
+	// data into the crashmanager
+	g_server->set_pre_callback([](std::string cname, std::string fname, const std::vector<ipc::value>& args, void* data)
 	{
-		util::CrashManager& crashManager = *static_cast<util::CrashManager*>(data);
-		crashManager.ProcessPostServerCall(cname, fname, args);
-	}, &crashManager);
-
+		uint32_t call = util::CallStats::Intern(cname, fname);
+		util::CallStats::ProcessPreServerCall(call, args);
+#if defined(WIN32) && defined(ENABLE_CRASHREPORT)
+		util::CrashManager::ProcessPreServerCall(call, args);
 #endif
+	}, nullptr);
+	g_server->set_post_callback([](std::string cname, std::string fname, const std::vector<ipc::value>& args, void* data)
+	{
+		util::CallStats::ProcessPostServerCall(cname, fname, args);
+#if defined(WIN32) && defined(ENABLE_CRASHREPORT)
+		util::CrashManager::ProcessPostServerCall(cname, fname, args);
 #endif
+	}, nullptr);
 
 #ifdef WIN32
 	// Connect the metrics provider with our crash handler process, sending our current version tag
@@ -838,6 +875,7 @@ void OBS_API::OBS_API_initAPI(
 #endif
 
 	osn::Source::initialize_global_signals();
+	connectHotkeySignals(true);
 
 	cpuUsageInfo = os_cpu_usage_info_start();
 	ConfigManager::getInstance().setAppdataPath(appdata);
@@ -862,6 +900,10 @@ void OBS_API::OBS_API_initAPI(
 #endif
 	}
 
+	DiskReplayBuffer::Register();
+	InitAudioBitrateTable();
+	osn::Global::BuildTypeCatalog();
+
 	OBS_service::createService();
 	OBS_service::createStreamingOutput();
 	OBS_service::createRecordingOutput();
@@ -918,6 +960,7 @@ void OBS_API::OBS_API_destroyOBS_API(
 	//  osn::Source::Manager.
 	osn::Source::finalize_global_signals();
 	/* END INJECT osn::Source::Manager */
+	connectHotkeySignals(false);
 	destroyOBS_API();
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -950,23 +993,135 @@ void OBS_API::OBS_API_getPerformanceStatistics(
 	AUTO_DEBUG;
 }
 
-void OBS_API::QueryHotkeys(
+static bool profilingEnabled = false;
+
+void OBS_API::OBS_API_setProfilingEnabled(
     void*                          data,
     const int64_t                  id,
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	struct HotkeyInfo
-	{
-		std::string                objectName;
-		obs_hotkey_registerer_type objectType;
-		std::string                hotkeyName;
-		std::string                hotkeyDesc;
-		obs_hotkey_id              hotkeyId;
-	};
+	bool enable = !!args[0].value_union.i32;
+	if (enable != profilingEnabled) {
+		if (enable)
+			profiler_start();
+		else
+			profiler_stop();
+		profilingEnabled = enable;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+template<typename T>
+static void WriteSnapshotValue(std::vector<char>& buffer, T value)
+{
+	size_t offset = buffer.size();
+	buffer.resize(offset + sizeof(T));
+	memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+static void WriteSnapshotOutput(std::vector<char>& buffer, uint8_t kind, obs_output_t* output)
+{
+	WriteSnapshotValue<uint8_t>(buffer, kind);
+	WriteSnapshotValue<uint8_t>(buffer, output && obs_output_active(output));
+	WriteSnapshotValue<int32_t>(buffer, output ? obs_output_get_total_frames(output) : 0);
+	WriteSnapshotValue<int32_t>(buffer, output ? obs_output_get_frames_dropped(output) : 0);
+	WriteSnapshotValue<float>(buffer, output ? obs_output_get_congestion(output) : 0.0f);
+	WriteSnapshotValue<uint64_t>(buffer, output ? obs_output_get_total_bytes(output) : 0);
+}
+
+struct SnapshotEntries
+{
+	std::vector<char>* buffer;
+	uint16_t           depth;
+	uint32_t           count;
+};
+
+static bool WriteSnapshotEntry(void* data, profiler_snapshot_entry_t* entry)
+{
+	SnapshotEntries* entries = static_cast<SnapshotEntries*>(data);
+
+	const char* name   = profiler_snapshot_entry_name(entry);
+	uint16_t    length = name ? uint16_t(std::min<size_t>(strlen(name), UINT16_MAX)) : 0;
+
+	// Times are bucketed per microsecond, keep the sum so consumers can diff two
+	// snapshots and get the average over the interval
+	uint64_t                 sum   = 0;
+	profiler_time_entries_t* times = profiler_snapshot_entry_times(entry);
+	for (size_t i = 0; times && i < times->num; i++)
+		sum += times->array[i].time_delta * times->array[i].count;
+
+	WriteSnapshotValue<uint16_t>(*entries->buffer, entries->depth);
+	WriteSnapshotValue<uint16_t>(*entries->buffer, length);
+	entries->buffer->insert(entries->buffer->end(), name, name + length);
+	WriteSnapshotValue<uint64_t>(*entries->buffer, profiler_snapshot_entry_overall_count(entry));
+	WriteSnapshotValue<uint64_t>(*entries->buffer, sum);
+	WriteSnapshotValue<uint64_t>(*entries->buffer, profiler_snapshot_entry_min_time(entry));
+	WriteSnapshotValue<uint64_t>(*entries->buffer, profiler_snapshot_entry_max_time(entry));
+	entries->count++;
+
+	SnapshotEntries children = {entries->buffer, uint16_t(entries->depth + 1), 0};
+	profiler_snapshot_entry_enumerate_children(entry, WriteSnapshotEntry, &children);
+	entries->count += children.count;
+	return true;
+}
+
+/* Snapshot layout, little endian and tightly packed:
+ *  uint32 version, uint64 timestamp (ns), uint8 profiling enabled
+ *  uint32 rendered frames, uint32 lagged frames (render thread missed its deadline)
+ *  uint32 video frames, uint32 skipped frames (encoders could not keep up)
+ *  uint32 output count, per output:
+ *    uint8 kind (0 stream, 1 recording, 2 replay buffer), uint8 active,
+ *    int32 total frames, int32 dropped frames (network), float congestion, uint64 total bytes
+ *  uint32 entry count, per profiler entry in depth-first order:
+ *    uint16 depth, uint16 name length, char[] name,
+ *    uint64 calls, uint64 total time (us), uint64 min time (us), uint64 max time (us)
+ */
+void OBS_API::OBS_API_getPerformanceSnapshot(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	const uint32_t    version = 1;
+	std::vector<char> buffer;
+	buffer.reserve(4096);
+
+	WriteSnapshotValue<uint32_t>(buffer, version);
+	WriteSnapshotValue<uint64_t>(buffer, os_gettime_ns());
+	WriteSnapshotValue<uint8_t>(buffer, profilingEnabled);
+
+	video_t* video = obs_get_video();
+	WriteSnapshotValue<uint32_t>(buffer, obs_get_total_frames());
+	WriteSnapshotValue<uint32_t>(buffer, obs_get_lagged_frames());
+	WriteSnapshotValue<uint32_t>(buffer, video ? video_output_get_total_frames(video) : 0);
+	WriteSnapshotValue<uint32_t>(buffer, video ? video_output_get_skipped_frames(video) : 0);
+
+	WriteSnapshotValue<uint32_t>(buffer, 3);
+	WriteSnapshotOutput(buffer, 0, OBS_service::getStreamingOutput());
+	WriteSnapshotOutput(buffer, 1, OBS_service::getRecordingOutput());
+	WriteSnapshotOutput(buffer, 2, OBS_service::getReplayBufferOutput());
+
+	size_t countOffset = buffer.size();
+	WriteSnapshotValue<uint32_t>(buffer, 0);
+	if (profilingEnabled) {
+		profiler_snapshot_t* snapshot = profile_snapshot_create();
+		SnapshotEntries      entries  = {&buffer, 0, 0};
+		profiler_snapshot_enumerate_roots(snapshot, WriteSnapshotEntry, &entries);
+		profile_snapshot_free(snapshot);
+		memcpy(buffer.data() + countOffset, &entries.count, sizeof(uint32_t));
+	}
 
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(buffer));
+	AUTO_DEBUG;
+}
+
+static void enumHotkeys(std::vector<HotkeyRegistry::Hotkey>& hotkeys)
+{
 	// For each registered hotkey
-	std::vector<HotkeyInfo> hotkeyInfos;
 	obs_enum_hotkeys(
 	    [](void* data, obs_hotkey_id id, obs_hotkey_t* key) {
 		    // Make sure every word has an initial capital letter
@@ -979,10 +1134,10 @@ void OBS_API::QueryHotkeys(
 			    }
 			    return s;
 		    };
-		    std::vector<HotkeyInfo>& hotkeyInfos     = *static_cast<std::vector<HotkeyInfo>*>(data);
+		    auto&                    hotkeyInfos     = *static_cast<std::vector<HotkeyRegistry::Hotkey>*>(data);
 		    auto                     registerer_type = obs_hotkey_get_registerer_type(key);
 		    void*                    registerer      = obs_hotkey_get_registerer(key);
-		    HotkeyInfo               currentHotkeyInfo;
+		    HotkeyRegistry::Hotkey   currentHotkeyInfo = {};
 		    if (registerer == nullptr)
 			    return true;
 
@@ -1055,23 +1210,76 @@ void OBS_API::QueryHotkeys(
 
 		    currentHotkeyInfo.hotkeyName = key_name;
 		    currentHotkeyInfo.hotkeyDesc = desc;
-		    currentHotkeyInfo.hotkeyId   = hotkeyId;
+		    currentHotkeyInfo.id         = hotkeyId;
 		    hotkeyInfos.push_back(currentHotkeyInfo);
 
 		    return true;
 	    },
-	    &hotkeyInfos);
+	    &hotkeys);
+}
+
+// Enumerates the hotkeys again only if one was registered, unregistered or renamed since the last time
+static void refreshHotkeys(bool force)
+{
+	if (!hotkeyRegistry.ConsumeDirty() && !force)
+		return;
+
+	std::vector<HotkeyRegistry::Hotkey> hotkeys;
+	enumHotkeys(hotkeys);
+	hotkeyRegistry.Update(std::move(hotkeys));
+}
+
+static void pushHotkey(std::vector<ipc::value>& rval, const HotkeyRegistry::Hotkey& hotkey)
+{
+	rval.push_back(ipc::value(hotkey.objectName));
+	rval.push_back(ipc::value(hotkey.objectType));
+	rval.push_back(ipc::value(hotkey.hotkeyName));
+	rval.push_back(ipc::value(hotkey.hotkeyDesc));
+	rval.push_back(ipc::value(hotkey.id));
+}
+
+void OBS_API::QueryHotkeys(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Descriptions can change without a signal, the full query stays authoritative
+	refreshHotkeys(true);
+
+	HotkeyRegistry::Delta delta;
+	hotkeyRegistry.Since(0, delta);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 
 	// For each hotkey that we've found
-	for (auto& hotkeyInfo : hotkeyInfos) {
-		rval.push_back(ipc::value(hotkeyInfo.objectName));
-		rval.push_back(ipc::value(uint32_t(hotkeyInfo.objectType)));
-		rval.push_back(ipc::value(hotkeyInfo.hotkeyName));
-		rval.push_back(ipc::value(hotkeyInfo.hotkeyDesc));
-		rval.push_back(ipc::value(uint64_t(hotkeyInfo.hotkeyId)));
-	}
+	for (auto& hotkey : delta.changed)
+		pushHotkey(rval, hotkey);
+
+	AUTO_DEBUG;
+}
+
+void OBS_API::QueryHotkeysSince(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Only registrations, removals and renames mark the list dirty. A plugin that changes a
+	// description without a signal is only seen by the next full QueryHotkeys.
+	refreshHotkeys(false);
+
+	HotkeyRegistry::Delta delta;
+	hotkeyRegistry.Since(args[0].value_union.ui64, delta);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(delta.version));
+	rval.push_back(ipc::value((uint32_t)delta.full));
+	rval.push_back(ipc::value((uint64_t)delta.changed.size()));
+	for (auto& hotkey : delta.changed)
+		pushHotkey(rval, hotkey);
+	for (auto removed : delta.removed)
+		rval.push_back(ipc::value(removed));
 
 	AUTO_DEBUG;
 }
@@ -1093,6 +1301,27 @@ void OBS_API::ProcessHotkeyStatus(
 	AUTO_DEBUG;
 }
 
+void OBS_API::ProcessHotkeyStatusBatch(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Pairs of hotkey id and pressed state, both as uint64_t
+	const std::vector<char>& batch = args[0].value_bin;
+	size_t                   count = batch.size() / (2 * sizeof(uint64_t));
+
+	for (size_t idx = 0; idx < count; idx++) {
+		uint64_t pair[2];
+		memcpy(pair, batch.data() + idx * sizeof(pair), sizeof(pair));
+		obs_hotkey_trigger_routed_callback((obs_hotkey_id)pair[0], pair[1] != 0);
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+
+	AUTO_DEBUG;
+}
+
 void OBS_API::SetUsername(
     void*                          data,
     const int64_t                  id,
@@ -1453,13 +1682,16 @@ void OBS_API::destroyOBS_API(void)
 
 	OBS_service::stopAllOutputs();
 	OBS_service::waitReleaseWorker();
+	OBS_service::releaseStreamingDestinations();
+	OBS_service::releaseRecordingSegments();
 
 	obs_encoder_t* streamingEncoder = OBS_service::getStreamingEncoder();
 	if (streamingEncoder != NULL)
 		obs_encoder_release(streamingEncoder);
 
+	// Holds its own reference, also when it is the shared stream encoder
 	obs_encoder_t* recordingEncoder = OBS_service::getRecordingEncoder();
-	if (recordingEncoder != NULL && (OBS_service::useRecordingPreset() || obs_get_multiple_rendering()))
+	if (recordingEncoder != NULL)
 		obs_encoder_release(recordingEncoder);
 
 	obs_encoder_t* audioStreamingEncoder = OBS_service::getAudioSimpleStreamingEncoder();
@@ -1467,13 +1699,21 @@ void OBS_API::destroyOBS_API(void)
 		obs_encoder_release(audioStreamingEncoder);
 
 	obs_encoder_t* audioRecordingEncoder = OBS_service::getAudioSimpleRecordingEncoder();
-	if (audioRecordingEncoder != NULL && (OBS_service::useRecordingPreset() || obs_get_multiple_rendering()))
+	if (audioRecordingEncoder != NULL)
 		obs_encoder_release(audioRecordingEncoder);
 
 	obs_encoder_t* archiveEncoder = OBS_service::getArchiveEncoder();
 	if (archiveEncoder != NULL)
 		obs_encoder_release(archiveEncoder);
 
+	EncoderRegistry::Clear();
+	OBS_settings::releaseDevices();
+	hotkeyRegistry.Clear();
+	osn::Global::ClearTypeCatalog();
+	osn::Transition::ClearPreparations();
+	osn::Source::ClearMediaStates();
+	osn::Scene::ClearConnections();
+
 	obs_output_t* streamingOutput = OBS_service::getStreamingOutput();
 	if (streamingOutput != NULL)
 		obs_output_release(streamingOutput);
@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "nodeobs_audio_encoders.h"
+#include "audio-bitrate-table.h"
 
 static const std::string encoders[] = {
     "ffmpeg_aac",
@@ -46,19 +47,16 @@ static const char* EncoderName(const char* id)
 	return NullToEmpty(obs_encoder_get_display_name(id));
 }
 
-static std::map<int, const char*> bitrateMap;
-static std::string                channelSetup;
-
-static void HandleIntProperty(obs_property_t* prop, const char* id)
+static void HandleIntProperty(obs_property_t* prop, AudioBitrateTable::Bitrates& bitrates)
 {
 	const int max_ = obs_property_int_max(prop);
 	const int step = obs_property_int_step(prop);
 
 	for (int i = obs_property_int_min(prop); i <= max_; i += step)
-		bitrateMap[i] = id;
+		bitrates.push_back(i);
 }
 
-static void HandleListProperty(obs_property_t* prop, const char* id)
+static void HandleListProperty(obs_property_t* prop, const char* id, AudioBitrateTable::Bitrates& bitrates)
 {
 	obs_combo_format format = obs_property_list_format(prop);
 	if (format != OBS_COMBO_FORMAT_INT) {
@@ -78,12 +76,11 @@ static void HandleListProperty(obs_property_t* prop, const char* id)
 		if (obs_property_list_item_disabled(prop, i))
 			continue;
 
-		int bitrate         = static_cast<int>(obs_property_list_item_int(prop, i));
-		bitrateMap[bitrate] = id;
+		bitrates.push_back(static_cast<int>(obs_property_list_item_int(prop, i)));
 	}
 }
 
-static void HandleSampleRate(obs_property_t* prop, const char* id)
+static void HandleSampleRate(obs_property_t* prop, const char* id, uint32_t sampleRate)
 {
 	auto                                               ReleaseData = [](obs_data_t* data) { obs_data_release(data); };
 	std::unique_ptr<obs_data_t, decltype(ReleaseData)> data{obs_encoder_defaults(id), ReleaseData};
@@ -98,15 +95,12 @@ static void HandleSampleRate(obs_property_t* prop, const char* id)
 		return;
 	}
 
-	uint64_t sampleRate = config_get_uint(ConfigManager::getInstance().getBasic(), "Audio",
-			"SampleRate");
-
 	obs_data_set_int(data.get(), "samplerate", sampleRate);
 
 	obs_property_modified(prop, data.get());
 }
 
-static void HandleEncoderProperties(const char* id)
+static bool HandleEncoderProperties(const char* id, uint32_t sampleRate, AudioBitrateTable::Bitrates& bitrates)
 {
 	auto DestroyProperties = [](obs_properties_t* props) { obs_properties_destroy(props); };
 	std::unique_ptr<obs_properties_t, decltype(DestroyProperties)> props{obs_get_encoder_properties(id),
@@ -119,22 +113,24 @@ static void HandleEncoderProperties(const char* id)
 		    "'%s' (%s)",
 		    EncoderName(id),
 		    id);
-		return;
+		return false;
 	}
 
 	obs_property_t* samplerate = obs_properties_get(props.get(), "samplerate");
 	if (samplerate)
-		HandleSampleRate(samplerate, id);
+		HandleSampleRate(samplerate, id, sampleRate);
 
 	obs_property_t* bitrate = obs_properties_get(props.get(), "bitrate");
 
 	obs_property_type type = obs_property_get_type(bitrate);
 	switch (type) {
 	case OBS_PROPERTY_INT:
-		return HandleIntProperty(bitrate, id);
+		HandleIntProperty(bitrate, bitrates);
+		return true;
 
 	case OBS_PROPERTY_LIST:
-		return HandleListProperty(bitrate, id);
+		HandleListProperty(bitrate, id, bitrates);
+		return true;
 
 	default:
 		break;
@@ -147,6 +143,7 @@ static void HandleEncoderProperties(const char* id)
 	    EncoderName(id),
 	    id,
 	    static_cast<int>(type));
+	return false;
 }
 
 static const char* GetCodec(const char* id)
@@ -171,85 +168,211 @@ bool IsSurround(const char* channelSetup)
 	return false;
 }
 
-void LimitBitrate(std::map<int, const char*>& values, int maximumBitrate)
+static bool EnumerateBitrates(
+    const std::string&           encoderId,
+    const std::string&           layout,
+    uint32_t                     sampleRate,
+    AudioBitrateTable::Bitrates& bitrates)
 {
-	auto condition = [=](const std::pair<int, const char*>& p) { return p.first > maximumBitrate; };
+	// A corrupted encoder dll will fail when requesting it's properties here by
+	// calling "obs_get_encoder_properties", this try-catch block will make sure
+	// that this encoder won't be used. A good solution would be checking this
+	// when starting obs (checking if every encoder/module is valid) and/or
+	// showing the user why the encoder why disabled (invalid version, need to
+	// update, etc)
+	try {
+		if (!HandleEncoderProperties(encoderId.c_str(), sampleRate, bitrates))
+			return false;
+	} catch (...) {
+		return false;
+	}
+
+	// Limit the bitrate to 320 if not surround
+	if (!IsSurround(layout.c_str())) {
+		auto limited = std::remove_if(bitrates.begin(), bitrates.end(), [](int bitrate) { return bitrate > 320; });
+		bitrates.erase(limited, bitrates.end());
+	}
 
-	for (auto i = values.begin(); (i = std::find_if(i, values.end(), condition)) != values.end(); values.erase(i++))
-		;
+	std::sort(bitrates.begin(), bitrates.end());
+	bitrates.erase(std::unique(bitrates.begin(), bitrates.end()), bitrates.end());
+	return true;
+}
+
+static AudioBitrateTable& GetBitrateTable()
+{
+	static AudioBitrateTable table(EnumerateBitrates);
+	return table;
 }
 
+// Bumped when the way bitrates are enumerated changes, so saved tables get recomputed
+static const int64_t bitrateTableVersion = 2;
+
 static const std::string aac_ = "AAC";
-static void              PopulateBitrateMap()
+
+// Encoders in the order the bitrate map was always built: the fallback first, then any other
+// AAC encoder, then the known ones. A later encoder replaces an earlier one for a bitrate.
+static std::vector<std::string> GetAACEncoders()
 {
-	// Get the current channel setup and check if it changed, if that is the case the bitrate map could need an update
-	auto currentChannelSetup =
-	    std::string(std::string(config_get_string(ConfigManager::getInstance().getBasic(), "Audio", "ChannelSetup")));
-
-	if (currentChannelSetup != channelSetup) {
-		channelSetup = currentChannelSetup;
-		bitrateMap.clear();
-
-		HandleEncoderProperties(fallbackEncoder.c_str());
-
-		const char* id = nullptr;
-		for (size_t i = 0; obs_enum_encoder_types(i, &id); i++) {
-			auto Compare = [=](const std::string& val) { return val == NullToEmpty(id); };
-
-			if (find_if(begin(encoders), end(encoders), Compare) != end(encoders))
-				continue;
-
-			if (aac_ != GetCodec(NullToEmpty(id)))
-				continue;
-
-			// A corrupted encoder dll will fail when requesting it's properties here by
-			// calling "obs_get_encoder_properties", this try-catch block will make sure
-			// that this encoder won't be used. A good solution would be checking this
-			// when starting obs (checking if every encoder/module is valid) and/or
-			// showing the user why the encoder why disabled (invalid version, need to
-			// update, etc)
-			try {
-				HandleEncoderProperties(id);
-			} catch (...) {
-				continue;
-			}
-		}
+	std::vector<std::string> aacEncoders = {fallbackEncoder};
+
+	const char* id = nullptr;
+	for (size_t i = 0; obs_enum_encoder_types(i, &id); i++) {
+		auto Compare = [=](const std::string& val) { return val == NullToEmpty(id); };
+
+		if (find_if(begin(encoders), end(encoders), Compare) != end(encoders))
+			continue;
+
+		if (aac_ != GetCodec(NullToEmpty(id)))
+			continue;
+
+		aacEncoders.push_back(id);
+	}
+
+	for (auto& encoder : encoders) {
+		if (encoder == fallbackEncoder)
+			continue;
+
+		if (aac_ != GetCodec(encoder.c_str()))
+			continue;
+
+		aacEncoders.push_back(encoder);
+	}
+
+	return aacEncoders;
+}
+
+// Changes whenever libobs or the set of encoder plugins does
+static std::string GetEncoderFingerprint()
+{
+	std::vector<std::string> types;
+	const char*              id = nullptr;
+	for (size_t i = 0; obs_enum_encoder_types(i, &id); i++)
+		types.push_back(std::string(NullToEmpty(id)) + ":" + GetCodec(NullToEmpty(id)));
+	std::sort(types.begin(), types.end());
+
+	std::string fingerprint = NullToEmpty(obs_get_version_string());
+	for (auto& type : types)
+		fingerprint += ";" + type;
+	return fingerprint;
+}
 
-		for (auto& encoder : encoders) {
-			if (encoder == fallbackEncoder)
-				continue;
+static std::mutex bitrateTableMutex;
+static bool       bitrateTablePrepared = false;
+static uint64_t   bitrateTableSavedRevision = 0;
 
-			if (aac_ != GetCodec(encoder.c_str()))
-				continue;
+static void LoadBitrateTable(AudioBitrateTable& table)
+{
+	obs_data_t* data =
+	    obs_data_create_from_json_file_safe(ConfigManager::getInstance().getAudioBitrates().c_str(), "bak");
+	if (!data)
+		return;
 
-			HandleEncoderProperties(encoder.c_str());
+	if (obs_data_get_int(data, "version") == bitrateTableVersion
+	    && table.GetFingerprint() == obs_data_get_string(data, "fingerprint")) {
+		obs_data_array_t* entries = obs_data_get_array(data, "entries");
+		size_t            count   = obs_data_array_count(entries);
+		for (size_t idx = 0; idx < count; idx++) {
+			obs_data_t*              item  = obs_data_array_item(entries, idx);
+			AudioBitrateTable::Entry entry = {};
+			entry.encoderId                = obs_data_get_string(item, "encoder");
+			entry.layout                   = obs_data_get_string(item, "layout");
+			entry.sampleRate               = uint32_t(obs_data_get_int(item, "samplerate"));
+
+			std::istringstream bitrates(obs_data_get_string(item, "bitrates"));
+			for (std::string bitrate; std::getline(bitrates, bitrate, ',');)
+				entry.bitrates.push_back(atoi(bitrate.c_str()));
+
+			table.Insert(entry);
+			obs_data_release(item);
 		}
+		obs_data_array_release(entries);
+	}
+
+	obs_data_release(data);
+}
+
+static void SaveBitrateTable(AudioBitrateTable& table)
+{
+	obs_data_t*       data    = obs_data_create();
+	obs_data_array_t* entries = obs_data_array_create();
+
+	for (auto& entry : table.GetEntries()) {
+		std::ostringstream bitrates;
+		for (size_t idx = 0; idx < entry.bitrates.size(); idx++)
+			bitrates << (idx ? "," : "") << entry.bitrates[idx];
+
+		obs_data_t* item = obs_data_create();
+		obs_data_set_string(item, "encoder", entry.encoderId.c_str());
+		obs_data_set_string(item, "layout", entry.layout.c_str());
+		obs_data_set_int(item, "samplerate", entry.sampleRate);
+		obs_data_set_string(item, "bitrates", bitrates.str().c_str());
+		obs_data_array_push_back(entries, item);
+		obs_data_release(item);
+	}
+
+	obs_data_set_int(data, "version", bitrateTableVersion);
+	obs_data_set_string(data, "fingerprint", table.GetFingerprint().c_str());
+	obs_data_set_array(data, "entries", entries);
+
+	if (!obs_data_save_json_safe(data, ConfigManager::getInstance().getAudioBitrates().c_str(), "tmp", "bak"))
+		blog(LOG_WARNING, "Failed to save the audio encoder bitrate table");
+
+	obs_data_array_release(entries);
+	obs_data_release(data);
+}
+
+static void PrepareBitrateTable(void)
+{
+	std::unique_lock<std::mutex> ulock(bitrateTableMutex);
+	if (bitrateTablePrepared)
+		return;
+
+	AudioBitrateTable& table = GetBitrateTable();
+	table.SetEncoders(GetAACEncoders(), GetEncoderFingerprint());
+	LoadBitrateTable(table);
+	bitrateTableSavedRevision = table.GetRevision();
+	bitrateTablePrepared      = true;
+}
+
+void InitAudioBitrateTable(void)
+{
+	PrepareBitrateTable();
+	GetAACEncoderBitrateMap();
+}
+
+const std::map<int, const char*>& GetAACEncoderBitrateMap()
+{
+	PrepareBitrateTable();
+
+	config_t*   basic        = ConfigManager::getInstance().getBasic();
+	const char* channelSetup = NullToEmpty(config_get_string(basic, "Audio", "ChannelSetup"));
+	uint32_t    sampleRate   = uint32_t(config_get_uint(basic, "Audio", "SampleRate"));
+
+	AudioBitrateTable&                   table      = GetBitrateTable();
+	const AudioBitrateTable::BitrateMap& bitrateMap = table.GetBitrateMap(channelSetup, sampleRate);
+
+	// Only entries that weren't known yet had to be enumerated
+	std::unique_lock<std::mutex> ulock(bitrateTableMutex);
+	uint64_t                     revision = table.GetRevision();
+	if (revision != bitrateTableSavedRevision) {
+		bitrateTableSavedRevision = revision;
+		SaveBitrateTable(table);
 
 		if (bitrateMap.empty()) {
 			blog(
 			    LOG_ERROR,
 			    "Could not enumerate any AAC encoder "
 			    "bitrates");
-			return;
-		}
+		} else {
+			std::ostringstream ss;
+			for (auto& entry : bitrateMap)
+				ss << "\n	" << std::setw(3) << entry.first << " kbit/s: '" << EncoderName(entry.second) << "' ("
+				   << entry.second << ')';
 
-		// Limit the bitrate to 320 if not surround
-		if (!IsSurround(channelSetup.c_str())) {
-			LimitBitrate(bitrateMap, 320);
+			blog(LOG_DEBUG, "AAC encoder bitrate mapping:%s", ss.str().c_str());
 		}
-
-		std::ostringstream ss;
-		for (auto& entry : bitrateMap)
-			ss << "\n	" << std::setw(3) << entry.first << " kbit/s: '" << EncoderName(entry.second) << "' ("
-			   << entry.second << ')';
-
-		blog(LOG_DEBUG, "AAC encoder bitrate mapping:%s", ss.str().c_str());
 	}
-}
 
-const std::map<int, const char*>& GetAACEncoderBitrateMap()
-{
-	PopulateBitrateMap();
 	return bitrateMap;
 }
 
@@ -276,24 +399,12 @@ bool IsMultitrackAudioSupported(const char* format)
 int FindClosestAvailableAACBitrate(int bitrate)
 {
 	auto& map_ = GetAACEncoderBitrateMap();
-	int   prev = 0;
-	int   next = INVALID_BITRATE;
-
-	for (auto val : map_) {
-		if (next > val.first) {
-			if (val.first == bitrate)
-				return bitrate;
-
-			if (val.first < next && val.first > bitrate)
-				next = val.first;
-			if (val.first > prev && val.first < bitrate)
-				prev = val.first;
-		}
-	}
 
-	if (next != INVALID_BITRATE)
-		return next;
-	if (prev != 0)
-		return prev;
+	// The bitrate itself or the next one above it, else the closest one below
+	auto next = map_.lower_bound(bitrate);
+	if (next != end(map_) && next->first < INVALID_BITRATE)
+		return next->first;
+	if (next != begin(map_) && std::prev(next)->first > 0)
+		return std::prev(next)->first;
 	return 192;
 }
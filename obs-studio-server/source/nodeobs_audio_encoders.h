@@ -22,6 +22,8 @@
 
 #include "nodeobs_api.h"
 
+// Loads the saved bitrate table, or enumerates the encoders for the current audio settings
+void                              InitAudioBitrateTable(void);
 const std::map<int, const char*>& GetAACEncoderBitrateMap();
 const char*                       GetAACEncoderForBitrate(int bitrate);
 int                               FindClosestAvailableAACBitrate(int bitrate);
@@ -218,6 +218,21 @@ void OBS_content::Register(ipc::server& srv)
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::Int32},
 	    OBS_content_setDrawGuideLines));
 
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_content_setDisplayMaxFps",
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32},
+	    OBS_content_setDisplayMaxFps));
+
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_content_setDisplayOverlayCache",
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::Int32},
+	    OBS_content_setDisplayOverlayCache));
+
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_content_setDisplayPaused",
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::Int32},
+	    OBS_content_setDisplayPaused));
+
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_content_createIOSurface",
 	    std::vector<ipc::type>{ipc::type::String},
@@ -643,6 +658,60 @@ void OBS_content::OBS_content_setDrawGuideLines(
 	AUTO_DEBUG;
 }
 
+void OBS_content::OBS_content_setDisplayMaxFps(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Find Display
+	auto it = displays.find(args[0].value_str);
+	if (it == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Display key is not valid!"));
+		return;
+	}
+	it->second->SetMaxFps(args[1].value_union.ui32);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_content::OBS_content_setDisplayOverlayCache(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Find Display
+	auto it = displays.find(args[0].value_str);
+	if (it == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Display key is not valid!"));
+		return;
+	}
+	it->second->SetOverlayCache((bool)args[1].value_union.i32);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_content::OBS_content_setDisplayPaused(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Find Display
+	auto it = displays.find(args[0].value_str);
+	if (it == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Display key is not valid!"));
+		return;
+	}
+	it->second->SetPaused((bool)args[1].value_union.i32);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
 void OBS_content::OBS_content_createIOSurface(
     void*                          data,
     const int64_t                  id,
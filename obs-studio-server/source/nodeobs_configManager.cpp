@@ -138,6 +138,8 @@ void initBasicDefault(config_t* config)
 	config_set_default_int(config, "SimpleOutput", "RecRBTime", 20);
 	config_set_default_int(config, "SimpleOutput", "RecRBSize", 512);
 	config_set_default_string(config, "SimpleOutput", "RecRBPrefix", "Replay");
+	config_set_default_bool(config, "SimpleOutput", "RecRBDiskSpill", false);
+	config_set_default_uint(config, "SimpleOutput", "RecRBMemoryHead", 16);
 	config_set_default_bool(config, "SimpleOutput", "replayBufferUseStreamOutput", true);
 	config_set_default_string(config, "SimpleOutput", "Profile", "main");
 
@@ -189,6 +191,10 @@ void initBasicDefault(config_t* config)
 
 	config_set_default_string(config, "Output", "FilenameFormatting", "%CCYY-%MM-%DD %hh-%mm-%ss");
 
+	config_set_default_bool(config, "Output", "RecSplitFile", false);
+	config_set_default_uint(config, "Output", "RecSplitFileTime", 15);
+	config_set_default_uint(config, "Output", "RecSplitFileSize", 2048);
+
 	config_set_default_bool(config, "Output", "DelayEnable", false);
 	config_set_default_uint(config, "Output", "DelaySec", 20);
 	config_set_default_bool(config, "Output", "DelayPreserve", true);
@@ -199,6 +205,9 @@ void initBasicDefault(config_t* config)
 
 	config_set_default_string(config, "Output", "BindIP", "default");
 	config_set_default_bool(config, "Output", "DynamicBitrate", false);
+	config_set_default_bool(config, "Output", "AdaptiveBitrate", false);
+	config_set_default_uint(config, "Output", "AdaptiveBitrateMin", 500);
+	config_set_default_uint(config, "Output", "AdaptiveBitrateMax", 0);
 	config_set_default_bool(config, "Output", "NewSocketLoopEnable", false);
 	config_set_default_bool(config, "Output", "LowLatencyEnable", false);
 
@@ -315,3 +324,11 @@ std::string ConfigManager::getRecord()
 	return appdata + "/recordEncoder.json";
 #endif
 };
+std::string ConfigManager::getAudioBitrates()
+{
+#ifdef WIN32
+	return appdata + "\\audioBitrates.json";
+#else
+	return appdata + "/audioBitrates.json";
+#endif
+};
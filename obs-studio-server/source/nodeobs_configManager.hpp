@@ -50,5 +50,6 @@ public:
 	std::string getService();
 	std::string getStream();
 	std::string getRecord();
+	std::string getAudioBitrates();
 	void reloadConfig(void);
 };
\ No newline at end of file
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "nodeobs_display.h"
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <string>
@@ -31,6 +32,8 @@ std::vector<std::pair<std::string, std::pair<uint32_t, uint32_t>>> sourcesSize;
 extern std::string currentScene; /* defined in OBS_content.cpp */
 
 static const uint32_t grayPaddingArea = 10ul;
+// Vertices per frame for the selection overlay and for its labels, about 500 selected items
+static const uint32_t OverlayCapacity = 65535ul;
 std::mutex OBS::Display::m_displayMtx;
 
 static void RecalculateApectRatioConstrainedSize(
@@ -305,8 +308,11 @@ OBS::Display::Display()
 	*v.color = 0xFFFFFFFF;
 	m_boxTris->Update();
 
+	// Selection overlay
+	m_overlayVertices = std::make_unique<GS::VertexBuffer>(OverlayCapacity);
+
 	// Text
-	m_textVertices = new GS::VertexBuffer(65535);
+	m_textVertices = new GS::VertexBuffer(OverlayCapacity);
 	m_textEffect   = obs_get_base_effect(OBS_EFFECT_DEFAULT);
 	m_textTexture  = gs_texture_create_from_file((g_moduleDirectory + "/resources/roboto.png").c_str());
 	if (!m_textTexture) {
@@ -397,8 +403,18 @@ OBS::Display::~Display()
 		obs_leave_graphics();
 	}
 
-	m_boxLine = nullptr;
-	m_boxTris = nullptr;
+	WatchOverlayScene(nullptr);
+
+	m_boxLine         = nullptr;
+	m_boxTris         = nullptr;
+	m_overlayVertices = nullptr;
+
+	if (m_frameTexture || m_overlayTexture) {
+		obs_enter_graphics();
+		gs_texrender_destroy(m_frameTexture);
+		gs_texrender_destroy(m_overlayTexture);
+		obs_leave_graphics();
+	}
 
 	if (m_display)
 		obs_display_destroy(m_display);
@@ -634,209 +650,27 @@ void OBS::Display::SetResizeBoxInnerColor(uint8_t r, uint8_t g, uint8_t b, uint8
 	m_resizeInnerColor = a << 24 | b << 16 | g << 8 | r;
 }
 
-static void
-    DrawGlyph(GS::VertexBuffer* vb, float_t x, float_t y, float_t scale, float_t depth, char glyph, uint32_t color)
-{
-	float uvX = 0, uvY = 0, uvO = 1.0 / 4.0;
-	switch (glyph) {
-	default:
-		return;
-		break;
-	case '1':
-		uvX = 0;
-		uvY = 0;
-		break;
-	case '2':
-		uvX = uvO;
-		uvY = 0;
-		break;
-	case '3':
-		uvX = uvO * 2;
-		uvY = 0;
-		break;
-	case '4':
-		uvX = uvO * 3;
-		uvY = 0;
-		break;
-	case '5':
-		uvX = 0;
-		uvY = uvO * 1;
-		break;
-	case '6':
-		uvX = uvO;
-		uvY = uvO * 1;
-		break;
-	case '7':
-		uvX = uvO * 2;
-		uvY = uvO * 1;
-		break;
-	case '8':
-		uvX = uvO * 3;
-		uvY = uvO * 1;
-		break;
-	case '9':
-		uvX = 0;
-		uvY = uvO * 2;
-		break;
-	case '0':
-		uvX = uvO;
-		uvY = uvO * 2;
-		break;
-	case 'p':
-		uvX = uvO * 2;
-		uvY = uvO * 2;
-		break;
-	case 'x':
-		uvX = uvO * 3;
-		uvY = uvO * 2;
-		break;
-	}
-
-	GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
-	size_t     bs = vb->Size();
-	vb->Resize(uint32_t(bs + 6));
-
-	// Top Left
-	v = vb->At(uint32_t(bs + 0));
-	vec3_set(v.position, x, y, depth);
-	vec4_set(v.uv[0], uvX, uvY, 0, 0);
-	*v.color = color;
-	// Top Right
-	v = vb->At(uint32_t(bs + 1));
-	vec3_set(v.position, x + scale, y, depth);
-	vec4_set(v.uv[0], uvX + uvO, uvY, 0, 0);
-	*v.color = color;
-	// Bottom Left
-	v = vb->At(uint32_t(bs + 2));
-	vec3_set(v.position, x, y + scale * 2, depth);
-	vec4_set(v.uv[0], uvX, uvY + uvO, 0, 0);
-	*v.color = color;
-
-	// Top Right
-	v = vb->At(uint32_t(bs + 3));
-	vec3_set(v.position, x + scale, y, depth);
-	vec4_set(v.uv[0], uvX + uvO, uvY, 0, 0);
-	*v.color = color;
-	// Bottom Left
-	v = vb->At(uint32_t(bs + 4));
-	vec3_set(v.position, x, y + scale * 2, depth);
-	vec4_set(v.uv[0], uvX, uvY + uvO, 0, 0);
-	*v.color = color;
-	// Bottom Right
-	v = vb->At(uint32_t(bs + 5));
-	vec3_set(v.position, x + scale, y + scale * 2, depth);
-	vec4_set(v.uv[0], uvX + uvO, uvY + uvO, 0, 0);
-	*v.color = color;
-}
-
 #define HANDLE_RADIUS 5.0f
-#define HANDLE_DIAMETER 10.0f
 
 inline bool CloseFloat(float a, float b, float epsilon = 0.01)
 {
 	return abs(a - b) <= epsilon;
 }
 
-inline void DrawOutline(OBS::Display* dp, matrix4& mtx, obs_transform_info& info)
-{
-	gs_matrix_push();
-	gs_matrix_set(&mtx);
-	gs_draw(GS_LINESTRIP, 0, 0);
-	gs_matrix_pop();
-}
-
-inline void DrawBoxAt(OBS::Display* dp, float_t x, float_t y, matrix4& mtx)
-{
-	gs_matrix_push();
-
-	vec3 pos = {x, y, 0.0f};
-	vec3_transform(&pos, &pos, &mtx);
-
-	vec3 offset = {-HANDLE_RADIUS, -HANDLE_RADIUS, 0.0f};
-	offset.x *= dp->m_previewToWorldScale.x;
-	offset.y *= dp->m_previewToWorldScale.y;
-
-	gs_matrix_translate(&pos);
-	gs_matrix_translate(&offset);
-	gs_matrix_scale3f(
-	    HANDLE_DIAMETER * dp->m_previewToWorldScale.x,
-		HANDLE_DIAMETER * dp->m_previewToWorldScale.y,
-		1.0f);
-
-	gs_draw(GS_LINESTRIP, 0, 0);
-	gs_matrix_pop();
-}
-
-inline void DrawSquareAt(OBS::Display* dp, float_t x, float_t y, matrix4& mtx)
-{
-	gs_matrix_push();
-
-	vec3 pos = {x, y, 0.0f};
-	vec3_transform(&pos, &pos, &mtx);
-
-	vec3 offset = {-HANDLE_RADIUS, -HANDLE_RADIUS, 0.0f};
-	offset.x *= dp->m_previewToWorldScale.x;
-	offset.y *= dp->m_previewToWorldScale.y;
-
-	gs_matrix_translate(&pos);
-	gs_matrix_translate(&offset);
-	gs_matrix_scale3f(
-	    HANDLE_DIAMETER * dp->m_previewToWorldScale.x,
-		HANDLE_DIAMETER * dp->m_previewToWorldScale.y,
-		1.0f);
-
-	gs_draw(GS_TRISTRIP, 0, 0);
-	gs_matrix_pop();
-}
-
-inline void DrawGuideline(OBS::Display* dp, float_t x, float_t y, matrix4& mtx)
+static void UploadOverlayVertices(
+    GS::VertexBuffer*                     vb,
+    uint32_t                              offset,
+    const std::vector<GS::OverlayVertex>& vertices,
+    uint32_t                              count)
 {
-	gs_rect rect;
-	rect.x  = dp->GetPreviewOffset().first;
-	rect.y  = dp->GetPreviewOffset().second;
-	rect.cx = dp->GetPreviewSize().first;
-	rect.cy = dp->GetPreviewSize().second;
-
-	gs_set_scissor_rect(&rect);
-	gs_matrix_push();
-
-	vec3 center = {0.5, 0.5, 0.0f};
-	vec3_transform(&center, &center, &mtx);
-
-	vec3 pos = {x, y, 0.0f};
-	vec3_transform(&pos, &pos, &mtx);
-
-	vec3 normal;
-	vec3_sub(&normal, &center, &pos);
-	vec3_norm(&normal, &normal);
-
-	gs_matrix_translate(&pos);
-
-	vec3 up = {0, 1.0, 0};
-	vec3 dn = {0, -1.0, 0};
-	vec3 lt = {-1.0, 0, 0};
-	vec3 rt = {1.0, 0, 0};
-
-	if (vec3_dot(&up, &normal) > 0.5f) {
-		// Dominantly looking up.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(-90.0f));
-	} else if (vec3_dot(&dn, &normal) > 0.5f) {
-		// Dominantly looking down.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(90.0f));
-	} else if (vec3_dot(&lt, &normal) > 0.5f) {
-		// Dominantly looking left.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(0.0f));
-	} else if (vec3_dot(&rt, &normal) > 0.5f) {
-		// Dominantly looking right.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(180.0f));
+	vec3*     positions = vb->GetPositions() + offset;
+	uint32_t* colors    = vb->GetColors() + offset;
+	vec4*     uvs       = vb->GetUVLayer(0) + offset;
+	for (uint32_t n = 0; n < count; n++) {
+		vec3_set(&positions[n], vertices[n].x, vertices[n].y, 0);
+		vec4_set(&uvs[n], vertices[n].u, vertices[n].v, 0, 0);
+		colors[n] = vertices[n].color;
 	}
-
-	gs_matrix_scale3f(65535, 65535, 65535);
-
-	gs_draw(GS_LINES, 0, 2);
-
-	gs_matrix_pop();
-	gs_set_scissor_rect(nullptr);
 }
 
 bool OBS::Display::DrawSelectedSource(obs_scene_t* scene, obs_sceneitem_t* item, void* param)
@@ -849,12 +683,8 @@ bool OBS::Display::DrawSelectedSource(obs_scene_t* scene, obs_sceneitem_t* item,
 	uint32_t      flags       = obs_source_get_output_flags(itemSource);
 	bool          isOnlyAudio = (flags & OBS_SOURCE_VIDEO) == 0;
 
-	obs_source_t* sceneSource = obs_scene_get_source(scene);
-
-	uint32_t sceneWidth  = obs_source_get_width(sceneSource);
-	uint32_t sceneHeight = obs_source_get_height(sceneSource);
-	uint32_t itemWidth   = obs_source_get_width(itemSource);
-	uint32_t itemHeight  = obs_source_get_height(itemSource);
+	uint32_t itemWidth  = obs_source_get_width(itemSource);
+	uint32_t itemHeight = obs_source_get_height(itemSource);
 
 	if (!obs_sceneitem_selected(item) || isOnlyAudio || ((itemWidth <= 0) && (itemHeight <= 0)))
 		return true;
@@ -882,204 +712,251 @@ bool OBS::Display::DrawSelectedSource(obs_scene_t* scene, obs_sceneitem_t* item,
 			return true;
 	}
 
+	// Only collect the geometry here, DisplayCallback draws all items at once
 	OBS::Display* dp = reinterpret_cast<OBS::Display*>(param);
 
-	vec4         color;
+	GS::OverlayTransform box;
+	box.originX = boxTransform.t.x;
+	box.originY = boxTransform.t.y;
+	box.axisXx  = boxTransform.x.x;
+	box.axisXy  = boxTransform.x.y;
+	box.axisYx  = boxTransform.y.x;
+	box.axisYy  = boxTransform.y.y;
+	dp->m_overlay.AddItem(box);
+
+	return true;
+}
+
+void OBS::Display::DrawOverlayGeometry(Display* dp)
+{
 	gs_effect_t* solid       = obs_get_base_effect(OBS_EFFECT_SOLID);
 	gs_eparam_t* solid_color = gs_effect_get_param_by_name(solid, "color");
+	vec4         color;
 
-	obs_transform_info info;
-	obs_sceneitem_get_info(item, &info);
-
-	gs_load_vertexbuffer(dp->m_boxLine->Update(false));
-	vec4_set(
-	    &color,
-	    (dp->m_outlineColor & 0xFF) / 255.0f,
-	    ((dp->m_outlineColor & 0xFF00) >> 8) / 255.0f,
-	    ((dp->m_outlineColor & 0xFF0000) >> 16) / 255.0f,
-	    ((dp->m_outlineColor & 0xFF000000) >> 24) / 255.0f);
-	gs_effect_set_vec4(solid_color, &color);
-	DrawOutline(dp, boxTransform, info);
-
-	gs_load_vertexbuffer(dp->m_boxTris->Update(false));
-	vec4_set(
-	    &color,
-	    (dp->m_resizeInnerColor & 0xFF) / 255.0f,
-	    ((dp->m_resizeInnerColor & 0xFF00) >> 8) / 255.0f,
-	    ((dp->m_resizeInnerColor & 0xFF0000) >> 16) / 255.0f,
-	    ((dp->m_resizeInnerColor & 0xFF000000) >> 24) / 255.0f);
-	gs_effect_set_vec4(solid_color, &color);
-	DrawSquareAt(dp, 0, 0, boxTransform);
-	DrawSquareAt(dp, 1, 0, boxTransform);
-	DrawSquareAt(dp, 0, 1, boxTransform);
-	DrawSquareAt(dp, 1, 1, boxTransform);
-	DrawSquareAt(dp, 0.5, 0, boxTransform);
-	DrawSquareAt(dp, 0.5, 1, boxTransform);
-	DrawSquareAt(dp, 0, 0.5, boxTransform);
-	DrawSquareAt(dp, 1, 0.5, boxTransform);
-
-	gs_load_vertexbuffer(dp->m_boxLine->Update(false));
-	vec4_set(
-	    &color,
-	    (dp->m_resizeOuterColor & 0xFF) / 255.0f,
-	    ((dp->m_resizeOuterColor & 0xFF00) >> 8) / 255.0f,
-	    ((dp->m_resizeOuterColor & 0xFF0000) >> 16) / 255.0f,
-	    ((dp->m_resizeOuterColor & 0xFF000000) >> 24) / 255.0f);
-	gs_effect_set_vec4(solid_color, &color);
-	DrawBoxAt(dp, 0, 0, boxTransform);
-	DrawBoxAt(dp, 1, 0, boxTransform);
-	DrawBoxAt(dp, 0, 1, boxTransform);
-	DrawBoxAt(dp, 1, 1, boxTransform);
-	DrawBoxAt(dp, 0.5, 0, boxTransform);
-	DrawBoxAt(dp, 0.5, 1, boxTransform);
-	DrawBoxAt(dp, 0, 0.5, boxTransform);
-	DrawBoxAt(dp, 1, 0.5, boxTransform);
-
-	if (dp->m_drawGuideLines) {
-		vec4_set(
-		    &color,
-		    (dp->m_guidelineColor & 0xFF) / 255.0f,
-		    ((dp->m_guidelineColor & 0xFF00) >> 8) / 255.0f,
-		    ((dp->m_guidelineColor & 0xFF0000) >> 16) / 255.0f,
-		    ((dp->m_guidelineColor & 0xFF000000) >> 24) / 255.0f);
+	// Handles first so their outlines and the item outlines stay on top
+	const std::vector<GS::OverlayVertex>& tris  = dp->m_overlay.Triangles();
+	const std::vector<GS::OverlayVertex>& lines = dp->m_overlay.Lines();
+
+	uint32_t capacity  = OverlayCapacity;
+	uint32_t trisCount = uint32_t(std::min<size_t>(tris.size(), capacity / 3 * 3));
+	uint32_t lineCount = uint32_t(std::min<size_t>(lines.size(), (capacity - trisCount) / 2 * 2));
+
+	if (trisCount + lineCount > 0) {
+		dp->m_overlayVertices->Resize(trisCount + lineCount);
+		UploadOverlayVertices(dp->m_overlayVertices.get(), 0, tris, trisCount);
+		UploadOverlayVertices(dp->m_overlayVertices.get(), trisCount, lines, lineCount);
+
+		gs_technique_t* colored_tech = gs_effect_get_technique(solid, "SolidColored");
+		vec4_set(&color, 1.0f, 1.0f, 1.0f, 1.0f);
 		gs_effect_set_vec4(solid_color, &color);
-		DrawGuideline(dp, 0.5, 0, boxTransform);
-		DrawGuideline(dp, 0.5, 1, boxTransform);
-		DrawGuideline(dp, 0, 0.5, boxTransform);
-		DrawGuideline(dp, 1, 0.5, boxTransform);
-
-		// TEXT RENDERING
-		// THIS DESPERATELY NEEDS TO BE REWRITTEN INTO SHADER CODE
-		// DO SO WHENEVER...
-		GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
-
-		matrix4 itemMatrix, sceneToView;
-		obs_sceneitem_get_box_transform(item, &itemMatrix);
-		matrix4_identity(&sceneToView);
-		sceneToView.x.x = dp->m_worldToPreviewScale.x;
-		sceneToView.y.y = dp->m_worldToPreviewScale.y;
-
-		// Retrieve actual corner and edge positions.
-		vec3 edge[4], center;
-		{
-			vec3_set(&edge[0], 0, 0.5, 0);
-			vec3_transform(&edge[0], &edge[0], &itemMatrix);
-			vec3_set(&edge[1], 0.5, 0, 0);
-			vec3_transform(&edge[1], &edge[1], &itemMatrix);
-			vec3_set(&edge[2], 1, 0.5, 0);
-			vec3_transform(&edge[2], &edge[2], &itemMatrix);
-			vec3_set(&edge[3], 0.5, 1, 0);
-			vec3_transform(&edge[3], &edge[3], &itemMatrix);
-
-			vec3_set(&center, 0.5, 0.5, 0);
-			vec3_transform(&center, &center, &itemMatrix);
-			;
-		}
 
-		std::vector<char> buf(8);
-		float_t           pt = 8 * dp->m_previewToWorldScale.y;
-		for (size_t n = 0; n < 4; n++) {
-			bool isIn = (edge[n].x >= 0) && (edge[n].x < sceneWidth) && (edge[n].y >= 0) && (edge[n].y < sceneHeight);
-
-			if (!isIn)
-				continue;
-
-			vec3 alignLeft = {-1, 0, 0};
-			vec3 alignTop  = {0, -1, 0};
-
-			vec3 temp;
-			vec3_sub(&temp, &edge[n], &center);
-			vec3_norm(&temp, &temp);
-			float left = vec3_dot(&temp, &alignLeft), top = vec3_dot(&temp, &alignTop);
-			if (left > 0.5) { // LEFT
-				float_t dist = edge[n].x;
-				if (dist > (pt * 4)) {
-					size_t  len    = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(
-						    dp->m_textVertices,
-						    (edge[n].x / 2) - offset + (p * pt),
-						    edge[n].y - pt * 2,
-						    pt,
-						    0,
-						    v,
-						    dp->m_guidelineColor);
-					}
-				}
-			} else if (left < -0.5) { // RIGHT
-				float_t dist = sceneWidth - edge[n].x;
-				if (dist > (pt * 4)) {
-					size_t  len    = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(
-						    dp->m_textVertices,
-						    edge[n].x + (dist / 2) - offset + (p * pt),
-						    edge[n].y - pt * 2,
-						    pt,
-						    0,
-						    v,
-						    dp->m_guidelineColor);
-					}
-				}
-			} else if (top > 0.5) { // UP
-				float_t dist = edge[n].y;
-				if (dist > pt) {
-					size_t  len    = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(
-						    dp->m_textVertices,
-						    edge[n].x + (p * pt),
-						    edge[n].y - (dist / 2) - pt,
-						    pt,
-						    0,
-						    v,
-						    dp->m_guidelineColor);
-					}
-				}
-			} else if (top < -0.5) { // DOWN
-				float_t dist = sceneHeight - edge[n].y;
-				if (dist > (pt * 4)) {
-					size_t  len    = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(
-						    dp->m_textVertices,
-						    edge[n].x + (p * pt),
-						    edge[n].y + (dist / 2) - pt,
-						    pt,
-						    0,
-						    v,
-						    dp->m_guidelineColor);
-					}
-				}
-			}
+		gs_technique_begin(colored_tech);
+		gs_technique_begin_pass(colored_tech, 0);
+
+		gs_load_vertexbuffer(dp->m_overlayVertices->Update());
+		gs_load_indexbuffer(nullptr);
+		if (trisCount > 0)
+			gs_draw(GS_TRIS, 0, trisCount);
+		if (lineCount > 0)
+			gs_draw(GS_LINES, trisCount, lineCount);
+
+		gs_technique_end_pass(colored_tech);
+		gs_technique_end(colored_tech);
+	}
+
+	// Text Rendering
+	const std::vector<GS::OverlayVertex>& glyphs     = dp->m_overlay.Glyphs();
+	uint32_t                              glyphCount = uint32_t(std::min<size_t>(glyphs.size(), capacity / 6 * 6));
+	if (glyphCount > 0) {
+		dp->m_textVertices->Resize(glyphCount);
+		UploadOverlayVertices(dp->m_textVertices, 0, glyphs, glyphCount);
+
+		gs_vertbuffer_t* vb = dp->m_textVertices->Update();
+		while (gs_effect_loop(dp->m_textEffect, "Draw")) {
+			gs_effect_set_texture(gs_effect_get_param_by_name(dp->m_textEffect, "image"), dp->m_textTexture);
+			gs_load_vertexbuffer(vb);
+			gs_load_indexbuffer(nullptr);
+			gs_draw(GS_TRIS, 0, glyphCount);
 		}
 	}
+}
+
+// Item changes of a scene that move, show or hide a part of the selection overlay
+static const char* overlaySignals[] = {
+    "item_select",
+    "item_deselect",
+    "item_transform",
+    "item_add",
+    "item_remove",
+    "item_visible",
+    "reorder",
+    "refresh",
+};
+
+// Source size changes emit no scene signal, they are picked up by this refresh
+static const uint64_t overlayRefreshNs = 1000000000ull;
+
+void OBS::Display::OverlayChangedCallback(void* data, calldata_t* cd)
+{
+	static_cast<Display*>(data)->m_overlayDirty = true;
+}
 
+void OBS::Display::WatchOverlayScene(obs_source_t* scene)
+{
+	if (scene == m_overlayScene)
+		return;
+
+	if (m_overlayScene) {
+		signal_handler_t* sh = obs_source_get_signal_handler(m_overlayScene);
+		for (const char* signal : overlaySignals)
+			signal_handler_disconnect(sh, signal, OverlayChangedCallback, this);
+		obs_source_release(m_overlayScene);
+	}
+
+	m_overlayScene = scene;
+	m_overlayDirty = true;
+
+	if (m_overlayScene) {
+		obs_source_addref(m_overlayScene);
+		signal_handler_t* sh = obs_source_get_signal_handler(m_overlayScene);
+		for (const char* signal : overlaySignals)
+			signal_handler_connect(sh, signal, OverlayChangedCallback, this);
+	}
+}
+
+bool OBS::Display::OverlayNeedsRebuild(obs_source_t* scene, const GS::OverlayStyle& style, uint32_t cx, uint32_t cy)
+{
+	WatchOverlayScene(scene);
+
+	uint64_t now     = os_gettime_ns();
+	bool     rebuild = m_overlayDirty.exchange(false);
+	rebuild |= memcmp(&style, &m_overlayStyle, sizeof(style)) != 0;
+	rebuild |= cx != m_overlayWidth || cy != m_overlayHeight;
+	rebuild |= now - m_overlayBuiltNs >= overlayRefreshNs;
+	if (!rebuild)
+		return false;
+
+	m_overlayStyle   = style;
+	m_overlayWidth   = cx;
+	m_overlayHeight  = cy;
+	m_overlayBuiltNs = now;
 	return true;
 }
 
+void OBS::Display::DrawOverlay(
+    Display* dp, uint32_t cx, uint32_t cy, const vec2& tlCorner, const vec2& brCorner, bool rebuilt)
+{
+	if (!dp->m_cacheOverlay) {
+		DrawOverlayGeometry(dp);
+		return;
+	}
+
+	if (dp->m_overlay.Empty())
+		return;
+
+	if (!dp->m_overlayTexture)
+		dp->m_overlayTexture = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+
+	// Redraw the cached overlay only when the rebuilt geometry differs from the one drawn before
+	uint64_t signature = rebuilt ? dp->m_overlay.Signature() ^ ((uint64_t(cx) << 32) | cy) : dp->m_overlaySignature;
+	if (!dp->m_overlayValid || signature != dp->m_overlaySignature) {
+		dp->m_overlayValid = false;
+		gs_texrender_reset(dp->m_overlayTexture);
+		if (!gs_texrender_begin(dp->m_overlayTexture, cx, cy)) {
+			DrawOverlayGeometry(dp);
+			return;
+		}
+
+		vec4 clear;
+		vec4_zero(&clear);
+		gs_clear(GS_CLEAR_COLOR, &clear, 0.0f, 0);
+		gs_ortho(tlCorner.x, brCorner.x, tlCorner.y, brCorner.y, -100.0f, 100.0f);
+
+		// Keep the texture premultiplied so it composites like the direct drawing
+		gs_blend_state_push();
+		gs_blend_function_separate(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA, GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+		DrawOverlayGeometry(dp);
+		gs_blend_state_pop();
+
+		gs_texrender_end(dp->m_overlayTexture);
+		dp->m_overlayValid     = true;
+		dp->m_overlaySignature = signature;
+	}
+
+	gs_texture_t* texture = gs_texrender_get_texture(dp->m_overlayTexture);
+	gs_effect_t*  effect  = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+
+	gs_ortho(0.0f, float(cx), 0.0f, float(cy), -100.0f, 100.0f);
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	while (gs_effect_loop(effect, "Draw")) {
+		gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), texture);
+		gs_draw_sprite(texture, 0, cx, cy);
+	}
+	gs_blend_state_pop();
+}
+
 void OBS::Display::DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy)
 {
-	Display*        dp          = static_cast<Display*>(displayPtr);
+	Display* dp = static_cast<Display*>(displayPtr);
+
+	// Read once, the IPC thread may change it while the frame is drawn
+	uint32_t maxFps = dp->m_maxFps;
+	if (maxFps == 0) {
+		RenderDisplay(dp, cx, cy);
+		return;
+	}
+
+	// Capped displays render into a texture and present it again until the next frame is due
+	if (!dp->m_frameTexture)
+		dp->m_frameTexture = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+
+	uint64_t now      = os_gettime_ns();
+	uint64_t interval = 1000000000ull / maxFps;
+	bool     resized  = dp->m_frameSize.first != cx || dp->m_frameSize.second != cy;
+	if (!dp->m_frameValid || resized || now - dp->m_lastFrameNs >= interval) {
+		dp->m_frameValid = false;
+		gs_texrender_reset(dp->m_frameTexture);
+		if (!gs_texrender_begin(dp->m_frameTexture, cx, cy)) {
+			RenderDisplay(dp, cx, cy);
+			return;
+		}
+
+		RenderDisplay(dp, cx, cy);
+		gs_texrender_end(dp->m_frameTexture);
+
+		dp->m_frameValid  = true;
+		dp->m_frameSize   = std::make_pair(cx, cy);
+		dp->m_lastFrameNs = now;
+	}
+
+	gs_texture_t* texture = gs_texrender_get_texture(dp->m_frameTexture);
+	gs_effect_t*  effect  = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+
+	gs_viewport_push();
+	gs_projection_push();
+	gs_ortho(0.0f, float(cx), 0.0f, float(cy), -100.0f, 100.0f);
+	gs_set_viewport(0, 0, cx, cy);
+
+	gs_blend_state_push();
+	gs_enable_blending(false);
+	while (gs_effect_loop(effect, "Draw")) {
+		gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), texture);
+		gs_draw_sprite(texture, 0, cx, cy);
+	}
+	gs_blend_state_pop();
+
+	gs_projection_pop();
+	gs_viewport_pop();
+}
+
+void OBS::Display::RenderDisplay(Display* dp, uint32_t cx, uint32_t cy)
+{
 	gs_effect_t*    solid       = obs_get_base_effect(OBS_EFFECT_SOLID);
 	gs_eparam_t*    solid_color = gs_effect_get_param_by_name(solid, "color");
 	gs_technique_t* solid_tech  = gs_effect_get_technique(solid, "Solid");
 	vec4            color;
 
-	dp->UpdatePreviewArea();
-
 	// Get proper source/base size.
 	uint32_t sourceW, sourceH;
 	if (dp->m_source) {
@@ -1101,6 +978,10 @@ void OBS::Display::DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy)
 			sourceH = 1;
 	}
 
+	// Resizes and padding changes update the preview area themselves
+	if (dp->m_previewSourceSize.first != sourceW || dp->m_previewSourceSize.second != sourceH)
+		dp->UpdatePreviewArea();
+
 	gs_viewport_push();
 	gs_projection_push();
 
@@ -1200,26 +1081,27 @@ void OBS::Display::DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy)
 		 * that are actually scenes and our main transition scene */
 
 		if (scene) {
-			dp->m_textVertices->Resize(0);
-
-			gs_technique_begin(solid_tech);
-			gs_technique_begin_pass(solid_tech, 0);
-
-			obs_scene_enum_items(scene, DrawSelectedSource, dp);
-
-			gs_technique_end_pass(solid_tech);
-			gs_technique_end(solid_tech);
-
-			// Text Rendering
-			if (dp->m_textVertices->Size() > 0) {
-				gs_vertbuffer_t* vb = dp->m_textVertices->Update();
-				while (gs_effect_loop(dp->m_textEffect, "Draw")) {
-					gs_effect_set_texture(gs_effect_get_param_by_name(dp->m_textEffect, "image"), dp->m_textTexture);
-					gs_load_vertexbuffer(vb);
-					gs_load_indexbuffer(nullptr);
-					gs_draw(GS_TRIS, 0, (uint32_t)dp->m_textVertices->Size());
-				}
+			// Zeroed so the padding compares equal between frames
+			GS::OverlayStyle style = {};
+			style.outlineColor     = dp->m_outlineColor;
+			style.guidelineColor   = dp->m_guidelineColor;
+			style.resizeOuterColor = dp->m_resizeOuterColor;
+			style.resizeInnerColor = dp->m_resizeInnerColor;
+			style.handleRadiusX    = HANDLE_RADIUS * dp->m_previewToWorldScale.x;
+			style.handleRadiusY    = HANDLE_RADIUS * dp->m_previewToWorldScale.y;
+			style.glyphSize        = 8 * dp->m_previewToWorldScale.y;
+			style.sceneWidth       = float(obs_source_get_width(source));
+			style.sceneHeight      = float(obs_source_get_height(source));
+			style.drawGuideLines   = dp->m_drawGuideLines;
+
+			// The cached overlay keeps the geometry of the last enumeration while nothing changed
+			bool rebuild = !dp->m_cacheOverlay || dp->OverlayNeedsRebuild(source, style, cx, cy);
+			if (rebuild) {
+				dp->m_overlay.Reset(style);
+				obs_scene_enum_items(scene, DrawSelectedSource, dp);
 			}
+
+			DrawOverlay(dp, cx, cy, tlCorner, brCorner, rebuild);
 		}
 	}
 
@@ -1273,6 +1155,8 @@ void OBS::Display::UpdatePreviewArea()
 		m_previewSize.second -= offsetY * 2;
 	}
 
+	m_previewSourceSize = std::make_pair(sourceW, sourceH);
+
 	m_worldToPreviewScale.x = float_t(m_previewSize.first) / float_t(sourceW);
 	m_worldToPreviewScale.y = float_t(m_previewSize.second) / float_t(sourceH);
 	m_previewToWorldScale.x = float_t(sourceW) / float_t(m_previewSize.first);
@@ -1336,3 +1220,41 @@ void OBS::Display::SetDrawGuideLines(bool drawGuideLines)
 {
 	m_drawGuideLines = drawGuideLines;
 }
+
+void OBS::Display::SetMaxFps(uint32_t fps)
+{
+	m_maxFps     = fps;
+	m_frameValid = false;
+}
+
+uint32_t OBS::Display::GetMaxFps()
+{
+	return m_maxFps;
+}
+
+void OBS::Display::SetOverlayCache(bool enabled)
+{
+	m_cacheOverlay = enabled;
+	m_overlayValid = false;
+	m_overlayDirty = true;
+}
+
+bool OBS::Display::GetOverlayCache()
+{
+	return m_cacheOverlay;
+}
+
+void OBS::Display::SetPaused(bool paused)
+{
+	m_paused = paused;
+	if (m_display)
+		obs_display_set_enabled(m_display, !paused);
+
+	// Show the current content again when resuming
+	m_frameValid = false;
+}
+
+bool OBS::Display::GetPaused()
+{
+	return m_paused;
+}
@@ -19,10 +19,12 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <system_error>
 #include <thread>
 #include <vector>
+#include "gs-overlay.h"
 #include "gs-vertexbuffer.h"
 #include "obs.h"
 #include "ipc-server.hpp"
@@ -88,9 +90,27 @@ namespace OBS
 		void SetDrawGuideLines(bool drawGuideLines);
 		void UpdatePreviewArea();
 
+		// Render policy
+		/// Cap the rate at which the display content is rendered, 0 renders every frame
+		void     SetMaxFps(uint32_t fps);
+		uint32_t GetMaxFps();
+		/// Keep the selection overlay in a texture, redrawn only when its geometry changes
+		void SetOverlayCache(bool enabled);
+		bool GetOverlayCache();
+		/// Stop rendering the display altogether, e.g. while its window is hidden
+		void SetPaused(bool paused);
+		bool GetPaused();
+
 		private:
 		static void DisplayCallback(void* displayPtr, uint32_t cx, uint32_t cy);
+		static void RenderDisplay(Display* dp, uint32_t cx, uint32_t cy);
+		static void DrawOverlay(
+		    Display* dp, uint32_t cx, uint32_t cy, const vec2& tlCorner, const vec2& brCorner, bool rebuilt);
+		static void DrawOverlayGeometry(Display* dp);
 		static bool DrawSelectedSource(obs_scene_t* scene, obs_sceneitem_t* item, void* param);
+		static void OverlayChangedCallback(void* data, calldata_t* cd);
+		bool        OverlayNeedsRebuild(obs_source_t* scene, const GS::OverlayStyle& style, uint32_t cx, uint32_t cy);
+		void        WatchOverlayScene(obs_source_t* scene);
 		void        setSizeCall(int step);
 
 		public: // Rendering code needs it.
@@ -119,6 +139,34 @@ namespace OBS
 
 		std::unique_ptr<GS::VertexBuffer> m_boxLine, m_boxTris;
 
+		// Selection overlay of the current frame, filled by DrawSelectedSource
+		GS::OverlayGeometry               m_overlay;
+		std::unique_ptr<GS::VertexBuffer> m_overlayVertices;
+
+		// Render policy, the flags are set from the IPC thread and read by the graphics thread
+		std::atomic<uint32_t> m_maxFps{0};
+		std::atomic<bool>     m_cacheOverlay{false};
+		std::atomic<bool>     m_paused{false};
+		gs_texrender_t*       m_frameTexture = nullptr;
+		std::atomic<bool>     m_frameValid{false};
+		uint64_t              m_lastFrameNs    = 0;
+		gs_texrender_t*       m_overlayTexture = nullptr;
+		std::atomic<bool>     m_overlayValid{false};
+		uint64_t              m_overlaySignature = 0;
+
+		// With the overlay cache the scene is only enumerated again when the watched scene
+		// signals a change, the style or display size changes, or the refresh interval passed
+		obs_source_t*     m_overlayScene = nullptr;
+		std::atomic<bool> m_overlayDirty{true};
+		GS::OverlayStyle  m_overlayStyle   = {};
+		uint32_t          m_overlayWidth   = 0;
+		uint32_t          m_overlayHeight  = 0;
+		uint64_t          m_overlayBuiltNs = 0;
+
+		/// Source size the preview area was last computed for
+		std::pair<uint32_t, uint32_t> m_previewSourceSize = {0, 0};
+		std::pair<uint32_t, uint32_t> m_frameSize         = {0, 0};
+
 		// Theme/Style
 		/// Padding
 		uint32_t             m_paddingSize  = 10;
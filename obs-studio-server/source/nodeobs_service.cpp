@@ -17,11 +17,21 @@
 ******************************************************************************/
 
 #include "nodeobs_service.h"
+#include "disk-replay-buffer.h"
+#include "encoder-registry.h"
 #ifdef WIN32
 #include <ShlObj.h>
 #include <windows.h>
 #include <filesystem>
 #endif
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <list>
+#include <memory>
+#include <sstream>
 #include "error.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
@@ -35,6 +45,9 @@ obs_output_t* streamingOutput    = nullptr;
 obs_output_t* recordingOutput    = nullptr;
 obs_output_t* replayBufferOutput = nullptr;
 
+// The segment worker replaces recordingOutput while recording, every access takes this
+std::recursive_mutex recordingOutputMutex;
+
 obs_output_t* virtualWebcamOutput = nullptr;
 
 obs_encoder_t* audioSimpleStreamingEncoder   = nullptr;
@@ -67,6 +80,111 @@ std::mutex             signalMutex;
 std::queue<SignalInfo> outputSignal;
 std::thread            releaseWorker;
 
+// Signaled by the streaming output deactivate signal while a delayed stream drains
+std::mutex                            releaseMutex;
+std::condition_variable               releaseCondition;
+bool                                  streamingDeactivated = false;
+std::chrono::steady_clock::time_point streamingStopTime;
+
+// Additional streaming outputs sharing the main streaming encoders
+struct StreamingDestination;
+
+struct DestinationSignal
+{
+	StreamingDestination* destination;
+	SignalInfo            signal;
+};
+
+struct StreamingDestination
+{
+	std::string                    name;
+	obs_service_t*                 service = nullptr;
+	obs_output_t*                  output  = nullptr;
+	std::vector<DestinationSignal> signals;
+
+	// Used to compute the bitrate between two stats queries
+	uint64_t lastBytes  = 0;
+	uint64_t lastTimeNs = 0;
+};
+
+std::map<std::string, std::unique_ptr<StreamingDestination>> streamingDestinations;
+
+// Rolling file output, the recording is split into numbered segments by time or size
+struct RecordingSegment
+{
+	obs_output_t*     output;
+	std::string       path;
+	std::atomic<bool> stopped{false};
+};
+
+struct
+{
+	std::mutex              mtx;
+	std::condition_variable cv;
+	std::thread             worker;
+	bool                    active = false;
+	bool                    stop   = false;
+
+	uint64_t maxTimeNs = 0;
+	uint64_t maxBytes  = 0;
+
+	// Segment N is written to <prefix><separator><N>.<extension>
+	std::string prefix;
+	std::string separator;
+	std::string extension;
+	uint32_t    index       = 0;
+	uint64_t    startTimeNs = 0;
+
+	// Read from output signal callbacks, never held while calling into libobs
+	std::mutex  pathMtx;
+	std::string currentPath;
+
+	// Previous segments, released from the IPC thread once their stop signal fired since
+	// handlers may still use an output they read before the switch
+	std::list<std::unique_ptr<RecordingSegment>> finishing;
+} recordingSegments;
+
+static std::string SegmentPath(uint32_t index)
+{
+	std::ostringstream path;
+	path << recordingSegments.prefix << recordingSegments.separator << std::setw(3) << std::setfill('0') << index
+	     << recordingSegments.extension;
+	return path.str();
+}
+
+// Live bitrate adaptation of the streaming encoder, stepped from dropped frames and congestion.
+// The worker holds its own references, the globals are replaced while it runs.
+struct
+{
+	std::mutex              mtx;
+	std::condition_variable cv;
+	std::thread             worker;
+	bool                    stop    = false;
+	obs_output_t*           output  = nullptr;
+	obs_encoder_t*          encoder = nullptr;
+
+	int64_t minKbps      = 0;
+	int64_t maxKbps      = 0;
+	int64_t originalKbps = 0;
+	int64_t currentKbps  = 0;
+
+	int                lastDropped = 0;
+	int                lastTotal   = 0;
+	uint64_t           lastBytes   = 0;
+	uint64_t           lastTimeNs  = 0;
+	int                stableTicks = 0;
+	int                cooldown    = 0;
+	std::deque<double> kbpsHistory;
+} adaptiveBitrate;
+
+static constexpr int    kAdaptiveBitrateIntervalMs    = 1000;
+static constexpr size_t kAdaptiveBitrateHistory       = 5;
+static constexpr double kAdaptiveBitrateDropRatio     = 0.02;
+static constexpr double kAdaptiveBitrateCongestion    = 0.3;
+static constexpr double kAdaptiveBitrateStable        = 0.05;
+static constexpr int    kAdaptiveBitrateStableTicks   = 10;
+static constexpr int    kAdaptiveBitrateCooldownTicks = 3;
+
 static constexpr int kSoundtrackArchiveEncoderIdx = 1;
 static constexpr int kSoundtrackArchiveTrackIdx = 5;
 static obs_encoder_t *streamArchiveEncST = nullptr;
@@ -114,6 +232,25 @@ void OBS_service::Register(ipc::server& srv)
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_service_stopVirtualWebcan", std::vector<ipc::type>{}, OBS_service_stopVirtualWebcan));
 
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_service_addStreamingDestination",
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String},
+	    OBS_service_addStreamingDestination));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_service_removeStreamingDestination",
+	    std::vector<ipc::type>{ipc::type::String},
+	    OBS_service_removeStreamingDestination));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_service_startStreamingDestination",
+	    std::vector<ipc::type>{ipc::type::String},
+	    OBS_service_startStreamingDestination));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_service_stopStreamingDestination",
+	    std::vector<ipc::type>{ipc::type::String, ipc::type::Int32},
+	    OBS_service_stopStreamingDestination));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_service_getStreamingDestinations", std::vector<ipc::type>{}, OBS_service_getStreamingDestinations));
+
 	srv.register_collection(cls);
 }
 
@@ -864,6 +1001,7 @@ bool OBS_service::createStreamingOutput(void)
 
 bool OBS_service::createRecordingOutput(void)
 {
+	std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
 	recordingOutput = obs_output_create("ffmpeg_muxer", "simple_file_output", nullptr, nullptr);
 	if (recordingOutput == nullptr) {
 		return false;
@@ -903,7 +1041,7 @@ void OBS_service::clearAudioEncoder(void)
 
 void OBS_service::updateStreamingEncoders(bool isSimpleMode)
 {
-	if (!isStreaming) {
+	if (!isStreamingEncoderInUse()) {
 		updateAudioStreamingEncoder(isSimpleMode);
 		updateVideoStreamingEncoder(isSimpleMode);
 	}
@@ -911,6 +1049,9 @@ void OBS_service::updateStreamingEncoders(bool isSimpleMode)
 
 bool OBS_service::startStreaming(void)
 {
+	// The worker of the previous stream must not outlive its output
+	stopAdaptiveBitrate();
+
 	const char* type = obs_service_get_output_type(service);
 	if (!type)
 		type = "rtmp_output";
@@ -964,6 +1105,8 @@ bool OBS_service::startStreaming(void)
 
 		std::unique_lock<std::mutex> ulock(signalMutex);
 		outputSignal.push(signal);
+	} else {
+		startAdaptiveBitrate();
 	}
 	return isStreaming;
 }
@@ -1033,6 +1176,12 @@ void OBS_service::updateAudioRecordingEncoder(bool isSimpleMode)
 		return;
 
 	if (isSimpleMode) {
+		// Holding the stream encoder handed out by the registry, a recording encoder of its own is created
+		if (aacSimpleRecEncID.empty() && audioSimpleRecordingEncoder) {
+			obs_encoder_release(audioSimpleRecordingEncoder);
+			audioSimpleRecordingEncoder = nullptr;
+		}
+
 		if (!createAudioEncoder(&audioSimpleRecordingEncoder, aacSimpleRecEncID, 192, "simple_aac_recording", 0))
 			throw "Failed to create audio simple recording encoder";
 
@@ -1109,28 +1258,38 @@ bool OBS_service::updateRecordingEncoders(bool isSimpleMode)
 		ffmpegOutput         = false;
 
 		if (isSimpleMode) {
-			if (!isStreaming)
+			if (!isStreamingEncoderInUse())
 				updateAudioStreamingEncoder(isSimpleMode);
 
-			if (!obs_get_multiple_rendering())
+			if (!obs_get_multiple_rendering()) {
+				EncoderRegistry::Register(&audioSimpleStreamingEncoder, 0, OBS_MAIN_VIDEO_RENDERING);
+				EncoderRegistry::Share(
+				    &audioSimpleRecordingEncoder, audioSimpleStreamingEncoder, 0, OBS_MAIN_VIDEO_RENDERING);
 				useStreamEncoder = true;
-			else {
-				duplicate_encoder(&audioSimpleRecordingEncoder, audioSimpleStreamingEncoder, 0);
+			} else {
+				EncoderRegistry::Share(
+				    &audioSimpleRecordingEncoder, audioSimpleStreamingEncoder, 0, OBS_RECORDING_VIDEO_RENDERING);
 				obs_encoder_set_audio(audioSimpleRecordingEncoder, obs_get_audio());
 				useStreamEncoder = false;
 			}
+			// The slot no longer holds the encoder created for aacSimpleRecEncID, the next
+			// preset must not take it for its own
+			aacSimpleRecEncID.clear();
 		} else {
 			updateAudioRecordingEncoder(isSimpleMode);
 		}
 
-		if (!isStreaming)
+		if (!isStreamingEncoderInUse())
 			updateVideoStreamingEncoder(isSimpleMode);
 
 		if (!obs_get_multiple_rendering()) {
+			// Recording holds the stream encoder itself, the registry then refuses settings changes while it runs
+			EncoderRegistry::Register(&videoStreamingEncoder, 0, OBS_MAIN_VIDEO_RENDERING);
+			EncoderRegistry::Share(&videoRecordingEncoder, videoStreamingEncoder, 0, OBS_MAIN_VIDEO_RENDERING);
 			obs_encoder_set_video(videoStreamingEncoder, obs_get_video());
 			useStreamEncoder = true;
 		} else {
-			duplicate_encoder(&videoRecordingEncoder, videoStreamingEncoder);
+			EncoderRegistry::Share(&videoRecordingEncoder, videoStreamingEncoder, 0, OBS_RECORDING_VIDEO_RENDERING);
 			obs_encoder_set_video(videoRecordingEncoder, obs_get_video());
 			useStreamEncoder = false;
 		}
@@ -1145,6 +1304,10 @@ bool OBS_service::updateRecordingEncoders(bool isSimpleMode)
 
 bool OBS_service::startRecording(void)
 {
+	// A previous segmented recording may have stopped on its own, without stopRecording
+	stopRecordingSegments();
+
+	std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
 	if (recordingOutput)
 		obs_output_release(recordingOutput);
 
@@ -1172,7 +1335,12 @@ bool OBS_service::startRecording(void)
 			useStreamEncoder = updateRecordingEncoders(isSimpleMode);
 		}
 	}
-	updateFfmpegOutput(isSimpleMode, recordingOutput);
+	// Recording with the stream encoder would follow the adapted bitrate
+	if (useStreamEncoder)
+		stopAdaptiveBitrate();
+
+	bool segmented = setupRecordingSegments(isSimpleMode);
+	updateFfmpegOutput(isSimpleMode, recordingOutput, segmented);
 
 	obs_output_set_video_encoder(recordingOutput, useStreamEncoder ? videoStreamingEncoder : videoRecordingEncoder);
 	if (isSimpleMode) {
@@ -1210,25 +1378,41 @@ bool OBS_service::startRecording(void)
 		}
 		std::unique_lock<std::mutex> ulock(signalMutex);
 		outputSignal.push(signal);
+	} else if (segmented) {
+		std::unique_lock<std::mutex> ulock(recordingSegments.mtx);
+		recordingSegments.active      = true;
+		recordingSegments.stop        = false;
+		recordingSegments.startTimeNs = os_gettime_ns();
+		recordingSegments.worker      = std::thread(recordingSegmentWorker);
 	}
 	return isRecording;
 }
 
 void OBS_service::stopStreaming(bool forceStop)
 {
+	stopAdaptiveBitrate();
+
 	if (!obs_output_active(streamingOutput) && !obs_output_reconnecting(streamingOutput))
 	{
 		blog(LOG_WARNING, "stopStreaming was ignored as stream not active or reconnecting");
 		return;
 	}
 
+	waitReleaseWorker();
+
+	{
+		std::unique_lock<std::mutex> ulock(releaseMutex);
+		streamingDeactivated = false;
+		streamingStopTime    = std::chrono::steady_clock::now();
+	}
+	signal_handler_connect(
+	    obs_output_get_signal_handler(streamingOutput), "deactivate", onStreamingOutputDeactivate, nullptr);
+
 	if (forceStop)
 		obs_output_force_stop(streamingOutput);
 	else
 		obs_output_stop(streamingOutput);
 
-	waitReleaseWorker();
-
 	releaseWorker = std::thread(releaseStreamingOutput);
 
 	isStreaming = false;
@@ -1236,6 +1420,9 @@ void OBS_service::stopStreaming(bool forceStop)
 
 void OBS_service::stopRecording(void)
 {
+	stopRecordingSegments();
+
+	std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
 	obs_output_stop(recordingOutput);
 	isRecording = false;
 }
@@ -1297,6 +1484,10 @@ void OBS_service::updateReplayBufferOutput(bool isSimpleMode, bool useStreamEnco
 	obs_data_set_bool(settings, "allow_spaces", !noSpace);
 	obs_data_set_int(settings, "max_time_sec", rbTime);
 	obs_data_set_int(settings, "max_size_mb", usingRecordingPreset ? rbSize : 0);
+	obs_data_set_int(
+	    settings,
+	    "memory_head_mb",
+	    config_get_uint(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBMemoryHead"));
 
 	if (!isSimpleMode) {
 		bool        usesBitrate = false;
@@ -1323,7 +1514,10 @@ bool OBS_service::startReplayBuffer(void)
 	if (replayBufferOutput)
 		obs_output_release(replayBufferOutput);
 
-	replayBufferOutput = obs_output_create("replay_buffer", "ReplayBuffer", nullptr, nullptr);
+	// Long replay windows are kept in a ring file on disk instead of RAM
+	bool diskSpill = config_get_bool(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBDiskSpill");
+	replayBufferOutput =
+	    obs_output_create(diskSpill ? DiskReplayBuffer::Id : "replay_buffer", "ReplayBuffer", nullptr, nullptr);
 	if (!replayBufferOutput)
 		return false;
 
@@ -1345,6 +1539,9 @@ bool OBS_service::startReplayBuffer(void)
 		rpUsesRec = true;
 	}
 
+	if (useStreamEncoder)
+		stopAdaptiveBitrate();
+
 	updateFfmpegOutput(isSimpleMode, replayBufferOutput);
 	updateReplayBufferOutput(isSimpleMode, useStreamEncoder);
 
@@ -1445,8 +1642,23 @@ bool OBS_service::isStreamingOutputActive(void)
 	return obs_output_active(streamingOutput);
 }
 
+bool OBS_service::isStreamingEncoderInUse(void)
+{
+	if (isStreaming)
+		return true;
+
+	for (auto& destination : streamingDestinations) {
+		if (destination.second->output
+		    && (obs_output_active(destination.second->output)
+		        || obs_output_reconnecting(destination.second->output)))
+			return true;
+	}
+	return false;
+}
+
 bool OBS_service::isRecordingOutputActive(void)
 {
+	std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
 	return obs_output_active(recordingOutput);
 }
 
@@ -1583,8 +1795,8 @@ void OBS_service::updateVideoStreamingEncoder(bool isSimpleMode)
 				obs_data_set_string(h264Settings, "profile", profile);
 		}
 
-		obs_encoder_update(videoStreamingEncoder, h264Settings);
-		obs_encoder_update(audioSimpleStreamingEncoder, aacSettings);
+		EncoderRegistry::Update(videoStreamingEncoder, h264Settings);
+		EncoderRegistry::Update(audioSimpleStreamingEncoder, aacSettings);
 
 		obs_data_release(h264Settings);
 		obs_data_release(aacSettings);
@@ -1643,7 +1855,7 @@ void OBS_service::updateService(void)
 	obs_output_set_service(streamingOutput, service);
 }
 
-void OBS_service::updateFfmpegOutput(bool isSimpleMode, obs_output_t* output)
+void OBS_service::updateFfmpegOutput(bool isSimpleMode, obs_output_t* output, bool segmented)
 {
 	const char* path;
 	const char* format;
@@ -1686,9 +1898,32 @@ void OBS_service::updateFfmpegOutput(bool isSimpleMode, obs_output_t* output)
 	if (fileNameFormat != NULL && format != NULL)
 		strPath += GenerateSpecifiedFilename(ffmpegOutput ? "avi" : format, noSpace, fileNameFormat);
 
-	if (!overwriteIfExists)
+	// Segments are numbered from the name, the name itself is never written
+	if (!overwriteIfExists && !segmented)
 		FindBestFilename(strPath, noSpace);
 
+	if (segmented) {
+		size_t extStart = strPath.find_last_of('.');
+		size_t dirEnd   = strPath.find_last_of("/\\");
+		if (extStart != std::string::npos && extStart > dirEnd + 1) {
+			std::unique_lock<std::mutex> ulock(recordingSegments.mtx);
+			std::string                  prefix = strPath.substr(0, extStart);
+			recordingSegments.prefix            = prefix;
+			recordingSegments.extension         = strPath.substr(extStart);
+
+			// Numbered like FindBestFilename until the first segment doesn't exist yet
+			for (int num = 2; !overwriteIfExists && os_file_exists(SegmentPath(recordingSegments.index).c_str());
+			     num++) {
+				recordingSegments.prefix =
+				    prefix + (noSpace ? "_" + std::to_string(num) : " (" + std::to_string(num) + ")");
+			}
+			strPath = SegmentPath(recordingSegments.index);
+		}
+
+		std::unique_lock<std::mutex> plock(recordingSegments.pathMtx);
+		recordingSegments.currentPath = strPath;
+	}
+
 	if (strPath.size() > 0) {
 		obs_data_t* settings = obs_data_create();
 		obs_data_set_string(settings, ffmpegOutput ? "url" : "path", strPath.c_str());
@@ -1729,6 +1964,7 @@ void OBS_service::updateAudioTracks()
 
 void OBS_service::LoadRecordingPreset_Lossless()
 {
+	std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
 	if (recordingOutput != NULL) {
 		obs_output_release(recordingOutput);
 	}
@@ -1802,6 +2038,7 @@ void OBS_service::UpdateFFmpegCustomOutput(void)
 {
 	update_ffmpeg_output(ConfigManager::getInstance().getBasic());
 
+	std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
 	if (recordingOutput != NULL) {
 		obs_output_release(recordingOutput);
 	}
@@ -1895,7 +2132,7 @@ void OBS_service::UpdateRecordingSettings_qsv11(int crf)
 		obs_data_set_int(settings, "qpb", crf);
 	}
 
-	obs_encoder_update(videoRecordingEncoder, settings);
+	EncoderRegistry::Update(videoRecordingEncoder, settings);
 
 	obs_data_release(settings);
 }
@@ -1909,7 +2146,7 @@ void OBS_service::UpdateRecordingSettings_nvenc(int cqp)
 	obs_data_set_int(settings, "cqp", cqp);
 	obs_data_set_int(settings, "bitrate", 0);
 
-	obs_encoder_update(videoRecordingEncoder, settings);
+	EncoderRegistry::Update(videoRecordingEncoder, settings);
 
 	obs_data_release(settings);
 }
@@ -1953,7 +2190,7 @@ void OBS_service::UpdateRecordingSettings_amd_cqp(int cqp)
 	obs_data_set_int(settings, "BFrame.Pattern", 0);
 
 	// Update and release
-	obs_encoder_update(videoRecordingEncoder, settings);
+	EncoderRegistry::Update(videoRecordingEncoder, settings);
 	obs_data_release(settings);
 }
 
@@ -1966,7 +2203,7 @@ void OBS_service::UpdateRecordingSettings_x264_crf(int crf)
 	obs_data_set_string(settings, "profile", "high");
 	obs_data_set_string(settings, "preset", lowCPUx264 ? "ultrafast" : "veryfast");
 
-	obs_encoder_update(videoRecordingEncoder, settings);
+	EncoderRegistry::Update(videoRecordingEncoder, settings);
 
 	obs_data_release(settings);
 }
@@ -2087,11 +2324,13 @@ void OBS_service::setStreamingOutput(obs_output_t* output)
 
 obs_output_t* OBS_service::getRecordingOutput(void)
 {
+	std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
 	return recordingOutput;
 }
 
 void OBS_service::setRecordingOutput(obs_output_t* output)
 {
+	std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
 	obs_output_release(recordingOutput);
 	recordingOutput = output;
 }
@@ -2134,6 +2373,11 @@ void OBS_service::updateStreamingOutput()
 		}
 	}
 
+	updateStreamingOutputSettings(streamingOutput);
+}
+
+void OBS_service::updateStreamingOutputSettings(obs_output_t* output, bool sharedEncoder)
+{
 	bool reconnect  = config_get_bool(ConfigManager::getInstance().getBasic(), "Output", "Reconnect");
 	int  retryDelay = config_get_uint(ConfigManager::getInstance().getBasic(), "Output", "RetryDelay");
 	int  maxRetries = config_get_uint(ConfigManager::getInstance().getBasic(), "Output", "MaxRetries");
@@ -2146,7 +2390,9 @@ void OBS_service::updateStreamingOutput()
 		delaySec = 0;
 
 	const char* bindIP           = config_get_string(ConfigManager::getInstance().getBasic(), "Output", "BindIP");
-	bool        enableDynBitrate = config_get_bool(ConfigManager::getInstance().getBasic(), "Output", "DynamicBitrate");
+	// Dynamic bitrate lowers the encoder bitrate, which would affect every output sharing it
+	bool enableDynBitrate =
+	    !sharedEncoder && config_get_bool(ConfigManager::getInstance().getBasic(), "Output", "DynamicBitrate");
 	bool        enableNewSocketLoop =
 	    config_get_bool(ConfigManager::getInstance().getBasic(), "Output", "NewSocketLoopEnable");
 	bool enableLowLatencyMode = config_get_bool(ConfigManager::getInstance().getBasic(), "Output", "LowLatencyEnable");
@@ -2156,16 +2402,16 @@ void OBS_service::updateStreamingOutput()
 	obs_data_set_bool(settings, "dyn_bitrate", enableDynBitrate);
 	obs_data_set_bool(settings, "new_socket_loop_enabled", enableNewSocketLoop);
 	obs_data_set_bool(settings, "low_latency_mode_enabled", enableLowLatencyMode);
-	obs_output_update(streamingOutput, settings);
+	obs_output_update(output, settings);
 	obs_data_release(settings);
 
 	if (!reconnect)
 		maxRetries = 0;
 
 	obs_output_set_delay(
-	    streamingOutput, useDelay ? uint32_t(delaySec) : 0, preserveDelay ? OBS_OUTPUT_DELAY_PRESERVE : 0);
+	    output, useDelay ? uint32_t(delaySec) : 0, preserveDelay ? OBS_OUTPUT_DELAY_PRESERVE : 0);
 
-	obs_output_set_reconnect_settings(streamingOutput, maxRetries, retryDelay);
+	obs_output_set_reconnect_settings(output, maxRetries, retryDelay);
 }
 
 std::vector<SignalInfo> streamingSignals;
@@ -2211,6 +2457,8 @@ void OBS_service::Query(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
+	releaseStoppedSegments();
+
 	std::unique_lock<std::mutex> ulock(signalMutex);
 	if (outputSignal.empty()) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -2224,6 +2472,10 @@ void OBS_service::Query(
 	rval.push_back(ipc::value(outputSignal.front().getSignal()));
 	rval.push_back(ipc::value(outputSignal.front().getCode()));
 	rval.push_back(ipc::value(outputSignal.front().getErrorMessage()));
+	if (!outputSignal.front().getDestination().empty() || !outputSignal.front().getPath().empty())
+		rval.push_back(ipc::value(outputSignal.front().getDestination()));
+	if (!outputSignal.front().getPath().empty())
+		rval.push_back(ipc::value(outputSignal.front().getPath()));
 
 	outputSignal.pop();
 
@@ -2245,7 +2497,8 @@ void OBS_service::JSCallbackOutputSignal(void* data, calldata_t* params)
 			output = streamingOutput;
 			isStreaming = false;
 		} else if (signal.getOutputType().compare("recording") == 0) {
-			output = recordingOutput;
+			// recordingOutput may be switched to another segment by now
+			output = reinterpret_cast<obs_output_t*>(calldata_ptr(params, "output"));
 			isRecording = false;
 		} else {
 			output = replayBufferOutput;
@@ -2260,6 +2513,12 @@ void OBS_service::JSCallbackOutputSignal(void* data, calldata_t* params)
 		}
 	}
 
+	// Signals of a segmented recording carry the file of the segment being written
+	if (signal.getOutputType().compare("recording") == 0) {
+		std::unique_lock<std::mutex> ulock(recordingSegments.pathMtx);
+		signal.setPath(recordingSegments.currentPath);
+	}
+
 	std::unique_lock<std::mutex> ulock(signalMutex);
 	outputSignal.push(signal);
 }
@@ -2279,6 +2538,7 @@ void OBS_service::connectOutputSignals(void)
 		}
 	}
 
+	std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
 	if (recordingOutput) {
 		signal_handler* recordingOutputSignalHandler = obs_output_get_signal_handler(recordingOutput);
 
@@ -2306,6 +2566,508 @@ void OBS_service::connectOutputSignals(void)
 	}
 }
 
+bool OBS_service::setupRecordingSegments(bool isSimpleMode)
+{
+	config_t* config = ConfigManager::getInstance().getBasic();
+
+	releaseStoppedSegments();
+
+	std::unique_lock<std::mutex> ulock(recordingSegments.mtx);
+	{
+		std::unique_lock<std::mutex> plock(recordingSegments.pathMtx);
+		recordingSegments.currentPath.clear();
+	}
+
+	// Custom ffmpeg output writes to a url, it can't be split
+	if (ffmpegOutput || !config_get_bool(config, "Output", "RecSplitFile"))
+		return false;
+
+	recordingSegments.maxTimeNs = config_get_uint(config, "Output", "RecSplitFileTime") * 60ULL * 1000000000ULL;
+	recordingSegments.maxBytes  = config_get_uint(config, "Output", "RecSplitFileSize") * 1024ULL * 1024ULL;
+	if (!recordingSegments.maxTimeNs && !recordingSegments.maxBytes)
+		return false;
+
+	bool noSpace = isSimpleMode ? config_get_bool(config, "SimpleOutput", "FileNameWithoutSpace")
+	                            : config_get_bool(config, "AdvOut", "RecFileNameWithoutSpace");
+	recordingSegments.separator = noSpace ? "_" : " ";
+	recordingSegments.index     = 1;
+	return true;
+}
+
+void OBS_service::stopRecordingSegments(void)
+{
+	std::unique_lock<std::mutex> ulock(recordingSegments.mtx);
+	if (!recordingSegments.active)
+		return;
+
+	recordingSegments.stop   = true;
+	recordingSegments.active = false;
+	ulock.unlock();
+	recordingSegments.cv.notify_all();
+
+	if (recordingSegments.worker.joinable())
+		recordingSegments.worker.join();
+}
+
+void OBS_service::releaseStoppedSegments(void)
+{
+	std::unique_lock<std::mutex> ulock(recordingSegments.mtx);
+	for (auto it = recordingSegments.finishing.begin(); it != recordingSegments.finishing.end();) {
+		if ((*it)->stopped) {
+			signal_handler_disconnect(
+			    obs_output_get_signal_handler((*it)->output), "stop", onRecordingSegmentStopped, it->get());
+			obs_output_release((*it)->output);
+			it = recordingSegments.finishing.erase(it);
+		} else {
+			it++;
+		}
+	}
+}
+
+void OBS_service::releaseRecordingSegments(void)
+{
+	stopRecordingSegments();
+
+	std::unique_lock<std::mutex> ulock(recordingSegments.mtx);
+	for (auto& segment : recordingSegments.finishing) {
+		if (!segment->stopped)
+			obs_output_force_stop(segment->output);
+		signal_handler_disconnect(
+		    obs_output_get_signal_handler(segment->output), "stop", onRecordingSegmentStopped, segment.get());
+		obs_output_release(segment->output);
+	}
+	recordingSegments.finishing.clear();
+}
+
+void OBS_service::recordingSegmentWorker(void)
+{
+	// Only this thread replaces recordingOutput while it runs, reading it needs no lock here
+	std::unique_lock<std::mutex> ulock(recordingSegments.mtx);
+	while (!recordingSegments.stop) {
+		recordingSegments.cv.wait_for(ulock, std::chrono::milliseconds(500));
+		if (recordingSegments.stop)
+			break;
+
+		if (!obs_output_active(recordingOutput))
+			continue;
+
+		uint64_t elapsed = os_gettime_ns() - recordingSegments.startTimeNs;
+		bool     due     = (recordingSegments.maxTimeNs && elapsed >= recordingSegments.maxTimeNs)
+		           || (recordingSegments.maxBytes
+		               && obs_output_get_total_bytes(recordingOutput) >= recordingSegments.maxBytes);
+		if (!due)
+			continue;
+
+		ulock.unlock();
+		bool split = splitRecording();
+		ulock.lock();
+
+		if (!split) {
+			// Keep writing the current segment and try again after a full interval
+			recordingSegments.startTimeNs = os_gettime_ns();
+		}
+	}
+}
+
+bool OBS_service::splitRecording(void)
+{
+	obs_output_t* previous = recordingOutput;
+	std::string   path     = SegmentPath(recordingSegments.index + 1);
+
+	obs_output_t* next = obs_output_create("ffmpeg_muxer", "simple_file_output", nullptr, nullptr);
+	if (!next)
+		return false;
+
+	// Same muxer settings as the previous segment, only the file changes
+	obs_data_t* settings = obs_output_get_settings(previous);
+	obs_data_set_string(settings, "path", path.c_str());
+	obs_output_update(next, settings);
+	obs_data_release(settings);
+
+	obs_output_set_video_encoder(next, obs_output_get_video_encoder(previous));
+	for (size_t idx = 0; idx < MAX_AUDIO_MIXES; idx++) {
+		obs_encoder_t* encoder = obs_output_get_audio_encoder(previous, idx);
+		if (encoder)
+			obs_output_set_audio_encoder(next, encoder, idx);
+	}
+
+	// The encoders keep running and the new muxer discards everything up to their next
+	// keyframe. The previous one is stopped as soon as that keyframe was written, so
+	// both files only share the frames encoded in the meantime.
+	if (!obs_output_start(next)) {
+		const char* error = obs_output_get_last_error(next);
+		blog(LOG_WARNING, "Failed to start recording segment %s: %s", path.c_str(), error ? error : "");
+		obs_output_release(next);
+		return false;
+	}
+
+	{
+		std::unique_lock<std::mutex> ulock(recordingSegments.mtx);
+		auto                         deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+		while (!recordingSegments.stop && obs_output_get_total_bytes(next) == 0
+		       && std::chrono::steady_clock::now() < deadline) {
+			recordingSegments.cv.wait_for(ulock, std::chrono::milliseconds(5));
+		}
+
+		if (recordingSegments.stop || obs_output_get_total_bytes(next) == 0) {
+			ulock.unlock();
+			blog(LOG_WARNING, "Recording segment %s received no keyframe, not switching", path.c_str());
+			obs_output_force_stop(next);
+			obs_output_release(next);
+			return false;
+		}
+	}
+
+	signal_handler_t* handler = obs_output_get_signal_handler(previous);
+	for (int i = 0; i < recordingSignals.size(); i++) {
+		signal_handler_disconnect(
+		    handler, recordingSignals.at(i).getSignal().c_str(), JSCallbackOutputSignal, &(recordingSignals.at(i)));
+	}
+
+	std::unique_ptr<RecordingSegment> segment = std::make_unique<RecordingSegment>();
+	segment->output                           = previous;
+	{
+		std::unique_lock<std::mutex> plock(recordingSegments.pathMtx);
+		segment->path                 = recordingSegments.currentPath;
+		recordingSegments.currentPath = path;
+	}
+	signal_handler_connect(handler, "stop", onRecordingSegmentStopped, segment.get());
+
+	{
+		std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
+		recordingOutput = next;
+	}
+	handler = obs_output_get_signal_handler(next);
+	for (int i = 0; i < recordingSignals.size(); i++) {
+		signal_handler_connect(
+		    handler, recordingSignals.at(i).getSignal().c_str(), JSCallbackOutputSignal, &(recordingSignals.at(i)));
+	}
+
+	{
+		std::unique_lock<std::mutex> ulock(recordingSegments.mtx);
+		recordingSegments.finishing.push_back(std::move(segment));
+		recordingSegments.index++;
+		recordingSegments.startTimeNs = os_gettime_ns();
+	}
+
+	obs_output_stop(previous);
+	blog(LOG_INFO, "Recording split, now writing %s", path.c_str());
+	return true;
+}
+
+void OBS_service::onRecordingSegmentStopped(void* data, calldata_t* params)
+{
+	RecordingSegment* segment = reinterpret_cast<RecordingSegment*>(data);
+
+	SignalInfo signal = SignalInfo("recording", "wrote");
+	signal.setCode((int)calldata_int(params, "code"));
+	signal.setPath(segment->path);
+	{
+		std::unique_lock<std::mutex> ulock(signalMutex);
+		outputSignal.push(signal);
+	}
+
+	// The output can't be released from its own signal, the next service query does it
+	segment->stopped = true;
+}
+
+static const char* destinationSignals[] =
+    {"start", "stop", "starting", "stopping", "activate", "deactivate", "reconnect", "reconnect_success"};
+
+void OBS_service::JSCallbackDestinationSignal(void* data, calldata_t* params)
+{
+	DestinationSignal& destinationSignal = *reinterpret_cast<DestinationSignal*>(data);
+	SignalInfo         signal            = destinationSignal.signal;
+
+	if (signal.getSignal().compare("stop") == 0) {
+		signal.setCode((int)calldata_int(params, "code"));
+
+		const char* error = obs_output_get_last_error(destinationSignal.destination->output);
+		if (error)
+			signal.setErrorMessage(error);
+	}
+
+	std::unique_lock<std::mutex> ulock(signalMutex);
+	outputSignal.push(signal);
+}
+
+static void disconnectDestinationSignals(StreamingDestination* destination)
+{
+	if (!destination->output)
+		return;
+
+	signal_handler* handler = obs_output_get_signal_handler(destination->output);
+	for (auto& destinationSignal : destination->signals) {
+		signal_handler_disconnect(
+		    handler,
+		    destinationSignal.signal.getSignal().c_str(),
+		    OBS_service::JSCallbackDestinationSignal,
+		    &destinationSignal);
+	}
+}
+
+static void releaseDestination(StreamingDestination* destination)
+{
+	if (destination->output) {
+		if (obs_output_active(destination->output))
+			obs_output_force_stop(destination->output);
+
+		disconnectDestinationSignals(destination);
+		destination->signals.clear();
+		obs_output_release(destination->output);
+		destination->output = nullptr;
+	}
+
+	if (destination->service) {
+		obs_service_release(destination->service);
+		destination->service = nullptr;
+	}
+}
+
+void OBS_service::OBS_service_addStreamingDestination(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::string name = args[0].value_str;
+	std::string type = args[1].value_str;
+
+	if (name.empty() || type.empty()) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid streaming destination.");
+	}
+
+	obs_data_t* settings = obs_data_create_from_json(args[2].value_str.c_str());
+	if (!settings) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid streaming destination settings.");
+	}
+
+	auto it = streamingDestinations.find(name);
+	if (it != streamingDestinations.end()) {
+		StreamingDestination* destination = it->second.get();
+		if (destination->output && obs_output_active(destination->output)) {
+			obs_data_release(settings);
+			PRETTY_ERROR_RETURN(ErrorCode::Error, "Streaming destination is active.");
+		}
+
+		if (type.compare(obs_service_get_type(destination->service)) == 0) {
+			obs_service_update(destination->service, settings);
+			obs_data_release(settings);
+			rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+			AUTO_DEBUG;
+			return;
+		}
+
+		// The service type changed, the output may have to change as well
+		releaseDestination(destination);
+		streamingDestinations.erase(it);
+	}
+
+	std::string    serviceName = "destination_service_" + name;
+	obs_service_t* newService  = obs_service_create(type.c_str(), serviceName.c_str(), settings, nullptr);
+	obs_data_release(settings);
+	if (!newService) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to create the streaming destination service.");
+	}
+
+	std::unique_ptr<StreamingDestination> destination = std::make_unique<StreamingDestination>();
+	destination->name    = name;
+	destination->service = newService;
+	streamingDestinations.emplace(name, std::move(destination));
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_service::OBS_service_removeStreamingDestination(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	auto it = streamingDestinations.find(args[0].value_str);
+	if (it == streamingDestinations.end()) {
+		PRETTY_ERROR_RETURN(ErrorCode::NotFound, "Streaming destination not found.");
+	}
+
+	releaseDestination(it->second.get());
+	streamingDestinations.erase(it);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_service::OBS_service_startStreamingDestination(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	auto it = streamingDestinations.find(args[0].value_str);
+	if (it == streamingDestinations.end()) {
+		PRETTY_ERROR_RETURN(ErrorCode::NotFound, "Streaming destination not found.");
+	}
+
+	if (it->second->output && obs_output_active(it->second->output)) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+		AUTO_DEBUG;
+		return;
+	}
+
+	if (!startStreamingDestination(it->first)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to start streaming destination!");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_service::OBS_service_stopStreamingDestination(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	auto it = streamingDestinations.find(args[0].value_str);
+	if (it == streamingDestinations.end()) {
+		PRETTY_ERROR_RETURN(ErrorCode::NotFound, "Streaming destination not found.");
+	}
+
+	stopStreamingDestination(it->first, (bool)args[1].value_union.i32);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_service::OBS_service_getStreamingDestinations(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)streamingDestinations.size()));
+
+	uint64_t now = os_gettime_ns();
+	for (auto& it : streamingDestinations) {
+		StreamingDestination* destination = it.second.get();
+		obs_output_t*         output      = destination->output;
+
+		bool     active       = output && obs_output_active(output);
+		bool     reconnecting = output && obs_output_reconnecting(output);
+		uint64_t bytes        = output ? obs_output_get_total_bytes(output) : 0;
+		int32_t  totalFrames  = output ? obs_output_get_total_frames(output) : 0;
+		int32_t  dropped      = output ? obs_output_get_frames_dropped(output) : 0;
+		double   congestion   = output ? obs_output_get_congestion(output) : 0.0;
+		int32_t  connectTime  = output ? obs_output_get_connect_time_ms(output) : 0;
+
+		// Bitrate since the previous query, reset when the output restarts
+		double kbps = 0.0;
+		if (bytes < destination->lastBytes)
+			destination->lastBytes = 0;
+		if (destination->lastTimeNs && now > destination->lastTimeNs)
+			kbps = double(bytes - destination->lastBytes) * 8.0 / 1000.0
+			       / (double(now - destination->lastTimeNs) / 1000000000.0);
+		destination->lastBytes  = bytes;
+		destination->lastTimeNs = now;
+
+		rval.push_back(ipc::value(destination->name));
+		rval.push_back(ipc::value((uint32_t)active));
+		rval.push_back(ipc::value((uint32_t)reconnecting));
+		rval.push_back(ipc::value(bytes));
+		rval.push_back(ipc::value(totalFrames));
+		rval.push_back(ipc::value(dropped));
+		rval.push_back(ipc::value(congestion));
+		rval.push_back(ipc::value(kbps));
+		rval.push_back(ipc::value(connectTime));
+	}
+
+	AUTO_DEBUG;
+}
+
+bool OBS_service::startStreamingDestination(const std::string& name)
+{
+	StreamingDestination* destination = streamingDestinations.at(name).get();
+
+	std::string currentOutputMode = config_get_string(ConfigManager::getInstance().getBasic(), "Output", "Mode");
+	bool        isSimpleMode      = currentOutputMode.compare("Simple") == 0;
+
+	// The encoders are shared with the main stream and the other destinations,
+	// they can only be reconfigured while none of them is live.
+	updateStreamingEncoders(isSimpleMode);
+
+	if (!destination->output) {
+		const char* type = obs_service_get_output_type(destination->service);
+		if (!type)
+			type = "rtmp_output";
+
+		std::string outputName = "destination_stream_" + name;
+		destination->output    = obs_output_create(type, outputName.c_str(), nullptr, nullptr);
+		if (!destination->output)
+			return false;
+
+		signal_handler* handler = obs_output_get_signal_handler(destination->output);
+		destination->signals.reserve(sizeof(destinationSignals) / sizeof(destinationSignals[0]));
+		for (const char* signalName : destinationSignals) {
+			SignalInfo signal = SignalInfo("streaming-destination", signalName);
+			signal.setDestination(name);
+			destination->signals.push_back({destination, signal});
+			signal_handler_connect(
+			    handler, signalName, JSCallbackDestinationSignal, &destination->signals.back());
+		}
+	}
+
+	// Destinations share the stream encoder, their bitrate is the configured one
+	stopAdaptiveBitrate();
+
+	updateStreamingOutputSettings(destination->output, true);
+	obs_output_set_service(destination->output, destination->service);
+	obs_output_set_video_encoder(destination->output, videoStreamingEncoder);
+	obs_output_set_audio_encoder(
+	    destination->output, isSimpleMode ? audioSimpleStreamingEncoder : audioAdvancedStreamingEncoder, 0);
+
+	destination->lastBytes  = 0;
+	destination->lastTimeNs = 0;
+
+	if (obs_output_start(destination->output))
+		return true;
+
+	SignalInfo signal = SignalInfo("streaming-destination", "stop");
+	signal.setDestination(name);
+	signal.setCode(OBS_OUTPUT_ERROR);
+	const char* error = obs_output_get_last_error(destination->output);
+	if (error) {
+		signal.setErrorMessage(error);
+		blog(LOG_INFO, "Last streaming error for destination %s: %s", name.c_str(), error);
+	}
+
+	std::unique_lock<std::mutex> ulock(signalMutex);
+	outputSignal.push(signal);
+	return false;
+}
+
+void OBS_service::stopStreamingDestination(const std::string& name, bool forceStop)
+{
+	obs_output_t* output = streamingDestinations.at(name)->output;
+	if (!output || (!obs_output_active(output) && !obs_output_reconnecting(output))) {
+		blog(LOG_WARNING, "stopStreamingDestination was ignored as %s is not active or reconnecting", name.c_str());
+		return;
+	}
+
+	if (forceStop)
+		obs_output_force_stop(output);
+	else
+		obs_output_stop(output);
+}
+
+void OBS_service::releaseStreamingDestinations(void)
+{
+	for (auto& destination : streamingDestinations)
+		releaseDestination(destination.second.get());
+
+	streamingDestinations.clear();
+}
+
 struct HotkeyInfo
 {
 	std::string                objectName;
@@ -2367,6 +3129,7 @@ void OBS_service::OBS_service_getLastRecording(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
+	std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
 	if (!recordingOutput) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Invalid recording ouput.");
 	}
@@ -2390,34 +3153,41 @@ bool OBS_service::useRecordingPreset()
 	return usingRecordingPreset;
 }
 
-void OBS_service::duplicate_encoder(obs_encoder_t** dst, obs_encoder_t* src, uint64_t trackIndex)
+void OBS_service::onStreamingOutputDeactivate(void* data, calldata_t* params)
 {
-	if (!src)
-		return;
-
-	if (*dst != src && *dst)
-		obs_encoder_release(*dst);
-
-	std::string name = obs_encoder_get_name(src);
-	name += "-duplicate";
-
-	if (obs_encoder_get_type(src) == OBS_ENCODER_AUDIO) {
-		*dst = obs_audio_encoder_create(
-		    obs_encoder_get_id(src), name.c_str(), obs_encoder_get_settings(src), trackIndex, nullptr);
-	} else if (obs_encoder_get_type(src) == OBS_ENCODER_VIDEO) {
-		*dst = obs_video_encoder_create(obs_encoder_get_id(src), name.c_str(), obs_encoder_get_settings(src), nullptr);
+	{
+		std::unique_lock<std::mutex> ulock(releaseMutex);
+		streamingDeactivated = true;
 	}
+	releaseCondition.notify_all();
 }
 
 void OBS_service::releaseStreamingOutput()
 {
-	if (config_get_bool(ConfigManager::getInstance().getBasic(), "Output", "DelayEnable")) {
-		uint32_t delay = obs_output_get_active_delay(streamingOutput);
-		while (delay != 0) {
-			delay = obs_output_get_active_delay(streamingOutput);
+	uint32_t delay = obs_output_get_active_delay(streamingOutput);
+	if (delay != 0) {
+		// Wait for the delay buffer to drain without spinning, reporting the
+		// remaining time once per second through the output signals.
+		auto                         deadline = streamingStopTime + std::chrono::seconds(delay);
+		std::unique_lock<std::mutex> ulock(releaseMutex);
+		while (!streamingDeactivated && obs_output_get_active_delay(streamingOutput) != 0) {
+			auto remaining = std::chrono::duration_cast<std::chrono::seconds>(
+			    deadline - std::chrono::steady_clock::now() + std::chrono::milliseconds(999));
+
+			SignalInfo signal = SignalInfo("streaming", "delay");
+			signal.setCode(int(std::max<int64_t>(remaining.count(), 0)));
+			{
+				std::unique_lock<std::mutex> slock(signalMutex);
+				outputSignal.push(signal);
+			}
+
+			releaseCondition.wait_for(ulock, std::chrono::seconds(1));
 		}
 	}
 
+	signal_handler_disconnect(
+	    obs_output_get_signal_handler(streamingOutput), "deactivate", onStreamingOutputDeactivate, nullptr);
+
 	if (twitchSoundtrackEnabled)
 		stopTwitchSoundtrackAudio();
 	else
@@ -2502,14 +3272,255 @@ void OBS_service::OBS_service_stopVirtualWebcan(
 }
 void OBS_service::stopAllOutputs()
 {
+	stopAdaptiveBitrate();
+
 	if (streamingOutput && obs_output_active(streamingOutput))
 		stopStreaming(true);
 
 	if (replayBufferOutput && obs_output_active(replayBufferOutput))
 		stopReplayBuffer(true);
 
-	if (recordingOutput && obs_output_active(recordingOutput))
+	// Not locked across stopRecording, it waits for the segment worker which takes the lock
+	bool recordingActive = false;
+	{
+		std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
+		recordingActive = recordingOutput && obs_output_active(recordingOutput);
+	}
+	if (recordingActive)
 		stopRecording();
+
+	for (auto& destination : streamingDestinations) {
+		if (destination.second->output && obs_output_active(destination.second->output))
+			obs_output_force_stop(destination.second->output);
+	}
+}
+
+void OBS_service::startAdaptiveBitrate(void)
+{
+	// A previous stream may have ended on its own, without stopStreaming
+	stopAdaptiveBitrate();
+
+	config_t* config = ConfigManager::getInstance().getBasic();
+	if (!config_get_bool(config, "Output", "AdaptiveBitrate"))
+		return;
+
+	// The rtmp output adapts the bitrate itself when dynamic bitrate is on
+	if (config_get_bool(config, "Output", "DynamicBitrate")) {
+		blog(LOG_INFO, "Adaptive bitrate disabled, dynamic bitrate is enabled on the output");
+		return;
+	}
+
+	obs_data_t* settings    = obs_encoder_get_settings(videoStreamingEncoder);
+	int64_t     bitrate     = obs_data_get_int(settings, "bitrate");
+	std::string rateControl = obs_data_get_string(settings, "rate_control");
+	obs_data_release(settings);
+
+	// Quality based rate controls have no bitrate to step
+	if (bitrate <= 0 || (!rateControl.empty() && astrcmpi(rateControl.c_str(), "CBR") != 0
+	                     && astrcmpi(rateControl.c_str(), "VBR") != 0 && astrcmpi(rateControl.c_str(), "ABR") != 0)) {
+		blog(LOG_INFO, "Adaptive bitrate disabled, the streaming encoder has no target bitrate");
+		return;
+	}
+
+	if (isStreamingEncoderShared()) {
+		blog(LOG_INFO, "Adaptive bitrate disabled, the streaming encoder is shared with another output");
+		return;
+	}
+
+	std::unique_lock<std::mutex> ulock(adaptiveBitrate.mtx);
+	adaptiveBitrate.output  = obs_output_get_ref(streamingOutput);
+	adaptiveBitrate.encoder = obs_encoder_get_ref(videoStreamingEncoder);
+	if (!adaptiveBitrate.output || !adaptiveBitrate.encoder) {
+		obs_output_release(adaptiveBitrate.output);
+		obs_encoder_release(adaptiveBitrate.encoder);
+		adaptiveBitrate.output  = nullptr;
+		adaptiveBitrate.encoder = nullptr;
+		return;
+	}
+	signal_handler_connect(
+	    obs_output_get_signal_handler(adaptiveBitrate.output), "stop", onAdaptiveBitrateOutputStop, nullptr);
+
+	adaptiveBitrate.originalKbps = bitrate;
+	adaptiveBitrate.currentKbps  = bitrate;
+	adaptiveBitrate.minKbps      = int64_t(config_get_uint(config, "Output", "AdaptiveBitrateMin"));
+	adaptiveBitrate.maxKbps      = int64_t(config_get_uint(config, "Output", "AdaptiveBitrateMax"));
+	if (adaptiveBitrate.maxKbps <= 0)
+		adaptiveBitrate.maxKbps = bitrate;
+	adaptiveBitrate.minKbps = std::min(adaptiveBitrate.minKbps, adaptiveBitrate.maxKbps);
+
+	adaptiveBitrate.lastDropped = 0;
+	adaptiveBitrate.lastTotal   = 0;
+	adaptiveBitrate.lastBytes   = 0;
+	adaptiveBitrate.lastTimeNs  = os_gettime_ns();
+	adaptiveBitrate.stableTicks = 0;
+	adaptiveBitrate.cooldown    = 0;
+	adaptiveBitrate.kbpsHistory.clear();
+	adaptiveBitrate.stop   = false;
+	adaptiveBitrate.worker = std::thread(adaptiveBitrateWorker);
+
+	blog(
+	    LOG_INFO,
+	    "Adaptive bitrate enabled between %lld and %lld kbps",
+	    (long long)adaptiveBitrate.minKbps,
+	    (long long)adaptiveBitrate.maxKbps);
+}
+
+void OBS_service::stopAdaptiveBitrate(void)
+{
+	std::unique_lock<std::mutex> ulock(adaptiveBitrate.mtx);
+	if (!adaptiveBitrate.worker.joinable())
+		return;
+
+	adaptiveBitrate.stop = true;
+	ulock.unlock();
+	adaptiveBitrate.cv.notify_all();
+	adaptiveBitrate.worker.join();
+
+	signal_handler_disconnect(
+	    obs_output_get_signal_handler(adaptiveBitrate.output), "stop", onAdaptiveBitrateOutputStop, nullptr);
+
+	// Other outputs may keep using the encoder, give them back the configured bitrate
+	if (adaptiveBitrate.currentKbps != adaptiveBitrate.originalKbps)
+		setStreamingBitrate(adaptiveBitrate.originalKbps, "restored");
+
+	obs_output_release(adaptiveBitrate.output);
+	obs_encoder_release(adaptiveBitrate.encoder);
+	adaptiveBitrate.output  = nullptr;
+	adaptiveBitrate.encoder = nullptr;
+}
+
+void OBS_service::onAdaptiveBitrateOutputStop(void* data, calldata_t* params)
+{
+	// Only wakes the worker up, it is joined by the next stopAdaptiveBitrate on the IPC thread
+	std::unique_lock<std::mutex> ulock(adaptiveBitrate.mtx);
+	adaptiveBitrate.stop = true;
+	adaptiveBitrate.cv.notify_all();
+}
+
+bool OBS_service::isStreamingEncoderShared(void)
+{
+	for (auto& destination : streamingDestinations) {
+		obs_output_t* output = destination.second->output;
+		if (output && obs_output_get_video_encoder(output) == videoStreamingEncoder
+		    && (obs_output_active(output) || obs_output_reconnecting(output)))
+			return true;
+	}
+
+	// Recording and the replay buffer use the stream encoder itself in simple mode and without multiple rendering
+	{
+		std::unique_lock<std::recursive_mutex> olock(recordingOutputMutex);
+		if (recordingOutput && obs_output_active(recordingOutput)
+		    && obs_output_get_video_encoder(recordingOutput) == videoStreamingEncoder)
+			return true;
+	}
+	return replayBufferOutput && obs_output_active(replayBufferOutput)
+	       && obs_output_get_video_encoder(replayBufferOutput) == videoStreamingEncoder;
+}
+
+bool OBS_service::setStreamingBitrate(int64_t kbps, const char* reason)
+{
+	obs_data_t* settings = obs_encoder_get_settings(adaptiveBitrate.encoder);
+	obs_data_set_int(settings, "bitrate", kbps);
+	bool updated = EncoderRegistry::Update(adaptiveBitrate.encoder, settings);
+	obs_data_release(settings);
+
+	// Another running output started using the encoder, its bitrate stays as is
+	if (!updated)
+		return false;
+
+	adaptiveBitrate.currentKbps = kbps;
+	blog(LOG_INFO, "Adaptive bitrate: %lld kbps (%s)", (long long)kbps, reason);
+
+	SignalInfo signal = SignalInfo("streaming", "bitrate");
+	signal.setCode(int(kbps));
+	signal.setErrorMessage(reason);
+
+	std::unique_lock<std::mutex> ulock(signalMutex);
+	outputSignal.push(signal);
+	return true;
+}
+
+void OBS_service::adaptiveBitrateWorker(void)
+{
+	std::unique_lock<std::mutex> ulock(adaptiveBitrate.mtx);
+	while (!adaptiveBitrate.stop) {
+		adaptiveBitrate.cv.wait_for(ulock, std::chrono::milliseconds(kAdaptiveBitrateIntervalMs));
+		if (adaptiveBitrate.stop)
+			break;
+
+		obs_output_t* output = adaptiveBitrate.output;
+		if (!obs_output_active(output) || obs_output_reconnecting(output))
+			continue;
+
+		int      dropped = obs_output_get_frames_dropped(output);
+		int      total   = obs_output_get_total_frames(output);
+		uint64_t bytes   = obs_output_get_total_bytes(output);
+		uint64_t now     = os_gettime_ns();
+		double   congestion = double(obs_output_get_congestion(output));
+
+		// Counters restart on reconnect
+		if (total < adaptiveBitrate.lastTotal || bytes < adaptiveBitrate.lastBytes) {
+			adaptiveBitrate.lastDropped = dropped;
+			adaptiveBitrate.lastTotal   = total;
+			adaptiveBitrate.lastBytes   = bytes;
+			adaptiveBitrate.lastTimeNs  = now;
+			continue;
+		}
+
+		int    frames    = total - adaptiveBitrate.lastTotal;
+		double dropRatio = frames > 0 ? double(dropped - adaptiveBitrate.lastDropped) / frames : 0.0;
+		double seconds   = double(now - adaptiveBitrate.lastTimeNs) / 1000000000.0;
+		if (seconds > 0) {
+			adaptiveBitrate.kbpsHistory.push_back(double(bytes - adaptiveBitrate.lastBytes) * 8 / seconds / 1000.0);
+			if (adaptiveBitrate.kbpsHistory.size() > kAdaptiveBitrateHistory)
+				adaptiveBitrate.kbpsHistory.pop_front();
+		}
+
+		adaptiveBitrate.lastDropped = dropped;
+		adaptiveBitrate.lastTotal   = total;
+		adaptiveBitrate.lastBytes   = bytes;
+		adaptiveBitrate.lastTimeNs  = now;
+
+		if (adaptiveBitrate.cooldown > 0) {
+			adaptiveBitrate.cooldown--;
+			continue;
+		}
+
+		int64_t     current = adaptiveBitrate.currentKbps;
+		int64_t     target  = current;
+		const char* reason  = nullptr;
+
+		if (dropRatio > kAdaptiveBitrateDropRatio || congestion > kAdaptiveBitrateCongestion) {
+			// Step below what the link actually carried, never more than 25% at once
+			double sent = 0;
+			for (double kbps : adaptiveBitrate.kbpsHistory)
+				sent += kbps;
+			sent /= std::max<size_t>(adaptiveBitrate.kbpsHistory.size(), 1);
+
+			target = current * 3 / 4;
+			if (sent > 0)
+				target = std::max(target, std::min(current, int64_t(sent * 0.9)));
+			target = std::max(target, adaptiveBitrate.minKbps);
+			reason = dropRatio > kAdaptiveBitrateDropRatio ? "dropped_frames" : "congestion";
+			adaptiveBitrate.stableTicks = 0;
+		} else if (dropRatio == 0 && congestion < kAdaptiveBitrateStable) {
+			if (++adaptiveBitrate.stableTicks >= kAdaptiveBitrateStableTicks) {
+				// Only upwards, a bitrate already above the maximum is left alone
+				target = std::max(
+				    current, std::min(adaptiveBitrate.maxKbps, std::max(current + current / 10, current + 50)));
+				reason = "recovered";
+				adaptiveBitrate.stableTicks = 0;
+			}
+		} else {
+			adaptiveBitrate.stableTicks = 0;
+		}
+
+		if (!reason || target == current)
+			continue;
+
+		if (setStreamingBitrate(target, reason))
+			adaptiveBitrate.cooldown = kAdaptiveBitrateCooldownTicks;
+	}
 }
 
 static inline uint32_t setMixer(obs_source_t *source, const int mixerIdx, const bool checked)
@@ -75,6 +75,8 @@ class SignalInfo
 	std::string m_signal;
 	int         m_code;
 	std::string m_errorMessage;
+	std::string m_destination;
+	std::string m_path;
 
 	public:
 	SignalInfo(){};
@@ -110,6 +112,22 @@ class SignalInfo
 	{
 		m_errorMessage = errorMessage;
 	};
+	std::string getDestination(void)
+	{
+		return m_destination;
+	};
+	void setDestination(std::string destination)
+	{
+		m_destination = destination;
+	};
+	std::string getPath(void)
+	{
+		return m_path;
+	};
+	void setPath(std::string path)
+	{
+		m_path = path;
+	};
 };
 
 class OBS_service
@@ -202,16 +220,58 @@ class OBS_service
 	    const int64_t                  id,
 	    const std::vector<ipc::value>& args,
 	    std::vector<ipc::value>&       rval);
+	static void OBS_service_addStreamingDestination(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
+	static void OBS_service_removeStreamingDestination(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
+	static void OBS_service_startStreamingDestination(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
+	static void OBS_service_stopStreamingDestination(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
+	static void OBS_service_getStreamingDestinations(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
 
 	private:
 	static bool startStreaming(void);
 	static void stopStreaming(bool forceStop);
+	static void startAdaptiveBitrate(void);
+	static void stopAdaptiveBitrate(void);
+	static void adaptiveBitrateWorker(void);
+	static void onAdaptiveBitrateOutputStop(void* data, calldata_t* params);
+	static bool isStreamingEncoderShared(void);
+	static bool setStreamingBitrate(int64_t kbps, const char* reason);
 	static bool startRecording(void);
 	static bool startReplayBuffer(void);
 	static void stopReplayBuffer(bool forceStop);
 	static void stopRecording(void);
 
 	static void releaseStreamingOutput(void);
+	static void onStreamingOutputDeactivate(void* data, calldata_t* params);
+
+	static bool setupRecordingSegments(bool isSimpleMode);
+	static void stopRecordingSegments(void);
+	static void releaseStoppedSegments(void);
+	static void recordingSegmentWorker(void);
+	static bool splitRecording(void);
+	static void onRecordingSegmentStopped(void* data, calldata_t* params);
+
+	static bool startStreamingDestination(const std::string& name);
+	static void stopStreamingDestination(const std::string& name, bool forceStop);
 
 	static void LoadRecordingPreset_h264(const char* encoder);
 	static void LoadRecordingPreset_Lossless(void);
@@ -264,9 +324,12 @@ class OBS_service
 	static obs_output_t* getVirtualWebcamOutput(void);
 	static void          setVirtualWebcamOutput(obs_output_t* output);
 	static void          waitReleaseWorker(void);
+	static void          releaseStreamingDestinations(void);
+	static void          releaseRecordingSegments(void);
 
 	// Update settings
 	static void updateStreamingOutput();
+	static void updateStreamingOutputSettings(obs_output_t* output, bool sharedEncoder = false);
 
 	// Update video encoders
 	static void updateStreamingEncoders(bool isSimpleMode);
@@ -279,7 +342,7 @@ class OBS_service
 	static void updateAudioTracks(void);
 
 	// Update outputs
-	static void updateFfmpegOutput(bool isSimpleMode, obs_output_t* output);
+	static void updateFfmpegOutput(bool isSimpleMode, obs_output_t* output, bool segmented = false);
 	static void UpdateFFmpegCustomOutput(void);
 	static void updateReplayBufferOutput(bool isSimpleMode, bool useStreamEncoder);
 
@@ -287,6 +350,7 @@ class OBS_service
 	static std::string GetDefaultVideoSavePath(void);
 
 	static bool isStreamingOutputActive(void);
+	static bool isStreamingEncoderInUse(void);
 	static bool isRecordingOutputActive(void);
 	static bool isReplayBufferOutputActive(void);
 
@@ -300,11 +364,10 @@ class OBS_service
 	// Output signals
 	static void connectOutputSignals(void);
 	static void JSCallbackOutputSignal(void* data, calldata_t*);
+	static void JSCallbackDestinationSignal(void* data, calldata_t*);
 
 	static bool useRecordingPreset();
 
-	static void duplicate_encoder(obs_encoder_t** dst, obs_encoder_t* src, uint64_t trackIndex = 0);
-
 	static bool EncoderAvailable(const char* encoder);
 	static void stopAllOutputs(void);
 
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "nodeobs_settings.h"
+#include "device-registry.h"
 #include "error.hpp"
 #include "nodeobs_api.h"
 #include "shared.hpp"
@@ -66,6 +67,10 @@ void OBS_settings::Register(ipc::server& srv)
 	    "OBS_settings_getOutputAudioDevices", std::vector<ipc::type>{}, OBS_settings_getOutputAudioDevices));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_settings_getVideoDevices", std::vector<ipc::type>{}, OBS_settings_getVideoDevices));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_settings_invalidateDevices", std::vector<ipc::type>{}, OBS_settings_invalidateDevices));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OBS_settings_rescanDevices", std::vector<ipc::type>{}, OBS_settings_rescanDevices));
 
 	srv.register_collection(cls);
 }
@@ -3736,6 +3741,39 @@ std::vector<SubCategory> OBS_settings::getAdvancedSettings()
 	overwriteIfExists.push_back(std::make_pair("stepVal", ipc::value((double)0)));
 	entries.push_back(overwriteIfExists);
 
+	//Split recording into multiple files
+	std::vector<std::pair<std::string, ipc::value>> recSplitFile;
+	recSplitFile.push_back(std::make_pair("name", ipc::value("RecSplitFile")));
+	recSplitFile.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_BOOL")));
+	recSplitFile.push_back(std::make_pair("description", ipc::value("Automatic file splitting")));
+	recSplitFile.push_back(std::make_pair("subType", ipc::value("")));
+	recSplitFile.push_back(std::make_pair("minVal", ipc::value((double)0)));
+	recSplitFile.push_back(std::make_pair("maxVal", ipc::value((double)0)));
+	recSplitFile.push_back(std::make_pair("stepVal", ipc::value((double)0)));
+	entries.push_back(recSplitFile);
+
+	//Split time (minutes)
+	std::vector<std::pair<std::string, ipc::value>> recSplitFileTime;
+	recSplitFileTime.push_back(std::make_pair("name", ipc::value("RecSplitFileTime")));
+	recSplitFileTime.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_INT")));
+	recSplitFileTime.push_back(std::make_pair("description", ipc::value("Split time (minutes, 0 to disable)")));
+	recSplitFileTime.push_back(std::make_pair("subType", ipc::value("")));
+	recSplitFileTime.push_back(std::make_pair("minVal", ipc::value((double)0)));
+	recSplitFileTime.push_back(std::make_pair("maxVal", ipc::value((double)1440)));
+	recSplitFileTime.push_back(std::make_pair("stepVal", ipc::value((double)1)));
+	entries.push_back(recSplitFileTime);
+
+	//Split size (MB)
+	std::vector<std::pair<std::string, ipc::value>> recSplitFileSize;
+	recSplitFileSize.push_back(std::make_pair("name", ipc::value("RecSplitFileSize")));
+	recSplitFileSize.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_INT")));
+	recSplitFileSize.push_back(std::make_pair("description", ipc::value("Split size (MB, 0 to disable)")));
+	recSplitFileSize.push_back(std::make_pair("subType", ipc::value("")));
+	recSplitFileSize.push_back(std::make_pair("minVal", ipc::value((double)0)));
+	recSplitFileSize.push_back(std::make_pair("maxVal", ipc::value((double)1048576)));
+	recSplitFileSize.push_back(std::make_pair("stepVal", ipc::value((double)1)));
+	entries.push_back(recSplitFileSize);
+
 	advancedSettings.push_back(
 	    serializeSettingsData("Recording", entries, ConfigManager::getInstance().getBasic(), "Output", true, true));
 	entries.clear();
@@ -3762,6 +3800,28 @@ std::vector<SubCategory> OBS_settings::getAdvancedSettings()
 	recRBSuffix.push_back(std::make_pair("stepVal", ipc::value((double)0)));
 	entries.push_back(recRBSuffix);
 
+	//Keep the replay buffer on disk
+	std::vector<std::pair<std::string, ipc::value>> recRBDiskSpill;
+	recRBDiskSpill.push_back(std::make_pair("name", ipc::value("RecRBDiskSpill")));
+	recRBDiskSpill.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_BOOL")));
+	recRBDiskSpill.push_back(std::make_pair("description", ipc::value("Keep the replay buffer on disk")));
+	recRBDiskSpill.push_back(std::make_pair("subType", ipc::value("")));
+	recRBDiskSpill.push_back(std::make_pair("minVal", ipc::value((double)0)));
+	recRBDiskSpill.push_back(std::make_pair("maxVal", ipc::value((double)0)));
+	recRBDiskSpill.push_back(std::make_pair("stepVal", ipc::value((double)0)));
+	entries.push_back(recRBDiskSpill);
+
+	//Memory used by the on-disk replay buffer (MB)
+	std::vector<std::pair<std::string, ipc::value>> recRBMemoryHead;
+	recRBMemoryHead.push_back(std::make_pair("name", ipc::value("RecRBMemoryHead")));
+	recRBMemoryHead.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_INT")));
+	recRBMemoryHead.push_back(std::make_pair("description", ipc::value("Replay buffer memory (MB)")));
+	recRBMemoryHead.push_back(std::make_pair("subType", ipc::value("")));
+	recRBMemoryHead.push_back(std::make_pair("minVal", ipc::value((double)1)));
+	recRBMemoryHead.push_back(std::make_pair("maxVal", ipc::value((double)1024)));
+	recRBMemoryHead.push_back(std::make_pair("stepVal", ipc::value((double)1)));
+	entries.push_back(recRBMemoryHead);
+
 	advancedSettings.push_back(serializeSettingsData(
 	    "Replay Buffer", entries, ConfigManager::getInstance().getBasic(), "SimpleOutput", true, true));
 	entries.clear();
@@ -3882,6 +3942,41 @@ std::vector<SubCategory> OBS_settings::getAdvancedSettings()
 	dynamicBitrate.push_back(std::make_pair("stepVal", ipc::value((double)0)));
 	entries.push_back(dynamicBitrate);
 
+	//Adapt the encoder bitrate without restarting the stream
+	std::vector<std::pair<std::string, ipc::value>> adaptiveBitrate;
+	adaptiveBitrate.push_back(std::make_pair("name", ipc::value("AdaptiveBitrate")));
+	adaptiveBitrate.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_BOOL")));
+	adaptiveBitrate.push_back(
+	    std::make_pair("description", ipc::value("Adapt the encoder bitrate to network conditions while streaming")));
+	adaptiveBitrate.push_back(std::make_pair("subType", ipc::value("")));
+	adaptiveBitrate.push_back(std::make_pair("minVal", ipc::value((double)0)));
+	adaptiveBitrate.push_back(std::make_pair("maxVal", ipc::value((double)0)));
+	adaptiveBitrate.push_back(std::make_pair("stepVal", ipc::value((double)0)));
+	entries.push_back(adaptiveBitrate);
+
+	//Adaptive bitrate floor (kbps)
+	std::vector<std::pair<std::string, ipc::value>> adaptiveBitrateMin;
+	adaptiveBitrateMin.push_back(std::make_pair("name", ipc::value("AdaptiveBitrateMin")));
+	adaptiveBitrateMin.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_INT")));
+	adaptiveBitrateMin.push_back(std::make_pair("description", ipc::value("Minimum bitrate (kbps)")));
+	adaptiveBitrateMin.push_back(std::make_pair("subType", ipc::value("")));
+	adaptiveBitrateMin.push_back(std::make_pair("minVal", ipc::value((double)100)));
+	adaptiveBitrateMin.push_back(std::make_pair("maxVal", ipc::value((double)1000000)));
+	adaptiveBitrateMin.push_back(std::make_pair("stepVal", ipc::value((double)50)));
+	entries.push_back(adaptiveBitrateMin);
+
+	//Adaptive bitrate ceiling (kbps)
+	std::vector<std::pair<std::string, ipc::value>> adaptiveBitrateMax;
+	adaptiveBitrateMax.push_back(std::make_pair("name", ipc::value("AdaptiveBitrateMax")));
+	adaptiveBitrateMax.push_back(std::make_pair("type", ipc::value("OBS_PROPERTY_INT")));
+	adaptiveBitrateMax.push_back(
+	    std::make_pair("description", ipc::value("Maximum bitrate (kbps, 0 for the encoder bitrate)")));
+	adaptiveBitrateMax.push_back(std::make_pair("subType", ipc::value("")));
+	adaptiveBitrateMax.push_back(std::make_pair("minVal", ipc::value((double)0)));
+	adaptiveBitrateMax.push_back(std::make_pair("maxVal", ipc::value((double)1000000)));
+	adaptiveBitrateMax.push_back(std::make_pair("stepVal", ipc::value((double)50)));
+	entries.push_back(adaptiveBitrateMax);
+
 #ifdef WIN32
 	//Enable new networking code
 	std::vector<std::pair<std::string, ipc::value>> newSocketLoopEnable;
@@ -4162,57 +4257,63 @@ void OBS_settings::saveGenericSettings(std::vector<SubCategory> genericSettings,
 	config_save_safe(config, "tmp", nullptr);
 }
 
-void getDevices(
-	const char* source_id,
-	const char* property_name,
-	std::vector<ipc::value>& rval)
+static bool enumerateDevices(const std::string& source_id, const std::string& property_name, DeviceRegistry::DeviceList& devices)
 {
-	auto settings = obs_get_source_defaults(source_id);
+	auto settings = obs_get_source_defaults(source_id.c_str());
 	if (!settings)
-		return;
+		return false;
 
 	const char* dummy_device_name = "does_not_exist";
-	obs_data_set_string(settings, property_name, dummy_device_name);
-	if (strcmp(source_id, "dshow_input") == 0) {
+	obs_data_set_string(settings, property_name.c_str(), dummy_device_name);
+	if (source_id == "dshow_input") {
 		obs_data_set_string(settings, "video_device_id", dummy_device_name);
 		obs_data_set_string(settings, "audio_device_id", dummy_device_name);
 	}
 
-	auto dummy_source = obs_source_create(source_id, dummy_device_name, settings, nullptr);
+	auto dummy_source = obs_source_create(source_id.c_str(), dummy_device_name, settings, nullptr);
+	obs_data_release(settings);
 	if (!dummy_source)
-		return;
+		return false;
 
 	auto props = obs_source_properties(dummy_source);
-	if (!props)
-		return;
+	auto prop  = props ? obs_properties_get(props, property_name.c_str()) : nullptr;
+	if (prop) {
+		size_t items = obs_property_list_item_count(prop);
+		for (size_t idx = 0; idx < items; idx++) {
+			const char* description = obs_property_list_item_name(prop, idx);
+			const char* device_id   = obs_property_list_item_string(prop, idx);
 
-	auto prop = obs_properties_get(props, property_name);
-	if (!prop)
-		return;
-
-	size_t items = obs_property_list_item_count(prop);
-	if (rval.size() > 1)
-		rval[1].value_union.ui64 += items;
-	else
-		rval.push_back(ipc::value((uint64_t)items));
-
-	for (size_t idx = 0; idx < items; idx++) {
-		const char* description = obs_property_list_item_name(prop, idx);
-		const char* device_id = obs_property_list_item_string(prop, idx);
+			if (!description || !strcmp(description, "") || !device_id || !strcmp(device_id, ""))
+				continue;
 
-		if (!description || !strcmp(description, "") ||
-			!device_id || !strcmp(device_id, "")) {
-			rval[1].value_union.ui64--;
-			continue;
+			devices.emplace_back(description, device_id);
 		}
-
-		rval.push_back(ipc::value(description));
-		rval.push_back(ipc::value(device_id));
 	}
 
 	obs_properties_destroy(props);
-	obs_data_release(settings);
 	obs_source_release(dummy_source);
+	return prop != nullptr;
+}
+
+static DeviceRegistry& getDeviceRegistry()
+{
+	static DeviceRegistry registry(enumerateDevices);
+	return registry;
+}
+
+void getDevices(
+	const char* source_id,
+	const char* property_name,
+	std::vector<ipc::value>& rval)
+{
+	DeviceRegistry::DeviceList devices;
+	getDeviceRegistry().Get(source_id, property_name, devices);
+
+	rval.push_back(ipc::value((uint64_t)devices.size()));
+	for (auto& device : devices) {
+		rval.push_back(ipc::value(device.first));
+		rval.push_back(ipc::value(device.second));
+	}
 }
 
 void OBS_settings::OBS_settings_getInputAudioDevices(
@@ -4268,4 +4369,37 @@ void OBS_settings::OBS_settings_getVideoDevices(
 #endif
 
 	getDevices(source_id, property_name, rval);
+	AUTO_DEBUG;
+}
+
+void OBS_settings::OBS_settings_invalidateDevices(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	uint64_t generation = getDeviceRegistry().Invalidate();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(generation));
+	AUTO_DEBUG;
+}
+
+void OBS_settings::OBS_settings_rescanDevices(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Listing devices instantiates sources, done here rather than on a thread of its own
+	uint64_t generation = getDeviceRegistry().Rescan();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(generation));
+	AUTO_DEBUG;
+}
+
+void OBS_settings::releaseDevices(void)
+{
+	getDeviceRegistry().Invalidate();
 }
@@ -182,6 +182,19 @@ class OBS_settings
 	    const int64_t                  id,
 	    const std::vector<ipc::value>& args,
 	    std::vector<ipc::value>&       rval);
+	static void OBS_settings_invalidateDevices(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
+	static void OBS_settings_rescanDevices(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
+
+	// Drops the cached device lists, called before libobs shuts down
+	static void releaseDevices(void);
 
 	private:
 	// Exposed methods to the frontend
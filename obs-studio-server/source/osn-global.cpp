@@ -18,9 +18,14 @@
 
 #include "osn-global.hpp"
 #include <error.hpp>
+#include <inttypes.h>
 #include <obs.h>
 #include "osn-source.hpp"
 #include "shared.hpp"
+#include "type-catalog.h"
+#include "utility.hpp"
+
+static TypeCatalog typeCatalog;
 
 void osn::Global::Register(ipc::server& srv)
 {
@@ -40,6 +45,8 @@ void osn::Global::Register(ipc::server& srv)
 	    std::make_shared<ipc::function>("GetMultipleRendering", std::vector<ipc::type>{}, GetMultipleRendering));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "SetMultipleRendering", std::vector<ipc::type>{ipc::type::Int32}, SetMultipleRendering));
+	cls->register_function(
+	    std::make_shared<ipc::function>("GetTypeCatalog", std::vector<ipc::type>{ipc::type::UInt64}, GetTypeCatalog));
 	srv.register_collection(cls);
 }
 
@@ -180,3 +187,119 @@ void osn::Global::SetMultipleRendering(
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
 }
+
+// obs_data_get_json only writes values that were set, the defaults are copied over as values first
+static obs_data_t* DefaultsToValues(obs_data_t* defaults)
+{
+	obs_data_t* values = obs_data_create();
+	for (obs_data_item_t* item = obs_data_first(defaults); item; obs_data_item_next(&item)) {
+		const char* name = obs_data_item_get_name(item);
+		switch (obs_data_item_gettype(item)) {
+		case OBS_DATA_STRING:
+			obs_data_set_string(values, name, obs_data_item_get_default_string(item));
+			break;
+		case OBS_DATA_NUMBER:
+			if (obs_data_item_numtype(item) == OBS_DATA_NUM_DOUBLE)
+				obs_data_set_double(values, name, obs_data_item_get_default_double(item));
+			else
+				obs_data_set_int(values, name, obs_data_item_get_default_int(item));
+			break;
+		case OBS_DATA_BOOLEAN:
+			obs_data_set_bool(values, name, obs_data_item_get_default_bool(item));
+			break;
+		case OBS_DATA_OBJECT: {
+			obs_data_t* obj = obs_data_item_get_default_obj(item);
+			if (obj) {
+				obs_data_t* objValues = DefaultsToValues(obj);
+				obs_data_set_obj(values, name, objValues);
+				obs_data_release(objValues);
+				obs_data_release(obj);
+			}
+			break;
+		}
+		case OBS_DATA_ARRAY: {
+			obs_data_array_t* array = obs_data_item_get_default_array(item);
+			if (array) {
+				obs_data_set_array(values, name, array);
+				obs_data_array_release(array);
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+	return values;
+}
+
+static void AddTypes(bool (*enumTypes)(size_t, const char**), obs_source_type type, std::vector<TypeCatalog::Entry>& entries)
+{
+	const char* typeId = nullptr;
+	for (size_t idx = 0; enumTypes(idx, &typeId); idx++) {
+		if (!typeId)
+			continue;
+
+		TypeCatalog::Entry entry;
+		entry.id          = typeId;
+		entry.type        = type;
+		entry.outputFlags = obs_get_source_output_flags(typeId);
+
+		const char* name  = obs_source_get_display_name(typeId);
+		entry.displayName = name ? name : "";
+
+		// Properties may fill in settings they need, the defaults are read first
+		obs_data_t* defaults = obs_get_source_defaults(typeId);
+		obs_data_t* values   = defaults ? DefaultsToValues(defaults) : nullptr;
+		const char* json     = values ? obs_data_get_json(values) : nullptr;
+		entry.defaults       = json ? json : "{}";
+		obs_data_release(values);
+
+		obs_properties_t* prp = obs_get_source_properties(typeId);
+		entry.propertiesHash  = prp ? utility::GetPropertySchemaHash(prp, defaults) : 0;
+		obs_properties_destroy(prp);
+		obs_data_release(defaults);
+
+		entries.push_back(std::move(entry));
+	}
+}
+
+void osn::Global::BuildTypeCatalog()
+{
+	std::vector<TypeCatalog::Entry> entries;
+	AddTypes(obs_enum_input_types, OBS_SOURCE_TYPE_INPUT, entries);
+	AddTypes(obs_enum_filter_types, OBS_SOURCE_TYPE_FILTER, entries);
+	AddTypes(obs_enum_transition_types, OBS_SOURCE_TYPE_TRANSITION, entries);
+
+	uint64_t fingerprint = typeCatalog.Set(entries);
+	blog(LOG_INFO, "Type catalog: %zu types, fingerprint %016" PRIx64, entries.size(), fingerprint);
+}
+
+void osn::Global::ClearTypeCatalog()
+{
+	typeCatalog.Clear();
+}
+
+void osn::Global::GetTypeCatalog(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::vector<TypeCatalog::Entry> entries;
+	uint64_t                        knownFingerprint = args[0].value_union.ui64;
+	uint64_t                        fingerprint      = typeCatalog.Get(knownFingerprint, entries);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(fingerprint));
+	rval.push_back(ipc::value((uint32_t)(fingerprint != 0 && fingerprint == knownFingerprint)));
+	rval.push_back(ipc::value((uint32_t)entries.size()));
+	for (auto& entry : entries) {
+		rval.push_back(ipc::value(entry.id));
+		rval.push_back(ipc::value(entry.type));
+		rval.push_back(ipc::value(entry.displayName));
+		rval.push_back(ipc::value(entry.outputFlags));
+		rval.push_back(ipc::value(entry.defaults));
+		rval.push_back(ipc::value(entry.propertiesHash));
+	}
+	AUTO_DEBUG;
+}
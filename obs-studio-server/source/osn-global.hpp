@@ -66,5 +66,14 @@ namespace osn
 		    const int64_t                  id,
 		    const std::vector<ipc::value>& args,
 		    std::vector<ipc::value>&       rval);
+
+		// Collects the catalog of source types, once the modules are loaded
+		static void BuildTypeCatalog();
+		static void ClearTypeCatalog();
+		static void GetTypeCatalog(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
 	};
 } // namespace osn
\ No newline at end of file
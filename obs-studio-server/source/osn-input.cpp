@@ -17,11 +17,17 @@
 ******************************************************************************/
 
 #include "osn-Input.hpp"
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <ipc-server.hpp>
 #include <memory>
 #include <obs.h>
+#include <set>
+#include <string>
+#include <thread>
 #include "error.hpp"
+#include "filter-chain-plan.h"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
@@ -39,6 +45,8 @@ void osn::Input::Register(ipc::server& srv)
 	    Create));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "CreatePrivate", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, CreatePrivate));
+	cls->register_function(
+	    std::make_shared<ipc::function>("CreateBatch", std::vector<ipc::type>{ipc::type::String}, CreateBatch));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "CreatePrivate",
 	    std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String},
@@ -101,6 +109,8 @@ void osn::Input::Register(ipc::server& srv)
 	    "FindFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, FindFilter));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "CopyFiltersTo", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, CopyFiltersTo));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "SetFilterChain", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, SetFilterChain));
 
 	cls->register_function(std::make_shared<ipc::function>(
 	    "GetDuration", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, GetDuration));
@@ -175,6 +185,160 @@ void osn::Input::Create(
 	AUTO_DEBUG;
 }
 
+// Upper bound of the threads creating the sources of a batch
+static const size_t CreateBatchWorkers = 4;
+
+// Types whose create callback opens nothing tied to the creating thread (COM, devices,
+// windows, capture sessions), the only ones created off the IPC thread
+static const std::set<std::string> ParallelCreateTypes = {
+    "color_source",
+    "color_source_v2",
+    "color_source_v3",
+    "image_source",
+    "slideshow",
+    "ffmpeg_source",
+};
+
+struct BatchSource
+{
+	obs_data_t*   info   = nullptr;
+	obs_source_t* source = nullptr;
+};
+
+static void CreateBatchSources(std::vector<BatchSource>& batch)
+{
+	auto create = [](BatchSource& entry) {
+		obs_data_t* settings = obs_data_get_obj(entry.info, "settings");
+		const char* type     = obs_data_get_string(entry.info, "type");
+		const char* name     = obs_data_get_string(entry.info, "name");
+		entry.source         = obs_source_create(type, name, settings, nullptr);
+		obs_data_release(settings);
+	};
+
+	std::vector<BatchSource*> parallel, serial;
+	for (auto& entry : batch) {
+		if (ParallelCreateTypes.count(obs_data_get_string(entry.info, "type")))
+			parallel.push_back(&entry);
+		else
+			serial.push_back(&entry);
+	}
+
+	size_t workers = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), CreateBatchWorkers);
+	workers        = std::min(workers, parallel.size());
+
+	// Sources don't depend on each other, libobs serializes what they share
+	std::atomic<size_t> next(0);
+	auto                work = [&parallel, &next, &create]() {
+		for (size_t n = next++; n < parallel.size(); n = next++)
+			create(*parallel[n]);
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t n = 0; n < workers; n++)
+		threads.emplace_back(work);
+
+	// Everything else is created here, as Input.Create would, then this thread helps out
+	for (BatchSource* entry : serial)
+		create(*entry);
+	work();
+	for (auto& thread : threads)
+		thread.join();
+}
+
+static void ApplyBatchSource(obs_source_t* source, obs_data_t* info)
+{
+	if (obs_source_get_audio_mixers(source)) {
+		obs_data_t* syncOffset = obs_data_get_obj(info, "syncOffset");
+		int64_t     offset     = 0;
+		if (syncOffset)
+			offset = obs_data_get_int(syncOffset, "sec") * 1000000000 + obs_data_get_int(syncOffset, "nsec");
+		obs_data_release(syncOffset);
+
+		obs_source_set_muted(source, obs_data_get_bool(info, "muted"));
+		obs_source_set_volume(
+		    source, obs_data_has_user_value(info, "volume") ? float(obs_data_get_double(info, "volume")) : 1.0f);
+		obs_source_set_sync_offset(source, offset);
+	}
+
+	obs_data_array_t* filters = obs_data_get_array(info, "filters");
+	for (size_t idx = 0; idx < obs_data_array_count(filters); idx++) {
+		obs_data_t*   filterInfo = obs_data_array_item(filters, idx);
+		obs_data_t*   settings   = obs_data_get_obj(filterInfo, "settings");
+		const char*   type       = obs_data_get_string(filterInfo, "type");
+		const char*   name       = obs_data_get_string(filterInfo, "name");
+		obs_source_t* filter     = obs_source_create_private(type, name, settings);
+		obs_data_release(settings);
+
+		if (filter) {
+			// Same bookkeeping as Filter.Create, the client may look the filter up later
+			if (osn::Source::Manager::GetInstance().allocate(filter) != UINT64_MAX)
+				osn::Source::attach_source_signals(filter);
+
+			obs_source_set_enabled(
+			    filter, obs_data_has_user_value(filterInfo, "enabled") ? obs_data_get_bool(filterInfo, "enabled") : true);
+			obs_source_filter_add(source, filter);
+			obs_source_release(filter);
+		} else {
+			blog(LOG_WARNING, "Failed to create filter '%s' of type '%s'.", name, type);
+		}
+		obs_data_release(filterInfo);
+	}
+	obs_data_array_release(filters);
+}
+
+void osn::Input::CreateBatch(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// The sources come as the JSON array given to createSources
+	std::string json    = "{\"sources\":" + args[0].value_str + "}";
+	obs_data_t* request = obs_data_create_from_json(json.c_str());
+	if (!request) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source list is not valid JSON.");
+	}
+
+	obs_data_array_t*        sources = obs_data_get_array(request, "sources");
+	std::vector<BatchSource> batch(obs_data_array_count(sources));
+	for (size_t idx = 0; idx < batch.size(); idx++)
+		batch[idx].info = obs_data_array_item(sources, idx);
+	obs_data_array_release(sources);
+	obs_data_release(request);
+
+	CreateBatchSources(batch);
+
+	// uid, settings, audio mixers and muted per source, UINT64_MAX as uid if it failed
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	for (auto& entry : batch) {
+		uint64_t uid = entry.source ? osn::Source::Manager::GetInstance().find(entry.source) : UINT64_MAX;
+		if (uid == UINT64_MAX) {
+			if (entry.source)
+				obs_source_release(entry.source);
+			blog(
+			    LOG_WARNING,
+			    "Failed to create input '%s' of type '%s'.",
+			    obs_data_get_string(entry.info, "name"),
+			    obs_data_get_string(entry.info, "type"));
+			rval.push_back(ipc::value(uint64_t(UINT64_MAX)));
+			rval.push_back(ipc::value(""));
+			rval.push_back(ipc::value(uint32_t(0)));
+			rval.push_back(ipc::value(false));
+		} else {
+			ApplyBatchSource(entry.source, entry.info);
+
+			obs_data_t* settings = obs_source_get_settings(entry.source);
+			rval.push_back(ipc::value(uid));
+			rval.push_back(ipc::value(obs_data_get_full_json(settings)));
+			rval.push_back(ipc::value(obs_source_get_audio_mixers(entry.source)));
+			rval.push_back(ipc::value(obs_source_muted(entry.source)));
+			obs_data_release(settings);
+		}
+		obs_data_release(entry.info);
+	}
+	AUTO_DEBUG;
+}
+
 void osn::Input::CreatePrivate(
     void*                          data,
     const int64_t                  id,
@@ -708,6 +872,122 @@ void osn::Input::CopyFiltersTo(
 	AUTO_DEBUG;
 }
 
+void osn::Input::SetFilterChain(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* input = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!input) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Input reference is not valid.");
+	}
+
+	// The chain comes as the JSON array given to setFilterChain
+	std::string json    = "{\"filters\":" + args[1].value_str + "}";
+	obs_data_t* request = obs_data_create_from_json(json.c_str());
+	if (!request) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Filter chain is not valid JSON.");
+	}
+
+	struct Link
+	{
+		obs_source_t* filter;
+		obs_data_t*   entry;
+	};
+
+	// Nothing changes unless every filter of the chain can be used
+	obs_data_array_t*     entries = obs_data_get_array(request, "filters");
+	std::vector<Link>     chain;
+	std::vector<uint64_t> desired;
+	bool                  valid = true;
+	for (size_t idx = 0; idx < obs_data_array_count(entries); idx++) {
+		obs_data_t*   entry  = obs_data_array_item(entries, idx);
+		uint64_t      uid    = obs_data_get_int(entry, "id");
+		obs_source_t* filter = osn::Source::Manager::GetInstance().find(uid);
+		chain.push_back({filter, entry});
+		desired.push_back(uid);
+
+		obs_source_t* parent = filter ? obs_filter_get_parent(filter) : nullptr;
+		if (!filter || obs_source_get_type(filter) != OBS_SOURCE_TYPE_FILTER || (parent && parent != input))
+			valid = false;
+	}
+	obs_data_array_release(entries);
+	obs_data_release(request);
+
+	auto release = [&chain]() {
+		for (auto& link : chain)
+			obs_data_release(link.entry);
+	};
+
+	auto enum_cb = [](obs_source_t* parent, obs_source_t* filter, void* data) {
+		std::vector<uint64_t>* filters = reinterpret_cast<std::vector<uint64_t>*>(data);
+
+		uint64_t id = osn::Source::Manager::GetInstance().find(filter);
+		if (id != UINT64_MAX) {
+			filters->push_back(id);
+		}
+	};
+
+	std::vector<uint64_t> current;
+	obs_source_enum_filters(input, enum_cb, &current);
+
+	std::vector<FilterChainPlan::Step> steps;
+	if (!valid || !FilterChainPlan::Make(current, desired, steps)) {
+		release();
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Filter chain is not valid.");
+	}
+
+	// libobs relinks the chain on every step, holding the graphics lock keeps
+	// the render thread from drawing a frame through a half applied chain
+	obs_enter_graphics();
+	for (auto& step : steps) {
+		obs_source_t* filter = osn::Source::Manager::GetInstance().find(step.filter);
+		switch (step.action) {
+		case FilterChainPlan::Action::Remove:
+			obs_source_filter_remove(input, filter);
+			break;
+		case FilterChainPlan::Action::Add:
+			obs_source_filter_add(input, filter);
+			break;
+		case FilterChainPlan::Action::MoveToFront:
+			obs_source_filter_set_order(input, filter, OBS_ORDER_MOVE_TOP);
+			break;
+		case FilterChainPlan::Action::MoveToBack:
+			obs_source_filter_set_order(input, filter, OBS_ORDER_MOVE_BOTTOM);
+			break;
+		}
+	}
+	obs_leave_graphics();
+
+	// Filters may create graphics resources while they update, which takes the lock themselves
+	for (auto& link : chain) {
+		if (obs_data_has_user_value(link.entry, "enabled")) {
+			bool enabled = obs_data_get_bool(link.entry, "enabled");
+			if (obs_source_enabled(link.filter) != enabled)
+				obs_source_set_enabled(link.filter, enabled);
+		}
+
+		obs_data_t* settings = obs_data_get_obj(link.entry, "settings");
+		if (settings) {
+			obs_source_update(link.filter, settings);
+			obs_data_release(settings);
+		}
+	}
+	release();
+
+	// The resulting chain, the client would ask for it right after
+	current.clear();
+	obs_source_enum_filters(input, enum_cb, &current);
+	if (current != desired)
+		blog(LOG_WARNING, "Filter chain of '%s' differs from the one requested.", obs_source_get_name(input));
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	for (uint64_t uid : current)
+		rval.push_back(ipc::value(uid));
+	AUTO_DEBUG;
+}
+
 void osn::Input::GetDuration(
     void*                          data,
     const int64_t                  id,
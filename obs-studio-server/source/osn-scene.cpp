@@ -18,10 +18,27 @@
 
 #include "osn-scene.hpp"
 #include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include "error.hpp"
 #include "osn-sceneitem.hpp"
+#include "osn-transition.hpp"
+#include "scene-event-queue.h"
+#include "scene-index.h"
 #include "shared.hpp"
 
+// Signal handler data of a connected scene, valid until its signals are disconnected
+struct SceneConnection
+{
+	uint64_t      uid;
+	obs_source_t* source;
+};
+
+static SceneEventQueue                                       sceneEvents;
+static std::mutex                                            connectionsMutex;
+static std::map<uint64_t, std::unique_ptr<SceneConnection>> connections;
+
 void osn::Scene::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Scene");
@@ -67,6 +84,18 @@ void osn::Scene::Register(ipc::server& srv)
 	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32},
 	    GetItemsInRange));
 
+	cls->register_function(std::make_shared<ipc::function>(
+	    "HitTest", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Double, ipc::type::Double}, HitTest));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "QueryRect",
+	    std::vector<ipc::type>{
+	        ipc::type::UInt64, ipc::type::Double, ipc::type::Double, ipc::type::Double, ipc::type::Double},
+	    QueryRect));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "SnapCandidates",
+	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64, ipc::type::Double},
+	    SnapCandidates));
+
 	cls->register_function(
 	    std::make_shared<ipc::function>("Connect", std::vector<ipc::type>{ipc::type::UInt64}, Connect));
 	cls->register_function(
@@ -179,6 +208,8 @@ void osn::Scene::Release(
 	};
 	obs_scene_enum_items(scene, cb, &items);
 
+	// A transition preparing the scene holds a reference and keeps it showing
+	osn::Transition::CancelPreparations(args[0].value_union.ui64);
 	obs_source_release(source);
 
 	for (auto item : items) {
@@ -214,6 +245,7 @@ void osn::Scene::Remove(
 	};
 	obs_scene_enum_items(scene, cb, &items);
 
+	osn::Transition::CancelPreparations(args[0].value_union.ui64);
 	obs_source_remove(source);
 	osn::Source::Manager::GetInstance().free(args[0].value_union.ui64);
 
@@ -679,14 +711,254 @@ void osn::Scene::GetItemsInRange(
 	AUTO_DEBUG;
 }
 
+static bool PushItem(obs_sceneitem_t* item, std::vector<ipc::value>& rval)
+{
+	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+	if (uid == UINT64_MAX) {
+		uid = osn::SceneItem::Manager::GetInstance().allocate(item);
+		if (uid == UINT64_MAX)
+			return false;
+		obs_sceneitem_addref(item);
+	}
+	rval.push_back(ipc::value((uint64_t)uid));
+	rval.push_back(ipc::value(obs_sceneitem_get_id(item)));
+	return true;
+}
+
+void osn::Scene::HitTest(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
+	}
+
+	float            x    = float(args[1].value_union.fp64);
+	float            y    = float(args[2].value_union.fp64);
+	obs_sceneitem_t* item = nullptr;
+	bool isScene = SceneIndex::Query(source, [&](util::SpatialIndex& index, obs_scene_t* scene) {
+		const util::SpatialIndex::Entry* entry = index.HitTest(x, y);
+		if (entry)
+			item = obs_scene_find_sceneitem_by_id(scene, int64_t(entry->key));
+	});
+	if (!isScene) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	if (item && !PushItem(item, rval)) {
+		rval.clear();
+		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
+	}
+	AUTO_DEBUG;
+}
+
+void osn::Scene::QueryRect(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
+	}
+
+	util::SpatialIndex::Rect rect;
+	rect.left   = float(args[1].value_union.fp64);
+	rect.top    = float(args[2].value_union.fp64);
+	rect.right  = rect.left + float(args[3].value_union.fp64);
+	rect.bottom = rect.top + float(args[4].value_union.fp64);
+
+	std::vector<obs_sceneitem_t*> found;
+	bool isScene = SceneIndex::Query(source, [&](util::SpatialIndex& index, obs_scene_t* scene) {
+		std::vector<const util::SpatialIndex::Entry*> entries;
+		index.QueryRect(rect, entries);
+		for (auto entry : entries) {
+			obs_sceneitem_t* item = obs_scene_find_sceneitem_by_id(scene, int64_t(entry->key));
+			if (item)
+				found.push_back(item);
+		}
+	});
+	if (!isScene) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	for (obs_sceneitem_t* item : found) {
+		if (!PushItem(item, rval)) {
+			rval.clear();
+			PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
+		}
+	}
+	AUTO_DEBUG;
+}
+
+void osn::Scene::SnapCandidates(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
+	}
+
+	obs_sceneitem_t* target = osn::SceneItem::Manager::GetInstance().find(args[1].value_union.ui64);
+	if (!target) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Item reference is not valid.");
+	}
+
+	struct Candidate
+	{
+		obs_sceneitem_t*         item;
+		util::SpatialIndex::Rect bounds;
+	};
+	std::vector<Candidate> found;
+	uint64_t               key      = uint64_t(obs_sceneitem_get_id(target));
+	float                  distance = float(args[2].value_union.fp64);
+	bool isScene = SceneIndex::Query(source, [&](util::SpatialIndex& index, obs_scene_t* scene) {
+		std::vector<const util::SpatialIndex::Entry*> entries;
+		index.QueryNear(key, distance, entries);
+		for (auto entry : entries) {
+			obs_sceneitem_t* item = obs_scene_find_sceneitem_by_id(scene, int64_t(entry->key));
+			if (item)
+				found.push_back({item, entry->bounds});
+		}
+	});
+	if (!isScene) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
+	}
+
+	// Bounds come along so snapping needs no further call per candidate
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	for (auto& candidate : found) {
+		if (!PushItem(candidate.item, rval)) {
+			rval.clear();
+			PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
+		}
+		rval.push_back(ipc::value(double(candidate.bounds.left)));
+		rval.push_back(ipc::value(double(candidate.bounds.top)));
+		rval.push_back(ipc::value(double(candidate.bounds.right)));
+		rval.push_back(ipc::value(double(candidate.bounds.bottom)));
+	}
+	AUTO_DEBUG;
+}
+
+static int64_t GetItemId(calldata_t* cd)
+{
+	obs_sceneitem_t* item = nullptr;
+	if (!calldata_get_ptr(cd, "item", &item) || !item)
+		return -1;
+	return obs_sceneitem_get_id(item);
+}
+
+static void ItemAddCallback(void* data, calldata_t* cd)
+{
+	int64_t item = GetItemId(cd);
+	if (item >= 0)
+		sceneEvents.ItemAdded(reinterpret_cast<SceneConnection*>(data)->uid, item);
+}
+
+static void ItemRemoveCallback(void* data, calldata_t* cd)
+{
+	int64_t item = GetItemId(cd);
+	if (item >= 0)
+		sceneEvents.ItemRemoved(reinterpret_cast<SceneConnection*>(data)->uid, item);
+}
+
+static void ItemVisibleCallback(void* data, calldata_t* cd)
+{
+	int64_t item = GetItemId(cd);
+	if (item >= 0)
+		sceneEvents.ItemVisible(reinterpret_cast<SceneConnection*>(data)->uid, item, calldata_bool(cd, "visible"));
+}
+
+static void ItemTransformCallback(void* data, calldata_t* cd)
+{
+	int64_t item = GetItemId(cd);
+	if (item >= 0)
+		sceneEvents.ItemTransformed(reinterpret_cast<SceneConnection*>(data)->uid, item);
+}
+
+static void ReorderCallback(void* data, calldata_t* cd)
+{
+	sceneEvents.Reordered(reinterpret_cast<SceneConnection*>(data)->uid);
+}
+
+static void DisconnectSignals(SceneConnection* connection);
+
+static void DestroyCallback(void* data, calldata_t* cd)
+{
+	SceneConnection*                 current = reinterpret_cast<SceneConnection*>(data);
+	std::unique_ptr<SceneConnection> connection;
+	{
+		std::lock_guard<std::mutex> lock(connectionsMutex);
+		auto                        found = connections.find(current->uid);
+		if (found == connections.end() || found->second.get() != current)
+			return;
+		connection = std::move(found->second);
+		connections.erase(found);
+	}
+
+	// The scene still signals item_remove and item_visible while its items go away
+	// after "destroy", nothing may point at the connection once it is freed
+	sceneEvents.Disconnect(connection->uid);
+	DisconnectSignals(connection.get());
+}
+
+static const std::pair<const char*, signal_callback_t> SceneSignals[] = {
+    {"item_add", ItemAddCallback},
+    {"item_remove", ItemRemoveCallback},
+    {"item_visible", ItemVisibleCallback},
+    {"item_transform", ItemTransformCallback},
+    {"reorder", ReorderCallback},
+    {"destroy", DestroyCallback},
+};
+
+static void DisconnectSignals(SceneConnection* connection)
+{
+	signal_handler_t* sh = obs_source_get_signal_handler(connection->source);
+	for (auto& signal : SceneSignals)
+		signal_handler_disconnect(sh, signal.first, signal.second, connection);
+}
+
 void osn::Scene::Connect(
     void*                          data,
     const int64_t                  id,
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
+	uint64_t      uid    = args[0].value_union.ui64;
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(uid);
+	if (!source || !obs_scene_from_source(source)) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Scene reference is not valid.");
+	}
+
+	SceneConnection* connection = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(connectionsMutex);
+		auto&                       slot = connections[uid];
+		if (!slot) {
+			slot.reset(new SceneConnection{uid, source});
+			connection = slot.get();
+		}
+	}
+
+	// Signal handlers may be running with the scene locked, they're connected without holding the lock
+	if (connection) {
+		sceneEvents.Connect(uid);
+		signal_handler_t* sh = obs_source_get_signal_handler(source);
+		for (auto& signal : SceneSignals)
+			signal_handler_connect(sh, signal.first, signal.second, connection);
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
-	// !FIXME! Signals
 }
 
 void osn::Scene::Disconnect(
@@ -695,6 +967,78 @@ void osn::Scene::Disconnect(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
+	uint64_t                         uid = args[0].value_union.ui64;
+	std::unique_ptr<SceneConnection> connection;
+	{
+		std::lock_guard<std::mutex> lock(connectionsMutex);
+		auto                        found = connections.find(uid);
+		if (found != connections.end()) {
+			connection = std::move(found->second);
+			connections.erase(found);
+		}
+	}
+
+	if (connection) {
+		sceneEvents.Disconnect(uid);
+		DisconnectSignals(connection.get());
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
-	// !FIXME! Signals
+}
+
+// Scene item id and uid, UINT64_MAX as uid if the client never asked for the item
+static void PushItem(obs_scene_t* scene, int64_t item, std::vector<ipc::value>& rval)
+{
+	obs_sceneitem_t* sceneitem = scene ? obs_scene_find_sceneitem_by_id(scene, item) : nullptr;
+	uint64_t         uid       = sceneitem ? osn::SceneItem::Manager::GetInstance().find(sceneitem) : UINT64_MAX;
+	rval.push_back(ipc::value(item));
+	rval.push_back(ipc::value(uid));
+}
+
+void osn::Scene::PollEvents(std::vector<ipc::value>& rval)
+{
+	std::vector<std::pair<uint64_t, SceneEventQueue::Batch>> batches;
+	sceneEvents.Take(batches);
+
+	rval.push_back(ipc::value((uint32_t)batches.size()));
+	for (auto& entry : batches) {
+		SceneEventQueue::Batch& batch  = entry.second;
+		obs_source_t*           source = osn::Source::Manager::GetInstance().find(entry.first);
+		obs_scene_t*            scene  = source ? obs_scene_from_source(source) : nullptr;
+
+		rval.push_back(ipc::value(entry.first));
+		rval.push_back(ipc::value((uint32_t)batch.reordered));
+
+		rval.push_back(ipc::value((uint32_t)batch.added.size()));
+		for (int64_t item : batch.added)
+			PushItem(scene, item, rval);
+
+		rval.push_back(ipc::value((uint32_t)batch.removed.size()));
+		for (int64_t item : batch.removed)
+			rval.push_back(ipc::value(item));
+
+		rval.push_back(ipc::value((uint32_t)batch.visible.size()));
+		for (auto& item : batch.visible) {
+			PushItem(scene, item.first, rval);
+			rval.push_back(ipc::value((uint32_t)item.second));
+		}
+
+		rval.push_back(ipc::value((uint32_t)batch.transformed.size()));
+		for (int64_t item : batch.transformed)
+			PushItem(scene, item, rval);
+	}
+}
+
+void osn::Scene::ClearConnections()
+{
+	std::map<uint64_t, std::unique_ptr<SceneConnection>> remaining;
+	{
+		std::lock_guard<std::mutex> lock(connectionsMutex);
+		remaining.swap(connections);
+	}
+
+	for (auto& connection : remaining)
+		DisconnectSignals(connection.second.get());
+	sceneEvents.Clear();
 }
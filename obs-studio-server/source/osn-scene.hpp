@@ -72,7 +72,18 @@ namespace osn
 		    const std::vector<ipc::value>& args,
 		    std::vector<ipc::value>&       rval);
 
-		// Signals?
+		// Picking and snapping, answered by the spatial index of the scene
+		static void
+		            HitTest(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void
+		            QueryRect(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void SnapCandidates(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+
+		// Item changes of connected scenes are batched and sent with every global query
 		static void
 		            Connect(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 		static void Disconnect(
@@ -80,5 +91,7 @@ namespace osn
 		    const int64_t                  id,
 		    const std::vector<ipc::value>& args,
 		    std::vector<ipc::value>&       rval);
+		static void PollEvents(std::vector<ipc::value>& rval);
+		static void ClearConnections();
 	};
 } // namespace osn
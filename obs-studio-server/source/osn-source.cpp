@@ -31,6 +31,19 @@
 #include "shared.hpp"
 #include "callback-manager.h"
 #include "memory-manager.h"
+#include "media-state-tracker.h"
+#include "osn-transition.hpp"
+
+static MediaStateTracker mediaStates([](uint64_t uid, MediaStateTracker::Sample& sample) {
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(uid);
+	if (!source)
+		return false;
+
+	sample.state    = obs_source_media_get_state(source);
+	sample.time     = obs_source_media_get_time(source);
+	sample.duration = obs_source_media_get_duration(source);
+	return true;
+});
 
 void osn::Source::initialize_global_signals()
 {
@@ -102,6 +115,9 @@ void osn::Source::global_source_destroy_cb(void* ptr, calldata_t* cd)
 
 	CallbackManager::removeSource(source);
 	detach_source_signals(source);
+	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+	if (uid != UINT64_MAX)
+		mediaStates.Unwatch(uid);
 	osn::Source::Manager::GetInstance().free(source);
 	MemoryManager::GetInstance().unregisterSource(source);
 }
@@ -121,7 +137,8 @@ void osn::Source::Register(ipc::server& srv)
 	cls->register_function(
 	    std::make_shared<ipc::function>("IsConfigurable", std::vector<ipc::type>{ipc::type::UInt64}, IsConfigurable));
 	cls->register_function(
-	    std::make_shared<ipc::function>("GetProperties", std::vector<ipc::type>{ipc::type::UInt64}, GetProperties));
+	    std::make_shared<ipc::function>(
+	        "GetProperties", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, GetProperties));
 	cls->register_function(
 	    std::make_shared<ipc::function>("GetSettings", std::vector<ipc::type>{ipc::type::UInt64}, GetSettings));
 	cls->register_function(std::make_shared<ipc::function>("Load", std::vector<ipc::type>{ipc::type::UInt64}, Load));
@@ -151,6 +168,12 @@ void osn::Source::Register(ipc::server& srv)
 	    std::make_shared<ipc::function>("GetEnabled", std::vector<ipc::type>{ipc::type::UInt64}, GetEnabled));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "SetEnabled", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetEnabled));
+	cls->register_function(
+	    std::make_shared<ipc::function>("GetMediaStates", std::vector<ipc::type>{ipc::type::Binary}, GetMediaStates));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "WatchMediaState", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, WatchMediaState));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "UnwatchMediaState", std::vector<ipc::type>{ipc::type::UInt64}, UnwatchMediaState));
 
 	cls->register_function(std::make_shared<ipc::function>(
 	    "SendMouseClick",
@@ -229,6 +252,8 @@ void osn::Source::Remove(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
 	}
 
+	// A preparation holds a reference and keeps the source showing
+	osn::Transition::CancelPreparations(args[0].value_union.ui64);
 	obs_source_remove(src);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -247,6 +272,7 @@ void osn::Source::Release(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
 	}
 
+	osn::Transition::CancelPreparations(args[0].value_union.ui64);
 	obs_source_release(src);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -288,7 +314,8 @@ void osn::Source::GetProperties(
 	obs_properties_t* prp = obs_source_properties(src);
 	obs_data* settings = obs_source_get_settings(src);
 
-	utility::ProcessProperties(prp, settings, updateSource, rval);
+	// The client passes the schema hash it already has so only the values are sent back
+	utility::ProcessProperties(prp, settings, updateSource, rval, args[1].value_union.ui64);
 
 	obs_properties_destroy(prp);
 
@@ -763,6 +790,78 @@ void osn::Source::SendKeyClick(
 }
 
 
+void osn::Source::GetMediaStates(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// The uids come packed as uint64_t, state, time and duration are returned for each of them
+	const std::vector<char>& uids  = args[0].value_bin;
+	size_t                   count = uids.size() / sizeof(uint64_t);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	for (size_t idx = 0; idx < count; idx++) {
+		uint64_t uid = 0;
+		memcpy(&uid, uids.data() + idx * sizeof(uint64_t), sizeof(uint64_t));
+
+		// UINT32_MAX as state if the source is gone
+		obs_source_t* source = osn::Source::Manager::GetInstance().find(uid);
+		rval.push_back(ipc::value(source ? (uint32_t)obs_source_media_get_state(source) : UINT32_MAX));
+		rval.push_back(ipc::value(source ? obs_source_media_get_time(source) : int64_t(0)));
+		rval.push_back(ipc::value(source ? obs_source_media_get_duration(source) : int64_t(0)));
+	}
+	AUTO_DEBUG;
+}
+
+void osn::Source::WatchMediaState(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* src = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!src) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
+	}
+
+	mediaStates.Watch(args[0].value_union.ui64, args[1].value_union.ui32);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Source::UnwatchMediaState(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	mediaStates.Unwatch(args[0].value_union.ui64);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Source::PollMediaStates(std::vector<ipc::value>& rval)
+{
+	std::vector<MediaStateTracker::Change> changes;
+	mediaStates.Poll(changes);
+
+	rval.push_back(ipc::value((uint32_t)changes.size()));
+	for (auto& change : changes) {
+		rval.push_back(ipc::value(change.first));
+		rval.push_back(ipc::value(change.second.state));
+		rval.push_back(ipc::value(change.second.time));
+		rval.push_back(ipc::value(change.second.duration));
+	}
+}
+
+void osn::Source::ClearMediaStates()
+{
+	mediaStates.Clear();
+}
+
 osn::Source::Manager& osn::Source::Manager::GetInstance()
 {
 	static osn::Source::Manager _inst;
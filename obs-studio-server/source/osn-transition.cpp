@@ -23,6 +23,9 @@
 #include "error.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
+#include "transition-preparer.h"
+
+static TransitionPreparer preparer;
 
 void osn::Transition::Register(ipc::server& srv)
 {
@@ -51,6 +54,10 @@ void osn::Transition::Register(ipc::server& srv)
 	    std::make_shared<ipc::function>("Set", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Set));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "Start", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32, ipc::type::UInt64}, Start));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "Prepare", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64, ipc::type::UInt32}, Prepare));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "GetPrepareState", std::vector<ipc::type>{ipc::type::UInt64}, GetPrepareState));
 	srv.register_collection(cls);
 }
 
@@ -208,6 +215,7 @@ void osn::Transition::Clear(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Transition reference is not valid.");
 	}
 
+	preparer.Cancel(args[0].value_union.ui64);
 	obs_transition_clear(transition);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -258,7 +266,111 @@ void osn::Transition::Start(
 
 	bool result = obs_transition_start(transition, OBS_TRANSITION_MODE_AUTO, ms, source);
 
+	// The transition shows the target now, a preparation for it is no longer needed
+	preparer.Cancel(args[0].value_union.ui64);
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(result));
 	AUTO_DEBUG;
 }
+
+static void CheckFirstFrame(obs_source_t*, obs_source_t* child, void* param)
+{
+	// Async video sources get their size from their first frame
+	uint32_t flags = obs_source_get_output_flags(child);
+	if ((flags & OBS_SOURCE_ASYNC_VIDEO) == OBS_SOURCE_ASYNC_VIDEO && obs_source_get_width(child) == 0)
+		*static_cast<bool*>(param) = false;
+}
+
+static bool HasFirstFrames(obs_source_t* source)
+{
+	bool ready = true;
+	CheckFirstFrame(nullptr, source, &ready);
+	obs_source_enum_active_tree(source, CheckFirstFrame, &ready);
+	return ready;
+}
+
+void osn::Transition::Prepare(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* transition = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!transition) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Transition reference is not valid.");
+	}
+
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[1].value_union.ui64);
+	if (!source) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
+	}
+
+	// Both are shown off the IPC and render threads: media and capture sources of the target
+	// open and decode their first frames, as do the media sources of a stinger transition.
+	// The references are dropped on a timeout, once the hold time passes, or when either is released.
+	obs_source_addref(transition);
+	obs_source_addref(source);
+
+	TransitionPreparer::Preparation preparation;
+	preparation.acquire = [transition, source]() {
+		obs_source_inc_showing(source);
+		obs_source_inc_showing(transition);
+	};
+	preparation.ready   = [transition, source]() { return HasFirstFrames(source) && HasFirstFrames(transition); };
+	preparation.release = [transition, source](bool acquired) {
+		if (acquired) {
+			obs_source_dec_showing(transition);
+			obs_source_dec_showing(source);
+		}
+		obs_source_release(transition);
+		obs_source_release(source);
+	};
+
+	preparer.Prepare(
+	    args[0].value_union.ui64,
+	    args[1].value_union.ui64,
+	    std::move(preparation),
+	    std::chrono::milliseconds(args[2].value_union.ui32));
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Transition::GetPrepareState(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	uint64_t                  target = UINT64_MAX;
+	TransitionPreparer::State state  = preparer.GetState(args[0].value_union.ui64, target);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)state));
+	rval.push_back(ipc::value(target));
+	AUTO_DEBUG;
+}
+
+void osn::Transition::PollPrepareStates(std::vector<ipc::value>& rval)
+{
+	std::vector<TransitionPreparer::Change> changes;
+	preparer.TakeChanges(changes);
+
+	rval.push_back(ipc::value((uint32_t)changes.size()));
+	for (auto& change : changes) {
+		rval.push_back(ipc::value(change.transition));
+		rval.push_back(ipc::value((uint32_t)change.state));
+		rval.push_back(ipc::value(change.target));
+	}
+}
+
+void osn::Transition::CancelPreparations(uint64_t uid)
+{
+	preparer.CancelSource(uid);
+}
+
+void osn::Transition::ClearPreparations()
+{
+	preparer.Clear();
+}
@@ -51,5 +51,19 @@ namespace osn
 		    Set(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 		static void
 		    Start(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void
+		    Prepare(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+		static void GetPrepareState(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+
+		// Pushes the preparations that became ready, timed out or expired since the last poll
+		static void PollPrepareStates(std::vector<ipc::value>& rval);
+		// Drops the preparations of a source or for it, before it is released or removed
+		static void CancelPreparations(uint64_t uid);
+		// Drops the preparations still held, before libobs shuts down
+		static void ClearPreparations();
 	};
 } // namespace osn
\ No newline at end of file
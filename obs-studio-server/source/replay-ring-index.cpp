@@ -0,0 +1,96 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "replay-ring-index.h"
+#include <algorithm>
+
+uint64_t ReplayRingIndex::RingSize(uint64_t kbps, int64_t maxTimeSec, uint64_t maxSizeBytes, uint64_t memoryHeadBytes)
+{
+	uint64_t minimum = memoryHeadBytes * 2 + 64ULL * 1024 * 1024;
+	if (maxSizeBytes)
+		return std::max(maxSizeBytes, minimum);
+
+	if (!kbps || maxTimeSec <= 0)
+		return std::max(DefaultSizeMB * 1024 * 1024, minimum);
+
+	uint64_t bytes = kbps * 1000 / 8 * uint64_t(maxTimeSec);
+	return std::max(bytes + bytes / 4, minimum);
+}
+
+void ReplayRingIndex::Reset(uint64_t ringSize, int64_t maxTimeUsec, uint64_t memoryHeadBytes)
+{
+	m_size        = ringSize;
+	m_maxTimeUsec = maxTimeUsec;
+	m_memoryHead  = memoryHeadBytes;
+	m_head        = 0;
+	m_released    = 0;
+	m_totalBytes  = 0;
+	m_packets.clear();
+}
+
+bool ReplayRingIndex::Append(Packet& packet, Range& release)
+{
+	release = {0, 0};
+	if (!m_size || packet.size > m_size / 2)
+		return false;
+
+	// Forget the packets this one overwrites and the ones that left the replay window
+	uint64_t end = m_head + packet.size;
+	while (!m_packets.empty()) {
+		const Packet& oldest = m_packets.front();
+		if (end - oldest.position <= m_size && (!m_maxTimeUsec || packet.dtsUsec - oldest.dtsUsec <= m_maxTimeUsec))
+			break;
+		m_packets.pop_front();
+	}
+
+	packet.position = m_head;
+	m_packets.push_back(packet);
+	m_head = end;
+	m_totalBytes += packet.size;
+
+	// Released in batches of a memory head to limit the syscalls
+	if (m_head - m_released >= m_memoryHead * 2) {
+		uint64_t releaseTo = m_head - m_memoryHead;
+		release            = {m_released, releaseTo - m_released};
+		m_released         = releaseTo;
+	}
+	return true;
+}
+
+std::vector<ReplayRingIndex::Packet> ReplayRingIndex::Window() const
+{
+	auto first = std::find_if(
+	    m_packets.begin(), m_packets.end(), [](const Packet& packet) { return packet.video && packet.keyframe; });
+	return std::vector<Packet>(first, m_packets.end());
+}
+
+bool ReplayRingIndex::Overwritten(const Packet& packet) const
+{
+	return m_head > packet.position + m_size;
+}
+
+bool ReplayRingIndex::ReleaseRead(uint64_t& readFrom, uint64_t readTo, Range& release) const
+{
+	// Pages were only faulted in to be copied out, the memory head is still being written
+	if (readTo - readFrom < m_memoryHead || readTo + m_memoryHead > m_head)
+		return false;
+
+	release  = {readFrom, readTo - readFrom};
+	readFrom = readTo;
+	return true;
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// Packets held in a replay ring file. Positions are logical and grow forever, the
+// ring only holds the last Size() bytes of them. Packets are dropped once they are
+// overwritten or leave the replay window, and only the most recently written part
+// of the ring (the memory head) is meant to stay resident.
+//
+// Not thread safe, the replay output guards it together with the ring.
+class ReplayRingIndex
+{
+	public:
+	// Ring size when neither a size nor a replay length bounds it, same as the default RecRBSize
+	static const uint64_t DefaultSizeMB = 512;
+
+	struct Packet
+	{
+		uint64_t position;
+		uint32_t size;
+		int64_t  pts;
+		int64_t  dts;
+		int64_t  dtsUsec;
+		int32_t  timebaseNum;
+		int32_t  timebaseDen;
+		uint32_t track;
+		bool     video;
+		bool     keyframe;
+	};
+
+	struct Range
+	{
+		uint64_t position;
+		uint64_t size;
+	};
+
+	// Ring holding maxTimeSec seconds at kbps plus a quarter for bitrate peaks and the part
+	// of the window before its first keyframe. maxSizeBytes wins when set.
+	static uint64_t RingSize(uint64_t kbps, int64_t maxTimeSec, uint64_t maxSizeBytes, uint64_t memoryHeadBytes);
+
+	void Reset(uint64_t ringSize, int64_t maxTimeUsec, uint64_t memoryHeadBytes);
+
+	// Places the packet at the head and sets its position, false if it can't fit the ring.
+	// 'release' is set to the part of the ring that left the memory head, if any.
+	bool Append(Packet& packet, Range& release);
+
+	// Packets of the replay window, from its first video keyframe
+	std::vector<Packet> Window() const;
+
+	// Whether the data of a packet was overwritten since it was appended
+	bool Overwritten(const Packet& packet) const;
+
+	// Saving reads [readFrom, readTo) back from the ring. Once enough was read outside the
+	// memory head it is set to 'release' and readFrom moves to readTo.
+	bool ReleaseRead(uint64_t& readFrom, uint64_t readTo, Range& release) const;
+
+	uint64_t Size() const
+	{
+		return m_size;
+	}
+	uint64_t Head() const
+	{
+		return m_head;
+	}
+	uint64_t TotalBytes() const
+	{
+		return m_totalBytes;
+	}
+	size_t Count() const
+	{
+		return m_packets.size();
+	}
+
+	private:
+	uint64_t           m_size        = 0;
+	int64_t            m_maxTimeUsec = 0;
+	uint64_t           m_memoryHead  = 0;
+	uint64_t           m_head        = 0;
+	uint64_t           m_released    = 0;
+	uint64_t           m_totalBytes  = 0;
+	std::deque<Packet> m_packets;
+};
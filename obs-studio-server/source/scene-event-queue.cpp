@@ -0,0 +1,142 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#include "scene-event-queue.h"
+
+void SceneEventQueue::Connect(uint64_t scene)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_scenes.emplace(scene, PendingScene());
+}
+
+void SceneEventQueue::Disconnect(uint64_t scene)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_scenes.erase(scene);
+}
+
+bool SceneEventQueue::IsConnected(uint64_t scene)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	return m_scenes.find(scene) != m_scenes.end();
+}
+
+SceneEventQueue::PendingItem* SceneEventQueue::Pending(uint64_t scene, int64_t item)
+{
+	auto found = m_scenes.find(scene);
+	if (found == m_scenes.end())
+		return nullptr;
+
+	m_stats.events++;
+	return &found->second.items[item];
+}
+
+void SceneEventQueue::ItemAdded(uint64_t scene, int64_t item)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	PendingItem*                 pending = Pending(scene, item);
+	if (pending)
+		pending->added = true;
+}
+
+void SceneEventQueue::ItemRemoved(uint64_t scene, int64_t item)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	PendingItem*                 pending = Pending(scene, item);
+	if (pending)
+		pending->removed = true;
+}
+
+void SceneEventQueue::ItemVisible(uint64_t scene, int64_t item, bool visible)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	PendingItem*                 pending = Pending(scene, item);
+	if (pending) {
+		pending->hasVisible = true;
+		pending->visible    = visible;
+	}
+}
+
+void SceneEventQueue::ItemTransformed(uint64_t scene, int64_t item)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	PendingItem*                 pending = Pending(scene, item);
+	if (pending)
+		pending->transformed = true;
+}
+
+void SceneEventQueue::Reordered(uint64_t scene)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	auto                         found = m_scenes.find(scene);
+	if (found != m_scenes.end()) {
+		m_stats.events++;
+		found->second.reordered = true;
+	}
+}
+
+void SceneEventQueue::Take(std::vector<std::pair<uint64_t, Batch>>& batches)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+
+	for (auto& scene : m_scenes) {
+		PendingScene& pending = scene.second;
+		Batch         batch;
+		batch.reordered = pending.reordered;
+
+		for (auto& item : pending.items) {
+			const PendingItem& changes = item.second;
+			if (changes.added && changes.removed)
+				continue;
+
+			// The client reads a new item as a whole, and has nothing to update for a removed one
+			if (changes.added) {
+				batch.added.push_back(item.first);
+			} else if (changes.removed) {
+				batch.removed.push_back(item.first);
+			} else {
+				if (changes.transformed)
+					batch.transformed.push_back(item.first);
+				if (changes.hasVisible)
+					batch.visible.emplace_back(item.first, changes.visible);
+			}
+		}
+
+		pending.items.clear();
+		pending.reordered = false;
+
+		if (batch.reordered || !batch.added.empty() || !batch.removed.empty() || !batch.transformed.empty()
+		    || !batch.visible.empty()) {
+			batches.emplace_back(scene.first, std::move(batch));
+			m_stats.batches++;
+		}
+	}
+}
+
+void SceneEventQueue::Clear()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_scenes.clear();
+}
+
+SceneEventQueue::Stats SceneEventQueue::GetStats()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	return m_stats;
+}
@@ -0,0 +1,90 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Item changes of the scenes a client is connected to, collected from the
+// scene signals and handed out in batches with every global callback query.
+// Changes to the same item in between are coalesced: an item dragged across
+// the canvas is reported as transformed once per batch, and one that was added
+// and removed before the client heard about it isn't reported at all. Signal
+// handlers may call in with the scene locked, nothing here calls into libobs.
+class SceneEventQueue
+{
+	public:
+	struct Batch
+	{
+		// Scene item ids, in increasing order
+		std::vector<int64_t>                  added;
+		std::vector<int64_t>                  removed;
+		std::vector<int64_t>                  transformed;
+		std::vector<std::pair<int64_t, bool>> visible;
+		bool                                  reordered = false;
+	};
+
+	struct Stats
+	{
+		uint64_t events;
+		uint64_t batches;
+	};
+
+	// Events of scenes that aren't connected are dropped
+	void Connect(uint64_t scene);
+	void Disconnect(uint64_t scene);
+	bool IsConnected(uint64_t scene);
+
+	void ItemAdded(uint64_t scene, int64_t item);
+	void ItemRemoved(uint64_t scene, int64_t item);
+	void ItemVisible(uint64_t scene, int64_t item, bool visible);
+	void ItemTransformed(uint64_t scene, int64_t item);
+	void Reordered(uint64_t scene);
+
+	// Appends the batch of every scene that changed since the last call
+	void Take(std::vector<std::pair<uint64_t, Batch>>& batches);
+
+	void  Clear();
+	Stats GetStats();
+
+	private:
+	struct PendingItem
+	{
+		bool added       = false;
+		bool removed     = false;
+		bool transformed = false;
+		bool hasVisible  = false;
+		bool visible     = false;
+	};
+
+	struct PendingScene
+	{
+		std::map<int64_t, PendingItem> items;
+		bool                           reordered = false;
+	};
+
+	PendingItem* Pending(uint64_t scene, int64_t item);
+
+	std::mutex                       m_mutex;
+	std::map<uint64_t, PendingScene> m_scenes;
+	Stats                            m_stats = {};
+};
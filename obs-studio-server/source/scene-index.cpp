@@ -0,0 +1,184 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "scene-index.h"
+#include <graphics/matrix4.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct IndexedScene
+{
+	// Held while querying, libobs may be called with it held
+	std::mutex         mutex;
+	util::SpatialIndex index;
+	bool               destroyed = false;
+
+	// Filled by the signal handlers, which may run with the scene locked, so this
+	// one is never held while calling into libobs
+	std::mutex                                             pendingMutex;
+	bool                                                   rebuild = true;
+	std::unordered_map<uint64_t, util::SpatialIndex::Quad> moved;
+};
+
+static std::mutex                                            scenesMutex;
+static std::map<obs_source_t*, std::shared_ptr<IndexedScene>> scenes;
+
+static const char* RebuildSignals[] = {"item_add", "item_remove", "reorder", "item_visible"};
+
+static void RebuildCallback(void* data, calldata_t* cd)
+{
+	IndexedScene*               indexed = reinterpret_cast<IndexedScene*>(data);
+	std::lock_guard<std::mutex> lock(indexed->pendingMutex);
+	indexed->rebuild = true;
+	indexed->moved.clear();
+}
+
+static void TransformCallback(void* data, calldata_t* cd)
+{
+	IndexedScene*    indexed = reinterpret_cast<IndexedScene*>(data);
+	obs_sceneitem_t* item    = nullptr;
+	if (!calldata_get_ptr(cd, "item", &item) || !item)
+		return;
+
+	// The box transform was just updated, read it now rather than looking the item up later
+	util::SpatialIndex::Quad quad = SceneIndex::GetQuad(item);
+	uint64_t                 key  = uint64_t(obs_sceneitem_get_id(item));
+
+	std::lock_guard<std::mutex> lock(indexed->pendingMutex);
+	if (!indexed->rebuild)
+		indexed->moved[key] = quad;
+}
+
+static void DestroyCallback(void* data, calldata_t* cd);
+
+static void Disconnect(obs_source_t* source, IndexedScene* indexed)
+{
+	// Each disconnect waits for running callbacks of its signal, the scene still emits
+	// item_remove and item_visible while its items are removed after "destroy"
+	signal_handler_t* sh = obs_source_get_signal_handler(source);
+	for (const char* signal : RebuildSignals)
+		signal_handler_disconnect(sh, signal, RebuildCallback, indexed);
+	signal_handler_disconnect(sh, "item_transform", TransformCallback, indexed);
+	signal_handler_disconnect(sh, "destroy", DestroyCallback, nullptr);
+}
+
+static void DestroyCallback(void* data, calldata_t* cd)
+{
+	obs_source_t* source = nullptr;
+	if (!calldata_get_ptr(cd, "source", &source))
+		return;
+
+	std::shared_ptr<IndexedScene> indexed;
+	{
+		std::lock_guard<std::mutex> lock(scenesMutex);
+		auto                        found = scenes.find(source);
+		if (found == scenes.end())
+			return;
+		indexed = found->second;
+		scenes.erase(found);
+	}
+
+	Disconnect(source, indexed.get());
+
+	std::lock_guard<std::mutex> lock(indexed->mutex);
+	indexed->index.Clear();
+	indexed->destroyed = true;
+}
+
+static std::shared_ptr<IndexedScene> GetIndexedScene(obs_source_t* source)
+{
+	std::lock_guard<std::mutex> lock(scenesMutex);
+	auto                        found = scenes.find(source);
+	if (found != scenes.end())
+		return found->second;
+
+	auto indexed   = std::make_shared<IndexedScene>();
+	scenes[source] = indexed;
+
+	signal_handler_t* sh = obs_source_get_signal_handler(source);
+	for (const char* signal : RebuildSignals)
+		signal_handler_connect(sh, signal, RebuildCallback, indexed.get());
+	signal_handler_connect(sh, "item_transform", TransformCallback, indexed.get());
+	signal_handler_connect(sh, "destroy", DestroyCallback, nullptr);
+	return indexed;
+}
+
+static void Rebuild(IndexedScene* indexed, obs_scene_t* scene)
+{
+	std::vector<util::SpatialIndex::Entry> entries;
+
+	// Bottom to top, so the enumeration order is the drawing order
+	auto cb = [](obs_scene_t* scene, obs_sceneitem_t* item, void* data) {
+		auto entries = reinterpret_cast<std::vector<util::SpatialIndex::Entry>*>(data);
+		if (!obs_sceneitem_visible(item))
+			return true;
+
+		util::SpatialIndex::Entry entry = {};
+		entry.key                       = uint64_t(obs_sceneitem_get_id(item));
+		entry.order                     = uint32_t(entries->size());
+		entry.quad                      = SceneIndex::GetQuad(item);
+		entries->push_back(entry);
+		return true;
+	};
+	obs_scene_enum_items(scene, cb, &entries);
+
+	indexed->index.Build(std::move(entries));
+}
+
+bool SceneIndex::Query(
+    obs_source_t* source, const std::function<void(util::SpatialIndex& index, obs_scene_t* scene)>& fn)
+{
+	obs_scene_t* scene = obs_scene_from_source(source);
+	if (!scene)
+		return false;
+
+	std::shared_ptr<IndexedScene> indexed = GetIndexedScene(source);
+	std::lock_guard<std::mutex>   lock(indexed->mutex);
+	if (indexed->destroyed)
+		return false;
+
+	bool                                                   rebuild;
+	std::unordered_map<uint64_t, util::SpatialIndex::Quad> moved;
+	{
+		std::lock_guard<std::mutex> pendingLock(indexed->pendingMutex);
+		rebuild          = indexed->rebuild;
+		indexed->rebuild = false;
+		moved.swap(indexed->moved);
+	}
+
+	if (rebuild) {
+		Rebuild(indexed.get(), scene);
+	} else {
+		for (auto& item : moved)
+			indexed->index.Update(item.first, item.second);
+	}
+
+	fn(indexed->index, scene);
+	return true;
+}
+
+util::SpatialIndex::Quad SceneIndex::GetQuad(obs_sceneitem_t* item)
+{
+	matrix4 boxTransform;
+	obs_sceneitem_get_box_transform(item, &boxTransform);
+	return util::SpatialIndex::MakeQuad(
+	    boxTransform.t.x, boxTransform.t.y, boxTransform.x.x, boxTransform.x.y, boxTransform.y.x, boxTransform.y.y);
+}
@@ -0,0 +1,37 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <functional>
+#include <obs.h>
+#include "util-spatialindex.h"
+
+// Spatial index of the visible items of a scene, keyed by scene item id. A scene
+// gets its index on the first query and keeps it until it's destroyed. Signals of
+// the scene flag the index: transforms are applied to the existing tree, adding,
+// removing, reordering or hiding items rebuilds it on the next query.
+class SceneIndex
+{
+	public:
+	// Calls fn with the up to date index of the scene. The index holds no references,
+	// fn resolves the keys with obs_scene_find_sceneitem_by_id. Returns false if
+	// source isn't a scene.
+	static bool Query(obs_source_t* source, const std::function<void(util::SpatialIndex& index, obs_scene_t* scene)>& fn);
+
+	static util::SpatialIndex::Quad GetQuad(obs_sceneitem_t* item);
+};
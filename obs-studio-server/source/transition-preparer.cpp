@@ -0,0 +1,242 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "transition-preparer.h"
+#include <algorithm>
+
+TransitionPreparer::TransitionPreparer(std::chrono::milliseconds pollInterval, std::chrono::milliseconds hold)
+    : m_pollInterval(pollInterval), m_hold(hold)
+{}
+
+TransitionPreparer::~TransitionPreparer()
+{
+	Clear();
+}
+
+void TransitionPreparer::Prepare(
+    uint64_t                  transition,
+    uint64_t                  target,
+    Preparation               preparation,
+    std::chrono::milliseconds timeout)
+{
+	auto entry         = std::make_shared<Entry>();
+	entry->target      = target;
+	entry->preparation = std::move(preparation);
+	entry->deadline    = std::chrono::steady_clock::now() + timeout;
+
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	auto                         found = m_entries.find(transition);
+	if (found != m_entries.end()) {
+		auto previous = found->second;
+		m_entries.erase(found);
+		Drop(ulock, previous);
+	}
+	m_entries[transition] = entry;
+	m_changes.erase(transition);
+
+	m_stop = false;
+	if (!m_worker.joinable())
+		m_worker = std::thread(&TransitionPreparer::Run, this);
+	m_wake.notify_all();
+}
+
+TransitionPreparer::State TransitionPreparer::GetState(uint64_t transition, uint64_t& target)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	auto                         found = m_entries.find(transition);
+	if (found == m_entries.end())
+		return State::None;
+	target = found->second->target;
+	return found->second->state;
+}
+
+TransitionPreparer::State TransitionPreparer::Wait(uint64_t transition, std::chrono::milliseconds timeout)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	State                        state = State::None;
+	m_changed.wait_for(ulock, timeout, [this, transition, &state]() {
+		auto found = m_entries.find(transition);
+		state      = found != m_entries.end() ? found->second->state : State::None;
+		return state != State::Preparing;
+	});
+	return state;
+}
+
+void TransitionPreparer::Cancel(uint64_t transition)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	auto                         found = m_entries.find(transition);
+	if (found == m_entries.end())
+		return;
+	auto entry = found->second;
+	m_entries.erase(found);
+	m_changes.erase(transition);
+	Drop(ulock, entry);
+	m_changed.notify_all();
+}
+
+void TransitionPreparer::CancelSource(uint64_t source)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	std::vector<std::shared_ptr<Entry>> dropped;
+	for (auto item = m_entries.begin(); item != m_entries.end();) {
+		if (item->first != source && item->second->target != source) {
+			++item;
+			continue;
+		}
+		dropped.push_back(item->second);
+		m_changes.erase(item->first);
+		item = m_entries.erase(item);
+	}
+
+	for (auto& entry : dropped)
+		Drop(ulock, entry);
+	if (!dropped.empty())
+		m_changed.notify_all();
+}
+
+void TransitionPreparer::TakeChanges(std::vector<Change>& changes)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	for (auto& change : m_changes)
+		changes.push_back(change.second);
+	m_changes.clear();
+}
+
+void TransitionPreparer::Clear()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	while (!m_entries.empty()) {
+		auto entry = m_entries.begin()->second;
+		m_entries.erase(m_entries.begin());
+		Drop(ulock, entry);
+	}
+	m_changes.clear();
+	m_stop = true;
+	m_wake.notify_all();
+	m_changed.notify_all();
+
+	if (m_worker.joinable()) {
+		std::thread worker = std::move(m_worker);
+		ulock.unlock();
+		worker.join();
+	}
+}
+
+void TransitionPreparer::Drop(std::unique_lock<std::mutex>& ulock, std::shared_ptr<Entry> entry)
+{
+	// An entry being acquired is released by the worker once acquire returns
+	entry->cancelled = true;
+	Release(ulock, entry);
+}
+
+void TransitionPreparer::Release(std::unique_lock<std::mutex>& ulock, std::shared_ptr<Entry> entry)
+{
+	if (entry->acquiring || entry->released)
+		return;
+	entry->released = true;
+
+	ulock.unlock();
+	entry->preparation.release(entry->acquired);
+	ulock.lock();
+}
+
+void TransitionPreparer::Run()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	while (!m_stop) {
+		// Acquire new preparations one at a time, they may take a while
+		std::shared_ptr<Entry> next;
+		for (auto& item : m_entries) {
+			if (!item.second->acquired && !item.second->acquiring) {
+				next = item.second;
+				break;
+			}
+		}
+		if (next) {
+			next->acquiring = true;
+			ulock.unlock();
+			next->preparation.acquire();
+			ulock.lock();
+			next->acquiring = false;
+			next->acquired  = true;
+			if (next->cancelled)
+				Drop(ulock, next);
+			continue;
+		}
+
+		// Poll the targets still preparing, release the ones that timed out or were held too long
+		auto                                now  = std::chrono::steady_clock::now();
+		auto                                wake = std::chrono::steady_clock::time_point::max();
+		std::vector<std::shared_ptr<Entry>> expired;
+		for (auto& item : m_entries) {
+			auto& entry = item.second;
+			if (entry->released)
+				continue;
+
+			if (entry->state == State::Preparing) {
+				if (entry->preparation.ready()) {
+					entry->holdUntil = now + m_hold;
+					SetState(item.first, *entry, State::Ready);
+				} else if (now >= entry->deadline) {
+					SetState(item.first, *entry, State::TimedOut);
+					expired.push_back(entry);
+					continue;
+				} else {
+					wake = std::min(wake, now + m_pollInterval);
+					continue;
+				}
+			}
+
+			if (now >= entry->holdUntil) {
+				SetState(item.first, *entry, State::Expired);
+				expired.push_back(entry);
+			} else {
+				wake = std::min(wake, entry->holdUntil);
+			}
+		}
+
+		// Releasing unlocks, the entries may change meanwhile so they are looked at again after
+		if (!expired.empty()) {
+			for (auto& entry : expired)
+				Release(ulock, entry);
+			continue;
+		}
+
+		auto woken = [this]() {
+			if (m_stop)
+				return true;
+			for (auto& item : m_entries) {
+				if (!item.second->acquired)
+					return true;
+			}
+			return false;
+		};
+		if (wake == std::chrono::steady_clock::time_point::max())
+			m_wake.wait(ulock, woken);
+		else
+			m_wake.wait_until(ulock, wake, woken);
+	}
+}
+
+void TransitionPreparer::SetState(uint64_t transition, Entry& entry, State state)
+{
+	entry.state           = state;
+	m_changes[transition] = {transition, entry.target, state};
+	m_changed.notify_all();
+}
@@ -0,0 +1,121 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Gets the target of a transition ready before the transition starts. Showing
+// a scene opens its media and capture sources, which otherwise happens on the
+// first frame of the transition. Preparations run on a worker thread: acquire
+// is called once, then ready is polled until it holds or the timeout passes.
+// A preparation that timed out is released right away. A ready one is held
+// until it is cancelled, usually once the transition has started and shows
+// the target itself, or until the hold time passes without a start.
+class TransitionPreparer
+{
+	public:
+	enum class State : uint32_t
+	{
+		None,
+		Preparing,
+		Ready,
+		TimedOut,
+		// Ready, but released after the hold time passed without the transition starting
+		Expired,
+	};
+
+	struct Change
+	{
+		uint64_t transition;
+		uint64_t target;
+		State    state;
+	};
+
+	struct Preparation
+	{
+		// Shows the target, called on the worker
+		std::function<void()> acquire;
+		// Whether the target has its first frames, polled on the worker after acquire
+		std::function<bool()> ready;
+		// Called exactly once when the preparation is dropped, acquired tells whether acquire ran
+		std::function<void(bool acquired)> release;
+	};
+
+	TransitionPreparer(
+	    std::chrono::milliseconds pollInterval = std::chrono::milliseconds(5),
+	    std::chrono::milliseconds hold         = std::chrono::milliseconds(10000));
+	~TransitionPreparer();
+
+	// Replaces any preparation of the transition
+	void Prepare(uint64_t transition, uint64_t target, Preparation preparation, std::chrono::milliseconds timeout);
+
+	// State of the preparation of the transition and the target it is for
+	State GetState(uint64_t transition, uint64_t& target);
+
+	// Blocks until the preparation is ready or timed out, or until timeout passes
+	State Wait(uint64_t transition, std::chrono::milliseconds timeout);
+
+	// Drops the preparation of the transition
+	void Cancel(uint64_t transition);
+
+	// Drops every preparation of the source or with the source as its target
+	void CancelSource(uint64_t source);
+
+	// Moves out the preparations that became ready, timed out or expired since the last call
+	void TakeChanges(std::vector<Change>& changes);
+
+	// Drops every preparation and stops the worker
+	void Clear();
+
+	private:
+	struct Entry
+	{
+		uint64_t                              target;
+		Preparation                           preparation;
+		std::chrono::steady_clock::time_point deadline;
+		std::chrono::steady_clock::time_point holdUntil;
+		State                                 state     = State::Preparing;
+		bool                                  acquiring = false;
+		bool                                  acquired  = false;
+		bool                                  cancelled = false;
+		bool                                  released  = false;
+	};
+
+	void Run();
+	void Drop(std::unique_lock<std::mutex>& ulock, std::shared_ptr<Entry> entry);
+	void Release(std::unique_lock<std::mutex>& ulock, std::shared_ptr<Entry> entry);
+	void SetState(uint64_t transition, Entry& entry, State state);
+
+	std::chrono::milliseconds                  m_pollInterval;
+	std::chrono::milliseconds                  m_hold;
+	std::mutex                                 m_mutex;
+	std::condition_variable                    m_wake;
+	std::condition_variable                    m_changed;
+	std::map<uint64_t, std::shared_ptr<Entry>> m_entries;
+	std::map<uint64_t, Change>                 m_changes;
+	std::thread                                m_worker;
+	bool                                       m_stop = false;
+};
@@ -0,0 +1,73 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "type-catalog.h"
+
+// 64-bit FNV-1a, each field followed by a separator so that moving bytes between fields changes it
+static void Hash(uint64_t& value, const void* data, size_t size)
+{
+	auto bytes = reinterpret_cast<const uint8_t*>(data);
+	for (size_t idx = 0; idx < size; idx++) {
+		value ^= bytes[idx];
+		value *= 0x100000001b3ull;
+	}
+	value ^= 0xff;
+	value *= 0x100000001b3ull;
+}
+
+static void Hash(uint64_t& value, const std::string& text)
+{
+	Hash(value, text.data(), text.size());
+}
+
+uint64_t TypeCatalog::Set(const std::vector<Entry>& entries)
+{
+	uint64_t fingerprint = 0xcbf29ce484222325ull;
+	for (auto& entry : entries) {
+		Hash(fingerprint, entry.id);
+		Hash(fingerprint, &entry.type, sizeof(entry.type));
+		Hash(fingerprint, entry.displayName);
+		Hash(fingerprint, &entry.outputFlags, sizeof(entry.outputFlags));
+		Hash(fingerprint, entry.defaults);
+		Hash(fingerprint, &entry.propertiesHash, sizeof(entry.propertiesHash));
+	}
+	// 0 stands for no catalog
+	if (fingerprint == 0)
+		fingerprint = 1;
+
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_entries     = entries;
+	m_fingerprint = fingerprint;
+	return fingerprint;
+}
+
+uint64_t TypeCatalog::Get(uint64_t knownFingerprint, std::vector<Entry>& entries)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	entries.clear();
+	if (knownFingerprint == 0 || knownFingerprint != m_fingerprint)
+		entries = m_entries;
+	return m_fingerprint;
+}
+
+void TypeCatalog::Clear()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_entries.clear();
+	m_fingerprint = 0;
+}
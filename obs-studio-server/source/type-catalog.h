@@ -0,0 +1,55 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Every registered source, filter and transition type with what the frontend
+// asks about it: display name, output flags, default settings and the hash of
+// its property schema. Collected once after the modules are loaded. The
+// fingerprint only depends on the entries, so it stays the same across
+// sessions with the same plugins and clients can keep the catalog.
+class TypeCatalog
+{
+	public:
+	struct Entry
+	{
+		std::string id;
+		uint32_t    type; // obs_source_type
+		std::string displayName;
+		uint32_t    outputFlags;
+		std::string defaults; // JSON
+		uint64_t    propertiesHash;
+	};
+
+	// Replaces the entries, returns the new fingerprint
+	uint64_t Set(const std::vector<Entry>& entries);
+
+	// Fills entries unless knownFingerprint is the current one. Returns the fingerprint, 0 while empty.
+	uint64_t Get(uint64_t knownFingerprint, std::vector<Entry>& entries);
+
+	void Clear();
+
+	private:
+	std::mutex         m_mutex;
+	std::vector<Entry> m_entries;
+	uint64_t           m_fingerprint = 0;
+};
@@ -0,0 +1,263 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-callstats.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include "error.hpp"
+#include "shared.hpp"
+
+struct CallCounters
+{
+	std::atomic<uint64_t> calls{0};
+	std::atomic<uint64_t> total_ns{0};
+	std::atomic<uint64_t> max_ns{0};
+	std::atomic<uint64_t> bytes_in{0};
+	std::atomic<uint64_t> bytes_out{0};
+	std::atomic<uint64_t> histogram[util::CallStats::HistogramBuckets] = {};
+};
+
+// Counters are only ever written by the thread owning them, so updates are plain
+// relaxed load/store pairs. Readers sum all threads with relaxed loads.
+struct ThreadCounters
+{
+	std::array<CallCounters, util::CallStats::MaxCalls> calls;
+};
+
+static std::shared_mutex                                        namesMutex;
+static std::map<std::string, std::map<std::string, uint32_t>>   callIds;
+static std::deque<std::pair<std::string, std::string>>          callNames;
+
+// Names are never moved once interned, so they can be read through these without namesMutex
+static std::atomic<const std::pair<std::string, std::string>*> publishedNames[util::CallStats::MaxCalls];
+
+static std::mutex                                  threadsMutex;
+static std::vector<std::unique_ptr<ThreadCounters>> threadCounters;
+
+thread_local ThreadCounters*                                 localCounters = nullptr;
+thread_local uint32_t                                        currentCall   = util::CallStats::InvalidCall;
+thread_local std::chrono::steady_clock::time_point           currentStart;
+
+// Ids this thread already interned, so repeated calls skip namesMutex
+thread_local std::map<std::string, std::map<std::string, uint32_t>> localCallIds;
+
+static ThreadCounters* GetThreadCounters()
+{
+	if (!localCounters) {
+		std::unique_lock<std::mutex> ulock(threadsMutex);
+		threadCounters.push_back(std::make_unique<ThreadCounters>());
+		localCounters = threadCounters.back().get();
+	}
+	return localCounters;
+}
+
+static inline void Increment(std::atomic<uint64_t>& counter, uint64_t value)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+static uint64_t PayloadSize(const std::vector<ipc::value>& values)
+{
+	uint64_t size = 0;
+	for (auto& value : values) {
+		switch (value.type) {
+		case ipc::type::String:
+			size += value.value_str.size();
+			break;
+		case ipc::type::Binary:
+			size += value.value_bin.size();
+			break;
+		default:
+			size += sizeof(value.value_union);
+			break;
+		}
+	}
+	return size;
+}
+
+static uint32_t HistogramBucket(uint64_t ns)
+{
+	uint64_t us     = ns / 1000;
+	uint32_t bucket = 0;
+	while (us > 1 && bucket < util::CallStats::HistogramBuckets - 1) {
+		us >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+static uint32_t InternShared(const std::string& cname, const std::string& fname)
+{
+	{
+		std::shared_lock<std::shared_mutex> slock(namesMutex);
+		auto                                 collection = callIds.find(cname);
+		if (collection != callIds.end()) {
+			auto function = collection->second.find(fname);
+			if (function != collection->second.end())
+				return function->second;
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> ulock(namesMutex);
+	auto&                               functions = callIds[cname];
+	auto                                function  = functions.find(fname);
+	if (function != functions.end())
+		return function->second;
+
+	if (callNames.size() >= util::CallStats::MaxCalls)
+		return util::CallStats::InvalidCall;
+
+	uint32_t call = uint32_t(callNames.size());
+	callNames.emplace_back(cname, fname);
+	functions.emplace(fname, call);
+	publishedNames[call].store(&callNames.back(), std::memory_order_release);
+	return call;
+}
+
+uint32_t util::CallStats::Intern(const std::string& cname, const std::string& fname)
+{
+	auto localCollection = localCallIds.find(cname);
+	if (localCollection != localCallIds.end()) {
+		auto function = localCollection->second.find(fname);
+		if (function != localCollection->second.end())
+			return function->second;
+	}
+
+	uint32_t call = InternShared(cname, fname);
+	if (call != InvalidCall)
+		localCallIds[cname].emplace(fname, call);
+	return call;
+}
+
+bool util::CallStats::GetName(uint32_t call, std::string& cname, std::string& fname)
+{
+	std::shared_lock<std::shared_mutex> slock(namesMutex);
+	if (call >= callNames.size())
+		return false;
+
+	cname = callNames[call].first;
+	fname = callNames[call].second;
+	return true;
+}
+
+bool util::CallStats::PeekName(uint32_t call, std::string& cname, std::string& fname)
+{
+	if (call >= MaxCalls)
+		return false;
+
+	const std::pair<std::string, std::string>* name = publishedNames[call].load(std::memory_order_acquire);
+	if (!name)
+		return false;
+
+	cname = name->first;
+	fname = name->second;
+	return true;
+}
+
+void util::CallStats::ProcessPreServerCall(uint32_t call, const std::vector<ipc::value>& args)
+{
+	currentCall = call;
+	if (currentCall == InvalidCall)
+		return;
+
+	Increment(GetThreadCounters()->calls[currentCall].bytes_in, PayloadSize(args));
+	currentStart = std::chrono::steady_clock::now();
+}
+
+void util::CallStats::ProcessPostServerCall(
+    const std::string&             cname,
+    const std::string&             fname,
+    const std::vector<ipc::value>& rval)
+{
+	if (currentCall == InvalidCall)
+		return;
+
+	uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+	                       std::chrono::steady_clock::now() - currentStart)
+	                       .count();
+
+	CallCounters& counters = GetThreadCounters()->calls[currentCall];
+	Increment(counters.calls, 1);
+	Increment(counters.total_ns, elapsed);
+	Increment(counters.bytes_out, PayloadSize(rval));
+	Increment(counters.histogram[HistogramBucket(elapsed)], 1);
+	if (elapsed > counters.max_ns.load(std::memory_order_relaxed))
+		counters.max_ns.store(elapsed, std::memory_order_relaxed);
+
+	currentCall = InvalidCall;
+}
+
+void util::CallStats::GetCallStats(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::vector<std::pair<std::string, std::string>> names;
+	{
+		std::shared_lock<std::shared_mutex> slock(namesMutex);
+		names.assign(callNames.begin(), callNames.end());
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)0));
+
+	std::unique_lock<std::mutex> ulock(threadsMutex);
+	uint32_t                     count = 0;
+	for (uint32_t call = 0; call < names.size(); call++) {
+		uint64_t              calls = 0, total_ns = 0, max_ns = 0, bytes_in = 0, bytes_out = 0;
+		std::vector<uint64_t> histogram(HistogramBuckets, 0);
+
+		for (auto& thread : threadCounters) {
+			CallCounters& counters = thread->calls[call];
+			calls += counters.calls.load(std::memory_order_relaxed);
+			total_ns += counters.total_ns.load(std::memory_order_relaxed);
+			max_ns = std::max(max_ns, counters.max_ns.load(std::memory_order_relaxed));
+			bytes_in += counters.bytes_in.load(std::memory_order_relaxed);
+			bytes_out += counters.bytes_out.load(std::memory_order_relaxed);
+			for (uint32_t bucket = 0; bucket < HistogramBuckets; bucket++)
+				histogram[bucket] += counters.histogram[bucket].load(std::memory_order_relaxed);
+		}
+
+		if (calls == 0)
+			continue;
+
+		std::vector<char> buffer(sizeof(uint64_t) * HistogramBuckets);
+		memcpy(buffer.data(), histogram.data(), buffer.size());
+
+		rval.push_back(ipc::value(names[call].first));
+		rval.push_back(ipc::value(names[call].second));
+		rval.push_back(ipc::value(calls));
+		rval.push_back(ipc::value(total_ns));
+		rval.push_back(ipc::value(max_ns));
+		rval.push_back(ipc::value(bytes_in));
+		rval.push_back(ipc::value(bytes_out));
+		rval.push_back(ipc::value(buffer));
+		count++;
+	}
+	rval[1] = ipc::value(count);
+
+	AUTO_DEBUG;
+}
@@ -0,0 +1,57 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <ipc-server.hpp>
+
+namespace util
+{
+	class CallStats
+	{
+		public:
+		// Maximum number of distinct collection/function pairs that can be tracked
+		static const uint32_t MaxCalls = 1024;
+		// Execution time histogram, bucket N holds calls that took [2^N, 2^(N+1)) microseconds
+		static const uint32_t HistogramBuckets = 24;
+		static const uint32_t InvalidCall = UINT32_MAX;
+
+		// Map a collection/function pair to a stable id, the lookup does not allocate once
+		// the pair was seen and takes no lock once the calling thread saw it. Returns
+		// InvalidCall if the table is full.
+		static uint32_t Intern(const std::string& cname, const std::string& fname);
+		static bool     GetName(uint32_t call, std::string& cname, std::string& fname);
+		// Same as GetName without taking any lock, for the crash handler which may run while
+		// the crashing thread holds it.
+		static bool PeekName(uint32_t call, std::string& cname, std::string& fname);
+
+		// Hooks for the ipc server pre/post callbacks, they only touch counters owned by
+		// the calling thread.
+		static void ProcessPreServerCall(uint32_t call, const std::vector<ipc::value>& args);
+		static void ProcessPostServerCall(const std::string& cname, const std::string& fname, const std::vector<ipc::value>& rval);
+
+		static void GetCallStats(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+	};
+}; // namespace util
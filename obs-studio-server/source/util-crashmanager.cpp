@@ -17,8 +17,10 @@
 ******************************************************************************/
 
 #include "util-crashmanager.h"
+#include "util-callstats.h"
 #include "util-metricsprovider.h"
 
+#include <atomic>
 #include <chrono>
 #include <codecvt>
 #include <iostream>
@@ -68,7 +70,11 @@ std::vector<std::string>                   handledOBSCrashes;
 PDH_HQUERY                                 cpuQuery;
 PDH_HCOUNTER                               cpuTotal;
 std::vector<nlohmann::json>                breadcrumbs;
-std::queue<std::pair<int, std::string>>    lastActions;
+// Last server calls, each slot packs the interned call id + 1 (high 32 bits, 0 means empty)
+// and how many times in a row it repeated (low 32 bits). Written without locks from the ipc threads.
+const uint64_t                             MaximumActionsRegistered = 64;
+std::atomic<uint64_t>                      lastActions[MaximumActionsRegistered];
+std::atomic<uint64_t>                      lastActionsHead{0};
 std::vector<std::string>                   warnings;
 std::mutex                                 messageMutex;
 util::MetricsProvider                      metricsClient;
@@ -886,17 +892,31 @@ nlohmann::json util::CrashManager::ComputeActions()
 #ifdef WIN32
 	nlohmann::json result = nlohmann::json::array();
 
-	while (!lastActions.empty()) {
-		auto counter = lastActions.front().first;
-		auto message = lastActions.front().second;
+	// Slots are emptied as they are read, so a later report only holds newer actions
+	uint64_t head  = lastActionsHead.load();
+	uint64_t first = head > MaximumActionsRegistered ? head - MaximumActionsRegistered : 0;
+	for (uint64_t i = first; i < head; i++) {
+		uint64_t action = lastActions[i % MaximumActionsRegistered].exchange(0);
+		if ((action >> 32) == 0)
+			continue;
+
+		// Never block here, the crashing thread may be inside CallStats
+		uint32_t    call = uint32_t(action >> 32) - 1;
+		std::string cname, fname;
+		std::string message;
+		if (util::CallStats::PeekName(call, cname, fname)) {
+			message = cname + std::string("::") + fname;
+		} else {
+			message = std::string("call#") + std::to_string(call);
+		}
 
 		// Update the message to reflect the count amount, if applicable
+		uint32_t    counter = uint32_t(action & 0xFFFFFFFF);
 		if (counter > 0) {
 			message = message + std::string("|") + std::to_string(counter);
 		}
 
 		result.push_back(message);
-		lastActions.pop();
 	}
 
 	return result;
@@ -1080,21 +1100,24 @@ void util::CrashManager::AddWarning(const std::string& warning)
 #endif
 }
 
-void RegisterAction(const std::string& message)
+void RegisterAction(uint32_t call)
 {
 #ifdef WIN32
-	static const int            MaximumActionsRegistered = 50;
-	std::lock_guard<std::mutex> lock(messageMutex);
+	if (call == util::CallStats::InvalidCall)
+		return;
 
-	// Check if this and the last message are the same, if true just add a counter
-	if (lastActions.size() > 0 && message.compare(lastActions.back().second) == 0) {
-		lastActions.back().first++;
-	} else {
-		lastActions.push({0, message});
-		if (lastActions.size() >= MaximumActionsRegistered) {
-			lastActions.pop();
-		}
+	// Check if this and the last action are the same, if true just add a counter
+	uint64_t head = lastActionsHead.load(std::memory_order_relaxed);
+	if (head > 0) {
+		std::atomic<uint64_t>& last   = lastActions[(head - 1) % MaximumActionsRegistered];
+		uint64_t               action = last.load(std::memory_order_relaxed);
+		if ((action >> 32) == uint64_t(call) + 1 && uint32_t(action) != UINT32_MAX
+		    && last.compare_exchange_strong(action, action + 1, std::memory_order_relaxed))
+			return;
 	}
+
+	uint64_t slot = lastActionsHead.fetch_add(1, std::memory_order_relaxed);
+	lastActions[slot % MaximumActionsRegistered].store((uint64_t(call) + 1) << 32, std::memory_order_release);
 #endif
 }
 
@@ -1162,10 +1185,8 @@ std::string util::CrashManager::getAppState()
 	return appState;
 }
 
-void util::CrashManager::ProcessPreServerCall(std::string cname, std::string fname, const std::vector<ipc::value>& args)
+void util::CrashManager::ProcessPreServerCall(uint32_t call, const std::vector<ipc::value>& args)
 {
-	std::string jsonEntry = cname + std::string("::") + fname;
-
 	// Perform this only if this user have a high crash rate (TODO: this check must be implemented)
 	/*
 	nlohmann::json ipcValues = nlohmann::json::array();
@@ -1173,7 +1194,7 @@ void util::CrashManager::ProcessPreServerCall(std::string cname, std::string fna
 	jsonEntry["ipc values"] = ipcValues;
 	*/
 
-	RegisterAction(jsonEntry);
+	RegisterAction(call);
 }
 
 void util::CrashManager::ProcessPostServerCall(
@@ -69,7 +69,9 @@ namespace util
 		// Return our global instance of the metrics provider, it's always valid
 		static MetricsProvider* const GetMetricsProvider();
 
-		static void ProcessPreServerCall(std::string cname, std::string fname, const std::vector<ipc::value>& args);
+		// 'call' is the id given by util::CallStats::Intern, it is only resolved back to a
+		// name when a crash report is built
+		static void ProcessPreServerCall(uint32_t call, const std::vector<ipc::value>& args);
 		static void ProcessPostServerCall(std::string cname, std::string fname, const std::vector<ipc::value>& args);
 
 		static void SetVersionName(std::string name);
@@ -0,0 +1,289 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "util-spatialindex.h"
+#include <algorithm>
+
+static inline util::SpatialIndex::Rect Bounds(const util::SpatialIndex::Quad& quad)
+{
+	util::SpatialIndex::Rect rect = {quad.x[0], quad.y[0], quad.x[0], quad.y[0]};
+	for (size_t n = 1; n < 4; n++) {
+		rect.left   = std::min(rect.left, quad.x[n]);
+		rect.top    = std::min(rect.top, quad.y[n]);
+		rect.right  = std::max(rect.right, quad.x[n]);
+		rect.bottom = std::max(rect.bottom, quad.y[n]);
+	}
+	return rect;
+}
+
+static inline void Merge(util::SpatialIndex::Rect& rect, const util::SpatialIndex::Rect& other)
+{
+	rect.left   = std::min(rect.left, other.left);
+	rect.top    = std::min(rect.top, other.top);
+	rect.right  = std::max(rect.right, other.right);
+	rect.bottom = std::max(rect.bottom, other.bottom);
+}
+
+static inline bool Contains(const util::SpatialIndex::Rect& rect, float x, float y)
+{
+	return x >= rect.left && x <= rect.right && y >= rect.top && y <= rect.bottom;
+}
+
+static inline bool Intersects(const util::SpatialIndex::Rect& a, const util::SpatialIndex::Rect& b)
+{
+	return a.left <= b.right && b.left <= a.right && a.top <= b.bottom && b.top <= a.bottom;
+}
+
+static bool Contains(const util::SpatialIndex::Quad& quad, float x, float y)
+{
+	// Inside a convex quad the point is on the same side of every edge, whatever
+	// the winding is, so flipped items work too
+	bool positive = false, negative = false;
+	for (size_t n = 0; n < 4; n++) {
+		size_t next  = (n + 1) % 4;
+		float  cross = (quad.x[next] - quad.x[n]) * (y - quad.y[n]) - (quad.y[next] - quad.y[n]) * (x - quad.x[n]);
+		positive |= cross > 0;
+		negative |= cross < 0;
+	}
+	return !(positive && negative);
+}
+
+static bool TopmostFirst(const util::SpatialIndex::Entry* a, const util::SpatialIndex::Entry* b)
+{
+	return a->order > b->order;
+}
+
+util::SpatialIndex::Quad
+    util::SpatialIndex::MakeQuad(float originX, float originY, float axisXx, float axisXy, float axisYx, float axisYy)
+{
+	Quad quad;
+	quad.x[0] = originX;
+	quad.y[0] = originY;
+	quad.x[1] = originX + axisXx;
+	quad.y[1] = originY + axisXy;
+	quad.x[2] = originX + axisXx + axisYx;
+	quad.y[2] = originY + axisXy + axisYy;
+	quad.x[3] = originX + axisYx;
+	quad.y[3] = originY + axisYy;
+	return quad;
+}
+
+void util::SpatialIndex::Clear()
+{
+	m_entries.clear();
+	m_nodes.clear();
+	m_lookup.clear();
+	m_refit = false;
+}
+
+void util::SpatialIndex::Build(std::vector<Entry> entries)
+{
+	m_entries = std::move(entries);
+	for (auto& entry : m_entries)
+		entry.bounds = Bounds(entry.quad);
+
+	m_nodes.clear();
+	m_nodes.reserve(2 * (m_entries.size() / LeafSize + 1));
+	if (!m_entries.empty())
+		BuildNode(0, uint32_t(m_entries.size()));
+
+	// Building sorts the entries, so the lookup is filled afterwards
+	m_lookup.clear();
+	m_lookup.reserve(m_entries.size());
+	for (size_t n = 0; n < m_entries.size(); n++)
+		m_lookup[m_entries[n].key] = n;
+
+	m_refit = false;
+}
+
+bool util::SpatialIndex::Update(uint64_t key, const Quad& quad)
+{
+	auto found = m_lookup.find(key);
+	if (found == m_lookup.end())
+		return false;
+
+	Entry& entry = m_entries[found->second];
+	entry.quad   = quad;
+	entry.bounds = Bounds(quad);
+	m_refit      = true;
+	return true;
+}
+
+size_t util::SpatialIndex::Size() const
+{
+	return m_entries.size();
+}
+
+const util::SpatialIndex::Entry* util::SpatialIndex::Find(uint64_t key) const
+{
+	auto found = m_lookup.find(key);
+	return found != m_lookup.end() ? &m_entries[found->second] : nullptr;
+}
+
+const util::SpatialIndex::Entry* util::SpatialIndex::HitTest(float x, float y)
+{
+	if (m_refit)
+		Refit();
+	if (m_nodes.empty())
+		return nullptr;
+
+	const Entry*          best = nullptr;
+	std::vector<uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while (!stack.empty()) {
+		uint32_t    index = stack.back();
+		const Node& node  = m_nodes[index];
+		stack.pop_back();
+
+		// Nothing below can be on top of what was already found
+		if (!Contains(node.bounds, x, y) || (best && node.maxOrder <= best->order))
+			continue;
+
+		if (node.right) {
+			stack.push_back(node.right);
+			stack.push_back(index + 1);
+			continue;
+		}
+
+		for (uint32_t n = node.first; n < node.first + node.count; n++) {
+			const Entry& entry = m_entries[n];
+			if (best && entry.order <= best->order)
+				continue;
+			if (Contains(entry.bounds, x, y) && Contains(entry.quad, x, y))
+				best = &entry;
+		}
+	}
+	return best;
+}
+
+void util::SpatialIndex::QueryRect(const Rect& rect, std::vector<const Entry*>& result)
+{
+	result.clear();
+	Collect(rect, result);
+	std::sort(result.begin(), result.end(), TopmostFirst);
+}
+
+void util::SpatialIndex::QueryNear(uint64_t key, float distance, std::vector<const Entry*>& result)
+{
+	result.clear();
+	if (m_refit)
+		Refit();
+
+	const Entry* entry = Find(key);
+	if (!entry)
+		return;
+
+	Rect rect = entry->bounds;
+	rect.left -= distance;
+	rect.top -= distance;
+	rect.right += distance;
+	rect.bottom += distance;
+
+	Collect(rect, result);
+	result.erase(
+	    std::remove_if(result.begin(), result.end(), [key](const Entry* other) { return other->key == key; }),
+	    result.end());
+	std::sort(result.begin(), result.end(), TopmostFirst);
+}
+
+uint32_t util::SpatialIndex::BuildNode(uint32_t first, uint32_t count)
+{
+	uint32_t index = uint32_t(m_nodes.size());
+	m_nodes.push_back({});
+
+	Rect     bounds   = m_entries[first].bounds;
+	Rect     centers  = {};
+	uint32_t maxOrder = 0;
+	for (uint32_t n = first; n < first + count; n++) {
+		const Entry& entry = m_entries[n];
+		float        x     = (entry.bounds.left + entry.bounds.right) / 2;
+		float        y     = (entry.bounds.top + entry.bounds.bottom) / 2;
+		if (n == first)
+			centers = {x, y, x, y};
+		Merge(bounds, entry.bounds);
+		Merge(centers, {x, y, x, y});
+		maxOrder = std::max(maxOrder, entry.order);
+	}
+
+	if (count <= LeafSize) {
+		m_nodes[index] = {bounds, maxOrder, 0, first, count};
+		return index;
+	}
+
+	// Median split along the axis where the item centers spread the most
+	bool horizontal = (centers.right - centers.left) >= (centers.bottom - centers.top);
+	auto begin      = m_entries.begin() + first;
+	std::nth_element(begin, begin + count / 2, begin + count, [horizontal](const Entry& a, const Entry& b) {
+		return horizontal ? (a.bounds.left + a.bounds.right) < (b.bounds.left + b.bounds.right)
+		                  : (a.bounds.top + a.bounds.bottom) < (b.bounds.top + b.bounds.bottom);
+	});
+
+	BuildNode(first, count / 2);
+	uint32_t right = BuildNode(first + count / 2, count - count / 2);
+	m_nodes[index] = {bounds, maxOrder, right, 0, 0};
+	return index;
+}
+
+void util::SpatialIndex::Refit()
+{
+	// Children always come after their parent
+	for (size_t index = m_nodes.size(); index-- > 0;) {
+		Node& node = m_nodes[index];
+		if (node.right) {
+			node.bounds = m_nodes[index + 1].bounds;
+			Merge(node.bounds, m_nodes[node.right].bounds);
+		} else {
+			node.bounds = m_entries[node.first].bounds;
+			for (uint32_t n = node.first + 1; n < node.first + node.count; n++)
+				Merge(node.bounds, m_entries[n].bounds);
+		}
+	}
+	m_refit = false;
+}
+
+void util::SpatialIndex::Collect(const Rect& rect, std::vector<const Entry*>& result)
+{
+	if (m_refit)
+		Refit();
+	if (m_nodes.empty())
+		return;
+
+	std::vector<uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while (!stack.empty()) {
+		uint32_t    index = stack.back();
+		const Node& node  = m_nodes[index];
+		stack.pop_back();
+
+		if (!Intersects(node.bounds, rect))
+			continue;
+
+		if (node.right) {
+			stack.push_back(node.right);
+			stack.push_back(index + 1);
+			continue;
+		}
+
+		for (uint32_t n = node.first; n < node.first + node.count; n++) {
+			if (Intersects(m_entries[n].bounds, rect))
+				result.push_back(&m_entries[n]);
+		}
+	}
+}
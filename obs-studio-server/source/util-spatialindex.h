@@ -0,0 +1,122 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <inttypes.h>
+#include <unordered_map>
+#include <vector>
+
+namespace util
+{
+	/*!
+	* \brief Bounding volume hierarchy over the oriented boxes of scene items
+	* Items are keyed by an id and carry their order in the scene, higher orders
+	* being drawn on top. Moving an item only refits the bounds of the tree,
+	* adding, removing or reordering items needs a new Build.
+	*/
+	class SpatialIndex
+	{
+		public:
+		struct Rect
+		{
+			float left, top, right, bottom;
+		};
+
+		/*!
+		* \brief Unit square of an item mapped to scene space
+		* Corner n is origin + u * axisX + v * axisY for (u, v) in
+		* (0, 0), (1, 0), (1, 1), (0, 1).
+		*/
+		struct Quad
+		{
+			float x[4];
+			float y[4];
+		};
+
+		struct Entry
+		{
+			uint64_t key;
+			uint32_t order;
+			Quad     quad;
+			Rect     bounds;
+		};
+
+		// Entries per leaf, small enough that testing a leaf is cheaper than splitting it
+		static const size_t LeafSize = 4;
+
+		static Quad MakeQuad(float originX, float originY, float axisXx, float axisXy, float axisYx, float axisYy);
+
+		void Clear();
+
+		/*!
+		* \brief Replace the content of the index
+		* \param entries Items in any order, keys must be unique
+		*/
+		void Build(std::vector<Entry> entries);
+
+		/*!
+		* \brief Move an item without rebuilding the tree
+		* \return false if the key isn't indexed
+		*/
+		bool Update(uint64_t key, const Quad& quad);
+
+		size_t Size() const;
+
+		const Entry* Find(uint64_t key) const;
+
+		/*!
+		* \brief Topmost item whose box contains the point
+		* \return nullptr if no item is under the point
+		*/
+		const Entry* HitTest(float x, float y);
+
+		/*!
+		* \brief Items whose bounds intersect the rectangle, topmost first
+		*/
+		void QueryRect(const Rect& rect, std::vector<const Entry*>& result);
+
+		/*!
+		* \brief Items other than key whose bounds lie within distance of its bounds, topmost first
+		* Those are the only items an edge of the item can snap to when it's moved
+		* by less than distance.
+		*/
+		void QueryNear(uint64_t key, float distance, std::vector<const Entry*>& result);
+
+		private:
+		struct Node
+		{
+			Rect     bounds;
+			uint32_t maxOrder;
+			// Inner nodes: index of the second child, the first one follows the node
+			// Leaves: 0, the entries are [first, first + count)
+			uint32_t right;
+			uint32_t first;
+			uint32_t count;
+		};
+
+		uint32_t BuildNode(uint32_t first, uint32_t count);
+		void     Refit();
+		void     Collect(const Rect& rect, std::vector<const Entry*>& result);
+
+		std::vector<Entry>                   m_entries;
+		std::vector<Node>                    m_nodes;
+		std::unordered_map<uint64_t, size_t> m_lookup;
+		bool                                 m_refit = false;
+	};
+} // namespace util
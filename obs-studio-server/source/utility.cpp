@@ -18,6 +18,7 @@
 
 #include "utility.hpp"
 #include "obs-property.hpp"
+#include "obs-property-schema.hpp"
 
 std::string utility::osn_current_version(std::string _version)
 {
@@ -188,11 +189,11 @@ void utility::unique_id::mark_free_range(utility::unique_id::id_t min, utility::
 	}
 }
 
-void utility::ProcessProperties(
-	obs_properties_t*           prp,
-	obs_data*                   settings,
-	bool&                       updateSource,
-	std::vector<ipc::value>&    rval)
+static void CollectProperties(
+	obs_properties_t*             prp,
+	obs_data*                     settings,
+	bool&                         updateSource,
+	obs::PropertySchema::List&    props)
 {
 	const char* buf = nullptr;
 	for (obs_property_t* p = obs_properties_first(prp); (p != nullptr); obs_property_next(&p)) {
@@ -371,7 +372,7 @@ void utility::ProcessProperties(
 		}
 		case OBS_PROPERTY_GROUP: {
 			auto grp = obs_property_group_content(p);
-			ProcessProperties(grp, settings, updateSource, rval);
+			CollectProperties(grp, settings, updateSource, props);
 			prop = nullptr;
 			break;
 		}
@@ -387,9 +388,31 @@ void utility::ProcessProperties(
 		prop->enabled          = obs_property_enabled(p);
 		prop->visible          = obs_property_visible(p);
 
-		std::vector<char> buf(prop->size());
-		if (prop->serialize(buf)) {
-			rval.push_back(ipc::value(buf));
-		}
+		props.push_back(std::move(prop));
 	}
 }
+
+void utility::ProcessProperties(
+	obs_properties_t*           prp,
+	obs_data*                   settings,
+	bool&                       updateSource,
+	std::vector<ipc::value>&    rval,
+	uint64_t                    knownHash)
+{
+	obs::PropertySchema::List props;
+	CollectProperties(prp, settings, updateSource, props);
+
+	std::vector<char> buf;
+	obs::PropertySchema::encode(props, buf, knownHash);
+	rval.push_back(ipc::value(buf));
+}
+
+uint64_t utility::GetPropertySchemaHash(obs_properties_t* prp, obs_data* settings)
+{
+	obs::PropertySchema::List props;
+	bool                      updateSource = false;
+	CollectProperties(prp, settings, updateSource, props);
+
+	std::vector<char> buf;
+	return obs::PropertySchema::encode(props, buf);
+}
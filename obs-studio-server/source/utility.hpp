@@ -265,9 +265,14 @@ namespace utility
         }
 	};
 
+	// Pushes the properties as a single obs::PropertySchema blob, without the schema if its hash is knownHash
 	void ProcessProperties(
 		obs_properties_t*              prp,
 		obs_data*                      settings,
 		bool&                          updateSource,
-		std::vector<ipc::value>&       rval);
+		std::vector<ipc::value>&       rval,
+		uint64_t                       knownHash = 0);
+
+	// Hash of the schema ProcessProperties sends for the properties
+	uint64_t GetPropertySchemaHash(obs_properties_t* prp, obs_data* settings);
 } // namespace utility
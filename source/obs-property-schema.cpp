@@ -0,0 +1,651 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "obs-property-schema.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+// Blob layout:
+//   magic, version, flags, schema hash, property count
+//   [flags & HasSchema] string table, then the schema of each property
+//   the values of each property
+// Integers are LEB128 varints, signed ones zigzag encoded first, doubles are
+// copied as is.
+
+static const uint32_t Magic     = 0x504e534f; // "OSNP"
+static const uint8_t  Version   = 1;
+static const uint8_t  HasSchema = 0x01;
+
+namespace
+{
+	class Writer
+	{
+		std::vector<char>& buf;
+
+		public:
+		Writer(std::vector<char>& buf) : buf(buf) {}
+
+		void u8(uint8_t value)
+		{
+			buf.push_back(char(value));
+		}
+
+		void raw(const void* data, size_t size)
+		{
+			buf.insert(buf.end(), reinterpret_cast<const char*>(data), reinterpret_cast<const char*>(data) + size);
+		}
+
+		void varint(uint64_t value)
+		{
+			while (value >= 0x80) {
+				u8(uint8_t(value) | 0x80);
+				value >>= 7;
+			}
+			u8(uint8_t(value));
+		}
+
+		void zigzag(int64_t value)
+		{
+			varint((uint64_t(value) << 1) ^ uint64_t(value >> 63));
+		}
+
+		void f64(double_t value)
+		{
+			double v = value;
+			raw(&v, sizeof(v));
+		}
+
+		void str(std::string_view value)
+		{
+			varint(value.size());
+			raw(value.data(), value.size());
+		}
+	};
+
+	class Reader
+	{
+		std::vector<char> const& buf;
+		size_t                   offset;
+
+		public:
+		bool ok = true;
+
+		Reader(std::vector<char> const& buf, size_t offset = 0) : buf(buf), offset(offset) {}
+
+		bool raw(void* data, size_t size)
+		{
+			if (!ok || buf.size() - offset < size)
+				return ok = false;
+			std::memcpy(data, buf.data() + offset, size);
+			offset += size;
+			return true;
+		}
+
+		uint8_t u8()
+		{
+			uint8_t value = 0;
+			raw(&value, 1);
+			return value;
+		}
+
+		uint64_t varint()
+		{
+			uint64_t value = 0;
+			for (unsigned shift = 0; ok && shift < 64; shift += 7) {
+				uint8_t byte = u8();
+				value |= uint64_t(byte & 0x7f) << shift;
+				if (!(byte & 0x80))
+					return value;
+			}
+			ok = false;
+			return 0;
+		}
+
+		int64_t zigzag()
+		{
+			uint64_t value = varint();
+			return int64_t(value >> 1) ^ -int64_t(value & 1);
+		}
+
+		double_t f64()
+		{
+			double value = 0;
+			raw(&value, sizeof(value));
+			return value;
+		}
+
+		std::string str()
+		{
+			uint64_t size = varint();
+			if (!ok || buf.size() - offset < size) {
+				ok = false;
+				return std::string();
+			}
+			std::string value(buf.data() + offset, size_t(size));
+			offset += size_t(size);
+			return value;
+		}
+	};
+
+	// Gives every distinct string an index into the table written ahead of the schema. The
+	// strings are only referenced, they belong to the properties being encoded.
+	class Interner
+	{
+		std::unordered_map<std::string_view, uint64_t> indices;
+
+		public:
+		std::vector<std::string_view> strings;
+
+		Interner(size_t expected)
+		{
+			indices.reserve(expected);
+			strings.reserve(expected);
+		}
+
+		uint64_t intern(const std::string& value)
+		{
+			auto inserted = indices.emplace(value, strings.size());
+			if (inserted.second)
+				strings.push_back(value);
+			return inserted.first->second;
+		}
+	};
+
+	std::shared_ptr<obs::Property> create(obs::Property::Type type)
+	{
+		switch (type) {
+		case obs::Property::Type::Boolean:
+			return std::make_shared<obs::BooleanProperty>();
+		case obs::Property::Type::Integer:
+			return std::make_shared<obs::IntegerProperty>();
+		case obs::Property::Type::Float:
+			return std::make_shared<obs::FloatProperty>();
+		case obs::Property::Type::Text:
+			return std::make_shared<obs::TextProperty>();
+		case obs::Property::Type::Path:
+			return std::make_shared<obs::PathProperty>();
+		case obs::Property::Type::List:
+			return std::make_shared<obs::ListProperty>();
+		case obs::Property::Type::Color:
+			return std::make_shared<obs::ColorProperty>();
+		case obs::Property::Type::Capture:
+			return std::make_shared<obs::CaptureProperty>();
+		case obs::Property::Type::Button:
+			return std::make_shared<obs::ButtonProperty>();
+		case obs::Property::Type::Font:
+			return std::make_shared<obs::FontProperty>();
+		case obs::Property::Type::EditableList:
+			return std::make_shared<obs::EditableListProperty>();
+		case obs::Property::Type::FrameRate:
+			return std::make_shared<obs::FrameRateProperty>();
+		default:
+			return nullptr;
+		}
+	}
+
+	void writeSchema(Writer& out, Interner& strings, obs::Property* prop)
+	{
+		out.u8(uint8_t(prop->type()));
+		out.varint(strings.intern(prop->name));
+		out.varint(strings.intern(prop->description));
+		out.varint(strings.intern(prop->long_description));
+
+		switch (prop->type()) {
+		case obs::Property::Type::Integer: {
+			auto p = static_cast<obs::IntegerProperty*>(prop);
+			out.u8(uint8_t(p->field_type));
+			out.zigzag(p->minimum);
+			out.zigzag(p->maximum);
+			out.zigzag(p->step);
+			break;
+		}
+		case obs::Property::Type::Float: {
+			auto p = static_cast<obs::FloatProperty*>(prop);
+			out.u8(uint8_t(p->field_type));
+			out.f64(p->minimum);
+			out.f64(p->maximum);
+			out.f64(p->step);
+			break;
+		}
+		case obs::Property::Type::Color:
+		case obs::Property::Type::Capture:
+			out.u8(uint8_t(static_cast<obs::NumberProperty*>(prop)->field_type));
+			break;
+		case obs::Property::Type::Text:
+			out.u8(uint8_t(static_cast<obs::TextProperty*>(prop)->field_type));
+			break;
+		case obs::Property::Type::Path: {
+			auto p = static_cast<obs::PathProperty*>(prop);
+			out.u8(uint8_t(p->field_type));
+			out.varint(strings.intern(p->filter));
+			out.varint(strings.intern(p->default_path));
+			break;
+		}
+		case obs::Property::Type::List: {
+			auto p = static_cast<obs::ListProperty*>(prop);
+			out.u8(uint8_t(p->field_type));
+			out.u8(uint8_t(p->format));
+			out.varint(p->items.size());
+			for (auto& item : p->items) {
+				out.varint(strings.intern(item.name));
+				out.u8(item.enabled);
+				switch (p->format) {
+				case obs::ListProperty::Format::Integer:
+					out.zigzag(item.value_int);
+					break;
+				case obs::ListProperty::Format::Float:
+					out.f64(item.value_float);
+					break;
+				case obs::ListProperty::Format::String:
+					out.varint(strings.intern(item.value_string));
+					break;
+				default:
+					break;
+				}
+			}
+			break;
+		}
+		case obs::Property::Type::EditableList: {
+			auto p = static_cast<obs::EditableListProperty*>(prop);
+			out.u8(uint8_t(p->field_type));
+			out.varint(strings.intern(p->filter));
+			out.varint(strings.intern(p->default_path));
+			break;
+		}
+		case obs::Property::Type::FrameRate: {
+			auto p = static_cast<obs::FrameRateProperty*>(prop);
+			out.varint(p->ranges.size());
+			for (auto& range : p->ranges) {
+				out.varint(range.minimum.first);
+				out.varint(range.minimum.second);
+				out.varint(range.maximum.first);
+				out.varint(range.maximum.second);
+			}
+			out.varint(p->options.size());
+			for (auto& option : p->options) {
+				out.varint(strings.intern(option.name));
+				out.varint(strings.intern(option.description));
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	std::shared_ptr<obs::Property> readSchema(Reader& in, const std::vector<std::string>& strings)
+	{
+		auto string = [&in, &strings]() -> const std::string& {
+			static const std::string empty;
+			uint64_t                 index = in.varint();
+			if (index >= strings.size()) {
+				in.ok = false;
+				return empty;
+			}
+			return strings[size_t(index)];
+		};
+
+		std::shared_ptr<obs::Property> prop = create(obs::Property::Type(in.u8()));
+		if (!prop) {
+			in.ok = false;
+			return nullptr;
+		}
+		prop->name             = string();
+		prop->description      = string();
+		prop->long_description = string();
+
+		switch (prop->type()) {
+		case obs::Property::Type::Integer: {
+			auto p        = static_cast<obs::IntegerProperty*>(prop.get());
+			p->field_type = obs::NumberProperty::NumberType(in.u8());
+			p->minimum    = in.zigzag();
+			p->maximum    = in.zigzag();
+			p->step       = in.zigzag();
+			break;
+		}
+		case obs::Property::Type::Float: {
+			auto p        = static_cast<obs::FloatProperty*>(prop.get());
+			p->field_type = obs::NumberProperty::NumberType(in.u8());
+			p->minimum    = in.f64();
+			p->maximum    = in.f64();
+			p->step       = in.f64();
+			break;
+		}
+		case obs::Property::Type::Color:
+		case obs::Property::Type::Capture:
+			static_cast<obs::NumberProperty*>(prop.get())->field_type = obs::NumberProperty::NumberType(in.u8());
+			break;
+		case obs::Property::Type::Text:
+			static_cast<obs::TextProperty*>(prop.get())->field_type = obs::TextProperty::TextType(in.u8());
+			break;
+		case obs::Property::Type::Path: {
+			auto p          = static_cast<obs::PathProperty*>(prop.get());
+			p->field_type   = obs::PathProperty::PathType(in.u8());
+			p->filter       = string();
+			p->default_path = string();
+			break;
+		}
+		case obs::Property::Type::List: {
+			auto p        = static_cast<obs::ListProperty*>(prop.get());
+			p->field_type = obs::ListProperty::ListType(in.u8());
+			p->format     = obs::ListProperty::Format(in.u8());
+			for (uint64_t count = in.varint(); in.ok && count > 0; count--) {
+				obs::ListProperty::Item item = {};
+				item.name                    = string();
+				item.enabled                 = !!in.u8();
+				switch (p->format) {
+				case obs::ListProperty::Format::Integer:
+					item.value_int = in.zigzag();
+					break;
+				case obs::ListProperty::Format::Float:
+					item.value_float = in.f64();
+					break;
+				case obs::ListProperty::Format::String:
+					item.value_string = string();
+					break;
+				default:
+					break;
+				}
+				p->items.push_back(std::move(item));
+			}
+			break;
+		}
+		case obs::Property::Type::EditableList: {
+			auto p          = static_cast<obs::EditableListProperty*>(prop.get());
+			p->field_type   = obs::EditableListProperty::ListType(in.u8());
+			p->filter       = string();
+			p->default_path = string();
+			break;
+		}
+		case obs::Property::Type::FrameRate: {
+			auto p = static_cast<obs::FrameRateProperty*>(prop.get());
+			for (uint64_t count = in.varint(); in.ok && count > 0; count--) {
+				obs::FrameRateProperty::Range range;
+				range.minimum.first  = uint32_t(in.varint());
+				range.minimum.second = uint32_t(in.varint());
+				range.maximum.first  = uint32_t(in.varint());
+				range.maximum.second = uint32_t(in.varint());
+				p->ranges.push_back(range);
+			}
+			for (uint64_t count = in.varint(); in.ok && count > 0; count--) {
+				obs::FrameRateProperty::Option option;
+				option.name        = string();
+				option.description = string();
+				p->options.push_back(std::move(option));
+			}
+			break;
+		}
+		default:
+			break;
+		}
+
+		return in.ok ? prop : nullptr;
+	}
+
+	void writeValues(Writer& out, obs::Property* prop)
+	{
+		out.u8(uint8_t(prop->enabled) | uint8_t(prop->visible) << 1);
+
+		switch (prop->type()) {
+		case obs::Property::Type::Boolean:
+			out.u8(static_cast<obs::BooleanProperty*>(prop)->value);
+			break;
+		case obs::Property::Type::Integer:
+			out.zigzag(static_cast<obs::IntegerProperty*>(prop)->value);
+			break;
+		case obs::Property::Type::Float:
+			out.f64(static_cast<obs::FloatProperty*>(prop)->value);
+			break;
+		case obs::Property::Type::Color:
+			out.zigzag(static_cast<obs::ColorProperty*>(prop)->value);
+			break;
+		case obs::Property::Type::Capture:
+			out.zigzag(static_cast<obs::CaptureProperty*>(prop)->value);
+			break;
+		case obs::Property::Type::Text:
+			out.str(static_cast<obs::TextProperty*>(prop)->value);
+			break;
+		case obs::Property::Type::Path:
+			out.str(static_cast<obs::PathProperty*>(prop)->value);
+			break;
+		case obs::Property::Type::List: {
+			auto p = static_cast<obs::ListProperty*>(prop);
+			switch (p->format) {
+			case obs::ListProperty::Format::Integer:
+				out.zigzag(p->current_value_int);
+				break;
+			case obs::ListProperty::Format::Float:
+				out.f64(p->current_value_float);
+				break;
+			case obs::ListProperty::Format::String:
+				out.str(p->current_value_str);
+				break;
+			default:
+				break;
+			}
+			break;
+		}
+		case obs::Property::Type::Font: {
+			auto p = static_cast<obs::FontProperty*>(prop);
+			out.str(p->face);
+			out.str(p->style);
+			out.str(p->path);
+			out.zigzag(p->sizeF);
+			out.varint(p->flags);
+			break;
+		}
+		case obs::Property::Type::EditableList: {
+			auto p = static_cast<obs::EditableListProperty*>(prop);
+			out.varint(p->values.size());
+			for (auto& value : p->values)
+				out.str(value);
+			break;
+		}
+		case obs::Property::Type::FrameRate: {
+			auto p = static_cast<obs::FrameRateProperty*>(prop);
+			out.varint(p->current_numerator);
+			out.varint(p->current_denominator);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	void readValues(Reader& in, obs::Property* prop)
+	{
+		uint8_t flags = in.u8();
+		prop->enabled = !!(flags & 1);
+		prop->visible = !!(flags & 2);
+
+		switch (prop->type()) {
+		case obs::Property::Type::Boolean:
+			static_cast<obs::BooleanProperty*>(prop)->value = !!in.u8();
+			break;
+		case obs::Property::Type::Integer:
+			static_cast<obs::IntegerProperty*>(prop)->value = in.zigzag();
+			break;
+		case obs::Property::Type::Float:
+			static_cast<obs::FloatProperty*>(prop)->value = in.f64();
+			break;
+		case obs::Property::Type::Color:
+			static_cast<obs::ColorProperty*>(prop)->value = in.zigzag();
+			break;
+		case obs::Property::Type::Capture:
+			static_cast<obs::CaptureProperty*>(prop)->value = in.zigzag();
+			break;
+		case obs::Property::Type::Text:
+			static_cast<obs::TextProperty*>(prop)->value = in.str();
+			break;
+		case obs::Property::Type::Path:
+			static_cast<obs::PathProperty*>(prop)->value = in.str();
+			break;
+		case obs::Property::Type::List: {
+			auto p = static_cast<obs::ListProperty*>(prop);
+			switch (p->format) {
+			case obs::ListProperty::Format::Integer:
+				p->current_value_int = in.zigzag();
+				break;
+			case obs::ListProperty::Format::Float:
+				p->current_value_float = in.f64();
+				break;
+			case obs::ListProperty::Format::String:
+				p->current_value_str = in.str();
+				break;
+			default:
+				break;
+			}
+			break;
+		}
+		case obs::Property::Type::Font: {
+			auto p   = static_cast<obs::FontProperty*>(prop);
+			p->face  = in.str();
+			p->style = in.str();
+			p->path  = in.str();
+			p->sizeF = in.zigzag();
+			p->flags = uint32_t(in.varint());
+			break;
+		}
+		case obs::Property::Type::EditableList: {
+			auto p = static_cast<obs::EditableListProperty*>(prop);
+			p->values.clear();
+			for (uint64_t count = in.varint(); in.ok && count > 0; count--)
+				p->values.push_back(in.str());
+			break;
+		}
+		case obs::Property::Type::FrameRate: {
+			auto p                 = static_cast<obs::FrameRateProperty*>(prop);
+			p->current_numerator   = uint32_t(in.varint());
+			p->current_denominator = uint32_t(in.varint());
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	// 64-bit FNV-1a
+	uint64_t hash(const std::vector<char>& data)
+	{
+		uint64_t value = 0xcbf29ce484222325ull;
+		for (char c : data) {
+			value ^= uint8_t(c);
+			value *= 0x100000001b3ull;
+		}
+		return value;
+	}
+} // namespace
+
+uint64_t obs::PropertySchema::encode(const List& props, std::vector<char>& buf, uint64_t knownHash)
+{
+	// The schema is written apart first to hash it
+	std::vector<char> schema, properties;
+	Interner          strings(props.size() * 4);
+	Writer            schemaOut(schema), propertiesOut(properties);
+	properties.reserve(props.size() * 16);
+	for (auto& prop : props)
+		writeSchema(propertiesOut, strings, prop.get());
+
+	schema.reserve(properties.size() * 4);
+	schemaOut.varint(strings.strings.size());
+	for (auto string : strings.strings)
+		schemaOut.str(string);
+	schema.insert(schema.end(), properties.begin(), properties.end());
+
+	uint64_t schemaHash = hash(schema);
+	if (schemaHash == knownHash) {
+		encodeValues(props, schemaHash, buf);
+		return schemaHash;
+	}
+
+	buf.clear();
+	buf.reserve(schema.size() + props.size() * 8 + 32);
+	Writer out(buf);
+	out.raw(&Magic, sizeof(Magic));
+	out.u8(Version);
+	out.u8(HasSchema);
+	out.raw(&schemaHash, sizeof(schemaHash));
+	out.varint(props.size());
+	out.raw(schema.data(), schema.size());
+	for (auto& prop : props)
+		writeValues(out, prop.get());
+
+	return schemaHash;
+}
+
+void obs::PropertySchema::encodeValues(const List& props, uint64_t hash, std::vector<char>& buf)
+{
+	buf.clear();
+	buf.reserve(props.size() * 8 + 32);
+	Writer out(buf);
+	out.raw(&Magic, sizeof(Magic));
+	out.u8(Version);
+	out.u8(0);
+	out.raw(&hash, sizeof(hash));
+	out.varint(props.size());
+	for (auto& prop : props)
+		writeValues(out, prop.get());
+}
+
+bool obs::PropertySchema::peek(std::vector<char> const& buf, uint64_t& hash, bool& hasSchema)
+{
+	Reader   in(buf);
+	uint32_t magic = 0;
+	in.raw(&magic, sizeof(magic));
+	uint8_t version = in.u8();
+	uint8_t flags   = in.u8();
+	in.raw(&hash, sizeof(hash));
+	hasSchema = !!(flags & HasSchema);
+	return in.ok && magic == Magic && version == Version;
+}
+
+bool obs::PropertySchema::decode(std::vector<char> const& buf, List& props)
+{
+	uint64_t schemaHash = 0;
+	bool     hasSchema  = false;
+	if (!peek(buf, schemaHash, hasSchema))
+		return false;
+
+	Reader   in(buf, sizeof(Magic) + 2 + sizeof(schemaHash));
+	uint64_t count = in.varint();
+
+	if (hasSchema) {
+		std::vector<std::string> strings;
+		uint64_t                 size = in.varint();
+		strings.reserve(size_t(std::min<uint64_t>(size, buf.size())));
+		for (; in.ok && size > 0; size--)
+			strings.push_back(in.str());
+
+		List decoded;
+		decoded.reserve(size_t(std::min<uint64_t>(count, buf.size())));
+		for (uint64_t idx = 0; in.ok && idx < count; idx++)
+			decoded.push_back(readSchema(in, strings));
+		if (!in.ok)
+			return false;
+		props.swap(decoded);
+	} else if (props.size() != count) {
+		return false;
+	}
+
+	for (auto& prop : props)
+		readValues(in, prop.get());
+
+	return in.ok;
+}
@@ -0,0 +1,48 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <memory>
+#include <vector>
+#include "obs-property.hpp"
+
+namespace obs
+{
+	// Encodes a whole property list as one blob. The schema part, everything that
+	// describes the properties, comes first with its strings interned in a table;
+	// the values follow. The schema is identified by a hash so it can be left out
+	// when the receiver already has it.
+	struct PropertySchema
+	{
+		typedef std::vector<std::shared_ptr<Property>> List;
+
+		// Fills buf and returns the schema hash. The schema is left out if its hash is knownHash.
+		static uint64_t encode(const List& props, std::vector<char>& buf, uint64_t knownHash = 0);
+
+		// Fills buf with the values only, for a schema whose hash is already known
+		static void encodeValues(const List& props, uint64_t hash, std::vector<char>& buf);
+
+		// Reads the hash of a blob and whether it carries the schema
+		static bool peek(std::vector<char> const& buf, uint64_t& hash, bool& hasSchema);
+
+		// Replaces props with the blob's properties. Without a schema in the blob, props must
+		// already hold the properties of the same schema and only their values are updated.
+		static bool decode(std::vector<char> const& buf, List& props);
+	};
+} // namespace obs
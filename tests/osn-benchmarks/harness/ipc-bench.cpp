@@ -0,0 +1,309 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Raw client <-> server round-trip benchmark.
+//
+// Talks to an obs-studio-server instance directly through lib-streamlabs-ipc,
+// bypassing the N-API layer, so the numbers only contain serialization,
+// transport and handler cost. The server has to be started beforehand:
+//   obs64 <socket> <version>
+// and the harness is then run with:
+//   osn-ipc-bench <socket> <working directory> <appdata> [iterations] [output.json]
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <ipc-client.hpp>
+#include <ipc-value.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "error.hpp"
+
+#undef strtoll
+#include "nlohmann/json.hpp"
+
+#ifndef OSN_VERSION
+#define OSN_VERSION "DEVMODE_VERSION"
+#endif
+
+struct BenchResult
+{
+	std::string name;
+	size_t      calls         = 0;
+	double      mean_us       = 0;
+	double      p50_us        = 0;
+	double      p99_us        = 0;
+	double      calls_per_sec = 0;
+	size_t      failures      = 0;
+};
+
+static std::shared_ptr<ipc::client> g_conn;
+
+static bool IsOk(const std::vector<ipc::value>& response)
+{
+	return response.size() > 0 && (ErrorCode)response[0].value_union.ui64 == ErrorCode::Ok;
+}
+
+static std::vector<ipc::value>
+    Call(const std::string& cname, const std::string& fname, const std::vector<ipc::value>& args)
+{
+	std::vector<ipc::value> response = g_conn->call_synchronous_helper(cname, fname, args);
+	if (!IsOk(response))
+		std::cerr << "Call " << cname << "::" << fname << " failed." << std::endl;
+	return response;
+}
+
+static double Percentile(const std::vector<double>& sorted, double pct)
+{
+	if (sorted.empty())
+		return 0;
+	size_t idx = static_cast<size_t>(pct * (sorted.size() - 1) + 0.5);
+	return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+static BenchResult Measure(
+    const std::string&                                    name,
+    size_t                                                iterations,
+    const std::function<std::vector<ipc::value>(void)>& fn)
+{
+	BenchResult         result;
+	std::vector<double> samples;
+	samples.reserve(iterations);
+	result.name = name;
+
+	// Warm up caches on both sides before sampling.
+	for (size_t i = 0; i < std::min<size_t>(iterations / 10, 100); i++)
+		fn();
+
+	auto begin = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; i++) {
+		auto tp_start = std::chrono::steady_clock::now();
+		if (!IsOk(fn()))
+			result.failures++;
+		auto tp_end = std::chrono::steady_clock::now();
+		samples.push_back(std::chrono::duration<double, std::micro>(tp_end - tp_start).count());
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	std::sort(samples.begin(), samples.end());
+	double total_s = std::chrono::duration<double>(end - begin).count();
+	double sum     = 0;
+	for (double sample : samples)
+		sum += sample;
+
+	result.calls         = samples.size();
+	result.mean_us       = samples.empty() ? 0 : sum / samples.size();
+	result.p50_us        = Percentile(samples, 0.50);
+	result.p99_us        = Percentile(samples, 0.99);
+	result.calls_per_sec = total_s > 0 ? samples.size() / total_s : 0;
+
+	std::cerr << name << ": p50 " << result.p50_us << "us, p99 " << result.p99_us << "us, "
+	          << result.calls_per_sec << " calls/s" << std::endl;
+	return result;
+}
+
+static uint64_t CreateInput(const std::string& type, const std::string& name, const std::string& settings)
+{
+	std::vector<ipc::value> response =
+	    Call("Input", "Create", {ipc::value(type), ipc::value(name), ipc::value(settings)});
+	return IsOk(response) ? response[1].value_union.ui64 : UINT64_MAX;
+}
+
+static std::string PayloadSettings(size_t bytes)
+{
+	nlohmann::json settings;
+	settings["bench_payload"] = std::string(bytes, 'x');
+	return settings.dump();
+}
+
+static void BenchGetSettings(std::vector<BenchResult>& results, size_t iterations)
+{
+	for (size_t bytes : {size_t(1024), size_t(100 * 1024)}) {
+		uint64_t uid = CreateInput("image_source", "bench_settings_" + std::to_string(bytes), PayloadSettings(bytes));
+		if (uid == UINT64_MAX)
+			continue;
+
+		results.push_back(Measure(
+		    "Source.GetSettings/" + std::to_string(bytes / 1024) + "KB", iterations, [uid]() {
+			    return g_conn->call_synchronous_helper("Source", "GetSettings", {ipc::value(uid)});
+		    }));
+
+		Call("Source", "Remove", {ipc::value(uid)});
+		Call("Source", "Release", {ipc::value(uid)});
+	}
+}
+
+static void BenchSceneItems(std::vector<BenchResult>& results, size_t iterations, size_t item_count)
+{
+	std::vector<ipc::value> response = Call("Scene", "Create", {ipc::value("bench_scene")});
+	if (!IsOk(response))
+		return;
+	uint64_t scene_uid = response[1].value_union.ui64;
+
+	uint64_t input_uid = CreateInput("image_source", "bench_item_source", "{}");
+	if (input_uid == UINT64_MAX)
+		return;
+
+	std::vector<uint64_t> items;
+	items.reserve(item_count);
+	for (size_t i = 0; i < item_count; i++) {
+		response = Call("Scene", "AddSource", {ipc::value(scene_uid), ipc::value(input_uid)});
+		if (IsOk(response))
+			items.push_back(response[1].value_union.ui64);
+	}
+
+	if (!items.empty()) {
+		size_t idx = 0;
+		results.push_back(Measure("SceneItem.SetPosition", iterations, [&items, &idx]() {
+			uint64_t item = items[idx++ % items.size()];
+			float    pos  = float(idx % 1920);
+			return g_conn->call_synchronous_helper(
+			    "SceneItem", "SetPosition", {ipc::value(item), ipc::value(pos), ipc::value(pos)});
+		}));
+
+		results.push_back(Measure(
+		    "Scene.GetItems/" + std::to_string(items.size()), std::max<size_t>(iterations / 10, 10), [scene_uid]() {
+			    return g_conn->call_synchronous_helper("Scene", "GetItems", {ipc::value(scene_uid)});
+		    }));
+	}
+
+	Call("Scene", "Remove", {ipc::value(scene_uid)});
+	Call("Scene", "Release", {ipc::value(scene_uid)});
+	Call("Source", "Remove", {ipc::value(input_uid)});
+	Call("Source", "Release", {ipc::value(input_uid)});
+}
+
+static void BenchGlobalQuery(std::vector<BenchResult>& results, size_t iterations)
+{
+	for (size_t count : {size_t(0), size_t(32), size_t(128)}) {
+		std::vector<uint64_t> inputs, volmeters;
+		for (size_t i = 0; i < count; i++) {
+			uint64_t input = CreateInput("image_source", "bench_volmeter_" + std::to_string(i), "{}");
+			if (input == UINT64_MAX)
+				continue;
+			inputs.push_back(input);
+
+			// 0 = OBS_FADER_CUBIC
+			std::vector<ipc::value> response = Call("Volmeter", "Create", {ipc::value((int32_t)0)});
+			if (!IsOk(response))
+				continue;
+			uint64_t volmeter = response[1].value_union.ui64;
+			volmeters.push_back(volmeter);
+			Call("Volmeter", "Attach", {ipc::value(volmeter), ipc::value(input)});
+		}
+
+		std::vector<char> ids(sizeof(uint64_t) * volmeters.size());
+		memcpy(ids.data(), volmeters.data(), ids.size());
+
+		results.push_back(
+		    Measure("CallbackManager.GlobalQuery/" + std::to_string(count), iterations, [&ids]() {
+			    return g_conn->call_synchronous_helper(
+			        "CallbackManager", "GlobalQuery", {ipc::value((uint64_t)ids.size()), ipc::value(ids)});
+		    }));
+
+		for (uint64_t volmeter : volmeters) {
+			Call("Volmeter", "Detach", {ipc::value(volmeter)});
+			Call("Volmeter", "Destroy", {ipc::value(volmeter)});
+		}
+		for (uint64_t input : inputs) {
+			Call("Source", "Remove", {ipc::value(input)});
+			Call("Source", "Release", {ipc::value(input)});
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 4) {
+		std::cerr << "Usage: osn-ipc-bench <socket> <working directory> <appdata> [iterations] [output.json]"
+		          << std::endl;
+		return 1;
+	}
+
+	std::string socketPath = argv[1];
+	std::string workingDir = argv[2];
+	std::string appdata    = argv[3];
+	size_t      iterations = argc > 4 ? std::stoul(argv[4]) : 10000;
+	std::string outputPath = argc > 5 ? argv[5] : "";
+
+#ifndef WIN32
+	socketPath = "/tmp/" + socketPath;
+#endif
+
+	for (size_t attempt = 0; attempt < 50 && !g_conn; attempt++) {
+		try {
+			g_conn = ipc::client::create(socketPath);
+		} catch (...) {
+			g_conn = nullptr;
+		}
+		if (!g_conn)
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+	if (!g_conn) {
+		std::cerr << "Failed to connect to " << socketPath << std::endl;
+		return 1;
+	}
+
+	Call("API", "SetWorkingDirectory", {ipc::value(workingDir)});
+	std::vector<ipc::value> response = Call(
+	    "API",
+	    "OBS_API_initAPI",
+	    {ipc::value(appdata), ipc::value("en-US"), ipc::value(OSN_VERSION), ipc::value("")});
+	if (!IsOk(response)) {
+		std::cerr << "Failed to initialize the server." << std::endl;
+		return 1;
+	}
+
+	std::vector<BenchResult> results;
+	BenchGetSettings(results, iterations);
+	BenchSceneItems(results, iterations, 1000);
+	BenchGlobalQuery(results, iterations);
+
+	Call("API", "OBS_API_destroyOBS_API", {});
+	g_conn->call_synchronous_helper("System", "Shutdown", {});
+
+	nlohmann::json report;
+	report["layer"]      = "ipc";
+	report["version"]    = OSN_VERSION;
+	report["iterations"] = iterations;
+	report["results"]    = nlohmann::json::array();
+	for (auto& result : results) {
+		report["results"].push_back(
+		    {{"name", result.name},
+		     {"calls", result.calls},
+		     {"failures", result.failures},
+		     {"mean_us", result.mean_us},
+		     {"p50_us", result.p50_us},
+		     {"p99_us", result.p99_us},
+		     {"calls_per_sec", result.calls_per_sec}});
+	}
+
+	if (outputPath.empty()) {
+		std::cout << report.dump(4) << std::endl;
+	} else {
+		std::ofstream out(outputPath, std::ios::trunc | std::ios::out);
+		out << report.dump(4) << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,136 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from '../../osn-tests/osn';
+import { logInfo, logEmptyLine } from '../../osn-tests/util/logger';
+import { OBSHandler } from '../../osn-tests/util/obs_handler';
+import { deleteConfigFiles } from '../../osn-tests/util/general';
+import { EOBSInputTypes } from '../../osn-tests/util/obs_enums';
+
+const fs = require('fs');
+const path = require('path');
+
+const testName = 'osn-bench-ipc';
+
+// Number of measured calls per scenario, override with OSN_BENCH_ITERATIONS
+const iterations: number = parseInt(process.env.OSN_BENCH_ITERATIONS || '2000', 10);
+
+// Machine-readable results, override with OSN_BENCH_OUTPUT
+const outputPath: string = process.env.OSN_BENCH_OUTPUT || path.join(process.cwd(), 'bench_napi.json');
+
+interface IBenchResult {
+    name: string;
+    calls: number;
+    mean_us: number;
+    p50_us: number;
+    p99_us: number;
+    calls_per_sec: number;
+}
+
+function percentile(sorted: number[], pct: number): number {
+    if (sorted.length == 0) {
+        return 0;
+    }
+    const idx = Math.min(Math.round(pct * (sorted.length - 1)), sorted.length - 1);
+    return sorted[idx];
+}
+
+function measure(name: string, count: number, fn: () => void): IBenchResult {
+    const samples: number[] = [];
+
+    // Warm up caches on both sides before sampling
+    for (let i = 0; i < Math.min(count / 10, 100); i++) {
+        fn();
+    }
+
+    const begin = process.hrtime.bigint();
+    for (let i = 0; i < count; i++) {
+        const start = process.hrtime.bigint();
+        fn();
+        samples.push(Number(process.hrtime.bigint() - start) / 1000);
+    }
+    const totalSec = Number(process.hrtime.bigint() - begin) / 1e9;
+
+    samples.sort((a, b) => a - b);
+    const result: IBenchResult = {
+        name: name,
+        calls: samples.length,
+        mean_us: samples.reduce((a, b) => a + b, 0) / samples.length,
+        p50_us: percentile(samples, 0.50),
+        p99_us: percentile(samples, 0.99),
+        calls_per_sec: totalSec > 0 ? samples.length / totalSec : 0,
+    };
+
+    logInfo(testName, name + ': p50 ' + result.p50_us.toFixed(1) + 'us, p99 ' + result.p99_us.toFixed(1) +
+        'us, ' + result.calls_per_sec.toFixed(0) + ' calls/s');
+    return result;
+}
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    const results: IBenchResult[] = [];
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' benchmarks');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process and write the report
+    after(function() {
+        obs.shutdown();
+        obs = null;
+
+        fs.writeFileSync(outputPath, JSON.stringify({
+            layer: 'napi',
+            iterations: iterations,
+            results: results
+        }, null, 4));
+
+        deleteConfigFiles();
+        logInfo(testName, 'Results written to ' + outputPath);
+        logEmptyLine();
+    });
+
+    it('Source settings round-trip with 1KB and 100KB payloads', () => {
+        [1024, 100 * 1024].forEach(bytes => {
+            const input = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'bench_settings_' + bytes,
+                { bench_payload: 'x'.repeat(bytes) });
+            expect(input).to.not.equal(undefined);
+
+            // The settings getter is served from the client cache, this one always goes to the server
+            results.push(measure('Source.GetSettings/' + (bytes / 1024) + 'KB', iterations, () => {
+                return input.slowUncachedSettings;
+            }));
+
+            input.release();
+        });
+    });
+
+    it('Scene item position and item lookup on a 1000 item scene', () => {
+        const scene = osn.SceneFactory.create('bench_scene');
+        const input = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'bench_item_source');
+        expect(scene).to.not.equal(undefined);
+        expect(input).to.not.equal(undefined);
+
+        const items: osn.ISceneItem[] = [];
+        for (let i = 0; i < 1000; i++) {
+            items.push(scene.add(input));
+        }
+
+        let idx = 0;
+        results.push(measure('SceneItem.SetPosition', iterations, () => {
+            const pos = idx % 1920;
+            items[idx++ % items.length].position = { x: pos, y: pos };
+        }));
+
+        // getItems() is answered from the client cache once listed, getItemAtIdx() always asks the server
+        idx = 0;
+        results.push(measure('Scene.GetItem/' + items.length, iterations, () => {
+            return scene.getItemAtIdx(idx++ % items.length);
+        }));
+
+        scene.release();
+        input.release();
+    });
+});
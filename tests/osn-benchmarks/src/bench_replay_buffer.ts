@@ -0,0 +1,112 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from '../../osn-tests/osn';
+import { logInfo, logEmptyLine } from '../../osn-tests/util/logger';
+import { OBSHandler, IOBSOutputSignalInfo } from '../../osn-tests/util/obs_handler';
+import { deleteConfigFiles, sleep } from '../../osn-tests/util/general';
+import { EOBSOutputType, EOBSOutputSignal, EOBSSettingsCategories } from '../../osn-tests/util/obs_enums';
+
+const fs = require('fs');
+const path = require('path');
+
+const testName = 'osn-bench-replay-buffer';
+
+// Length of the replay window that is filled and then saved, override with OSN_BENCH_REPLAY_SECONDS
+const replaySeconds: number = parseInt(process.env.OSN_BENCH_REPLAY_SECONDS || '300', 10);
+
+// Machine-readable results, override with OSN_BENCH_REPLAY_OUTPUT
+const outputPath: string = process.env.OSN_BENCH_REPLAY_OUTPUT || path.join(process.cwd(), 'bench_replay_buffer.json');
+
+interface IReplayResult {
+    name: string;
+    replay_sec: number;
+    save_ms: number;
+    memory_before_mb: number;
+    memory_full_mb: number;
+}
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    const results: IReplayResult[] = [];
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' benchmarks');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+        obs.connectOutputSignals();
+
+        obs.setSetting(EOBSSettingsCategories.Output, 'Mode', 'Simple');
+        obs.setSetting(EOBSSettingsCategories.Output, 'StreamEncoder', obs.os === 'win32' ? 'x264' : 'obs_x264');
+        obs.setSetting(EOBSSettingsCategories.Output, 'FilePath', path.join(path.normalize(__dirname), '..', 'osnData'));
+        obs.setSetting(EOBSSettingsCategories.Output, 'RecRBTime', replaySeconds);
+    });
+
+    // Shutdown OBS process and write the report
+    after(function() {
+        obs.shutdown();
+        obs = null;
+
+        fs.writeFileSync(outputPath, JSON.stringify({
+            layer: 'replay-buffer',
+            results: results
+        }, null, 4));
+
+        deleteConfigFiles();
+        logInfo(testName, 'Results written to ' + outputPath);
+        logEmptyLine();
+    });
+
+    async function fillAndSave(name: string, diskSpill: boolean) {
+        obs.setSetting(EOBSSettingsCategories.Advanced, 'RecRBDiskSpill', diskSpill);
+
+        let signalInfo: IOBSOutputSignalInfo;
+        const memoryBefore = osn.NodeObs.OBS_API_getPerformanceStatistics().memoryUsage;
+
+        osn.NodeObs.OBS_service_startReplayBuffer();
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Start);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Start, name + ' replay buffer did not start: ' + signalInfo.error);
+
+        // Fill the whole window before saving
+        await sleep(replaySeconds * 1000 + 2000);
+        const memoryFull = osn.NodeObs.OBS_API_getPerformanceStatistics().memoryUsage;
+
+        const start = process.hrtime.bigint();
+        osn.NodeObs.OBS_service_processReplayBufferHotkey();
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Writing);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Writing, name + ' replay was not saved');
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Wrote);
+        const saveMs = Number(process.hrtime.bigint() - start) / 1e6;
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Wrote, name + ' replay was not saved');
+
+        osn.NodeObs.OBS_service_stopReplayBuffer(false);
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Stopping);
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Stop);
+
+        const result: IReplayResult = {
+            name: name,
+            replay_sec: replaySeconds,
+            save_ms: saveMs,
+            memory_before_mb: memoryBefore,
+            memory_full_mb: memoryFull,
+        };
+        results.push(result);
+
+        logInfo(testName, name + ': saved ' + replaySeconds + 's in ' + saveMs.toFixed(0) + 'ms, memory ' +
+            memoryBefore.toFixed(0) + 'MB -> ' + memoryFull.toFixed(0) + 'MB');
+    }
+
+    it('Save a full in-memory replay buffer', async function() {
+        this.timeout(replaySeconds * 1000 + 120000);
+        await fillAndSave('replay_buffer', false);
+    });
+
+    it('Save a full disk-spilling replay buffer', async function() {
+        this.timeout(replaySeconds * 1000 + 120000);
+        await fillAndSave('disk_replay_buffer', true);
+    });
+});
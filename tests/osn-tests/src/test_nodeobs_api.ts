@@ -3,7 +3,8 @@ import { expect } from 'chai';
 import * as osn from '../osn';
 import { logInfo, logEmptyLine } from '../util/logger';
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
-import { OBSHandler, IPerformanceState, TOBSHotkey } from '../util/obs_handler';
+import { OBSHandler, IPerformanceState, TOBSHotkey, TOBSHotkeyDelta } from '../util/obs_handler';
+import { EOBSInputTypes } from '../util/obs_enums';
 import { showHideInputHotkeys, slideshowHotkeys, ffmpeg_sourceHotkeys,
     game_captureHotkeys, dshow_wasapitHotkeys,coreaudioHotkeys,  deleteConfigFiles } from '../util/general';
 
@@ -61,6 +62,48 @@ describe(testName, function() {
         expect(stats.diskSpaceAvailable).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetPerformanceStatistics, 'diskSpaceAvailable'));
     });
 
+    it('Get performance snapshot with profiling enabled', function(done) {
+        osn.NodeObs.OBS_API_setProfilingEnabled(true);
+
+        // Give the graphics thread time to record a few frames
+        setTimeout(() => {
+            const snapshot = osn.decodePerformanceSnapshot(osn.NodeObs.OBS_API_getPerformanceSnapshot());
+            osn.NodeObs.OBS_API_setProfilingEnabled(false);
+
+            expect(snapshot.version).to.equal(1, GetErrorMessage(ETestErrorMsg.GetPerformanceSnapshot, 'version'));
+            expect(snapshot.profiling).to.equal(true, GetErrorMessage(ETestErrorMsg.GetPerformanceSnapshot, 'profiling'));
+            expect(snapshot.outputs.length).to.equal(3, GetErrorMessage(ETestErrorMsg.GetPerformanceSnapshot, 'outputs'));
+            expect(snapshot.renderedFrames).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.GetPerformanceSnapshot, 'renderedFrames'));
+            expect(snapshot.entries.length).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.GetPerformanceSnapshot, 'entries'));
+            done();
+        }, 1000);
+    });
+
+    it('Get IPC call statistics', function() {
+        // Issue a few calls so the server has something to report
+        for (let i = 0; i < 5; i++) {
+            osn.NodeObs.OBS_API_getPerformanceStatistics();
+        }
+
+        const stats: any[] = osn.NodeObs.GetCallStats();
+        expect(stats).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetCallStats, 'all calls'));
+
+        const perfStats = stats.find(call => call.collection == 'API' && call.function == 'OBS_API_getPerformanceStatistics');
+        expect(perfStats).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetCallStats, 'OBS_API_getPerformanceStatistics'));
+        expect(perfStats.calls).to.be.at.least(5, GetErrorMessage(ETestErrorMsg.GetCallStats, 'OBS_API_getPerformanceStatistics'));
+        expect(perfStats.bytesOut).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.GetCallStats, 'OBS_API_getPerformanceStatistics'));
+        expect(perfStats.histogram.reduce((a: number, b: number) => a + b, 0)).to.equal(perfStats.calls,
+            GetErrorMessage(ETestErrorMsg.GetCallStats, 'OBS_API_getPerformanceStatistics'));
+    });
+
+    it('Get media cache statistics', function() {
+        const stats = osn.NodeObs.GetMediaCacheStats();
+        expect(stats).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetMediaCacheStats, 'all'));
+        expect(stats.allowedCachedSize).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.GetMediaCacheStats, 'allowedCachedSize'));
+        expect(stats.cachedSize).to.be.at.most(stats.allowedCachedSize, GetErrorMessage(ETestErrorMsg.GetMediaCacheStats, 'cachedSize'));
+        expect(stats.cachedSources).to.be.at.most(stats.sources, GetErrorMessage(ETestErrorMsg.GetMediaCacheStats, 'cachedSources'));
+    });
+
     it('Get hotkeys of all sources and process them', function() {
         let obsHotkeys: TOBSHotkey[];
 
@@ -153,6 +196,48 @@ describe(testName, function() {
         scene.release();
     });
 
+    it('Get hotkey changes since a version and process them in a batch', function() {
+        const sceneName = 'hotkeys_delta_scene';
+        const scene = osn.SceneFactory.create(sceneName);
+        expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateScene, sceneName));
+
+        // An empty scene has no hotkeys, its items register the show and hide pair
+        const inputName = 'hotkeys_delta_input';
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, inputName);
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, inputName));
+        const sceneItem = scene.add(input);
+        expect(sceneItem).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.AddSourceToScene, inputName, sceneName));
+
+        const all: TOBSHotkeyDelta = osn.NodeObs.OBS_API_QueryHotkeysSince(0);
+        expect(all.Full).to.equal(true, GetErrorMessage(ETestErrorMsg.QueryHotkeysSince, '0'));
+        expect(all.Changed.some(hotkey => hotkey.ObjectName === sceneName)).to.equal(true, GetErrorMessage(ETestErrorMsg.QueryHotkeysSince, '0'));
+
+        // Nothing happened since
+        const none: TOBSHotkeyDelta = osn.NodeObs.OBS_API_QueryHotkeysSince(all.Version);
+        expect(none.Full).to.equal(false, GetErrorMessage(ETestErrorMsg.QueryHotkeysSince, all.Version.toString()));
+        expect(none.Changed.length).to.equal(0, GetErrorMessage(ETestErrorMsg.QueryHotkeysSince, all.Version.toString()));
+        expect(none.Removed.length).to.equal(0, GetErrorMessage(ETestErrorMsg.QueryHotkeysSince, all.Version.toString()));
+
+        // Renaming the scene renames its hotkeys
+        const sceneHotkeys = all.Changed.filter(hotkey => hotkey.ObjectName === sceneName).map(hotkey => hotkey.HotkeyId);
+        expect(sceneHotkeys.length).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.QueryHotkeysSince, '0'));
+        scene.name = sceneName + '_renamed';
+        const renamed: TOBSHotkeyDelta = osn.NodeObs.OBS_API_QueryHotkeysSince(all.Version);
+        expect(renamed.Changed.map(hotkey => hotkey.HotkeyId)).to.include.members(sceneHotkeys, GetErrorMessage(ETestErrorMsg.QueryHotkeysSince, all.Version.toString()));
+
+        expect(function() {
+            osn.NodeObs.OBS_API_ProcessHotkeyStatus(sceneHotkeys.map(id => [id, true]));
+            osn.NodeObs.OBS_API_ProcessHotkeyStatus(sceneHotkeys.map(id => [id, false]));
+        }).to.not.throw();
+
+        // Removing the scene removes its hotkeys
+        sceneItem.remove();
+        input.release();
+        scene.release();
+        const removed: TOBSHotkeyDelta = osn.NodeObs.OBS_API_QueryHotkeysSince(renamed.Version);
+        expect(removed.Removed).to.include.members(sceneHotkeys, GetErrorMessage(ETestErrorMsg.QueryHotkeysSince, renamed.Version.toString()));
+    });
+
     it('Stop crash handler', function() {
         // Stopping crash handler as a last test case
         expect(function() {
@@ -148,6 +148,53 @@ describe(testName, function() {
         expect(signalInfo.signal).to.equal(EOBSOutputSignal.Wrote, GetErrorMessage(ETestErrorMsg.RecordingOutput));
     });
 
+    it('Simple mode - Record with the stream encoder, a preset and the stream encoder again', async function() {
+        // Preparing environment
+        obs.setSetting(EOBSSettingsCategories.Output, 'Mode', 'Simple');
+        obs.setSetting(EOBSSettingsCategories.Output, 'StreamEncoder', obs.os === 'win32' ? 'x264' : 'obs_x264');
+        obs.setSetting(EOBSSettingsCategories.Output, 'FilePath', path.join(path.normalize(__dirname), '..', 'osnData'));
+
+        let signalInfo: IOBSOutputSignalInfo;
+
+        // Switching back to a preset must give the recording an audio encoder of its own again
+        for (const quality of ['Stream', 'HQ', 'Stream']) {
+            obs.setSetting(EOBSSettingsCategories.Output, 'RecQuality', quality);
+
+            osn.NodeObs.OBS_service_startRecording();
+
+            signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Start);
+
+            if (signalInfo.signal == EOBSOutputSignal.Stop) {
+                throw Error(GetErrorMessage(ETestErrorMsg.RecordOutputDidNotStart, signalInfo.code.toString(), signalInfo.error));
+            }
+
+            expect(signalInfo.signal).to.equal(EOBSOutputSignal.Start, GetErrorMessage(ETestErrorMsg.RecordingOutput));
+
+            await sleep(500);
+
+            osn.NodeObs.OBS_service_stopRecording();
+
+            signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Stopping);
+            expect(signalInfo.signal).to.equal(EOBSOutputSignal.Stopping, GetErrorMessage(ETestErrorMsg.RecordingOutput));
+
+            signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Stop);
+
+            if (signalInfo.code != 0) {
+                throw Error(GetErrorMessage(ETestErrorMsg.RecordOutputStoppedWithError, signalInfo.code.toString(), signalInfo.error));
+            }
+
+            signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Wrote);
+
+            if (signalInfo.code != 0) {
+                throw Error(GetErrorMessage(ETestErrorMsg.RecordOutputStoppedWithError, signalInfo.code.toString(), signalInfo.error));
+            }
+
+            expect(signalInfo.signal).to.equal(EOBSOutputSignal.Wrote, GetErrorMessage(ETestErrorMsg.RecordingOutput));
+        }
+
+        obs.setSetting(EOBSSettingsCategories.Output, 'RecQuality', 'Stream');
+    });
+
     it('Simple mode - Start replay buffer, save replay and stop', async function() {
         // Preparing environment
         obs.setSetting(EOBSSettingsCategories.Output, 'Mode', 'Simple');
@@ -946,6 +993,223 @@ describe(testName, function() {
         expect(signalInfo.signal).to.equal(EOBSOutputSignal.Deactivate, GetErrorMessage(ETestErrorMsg.StreamOutput));
     });
 
+    it('Simple mode - Stop delayed stream and report remaining delay', async function() {
+        // Preparing environment
+        obs.setSetting(EOBSSettingsCategories.Output, 'Mode', 'Simple');
+        obs.setSetting(EOBSSettingsCategories.Output, 'StreamEncoder', obs.os === 'win32' ? 'x264' : 'obs_x264');
+        obs.setSetting(EOBSSettingsCategories.Advanced, 'DelayEnable', true);
+        obs.setSetting(EOBSSettingsCategories.Advanced, 'DelaySec', 5);
+
+        let signalInfo: IOBSOutputSignalInfo;
+
+        osn.NodeObs.OBS_service_startStreaming();
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Starting);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Starting, GetErrorMessage(ETestErrorMsg.StreamOutput));
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Activate);
+
+        if (signalInfo.signal == EOBSOutputSignal.Stop) {
+            throw Error(GetErrorMessage(ETestErrorMsg.StreamOutputDidNotStart, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Start);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Start, GetErrorMessage(ETestErrorMsg.StreamOutput));
+
+        await sleep(500);
+
+        osn.NodeObs.OBS_service_stopStreaming(false);
+
+        // Remaining delay is reported once per second until the output deactivates
+        const countdown: number[] = [];
+        do {
+            signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Deactivate);
+            expect(signalInfo.type).to.equal(EOBSOutputType.Streaming, GetErrorMessage(ETestErrorMsg.StreamOutput));
+            if (signalInfo.signal == EOBSOutputSignal.Delay) {
+                countdown.push(signalInfo.code);
+            }
+        } while (signalInfo.signal != EOBSOutputSignal.Deactivate);
+
+        expect(countdown.length).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.StreamDelay));
+        expect(countdown[0]).to.be.at.most(5, GetErrorMessage(ETestErrorMsg.StreamDelay));
+        for (let i = 1; i < countdown.length; i++) {
+            expect(countdown[i]).to.be.at.most(countdown[i - 1], GetErrorMessage(ETestErrorMsg.StreamDelay));
+        }
+
+        obs.setSetting(EOBSSettingsCategories.Advanced, 'DelayEnable', false);
+    });
+
+    it('Simple mode - Split recording into segments by size', async function() {
+        // Preparing environment
+        obs.setSetting(EOBSSettingsCategories.Output, 'Mode', 'Simple');
+        obs.setSetting(EOBSSettingsCategories.Output, 'StreamEncoder', obs.os === 'win32' ? 'x264' : 'obs_x264');
+        obs.setSetting(EOBSSettingsCategories.Output, 'FilePath', path.join(path.normalize(__dirname), '..', 'osnData'));
+        obs.setSetting(EOBSSettingsCategories.Advanced, 'RecSplitFile', true);
+        obs.setSetting(EOBSSettingsCategories.Advanced, 'RecSplitFileTime', 0);
+        obs.setSetting(EOBSSettingsCategories.Advanced, 'RecSplitFileSize', 1);
+
+        let signalInfo: IOBSOutputSignalInfo;
+
+        osn.NodeObs.OBS_service_startRecording();
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Start);
+
+        if (signalInfo.signal == EOBSOutputSignal.Stop) {
+            throw Error(GetErrorMessage(ETestErrorMsg.RecordOutputDidNotStart, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        expect(signalInfo.type).to.equal(EOBSOutputType.Recording, GetErrorMessage(ETestErrorMsg.RecordingOutput));
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Start, GetErrorMessage(ETestErrorMsg.RecordingOutput));
+
+        // The first segment is closed once it reached 1MB, while the recording goes on
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Wrote);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Wrote, GetErrorMessage(ETestErrorMsg.RecordingSegment));
+        expect(signalInfo.code).to.equal(0, GetErrorMessage(ETestErrorMsg.RecordingSegment));
+        expect(signalInfo.path).to.match(/[ _]001\.[a-z0-9]+$/, GetErrorMessage(ETestErrorMsg.RecordingSegment));
+
+        const segments: string[] = [signalInfo.path];
+
+        osn.NodeObs.OBS_service_stopRecording();
+
+        // Splits that happened meanwhile are reported before the recording stops
+        do {
+            signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Wrote);
+            if (signalInfo.signal == EOBSOutputSignal.Wrote) {
+                segments.push(signalInfo.path);
+            }
+        } while (signalInfo.signal != EOBSOutputSignal.Stop);
+
+        if (signalInfo.code != 0) {
+            throw Error(GetErrorMessage(ETestErrorMsg.RecordOutputStoppedWithError, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Wrote);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Wrote, GetErrorMessage(ETestErrorMsg.RecordingSegment));
+        segments.push(signalInfo.path);
+
+        expect(new Set(segments).size).to.equal(segments.length, GetErrorMessage(ETestErrorMsg.RecordingSegment));
+        segments.forEach(segment => {
+            expect(segment).to.match(/[ _]\d{3}\.[a-z0-9]+$/, GetErrorMessage(ETestErrorMsg.RecordingSegment));
+        });
+
+        obs.setSetting(EOBSSettingsCategories.Advanced, 'RecSplitFile', false);
+    });
+
+    it('Stream to multiple destinations sharing one encoder', async function() {
+        // Comma separated list of local RTMP sinks, e.g. rtmp://127.0.0.1:1935/live/a,rtmp://127.0.0.1:1935/live/b
+        const sinks: string[] = (process.env.OSN_TEST_RTMP_SINKS || '').split(',').filter(sink => sink.length > 0);
+        if (sinks.length == 0) {
+            this.skip();
+        }
+
+        obs.setSetting(EOBSSettingsCategories.Output, 'Mode', 'Simple');
+        obs.setSetting(EOBSSettingsCategories.Output, 'StreamEncoder', obs.os === 'win32' ? 'x264' : 'obs_x264');
+
+        const names = sinks.map((sink, index) => 'destination_' + index);
+        sinks.forEach((sink, index) => {
+            const server = sink.substring(0, sink.lastIndexOf('/'));
+            const key = sink.substring(sink.lastIndexOf('/') + 1);
+            osn.NodeObs.OBS_service_addStreamingDestination(names[index], 'rtmp_custom',
+                JSON.stringify({ server: server, key: key }));
+        });
+
+        // Signals of all destinations arrive interleaved on the same queue
+        const waitForAll = async (signal: EOBSOutputSignal) => {
+            const pending = new Set(names);
+            while (pending.size > 0) {
+                const signalInfo = await obs.getNextSignalInfo(EOBSOutputType.StreamingDestination, signal);
+                expect(signalInfo.type).to.equal(EOBSOutputType.StreamingDestination,
+                    GetErrorMessage(ETestErrorMsg.StreamingDestination, signalInfo.destination));
+
+                if (signalInfo.signal == EOBSOutputSignal.Stop && signal == EOBSOutputSignal.Start) {
+                    throw Error(GetErrorMessage(ETestErrorMsg.StreamingDestinationDidNotStart,
+                        signalInfo.destination, signalInfo.code.toString(), signalInfo.error));
+                }
+
+                if (signalInfo.signal == signal) {
+                    pending.delete(signalInfo.destination);
+                }
+            }
+        };
+
+        names.forEach(name => osn.NodeObs.OBS_service_startStreamingDestination(name));
+        await waitForAll(EOBSOutputSignal.Start);
+
+        await sleep(2000);
+
+        const stats: any[] = osn.NodeObs.OBS_service_getStreamingDestinations();
+        expect(stats.length).to.equal(names.length, GetErrorMessage(ETestErrorMsg.StreamingDestination, 'stats'));
+        stats.forEach(destination => {
+            expect(destination.active).to.equal(true, GetErrorMessage(ETestErrorMsg.StreamingDestination, destination.name));
+            expect(destination.bytesSent).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.StreamingDestination, destination.name));
+        });
+
+        names.forEach(name => osn.NodeObs.OBS_service_stopStreamingDestination(name, false));
+        await waitForAll(EOBSOutputSignal.Deactivate);
+
+        names.forEach(name => osn.NodeObs.OBS_service_removeStreamingDestination(name));
+        expect(osn.NodeObs.OBS_service_getStreamingDestinations().length).to.equal(0,
+            GetErrorMessage(ETestErrorMsg.StreamingDestination, 'remove'));
+    });
+
+    it('Simple mode - Lower streaming bitrate on a congested link', async function() {
+        // RTMP sink that can't keep up with the configured bitrate, e.g. rtmp://127.0.0.1:1935/live/throttled
+        const sink: string = process.env.OSN_TEST_RTMP_THROTTLED_SINK || '';
+        if (sink.length == 0) {
+            this.skip();
+        }
+
+        this.timeout(90000);
+
+        obs.setSetting(EOBSSettingsCategories.Output, 'Mode', 'Simple');
+        obs.setSetting(EOBSSettingsCategories.Output, 'StreamEncoder', obs.os === 'win32' ? 'x264' : 'obs_x264');
+        obs.setSetting(EOBSSettingsCategories.Output, 'VBitrate', 6000);
+        obs.setSetting(EOBSSettingsCategories.Advanced, 'DynamicBitrate', false);
+        obs.setSetting(EOBSSettingsCategories.Advanced, 'AdaptiveBitrate', true);
+        obs.setSetting(EOBSSettingsCategories.Advanced, 'AdaptiveBitrateMin', 500);
+
+        const previousService = osn.ServiceFactory.serviceContext;
+        osn.ServiceFactory.serviceContext = osn.ServiceFactory.create('rtmp_custom', 'throttled_sink', {
+            server: sink.substring(0, sink.lastIndexOf('/')),
+            key: sink.substring(sink.lastIndexOf('/') + 1)
+        });
+
+        let signalInfo: IOBSOutputSignalInfo;
+
+        osn.NodeObs.OBS_service_startStreaming();
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Starting);
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Activate);
+
+        if (signalInfo.signal == EOBSOutputSignal.Stop) {
+            throw Error(GetErrorMessage(ETestErrorMsg.StreamOutputDidNotStart, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Start);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Start, GetErrorMessage(ETestErrorMsg.StreamOutput));
+
+        // The stream keeps running while the encoder is reconfigured
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Bitrate);
+        expect(signalInfo.signal).to.equal(EOBSOutputSignal.Bitrate,
+            GetErrorMessage(ETestErrorMsg.AdaptiveBitrate, signalInfo.code.toString(), signalInfo.error));
+        expect(signalInfo.code).to.be.lessThan(6000,
+            GetErrorMessage(ETestErrorMsg.AdaptiveBitrate, signalInfo.code.toString(), signalInfo.error));
+        expect(signalInfo.code).to.be.at.least(500,
+            GetErrorMessage(ETestErrorMsg.AdaptiveBitrate, signalInfo.code.toString(), signalInfo.error));
+        expect(['congestion', 'dropped_frames']).to.include(signalInfo.error,
+            GetErrorMessage(ETestErrorMsg.AdaptiveBitrate, signalInfo.code.toString(), signalInfo.error));
+
+        osn.NodeObs.OBS_service_stopStreaming(true);
+
+        // Further steps may still be queued before the stop signals
+        do {
+            signalInfo = await obs.getNextSignalInfo(EOBSOutputType.Streaming, EOBSOutputSignal.Deactivate);
+        } while (signalInfo.signal != EOBSOutputSignal.Deactivate);
+
+        osn.ServiceFactory.serviceContext = previousService;
+        obs.setSetting(EOBSSettingsCategories.Advanced, 'AdaptiveBitrate', false);
+    });
+
     it('Fail test - Stream with invalid stream key', async function() {
         let signalInfo: IOBSOutputSignalInfo;
 
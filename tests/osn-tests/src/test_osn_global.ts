@@ -76,6 +76,36 @@ describe(testName, () => {
         });
     });
 
+    it('Get the type catalog', () => {
+        const catalog = osn.Global.getTypeCatalog();
+        expect(catalog.unchanged).to.equal(false);
+
+        const types = new Map(catalog.types.map(entry => [entry.id, entry] as [string, osn.ITypeCatalogEntry]));
+        const check = (ids: string[], type: osn.ESourceType) => {
+            ids.forEach(id => {
+                const entry = types.get(id);
+                expect(entry).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.TypeCatalog, id));
+                expect(entry.type).to.equal(type, GetErrorMessage(ETestErrorMsg.TypeCatalog, id));
+                expect(entry.outputFlags).to.equal(osn.Global.getOutputFlagsFromId(id), GetErrorMessage(ETestErrorMsg.TypeCatalogFlags, id));
+                expect(entry.defaults).to.be.an('object');
+            });
+        };
+        check(obs.inputTypes, osn.ESourceType.Input);
+        check(obs.filterTypes, osn.ESourceType.Filter);
+        check(obs.transitionTypes, osn.ESourceType.Transition);
+
+        // Defaults hold the values a new source starts with
+        const colorSource = types.get(EOBSInputTypes.ColorSource);
+        expect(colorSource.defaults.width).to.equal(400, GetErrorMessage(ETestErrorMsg.TypeCatalog, EOBSInputTypes.ColorSource));
+        expect(colorSource.defaults.height).to.equal(400, GetErrorMessage(ETestErrorMsg.TypeCatalog, EOBSInputTypes.ColorSource));
+
+        // A catalog kept from an earlier session is still current
+        const again = osn.Global.getTypeCatalog(catalog.fingerprint);
+        expect(again.fingerprint).to.equal(catalog.fingerprint, GetErrorMessage(ETestErrorMsg.TypeCatalogFingerprint));
+        expect(again.unchanged).to.equal(true, GetErrorMessage(ETestErrorMsg.TypeCatalogFingerprint));
+        expect(again.types.length).to.equal(0);
+    });
+
     it('Get lagged frames value', () => {
         let laggedFrames: number = undefined;
 
@@ -620,6 +620,133 @@ describe(testName, () => {
         input.release();
     });
 
+    it('Set the whole filter chain in one call', () => {
+        const input = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'test_source');
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ImageSource));
+
+        const filter1 = osn.FilterFactory.create(EOBSFilterTypes.Color, 'filter1');
+        const filter2 = osn.FilterFactory.create(EOBSFilterTypes.Crop, 'filter2');
+        const filter3 = osn.FilterFactory.create(EOBSFilterTypes.GPUDelay, 'filter3');
+        input.addFilter(filter1);
+        input.addFilter(filter2);
+
+        // Adding, moving and disabling at once
+        input.setFilterChain([
+            { filter: filter3 },
+            { filter: filter1, enabled: false },
+            { filter: filter2, settings: { left: 10 } }
+        ]);
+
+        let names = input.filters.map(filter => filter.name);
+        expect(names).to.eql(['filter3', 'filter1', 'filter2'], GetErrorMessage(ETestErrorMsg.SetFilterChain, 'test_source', 'reordering'));
+        expect(filter1.enabled).to.equal(false, GetErrorMessage(ETestErrorMsg.SetFilterChain, 'test_source', 'disabling'));
+        expect(filter3.enabled).to.equal(true, GetErrorMessage(ETestErrorMsg.SetFilterChain, 'test_source', 'adding'));
+        expect(filter2.settings['left']).to.equal(10, GetErrorMessage(ETestErrorMsg.FilterSetting, EOBSFilterTypes.Crop));
+
+        // Filters left out are removed
+        input.setFilterChain([{ filter: filter2 }, { filter: filter3 }]);
+
+        names = input.filters.map(filter => filter.name);
+        expect(names).to.eql(['filter2', 'filter3'], GetErrorMessage(ETestErrorMsg.SetFilterChain, 'test_source', 'removing'));
+
+        // A filter used by another input makes the whole chain fail
+        const other = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'other_source');
+        other.addFilter(filter1);
+        expect(() => input.setFilterChain([{ filter: filter1 }])).to.throw();
+
+        names = input.filters.map(filter => filter.name);
+        expect(names).to.eql(['filter2', 'filter3'], GetErrorMessage(ETestErrorMsg.SetFilterChain, 'test_source', 'a failed call'));
+
+        other.setFilterChain([]);
+        expect(other.filters.length).to.equal(0, GetErrorMessage(ETestErrorMsg.RemoveFilter));
+        input.setFilterChain([]);
+        expect(input.filters.length).to.equal(0, GetErrorMessage(ETestErrorMsg.RemoveFilter));
+
+        filter1.release();
+        filter2.release();
+        filter3.release();
+        other.release();
+        input.release();
+    });
+
+    it('Get the media state of several inputs in one call', () => {
+        const media1 = osn.InputFactory.create(EOBSInputTypes.FFMPEGSource, 'media1');
+        const media2 = osn.InputFactory.create(EOBSInputTypes.FFMPEGSource, 'media2');
+        expect(media1).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.FFMPEGSource));
+        expect(media2).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.FFMPEGSource));
+
+        const states = osn.InputFactory.getMediaStates([media1, media2]);
+        expect(states.length).to.equal(2, GetErrorMessage(ETestErrorMsg.GetMediaStates, 'media1'));
+        expect(states[0].state).to.equal(media1.getMediaState(), GetErrorMessage(ETestErrorMsg.GetMediaStates, 'media1'));
+        expect(states[0].duration).to.equal(media1.getDuration(), GetErrorMessage(ETestErrorMsg.GetMediaStates, 'media1'));
+        expect(states[1].state).to.equal(media2.getMediaState(), GetErrorMessage(ETestErrorMsg.GetMediaStates, 'media2'));
+        expect(states[1].time).to.equal(media2.seek, GetErrorMessage(ETestErrorMsg.GetMediaStates, 'media2'));
+
+        expect(osn.InputFactory.getMediaStates([]).length).to.equal(0, GetErrorMessage(ETestErrorMsg.GetMediaStates, 'an empty list'));
+
+        expect(media1.watchMediaState(() => {}, 250)).to.equal(true, GetErrorMessage(ETestErrorMsg.WatchMediaState, 'watch', 'media1'));
+        expect(media1.unwatchMediaState()).to.equal(true, GetErrorMessage(ETestErrorMsg.WatchMediaState, 'unwatch', 'media1'));
+
+        media1.release();
+        media2.release();
+    });
+
+    it('Create sources with their audio state and filters in one call', () => {
+        let audioType: string;
+
+        if (obs.os == 'win32') {
+            audioType = EOBSInputTypes.WASAPIInput;
+        } else if (obs.os == 'darwin') {
+            audioType = EOBSInputTypes.CoreAudioInput;
+        }
+
+        const inputs = osn.createSources([
+            {
+                type: audioType, name: 'batch_audio', settings: {}, filters: [],
+                muted: true, volume: 0.5, syncOffset: getTimeSpec(5000)
+            },
+            {
+                type: EOBSInputTypes.ImageSource, name: 'batch_image', settings: {}, muted: null, volume: null, syncOffset: null,
+                filters: [
+                    { type: EOBSFilterTypes.Color, name: 'batch_filter1', settings: {}, enabled: true },
+                    { type: EOBSFilterTypes.Crop, name: 'batch_filter2', settings: {}, enabled: false }
+                ]
+            },
+            {
+                type: 'does_not_exist', name: 'batch_invalid', settings: {}, filters: [],
+                muted: null, volume: null, syncOffset: null
+            }
+        ]);
+
+        // Results keep the order of the request
+        expect(inputs.length).to.equal(3, GetErrorMessage(ETestErrorMsg.CreateSources, 'batch', 'count'));
+        const audio = inputs[0];
+        const image = inputs[1];
+        expect(inputs[2]).to.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateSources, 'batch_invalid', 'value'));
+
+        expect(audio).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, audioType));
+        expect(audio.id).to.equal(audioType, GetErrorMessage(ETestErrorMsg.InputId, audioType));
+        expect(audio.name).to.equal('batch_audio', GetErrorMessage(ETestErrorMsg.InputName, audioType));
+        expect(audio.muted).to.equal(true, GetErrorMessage(ETestErrorMsg.CreateSources, 'batch_audio', 'muted state'));
+        expect(audio.volume).to.be.closeTo(0.5, 0.001, GetErrorMessage(ETestErrorMsg.CreateSources, 'batch_audio', 'volume'));
+        expect(audio.syncOffset).to.eql(getTimeSpec(5000), GetErrorMessage(ETestErrorMsg.CreateSources, 'batch_audio', 'sync offset'));
+
+        expect(image).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ImageSource));
+        expect(image.name).to.equal('batch_image', GetErrorMessage(ETestErrorMsg.InputName, EOBSInputTypes.ImageSource));
+        expect(image.filters.length).to.equal(2, GetErrorMessage(ETestErrorMsg.CreateSources, 'batch_image', 'filters'));
+        expect(image.filters[0].name).to.equal('batch_filter1', GetErrorMessage(ETestErrorMsg.CreateSources, 'batch_image', 'filters'));
+        expect(image.filters[0].enabled).to.equal(true, GetErrorMessage(ETestErrorMsg.CreateSources, 'batch_image', 'filters'));
+        expect(image.filters[1].name).to.equal('batch_filter2', GetErrorMessage(ETestErrorMsg.CreateSources, 'batch_image', 'filters'));
+        expect(image.filters[1].enabled).to.equal(false, GetErrorMessage(ETestErrorMsg.CreateSources, 'batch_image', 'filters'));
+
+        image.filters.forEach(function(filter) {
+            image.removeFilter(filter);
+            filter.release();
+        });
+        audio.release();
+        image.release();
+    });
+
     it('Fail test - Try to find an input that does not exist', () => {
         let inputFromName: IInput;
 
@@ -3,7 +3,7 @@ import { expect } from 'chai'
 import * as osn from '../osn';
 import { logInfo, logEmptyLine } from '../util/logger';
 import { OBSHandler } from '../util/obs_handler';
-import { deleteConfigFiles } from '../util/general';
+import { deleteConfigFiles, sleep } from '../util/general';
 import { EOBSInputTypes } from '../util/obs_enums';
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
 
@@ -285,6 +285,148 @@ describe(testName, () => {
         scene.release();
     });
 
+    it('Pick and snap scene items', async () => {
+        const sceneName = 'hitTest_test';
+        const settings = { width: 400, height: 300, color: 0xFFFFFFFF };
+
+        // Creating scene
+        const scene = osn.SceneFactory.create(sceneName);
+        expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateScene, sceneName));
+
+        // Two overlapping items, the second one on top
+        const bottomInput = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'hitTest_bottom', settings);
+        const topInput = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'hitTest_top', settings);
+        const bottomItem = scene.add(bottomInput);
+        const topItem = scene.add(topInput);
+        expect(bottomItem).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.AddSourceToScene, bottomInput.id, sceneName));
+        expect(topItem).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.AddSourceToScene, topInput.id, sceneName));
+        topItem.position = { x: 200, y: 100 };
+
+        // Box transforms are updated by the next video tick
+        await sleep(200);
+
+        expect(scene.hitTest(100, 50).source.name).to.equal('hitTest_bottom', GetErrorMessage(ETestErrorMsg.SceneHitTest, '100, 50'));
+        expect(scene.hitTest(300, 200).source.name).to.equal('hitTest_top', GetErrorMessage(ETestErrorMsg.SceneHitTest, '300, 200'));
+        expect(scene.hitTest(1000, 1000)).to.equal(undefined, GetErrorMessage(ETestErrorMsg.SceneHitTest, '1000, 1000'));
+
+        // Topmost first
+        const items = scene.queryRect(0, 0, 250, 150);
+        expect(items.length).to.equal(2, GetErrorMessage(ETestErrorMsg.SceneQueryRect, sceneName));
+        expect(items[0].source.name).to.equal('hitTest_top', GetErrorMessage(ETestErrorMsg.SceneQueryRect, sceneName));
+        expect(items[1].source.name).to.equal('hitTest_bottom', GetErrorMessage(ETestErrorMsg.SceneQueryRect, sceneName));
+        expect(scene.queryRect(1000, 1000, 10, 10).length).to.equal(0, GetErrorMessage(ETestErrorMsg.SceneQueryRect, sceneName));
+
+        const candidates = scene.snapCandidates(bottomItem, 10);
+        expect(candidates.length).to.equal(1, GetErrorMessage(ETestErrorMsg.SceneSnapCandidates, 'hitTest_bottom'));
+        expect(candidates[0].item.source.name).to.equal('hitTest_top', GetErrorMessage(ETestErrorMsg.SceneSnapCandidates, 'hitTest_bottom'));
+        expect(candidates[0].left).to.equal(200, GetErrorMessage(ETestErrorMsg.SceneSnapCandidates, 'hitTest_bottom'));
+        expect(candidates[0].bottom).to.equal(400, GetErrorMessage(ETestErrorMsg.SceneSnapCandidates, 'hitTest_bottom'));
+
+        // Moving an item updates the index
+        topItem.position = { x: 1000, y: 700 };
+        await sleep(200);
+
+        expect(scene.hitTest(300, 200).source.name).to.equal('hitTest_bottom', GetErrorMessage(ETestErrorMsg.SceneHitTest, '300, 200'));
+        expect(scene.hitTest(1100, 800).source.name).to.equal('hitTest_top', GetErrorMessage(ETestErrorMsg.SceneHitTest, '1100, 800'));
+        expect(scene.snapCandidates(bottomItem, 10).length).to.equal(0, GetErrorMessage(ETestErrorMsg.SceneSnapCandidates, 'hitTest_bottom'));
+
+        // Hidden items can't be picked
+        topItem.visible = false;
+        expect(scene.hitTest(1100, 800)).to.equal(undefined, GetErrorMessage(ETestErrorMsg.SceneHitTest, '1100, 800'));
+
+        bottomItem.source.release();
+        bottomItem.remove();
+        topItem.source.release();
+        topItem.remove();
+        scene.release();
+    });
+
+    it('Receive batched item changes of a connected scene', async () => {
+        const sceneName = 'events_test';
+        const settings = { width: 400, height: 300, color: 0xFFFFFFFF };
+
+        const scene = osn.SceneFactory.create(sceneName);
+        expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateScene, sceneName));
+
+        const batches: osn.ISceneEvents[] = [];
+        osn.NodeObs.RegisterSourceCallback(() => {});
+        expect(scene.connect((events: osn.ISceneEvents) => batches.push(events))).to.equal(true, GetErrorMessage(ETestErrorMsg.SceneEvents, sceneName, 'connection'));
+
+        const input1 = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'events_input1', settings);
+        const input2 = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'events_input2', settings);
+        const item1 = scene.add(input1);
+        const item2 = scene.add(input2);
+        await sleep(300);
+
+        let added = [].concat(...batches.map(events => events.added));
+        expect(added).to.include.members([item1.id, item2.id], GetErrorMessage(ETestErrorMsg.SceneEvents, sceneName, 'added items'));
+
+        // Several moves of the same item come as one change
+        batches.length = 0;
+        for (let x = 0; x < 10; x++) {
+            item1.position = { x: x * 10, y: 0 };
+        }
+        item2.visible = false;
+        await sleep(300);
+
+        const transformed = [].concat(...batches.map(events => events.transformed));
+        const visible = [].concat(...batches.map(events => events.visible));
+        expect(transformed.filter(id => id === item1.id).length).to.be.within(1, batches.length, GetErrorMessage(ETestErrorMsg.SceneEvents, sceneName, 'transformed items'));
+        expect(visible).to.deep.include({ id: item2.id, visible: false }, GetErrorMessage(ETestErrorMsg.SceneEvents, sceneName, 'hidden items'));
+
+        batches.length = 0;
+        const item2Id = item2.id;
+        item2.remove();
+        await sleep(300);
+
+        const removed = [].concat(...batches.map(events => events.removed));
+        expect(removed).to.include(item2Id, GetErrorMessage(ETestErrorMsg.SceneEvents, sceneName, 'removed items'));
+        expect(scene.getItems().length).to.equal(1, GetErrorMessage(ETestErrorMsg.SceneEvents, sceneName, 'removed items'));
+
+        // Nothing once disconnected
+        expect(scene.disconnect()).to.equal(true, GetErrorMessage(ETestErrorMsg.SceneEvents, sceneName, 'disconnection'));
+        batches.length = 0;
+        item1.visible = false;
+        await sleep(300);
+        expect(batches.length).to.equal(0, GetErrorMessage(ETestErrorMsg.SceneEvents, sceneName, 'nothing after disconnecting'));
+
+        osn.NodeObs.RemoveSourceCallback();
+        input1.release();
+        input2.release();
+        item1.remove();
+        scene.release();
+    });
+
+    it('Release a connected scene', async () => {
+        const sceneName = 'events_release_test';
+        const settings = { width: 400, height: 300, color: 0xFFFFFFFF };
+
+        const scene = osn.SceneFactory.create(sceneName);
+        expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateScene, sceneName));
+
+        const batches: osn.ISceneEvents[] = [];
+        osn.NodeObs.RegisterSourceCallback(() => {});
+        expect(scene.connect((events: osn.ISceneEvents) => batches.push(events))).to.equal(true, GetErrorMessage(ETestErrorMsg.SceneEvents, sceneName, 'connection'));
+
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'events_release_input', settings);
+        const item = scene.add(input);
+        await sleep(300);
+        expect(batches.length).to.be.greaterThan(0, GetErrorMessage(ETestErrorMsg.SceneEvents, sceneName, 'added items'));
+
+        // Released without disconnecting, the callback goes away with the scene
+        item.remove();
+        input.release();
+        expect(function() {
+            scene.release();
+        }).to.not.throw();
+
+        batches.length = 0;
+        await sleep(300);
+        expect(batches.length).to.equal(0, GetErrorMessage(ETestErrorMsg.SceneEvents, sceneName, 'nothing after releasing'));
+
+        osn.NodeObs.RemoveSourceCallback();
+    });
+
     it('Fail test - Get scene from name that don\'t exist ', () => {
         expect(function() {
             const failSceneFromName = osn.SceneFactory.fromName('does_not_exist');
@@ -133,6 +133,38 @@ describe(testName, () => {
         scene.release();         
     });
 
+    it('Prepare a scene and start transition to it', async () => {
+        const sceneName: string = 'test_osn_scene_prepared';
+        const transition = osn.TransitionFactory.create(EOBSTransitionTypes.Fade, 'transition');
+        const scene = osn.SceneFactory.create(sceneName);
+
+        expect(transition.prepareState).to.equal(osn.ETransitionPrepareState.None, GetErrorMessage(ETestErrorMsg.PrepareState, sceneName));
+
+        // The readiness is pushed with the global callbacks, an empty scene has nothing to wait for
+        const states: osn.ETransitionPrepareState[] = [];
+        osn.NodeObs.RegisterSourceCallback(() => {});
+        expect(transition.watchPrepareState(state => states.push(state))).to.equal(true, GetErrorMessage(ETestErrorMsg.PrepareState, sceneName));
+        transition.prepare(scene, 1000);
+
+        for (let n = 0; n < 100 && states.length == 0; n++) {
+            await new Promise(resolve => setTimeout(resolve, 10));
+        }
+        expect(states).to.deep.equal([osn.ETransitionPrepareState.Ready], GetErrorMessage(ETestErrorMsg.PrepareState, sceneName));
+        expect(transition.prepareState).to.equal(osn.ETransitionPrepareState.Ready, GetErrorMessage(ETestErrorMsg.PrepareState, sceneName));
+
+        transition.start(300, scene);
+        expect(transition.prepareState).to.equal(osn.ETransitionPrepareState.None, GetErrorMessage(ETestErrorMsg.PrepareState, sceneName));
+
+        const source = transition.getActiveSource();
+        expect(source).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetActiveSource, EOBSTransitionTypes.Fade));
+        expect(source.name).to.equal(sceneName, GetErrorMessage(ETestErrorMsg.SceneName, sceneName));
+
+        expect(transition.unwatchPrepareState()).to.equal(true, GetErrorMessage(ETestErrorMsg.PrepareState, sceneName));
+        osn.NodeObs.RemoveSourceCallback();
+        transition.release();
+        scene.release();
+    });
+
     it('Fail test - Try to get source from transition without setting in to transition', () => {
         let source: ISource;
         let transition: ITransition;
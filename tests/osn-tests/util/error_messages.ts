@@ -1,6 +1,9 @@
 export const enum ETestErrorMsg {
     // nodeobs_api
     GetPerformanceStatistics = 'Get performance statistics',
+    GetCallStats = 'Call statistics for %VALUE1% are wrong',
+    GetPerformanceSnapshot = 'Performance snapshot %VALUE1% is wrong',
+    GetMediaCacheStats = 'Media cache statistic %VALUE1% is wrong',
     ShowHideInputHotkeys = 'Show hide hotkey container is wrong',
     SlideShowHotkeys = 'Slideshow hotkey container is wrong',
     FFMPEGSourceHotkeys = 'FFMPEG source hotkey container is wrong',
@@ -11,6 +14,7 @@ export const enum ETestErrorMsg {
     AudioLineHotkeys = 'Audio Line hotkey container is wrong',
     CoreAudioInputHotkeys = 'Core Audio Input hotkey container is wrong',
     CoreAudioOutputHotkeys = 'Core Audio Output hotkey container is wrong',
+    QueryHotkeysSince = 'Hotkey changes since version %VALUE1% are wrong',
 
     // nodeobs_autoconfig
     BandwidthTest = 'Bandwidth test',
@@ -31,6 +35,8 @@ export const enum ETestErrorMsg {
     // nodeobs_service
     StreamOutput = 'Stream output',
     RecordingOutput = 'Recording output',
+    RecordingSegment = 'Recording segment',
+    AdaptiveBitrate = 'Adaptive bitrate | Bitrate: %VALUE1% / Reason: %VALUE2%',
     ReplayBuffer = 'Replay buffer',
     StreamOutputDidNotStart = 'Stream output failed to start | Error code: %VALUE1% / Error message: %VALUE2%',
     StreamOutputStoppedWithError = 'Stream ouput stopped with error | Error code: %VALUE1% / Error message: %VALUE2%',
@@ -38,6 +44,9 @@ export const enum ETestErrorMsg {
     RecordOutputStoppedWithError = 'Record ouput stopped with error | Error code: %VALUE1% / Error message: %VALUE2%',
     ReplayBufferDidNotStart = 'Replay buffer failed to start | Error code: %VALUE1% / Error message: %VALUE2%',
     ReplayBufferStoppedWithError = 'Replay buffer stopped with error | Error code: %VALUE1% / Error message: %VALUE2%',
+    StreamDelay = 'Stream delay countdown is wrong',
+    StreamingDestination = 'Streaming destination %VALUE1%',
+    StreamingDestinationDidNotStart = 'Streaming destination %VALUE1% failed to start | Error code: %VALUE2% / Error message: %VALUE3%',
     // nodeobs_settings
     GeneralSettings = 'One or more general settings failed to be updated',
     SingleGeneralSetting = 'Failed to update general setting %VALUE1%',
@@ -72,12 +81,16 @@ export const enum ETestErrorMsg {
     LaggedFrames = 'Failed to get lagged frames value',
     TotalFrames = 'Failed to get total frames value',
     Locale = 'Failed to update locale',
+    TypeCatalog = 'Type catalog is missing type %VALUE1%',
+    TypeCatalogFlags = 'Type catalog has wrong output flags for %VALUE1%',
+    TypeCatalogFingerprint = 'Type catalog fingerprint changed without the types changing',
     // osn-input
     CreateInput = 'Failed to create input %VALUE1%',
     InputId = 'Input %VALUE1% id value is wrong',
     InputName = 'Input %VALUE1% name value is wrong',
     InputSetting = 'Failed to update one or more settings of input %VALUE1%',
     InputFromName = 'Failed to get input from name %VALUE1%',
+    CreateSources = 'Input %VALUE1% created by createSources has the wrong %VALUE2%',
     FromNameInputName = 'Input returned from name %VALUE% has wrong name',
     FromNameInputId = 'Input returned from name %VALUE1% has wrong id',
     Volume = 'Failed to update volume of input %VALUE1%',
@@ -90,6 +103,9 @@ export const enum ETestErrorMsg {
     MoveFilterUp = 'Failed to move filter %VALUE1% up',
     MoveFilterBottom = 'Failed to move filter %VALUE1% to bottom',
     MoveFilterTop = 'Failed to move filter %VALUE1% to top',
+    SetFilterChain = 'Filter chain of input %VALUE1% is wrong after %VALUE2%',
+    GetMediaStates = 'Media state of input %VALUE1% is wrong',
+    WatchMediaState = 'Failed to %VALUE1% media state of input %VALUE2%',
     // osn-module
     OpenModule = 'Failed to open module %VALUE1%',
     Modules = 'Failed to get all opened modules',
@@ -113,6 +129,10 @@ export const enum ETestErrorMsg {
     GetSceneItems = 'Scene %VALUE1% does not have the right number of scene items',
     SceneItemPosition = 'Wrong position for scene item with input %VALUE1%',
     SceneItemPositionAfterMove = 'After moving, wrong position of scene item with input %VALUE1%',
+    SceneHitTest = 'Hit test at %VALUE1% returned the wrong scene item',
+    SceneQueryRect = 'Rect query on scene %VALUE1% returned the wrong scene items',
+    SceneSnapCandidates = 'Wrong snap candidates for scene item with input %VALUE1%',
+    SceneEvents = 'Scene %VALUE1% did not report %VALUE2%',
     // osn-sceneitem'
     GetSourceFromSceneItem = 'Failed to get source from scene item with id %VALUE1%',
     SourceFromSceneItemId = 'Source returned from scene item with id %VALUE1% has wrong id',
@@ -154,6 +174,7 @@ export const enum ETestErrorMsg {
     TransitionName = 'Transition %VALUE1% name value is wrong',
     TransitionSetting = 'Transition %VALUE1% setting is wrong',
     GetActiveSource = 'Failed to get active source from transition %VALUE1%',
+    PrepareState = 'Wrong preparation state of transition to %VALUE1%',
     // osn-video
     VideoSkippedFrames = 'Failed to get video skipped frames',
     VideoSkippedFramesWrongValue = 'Returned video skipped frames value is wrong',
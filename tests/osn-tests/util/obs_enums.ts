@@ -3,6 +3,7 @@ export const enum EOBSOutputType {
     Streaming = 'streaming',
     Recording = 'recording',
     ReplayBuffer = 'replay-buffer',
+    StreamingDestination = 'streaming-destination',
 }
   
 export const enum EOBSOutputSignal {
@@ -14,9 +15,11 @@ export const enum EOBSOutputSignal {
     Deactivate = 'deactivate',
     Reconnect = 'reconnect',
     ReconnectSuccess = 'reconnect_success',
+    Delay = 'delay',
     Writing = 'writing',
     Wrote = 'wrote',
     WriteError = 'writing_error',
+    Bitrate = 'bitrate',
 }
 
 export const enum EOBSInputTypes {
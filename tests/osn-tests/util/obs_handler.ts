@@ -25,6 +25,8 @@ export interface IOBSOutputSignalInfo {
     signal: EOBSOutputSignal;
     code: osn.EOutputCode;
     error: string;
+    destination?: string;
+    path?: string;
 }
 
 export interface IConfigProgress {
@@ -55,6 +57,15 @@ export type TOBSHotkey = {
     HotkeyId: number;
 };
 
+// Changes reported by OBS_API_QueryHotkeysSince. Only hotkeys that were registered, unregistered
+// or renamed are reported, description changes without a signal need OBS_API_QueryHotkeys.
+export type TOBSHotkeyDelta = {
+    Version: number;
+    Full: boolean;
+    Changed: TOBSHotkey[];
+    Removed: number[];
+};
+
 export type TConfigEvent = 'starting_step' | 'progress' | 'stopping_step' | 'error' | 'done';
 
 // OBSHandler class
@@ -0,0 +1,87 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+// Cold and warm bitrate lookups, the way GetAACEncoderForBitrate and
+// FindClosestAvailableAACBitrate query the table, against stub encoders
+// whose properties cost as much to read as a real encoder's. Writes a JSON
+// report, to the path given as first argument or to
+// bench_audio_bitrate_table.json.
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include "audio-bitrate-table.h"
+
+// Time obs_get_encoder_properties takes for one encoder, override with OSN_BENCH_ENCODER_COST_MS
+static int EnumerationCostMs()
+{
+	const char* value = getenv("OSN_BENCH_ENCODER_COST_MS");
+	return value ? atoi(value) : 5;
+}
+
+static const int Lookups = 10000;
+
+int main(int argc, char** argv)
+{
+	int costMs       = EnumerationCostMs();
+	int enumerations = 0;
+
+	auto stubEncoder = [&](const std::string&, const std::string&, uint32_t, AudioBitrateTable::Bitrates& bitrates) {
+		enumerations++;
+		std::this_thread::sleep_for(std::chrono::milliseconds(costMs));
+		for (int bitrate = 32; bitrate <= 320; bitrate += 32)
+			bitrates.push_back(bitrate);
+		return true;
+	};
+
+	AudioBitrateTable table(stubEncoder);
+	table.SetEncoders({"ffmpeg_aac", "mf_aac", "libfdk_aac", "CoreAudio_AAC"}, "bench");
+
+	auto lookup = [&](int bitrate) {
+		auto& map  = table.GetBitrateMap("Stereo", 48000);
+		auto  next = map.lower_bound(bitrate);
+		return next != map.end() ? next->first : 0;
+	};
+
+	auto start  = std::chrono::steady_clock::now();
+	int  result = lookup(160);
+	auto coldMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	start = std::chrono::steady_clock::now();
+	for (int n = 0; n < Lookups; n++)
+		result += lookup(n % 400);
+	auto warmNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / Lookups;
+
+	std::string   path = argc > 1 ? argv[1] : "bench_audio_bitrate_table.json";
+	std::ofstream report(path);
+	report << "{\n"
+	       << "    \"layer\": \"audio-bitrate-table\",\n"
+	       << "    \"encoders\": 4,\n"
+	       << "    \"enumeration_cost_ms\": " << costMs << ",\n"
+	       << "    \"cold\": { \"ms\": " << coldMs << ", \"enumerations\": " << enumerations << " },\n"
+	       << "    \"warm\": { \"lookups\": " << Lookups << ", \"ns_per_lookup\": " << warmNs << " }\n"
+	       << "}\n";
+
+	std::cout << "cold: " << coldMs << "ms, " << enumerations << " enumerations" << std::endl;
+	std::cout << "warm: " << warmNs << "ns per lookup over " << Lookups << " lookups (" << result << ")" << std::endl;
+	std::cout << "Results written to " << path << std::endl;
+
+	return enumerations == 4 ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+// Filter chain changes applied the way the client did before Input.SetFilterChain
+// and with a FilterChainPlan, counting the IPC calls, the chain rebuilds
+// (relink plus reorder signal in libobs) and the chains a frame may be rendered
+// with each of them costs. Writes a JSON report, to the path given as first
+// argument or to bench_filter_chain.json.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include "filter-chain-plan.h"
+
+static const size_t Filters = 8;
+static const int    Rounds  = 1000;
+
+struct Cost
+{
+	uint64_t calls    = 0;
+	uint64_t rebuilds = 0;
+	// Chains the render thread can pick up, SetFilterChain holds the graphics lock for all its steps
+	uint64_t rendered = 0;
+};
+
+// Source standing in for obs_source_t, in GetFilters order
+struct StubSource
+{
+	std::vector<uint64_t> filters;
+	Cost                  cost;
+
+	void Step(FilterChainPlan::Action action, uint64_t filter)
+	{
+		FilterChainPlan::Apply({action, filter}, filters);
+		cost.rebuilds++;
+		cost.rendered++;
+	}
+
+	// MoveFilter with OBS_ORDER_MOVE_UP, one place towards the front
+	void MoveUp(uint64_t filter)
+	{
+		auto found = std::find(filters.begin(), filters.end(), filter);
+		if (found != filters.begin())
+			std::iter_swap(found, found - 1);
+		cost.rebuilds++;
+		cost.rendered++;
+	}
+};
+
+// RemoveFilter and AddFilter for the filters that come and go
+static StubSource Exchange(const std::vector<uint64_t>& current, const std::vector<uint64_t>& desired)
+{
+	StubSource source{current, {}};
+	for (uint64_t filter : current) {
+		if (std::find(desired.begin(), desired.end(), filter) == desired.end()) {
+			source.Step(FilterChainPlan::Action::Remove, filter);
+			source.cost.calls++;
+		}
+	}
+	for (uint64_t filter : desired) {
+		if (std::find(current.begin(), current.end(), filter) == current.end()) {
+			source.Step(FilterChainPlan::Action::Add, filter);
+			source.cost.calls++;
+		}
+	}
+	return source;
+}
+
+// One MoveFilter call per place a filter moves, what dragging in the UI does
+static Cost StepByStep(const std::vector<uint64_t>& current, const std::vector<uint64_t>& desired)
+{
+	StubSource source = Exchange(current, desired);
+	for (size_t idx = 0; idx < desired.size(); idx++) {
+		auto place = std::find(source.filters.begin(), source.filters.end(), desired[idx]) - source.filters.begin();
+		for (; size_t(place) > idx; place--) {
+			source.MoveUp(desired[idx]);
+			source.cost.calls++;
+		}
+	}
+	source.cost.calls++; // GetFilters
+	return source.cost;
+}
+
+// Every filter sent to the back in order, what applying a preset does
+static Cost EachToBack(const std::vector<uint64_t>& current, const std::vector<uint64_t>& desired)
+{
+	StubSource source = Exchange(current, desired);
+	for (uint64_t filter : desired) {
+		source.Step(FilterChainPlan::Action::MoveToBack, filter);
+		source.cost.calls++;
+	}
+	source.cost.calls++; // GetFilters
+	return source.cost;
+}
+
+// Input.SetFilterChain, the reply carries the resulting chain
+static Cost Planned(const std::vector<uint64_t>& current, const std::vector<uint64_t>& desired)
+{
+	StubSource                         source{current, {}};
+	std::vector<FilterChainPlan::Step> steps;
+	FilterChainPlan::Make(current, desired, steps);
+	for (auto& step : steps)
+		source.Step(step.action, step.filter);
+	source.cost.rendered = std::min<uint64_t>(source.cost.rendered, 1);
+	source.cost.calls++;
+	return source.cost;
+}
+
+struct Scenario
+{
+	const char* name;
+	Cost        stepByStep, eachToBack, planned;
+};
+
+template<typename Generate>
+static Scenario Run(const char* name, Generate generate)
+{
+	Scenario     scenario{name, {}, {}, {}};
+	std::mt19937 random(48);
+	for (int round = 0; round < Rounds; round++) {
+		std::vector<uint64_t> current, desired;
+		generate(random, current, desired);
+
+		Cost costs[] = {StepByStep(current, desired), EachToBack(current, desired), Planned(current, desired)};
+		Cost* totals[] = {&scenario.stepByStep, &scenario.eachToBack, &scenario.planned};
+		for (size_t idx = 0; idx < 3; idx++) {
+			totals[idx]->calls += costs[idx].calls;
+			totals[idx]->rebuilds += costs[idx].rebuilds;
+			totals[idx]->rendered += costs[idx].rendered;
+		}
+	}
+	return scenario;
+}
+
+static std::vector<uint64_t> Chain(uint64_t first)
+{
+	std::vector<uint64_t> chain;
+	for (uint64_t filter = first; filter < first + Filters; filter++)
+		chain.push_back(filter);
+	return chain;
+}
+
+static std::string Json(const Cost& cost)
+{
+	std::ostringstream json;
+	json << "{ \"calls\": " << double(cost.calls) / Rounds << ", \"rebuilds\": " << double(cost.rebuilds) / Rounds
+	     << ", \"rendered_chains\": " << double(cost.rendered) / Rounds << " }";
+	return json.str();
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<Scenario> scenarios;
+
+	// Last filter dragged to the front
+	scenarios.push_back(Run("drag", [](std::mt19937&, std::vector<uint64_t>& current, std::vector<uint64_t>& desired) {
+		current = desired = Chain(1);
+		std::rotate(desired.begin(), desired.end() - 1, desired.end());
+	}));
+
+	// Same filters in another order
+	scenarios.push_back(
+	    Run("reorder", [](std::mt19937& random, std::vector<uint64_t>& current, std::vector<uint64_t>& desired) {
+		    current = desired = Chain(1);
+		    std::shuffle(desired.begin(), desired.end(), random);
+	    }));
+
+	// A preset sharing half of its filters with the current chain
+	scenarios.push_back(
+	    Run("preset", [](std::mt19937& random, std::vector<uint64_t>& current, std::vector<uint64_t>& desired) {
+		    current = Chain(1);
+		    desired = Chain(1 + Filters / 2);
+		    std::shuffle(desired.begin(), desired.end(), random);
+	    }));
+
+	// Planning cost on its own
+	std::vector<uint64_t>              current = Chain(1), desired = Chain(1 + Filters / 2);
+	std::vector<FilterChainPlan::Step> steps;
+	auto                               start = std::chrono::steady_clock::now();
+	for (int round = 0; round < Rounds; round++)
+		FilterChainPlan::Make(current, desired, steps);
+	double planUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / Rounds;
+
+	std::string   path = argc > 1 ? argv[1] : "bench_filter_chain.json";
+	std::ofstream report(path);
+	report << "{\n"
+	       << "    \"layer\": \"filter-chain\",\n"
+	       << "    \"filters\": " << Filters << ",\n"
+	       << "    \"rounds\": " << Rounds << ",\n"
+	       << "    \"plan_us\": " << planUs << ",\n"
+	       << "    \"scenarios\": {\n";
+	for (size_t idx = 0; idx < scenarios.size(); idx++) {
+		auto& scenario = scenarios[idx];
+		report << "        \"" << scenario.name << "\": {\n"
+		       << "            \"move_filter\": " << Json(scenario.stepByStep) << ",\n"
+		       << "            \"each_to_back\": " << Json(scenario.eachToBack) << ",\n"
+		       << "            \"set_filter_chain\": " << Json(scenario.planned) << "\n"
+		       << "        }" << (idx + 1 < scenarios.size() ? "," : "") << "\n";
+
+		std::cout << scenario.name << ": move filter " << Json(scenario.stepByStep) << ", each to back "
+		          << Json(scenario.eachToBack) << ", set filter chain " << Json(scenario.planned) << std::endl;
+	}
+	report << "    }\n"
+	       << "}\n";
+
+	std::cout << "Planning " << Filters << " filters takes " << planUs << "us" << std::endl;
+	std::cout << "Results written to " << path << std::endl;
+
+	bool fewer = true;
+	for (auto& scenario : scenarios)
+		fewer = fewer && scenario.planned.rebuilds <= scenario.eachToBack.rebuilds
+		        && scenario.planned.calls < scenario.eachToBack.calls;
+	return fewer ? 0 : 1;
+}
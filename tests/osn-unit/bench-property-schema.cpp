@@ -0,0 +1,144 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+// Round trips synthetic property lists of 10 to 1000 entries through the
+// per-property blobs of obs::Property::serialize and through one
+// obs::PropertySchema blob, reporting bytes and time of each. Writes a JSON
+// report, to the path given as first argument or to
+// bench_property_schema.json.
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include "obs-property-schema.hpp"
+
+static const int Rounds = 200;
+
+static obs::PropertySchema::List Synthetic(size_t count)
+{
+	static const char* formats[] = {"RGB", "NV12", "I420", "YUY2"};
+
+	obs::PropertySchema::List props;
+	for (size_t idx = 0; idx < count; idx++) {
+		std::shared_ptr<obs::Property> prop;
+		switch (idx % 4) {
+		case 0: {
+			auto list        = std::make_shared<obs::ListProperty>();
+			list->field_type = obs::ListProperty::ListType::List;
+			list->format     = obs::ListProperty::Format::String;
+			for (auto format : formats)
+				list->items.push_back({format, true, 0, 0, format});
+			list->current_value_str = formats[idx % 4];
+			prop                    = list;
+			break;
+		}
+		case 1: {
+			auto number        = std::make_shared<obs::IntegerProperty>();
+			number->field_type = obs::NumberProperty::NumberType::Slider;
+			number->minimum    = 0;
+			number->maximum    = 100;
+			number->step       = 1;
+			number->value      = int64_t(idx % 100);
+			prop               = number;
+			break;
+		}
+		case 2: {
+			auto text        = std::make_shared<obs::TextProperty>();
+			text->field_type = obs::TextProperty::TextType::Default;
+			text->value      = "Value " + std::to_string(idx);
+			prop             = text;
+			break;
+		}
+		default: {
+			auto boolean   = std::make_shared<obs::BooleanProperty>();
+			boolean->value = idx % 2 == 0;
+			prop           = boolean;
+			break;
+		}
+		}
+		prop->name             = "property_" + std::to_string(idx);
+		prop->description      = "Property " + std::to_string(idx % 16);
+		prop->long_description = "Shared tooltip of the property";
+		prop->enabled          = true;
+		prop->visible          = true;
+		props.push_back(prop);
+	}
+	return props;
+}
+
+template<typename F>
+static double MeasureUs(F f)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (int n = 0; n < Rounds; n++)
+		f();
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / Rounds;
+}
+
+int main(int argc, char** argv)
+{
+	std::string   path = argc > 1 ? argv[1] : "bench_property_schema.json";
+	std::ofstream report(path);
+	report << "{\n    \"layer\": \"property-schema\",\n    \"rounds\": " << Rounds << ",\n    \"sets\": [";
+
+	bool first = true;
+	for (size_t count : {10, 100, 1000}) {
+		obs::PropertySchema::List props = Synthetic(count);
+
+		size_t legacyBytes = 0;
+		double legacyUs    = MeasureUs([&]() {
+            legacyBytes = 0;
+            for (auto& prop : props) {
+                std::vector<char> buf(prop->size());
+                prop->serialize(buf);
+                legacyBytes += buf.size();
+                obs::Property::deserialize(buf);
+            }
+        });
+
+		std::vector<char>         buf;
+		obs::PropertySchema::List decoded;
+		uint64_t                  hash     = 0;
+		double                    schemaUs = MeasureUs([&]() {
+            hash = obs::PropertySchema::encode(props, buf);
+            obs::PropertySchema::decode(buf, decoded);
+        });
+		size_t                    schemaBytes = buf.size();
+
+		double valuesUs = MeasureUs([&]() {
+			obs::PropertySchema::encode(props, buf, hash);
+			obs::PropertySchema::decode(buf, decoded);
+		});
+		size_t valuesBytes = buf.size();
+
+		report << (first ? "" : ",") << "\n        { \"properties\": " << count << ", \"legacy\": { \"bytes\": "
+		       << legacyBytes << ", \"us\": " << legacyUs << " }, \"schema\": { \"bytes\": " << schemaBytes
+		       << ", \"us\": " << schemaUs << " }, \"known_schema\": { \"bytes\": " << valuesBytes
+		       << ", \"us\": " << valuesUs << " } }";
+		first = false;
+
+		std::cout << count << " properties: legacy " << legacyBytes << " bytes " << legacyUs << "us, schema "
+		          << schemaBytes << " bytes " << schemaUs << "us, known schema " << valuesBytes << " bytes "
+		          << valuesUs << "us" << std::endl;
+	}
+
+	report << "\n    ]\n}\n";
+	std::cout << "Results written to " << path << std::endl;
+	return 0;
+}
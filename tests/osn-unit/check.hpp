@@ -0,0 +1,44 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <iostream>
+
+// Checks shared by the unit tests, a failed check is reported and the test keeps going
+
+inline int failures = 0;
+
+#define CHECK(condition)                                                                  \
+	do {                                                                                  \
+		if (!(condition)) {                                                               \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": failed " #condition << std::endl; \
+			failures++;                                                                   \
+		}                                                                                 \
+	} while (false)
+
+// Exit code of a test, prints whether all checks of the named test passed
+inline int CheckResult(const char* name)
+{
+	if (failures > 0) {
+		std::cerr << failures << " check(s) failed" << std::endl;
+		return 1;
+	}
+
+	std::cout << name << ": all checks passed" << std::endl;
+	return 0;
+}
@@ -0,0 +1,161 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+// Audio encoder bitrate table, with an enumerator standing in for the
+// encoder properties.
+
+#include "audio-bitrate-table.h"
+#include "check.hpp"
+
+struct StubEncoders
+{
+	int enumerations = 0;
+
+	AudioBitrateTable::Enumerator Enumerator()
+	{
+		return [this](const std::string& encoderId, const std::string& layout, uint32_t sampleRate, AudioBitrateTable::Bitrates& bitrates) {
+			enumerations++;
+			if (encoderId == "broken_aac")
+				return false;
+			if (encoderId == "ffmpeg_aac")
+				bitrates = {64, 96, 128, 160};
+			if (encoderId == "mf_aac")
+				bitrates = {96, 128, 192};
+			if (layout == "5.1")
+				bitrates.push_back(512);
+			if (sampleRate == 48000)
+				bitrates.push_back(320);
+			return true;
+		};
+	}
+};
+
+static void TestMerge()
+{
+	StubEncoders      stub;
+	AudioBitrateTable table(stub.Enumerator());
+	table.SetEncoders({"ffmpeg_aac", "broken_aac", "mf_aac"}, "plugins");
+
+	const AudioBitrateTable::BitrateMap& map = table.GetBitrateMap("Stereo", 44100);
+	CHECK(map.size() == 5);
+	CHECK(std::string(map.at(64)) == "ffmpeg_aac");
+	CHECK(std::string(map.at(160)) == "ffmpeg_aac");
+	// The later encoder wins
+	CHECK(std::string(map.at(128)) == "mf_aac");
+	CHECK(std::string(map.at(192)) == "mf_aac");
+	CHECK(stub.enumerations == 3);
+
+	CHECK(&table.GetBitrateMap("Stereo", 44100) == &map);
+	CHECK(stub.enumerations == 3);
+	CHECK(table.GetRevision() == 3);
+
+	// Another sample rate or layout is another entry
+	CHECK(table.GetBitrateMap("Stereo", 48000).count(320) == 1);
+	CHECK(table.GetBitrateMap("5.1", 44100).count(512) == 1);
+	CHECK(stub.enumerations == 9);
+
+	AudioBitrateTable::Bitrates bitrates;
+	table.Find("broken_aac", "Stereo", 44100, bitrates);
+	CHECK(bitrates.empty());
+	table.Find("mf_aac", "Stereo", 44100, bitrates);
+	CHECK(bitrates.size() == 3);
+	CHECK(stub.enumerations == 9);
+}
+
+static void TestFingerprint()
+{
+	StubEncoders      stub;
+	AudioBitrateTable table(stub.Enumerator());
+	table.SetEncoders({"ffmpeg_aac"}, "plugins");
+	table.GetBitrateMap("Stereo", 44100);
+	CHECK(stub.enumerations == 1);
+
+	// Same plugins, only the order of the encoders changed
+	table.SetEncoders({"mf_aac", "ffmpeg_aac"}, "plugins");
+	table.GetBitrateMap("Stereo", 44100);
+	CHECK(stub.enumerations == 2);
+
+	table.SetEncoders({"mf_aac", "ffmpeg_aac"}, "other plugins");
+	table.GetBitrateMap("Stereo", 44100);
+	CHECK(stub.enumerations == 4);
+}
+
+static void TestSavedEntries()
+{
+	StubEncoders      stub;
+	AudioBitrateTable table(stub.Enumerator());
+	table.SetEncoders({"ffmpeg_aac", "mf_aac"}, "plugins");
+	table.GetBitrateMap("Stereo", 48000);
+
+	std::vector<AudioBitrateTable::Entry> entries = table.GetEntries();
+	CHECK(entries.size() == 2);
+
+	StubEncoders      restarted;
+	AudioBitrateTable loaded(restarted.Enumerator());
+	loaded.SetEncoders({"ffmpeg_aac", "mf_aac"}, "plugins");
+	for (auto& entry : entries)
+		loaded.Insert(entry);
+
+	const AudioBitrateTable::BitrateMap& original = table.GetBitrateMap("Stereo", 48000);
+	const AudioBitrateTable::BitrateMap& map      = loaded.GetBitrateMap("Stereo", 48000);
+	CHECK(map.size() == original.size());
+	for (auto& entry : original)
+		CHECK(map.count(entry.first) && std::string(map.at(entry.first)) == entry.second);
+	CHECK(restarted.enumerations == 0);
+	CHECK(loaded.GetRevision() == 0);
+}
+
+static void TestFailedEntries()
+{
+	StubEncoders      stub;
+	AudioBitrateTable table(stub.Enumerator());
+	table.SetEncoders({"ffmpeg_aac", "broken_aac"}, "plugins");
+	table.GetBitrateMap("Stereo", 44100);
+	CHECK(stub.enumerations == 2);
+
+	// Not asked again this session, but not saved either
+	table.GetBitrateMap("Stereo", 48000);
+	AudioBitrateTable::Bitrates bitrates;
+	table.Find("broken_aac", "Stereo", 44100, bitrates);
+	CHECK(stub.enumerations == 4);
+
+	std::vector<AudioBitrateTable::Entry> entries = table.GetEntries();
+	CHECK(entries.size() == 2);
+	for (auto& entry : entries)
+		CHECK(entry.encoderId == "ffmpeg_aac");
+
+	// The next session asks the failed encoder again
+	StubEncoders      restarted;
+	AudioBitrateTable loaded(restarted.Enumerator());
+	loaded.SetEncoders({"ffmpeg_aac", "broken_aac"}, "plugins");
+	for (auto& entry : entries)
+		loaded.Insert(entry);
+	loaded.GetBitrateMap("Stereo", 44100);
+	CHECK(restarted.enumerations == 1);
+}
+
+int main()
+{
+	TestMerge();
+	TestFingerprint();
+	TestSavedEntries();
+	TestFailedEntries();
+
+	return CheckResult("audio bitrate table");
+}
@@ -0,0 +1,161 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Caching of device lists, with an enumerator standing in for the dummy
+// sources the server instantiates.
+
+#include <atomic>
+#include <thread>
+#include "device-registry.h"
+#include "check.hpp"
+
+struct StubDevices
+{
+	std::atomic<int>           enumerations{0};
+	DeviceRegistry::DeviceList devices = {{"Microphone", "mic"}, {"Line In", "line"}};
+
+	DeviceRegistry::Enumerator Enumerator()
+	{
+		return [this](const std::string& sourceId, const std::string&, DeviceRegistry::DeviceList& list) {
+			if (sourceId != "stub_input_capture")
+				return false;
+			enumerations++;
+			list = devices;
+			return true;
+		};
+	}
+};
+
+static void TestCacheHits()
+{
+	StubDevices                stub;
+	DeviceRegistry             registry(stub.Enumerator());
+	DeviceRegistry::DeviceList devices;
+
+	uint64_t generation = registry.Get("stub_input_capture", "device_id", devices);
+	CHECK(devices.size() == 2);
+	CHECK(devices[0].first == "Microphone" && devices[0].second == "mic");
+	CHECK(stub.enumerations == 1);
+
+	for (int n = 0; n < 10; n++)
+		CHECK(registry.Get("stub_input_capture", "device_id", devices) == generation);
+	CHECK(stub.enumerations == 1);
+	CHECK(devices.size() == 2);
+
+	DeviceRegistry::Stats stats = registry.GetStats();
+	CHECK(stats.hits == 10);
+	CHECK(stats.misses == 1);
+
+	// Another property of the same type is a separate list
+	registry.Get("stub_input_capture", "other", devices);
+	CHECK(stub.enumerations == 2);
+}
+
+static void TestUnknownType()
+{
+	StubDevices                stub;
+	DeviceRegistry             registry(stub.Enumerator());
+	DeviceRegistry::DeviceList devices = {{"stale", "stale"}};
+
+	registry.Get("missing_capture", "device_id", devices);
+	CHECK(devices.empty());
+
+	// Failures aren't cached, the type may show up once its module is loaded
+	registry.Get("missing_capture", "device_id", devices);
+	CHECK(registry.GetStats().misses == 2);
+}
+
+static void TestInvalidate()
+{
+	StubDevices                stub;
+	DeviceRegistry             registry(stub.Enumerator());
+	DeviceRegistry::DeviceList devices;
+
+	uint64_t generation = registry.Get("stub_input_capture", "device_id", devices);
+	stub.devices.push_back({"Headset", "headset"});
+	registry.Get("stub_input_capture", "device_id", devices);
+	CHECK(devices.size() == 2);
+
+	registry.Invalidate();
+	CHECK(registry.Get("stub_input_capture", "device_id", devices) > generation);
+	CHECK(devices.size() == 3);
+	CHECK(stub.enumerations == 2);
+}
+
+static void TestRescan()
+{
+	StubDevices                stub;
+	DeviceRegistry             registry(stub.Enumerator());
+	DeviceRegistry::DeviceList devices;
+
+	uint64_t generation = registry.Get("stub_input_capture", "device_id", devices);
+
+	// Same devices, same generation
+	CHECK(registry.Rescan() == generation);
+	CHECK(stub.enumerations == 2);
+	CHECK(registry.Get("stub_input_capture", "device_id", devices) == generation);
+
+	stub.devices.pop_back();
+	uint64_t rescanned = registry.Rescan();
+	CHECK(rescanned > generation);
+	CHECK(registry.Get("stub_input_capture", "device_id", devices) == rescanned);
+	CHECK(devices.size() == 1);
+	CHECK(registry.GetStats().rescans == 2);
+
+	// Invalidated types aren't enumerated again until they are asked for
+	CHECK(registry.Invalidate() > rescanned);
+	registry.Rescan();
+	CHECK(stub.enumerations == 3);
+}
+
+static void TestMaxAge()
+{
+	StubDevices                stub;
+	DeviceRegistry             registry(stub.Enumerator(), std::chrono::milliseconds(50));
+	DeviceRegistry::DeviceList devices;
+
+	uint64_t generation = registry.Get("stub_input_capture", "device_id", devices);
+	CHECK(registry.Get("stub_input_capture", "device_id", devices) == generation);
+	CHECK(stub.enumerations == 1);
+
+	// An outdated list with the same devices keeps its generation
+	std::this_thread::sleep_for(std::chrono::milliseconds(80));
+	CHECK(registry.Get("stub_input_capture", "device_id", devices) == generation);
+	CHECK(stub.enumerations == 2);
+	CHECK(registry.GetStats().refreshes == 1);
+
+	// A device plugged meanwhile shows up without invalidating
+	stub.devices.push_back({"Headset", "headset"});
+	CHECK(registry.Get("stub_input_capture", "device_id", devices) == generation);
+	CHECK(devices.size() == 2);
+	std::this_thread::sleep_for(std::chrono::milliseconds(80));
+	CHECK(registry.Get("stub_input_capture", "device_id", devices) > generation);
+	CHECK(devices.size() == 3);
+	CHECK(stub.enumerations == 3);
+}
+
+int main()
+{
+	TestCacheHits();
+	TestUnknownType();
+	TestInvalidate();
+	TestRescan();
+	TestMaxAge();
+
+	return CheckResult("device registry");
+}
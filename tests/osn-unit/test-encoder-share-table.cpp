@@ -0,0 +1,111 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+
+// Keys and holders of EncoderShareTable, the bookkeeping behind EncoderRegistry.
+// Plain ints stand in for the encoders and the variables holding them.
+
+#include "encoder-share-table.h"
+#include "check.hpp"
+
+static void TestKeys()
+{
+	EncoderShareTable table;
+	int               x264 = 0, aac = 0;
+
+	size_t                 hash = EncoderShareTable::SettingsHash("{\"bitrate\":2500}");
+	EncoderShareTable::Key videoKey{"obs_x264", 0, 0, hash};
+	EncoderShareTable::Key audioKey{"ffmpeg_aac", 0, 0, EncoderShareTable::SettingsHash(nullptr)};
+	table.Set(&x264, videoKey);
+	table.Set(&aac, audioKey);
+
+	CHECK(table.Find(videoKey) == &x264);
+	CHECK(table.Find(audioKey) == &aac);
+	CHECK(EncoderShareTable::SettingsHash(nullptr) == EncoderShareTable::SettingsHash(""));
+
+	// Any part of the key differing is another encoder
+	CHECK(table.Find({"obs_x264", 1, 0, hash}) == nullptr);
+	CHECK(table.Find({"obs_x264", 0, 2, hash}) == nullptr);
+	CHECK(table.Find({"obs_x264", 0, 0, EncoderShareTable::SettingsHash("{\"bitrate\":6000}")}) == nullptr);
+
+	// New settings move the encoder to its new key
+	EncoderShareTable::Key updated{"obs_x264", 0, 0, EncoderShareTable::SettingsHash("{\"bitrate\":6000}")};
+	table.Set(&x264, updated);
+	CHECK(table.Find(videoKey) == nullptr);
+	CHECK(table.Find(updated) == &x264);
+
+	EncoderShareTable::Key key;
+	CHECK(table.KeyOf(&x264, key) && key == updated);
+
+	table.Erase(&x264);
+	CHECK(table.Find(updated) == nullptr);
+	CHECK(!table.KeyOf(&x264, key));
+	CHECK(table.Find(audioKey) == &aac);
+}
+
+static void TestHolders()
+{
+	EncoderShareTable table;
+	int               stream = 0, other = 0;
+	void*             streamSlot    = &stream;
+	void*             recordingSlot = nullptr;
+	void*             replaySlot    = nullptr;
+	table.Set(&stream, {"obs_x264", 0, 0, 1});
+
+	table.Hold(&streamSlot, &stream);
+	CHECK(table.Holders(&stream) == 1);
+
+	// Holding again from the same slot doesn't count twice
+	table.Hold(&streamSlot, &stream);
+	recordingSlot = &stream;
+	table.Hold(&recordingSlot, &stream);
+	replaySlot = &stream;
+	table.Hold(&replaySlot, &stream);
+	CHECK(table.Holders(&stream) == 3);
+
+	// A slot moving to another encoder stops holding the first one
+	replaySlot = &other;
+	table.Hold(&replaySlot, &other);
+	CHECK(table.Holders(&stream) == 2);
+	CHECK(table.Holders(&other) == 1);
+
+	table.Drop(&replaySlot);
+	CHECK(table.Holders(&other) == 0);
+
+	// Slots reassigned behind the table's back are pruned
+	recordingSlot = nullptr;
+	table.Prune([](const void* slot, void* encoder) { return *reinterpret_cast<void* const*>(slot) == encoder; });
+	CHECK(table.Holders(&stream) == 1);
+
+	// Erasing an expired encoder forgets its holders
+	table.Erase(&stream);
+	CHECK(table.Holders(&stream) == 0);
+
+	table.Hold(&streamSlot, &stream);
+	table.Clear();
+	CHECK(table.Holders(&stream) == 0);
+}
+
+int main()
+{
+	TestKeys();
+	TestHolders();
+
+	return CheckResult("encoder share table");
+}
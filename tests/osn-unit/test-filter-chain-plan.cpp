@@ -0,0 +1,160 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+// Plans turning one filter chain into another, replayed on a plain order the
+// way libobs applies them.
+
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <random>
+#include "filter-chain-plan.h"
+#include "check.hpp"
+
+static std::vector<uint64_t> Replay(std::vector<uint64_t> order, const std::vector<FilterChainPlan::Step>& steps)
+{
+	for (auto& step : steps)
+		FilterChainPlan::Apply(step, order);
+	return order;
+}
+
+static size_t Count(const std::vector<FilterChainPlan::Step>& steps, FilterChainPlan::Action action)
+{
+	return std::count_if(
+	    steps.begin(), steps.end(), [action](const FilterChainPlan::Step& step) { return step.action == action; });
+}
+
+static void TestUnchanged()
+{
+	std::vector<FilterChainPlan::Step> steps;
+	CHECK(FilterChainPlan::Make({1, 2, 3}, {1, 2, 3}, steps));
+	CHECK(steps.empty());
+	CHECK(FilterChainPlan::Make({}, {}, steps));
+	CHECK(steps.empty());
+}
+
+static void TestSingleMove()
+{
+	std::vector<FilterChainPlan::Step> steps;
+
+	// Dragging one filter is a single step whichever way it goes
+	CHECK(FilterChainPlan::Make({1, 2, 3, 4, 5}, {5, 1, 2, 3, 4}, steps));
+	CHECK(steps.size() == 1 && steps[0].action == FilterChainPlan::Action::MoveToFront && steps[0].filter == 5);
+
+	CHECK(FilterChainPlan::Make({1, 2, 3, 4, 5}, {2, 3, 4, 5, 1}, steps));
+	CHECK(steps.size() == 1 && steps[0].action == FilterChainPlan::Action::MoveToBack && steps[0].filter == 1);
+
+	CHECK(FilterChainPlan::Make({1, 2, 3, 4, 5}, {1, 2, 4, 3, 5}, steps));
+	CHECK(Replay({1, 2, 3, 4, 5}, steps) == std::vector<uint64_t>({1, 2, 4, 3, 5}));
+	CHECK(steps.size() == 2);
+}
+
+static void TestAddRemove()
+{
+	std::vector<FilterChainPlan::Step> steps;
+	CHECK(FilterChainPlan::Make({1, 2, 3}, {4, 1, 3, 5}, steps));
+	CHECK(Replay({1, 2, 3}, steps) == std::vector<uint64_t>({4, 1, 3, 5}));
+	CHECK(Count(steps, FilterChainPlan::Action::Remove) == 1);
+	CHECK(Count(steps, FilterChainPlan::Action::Add) == 2);
+	CHECK(steps.size() == 4);
+
+	// Removals come first, the chain never holds more filters than either end
+	CHECK(steps[0].action == FilterChainPlan::Action::Remove && steps[0].filter == 2);
+
+	CHECK(FilterChainPlan::Make({1, 2, 3}, {}, steps));
+	CHECK(steps.size() == 3 && Count(steps, FilterChainPlan::Action::Remove) == 3);
+
+	CHECK(FilterChainPlan::Make({}, {7, 8}, steps));
+	CHECK(Replay({}, steps) == std::vector<uint64_t>({7, 8}));
+	CHECK(steps.size() == 2);
+}
+
+static void TestDuplicates()
+{
+	std::vector<FilterChainPlan::Step> steps = {{FilterChainPlan::Action::Add, 9}};
+	CHECK(!FilterChainPlan::Make({1, 2}, {2, 1, 2}, steps));
+	CHECK(steps.empty());
+}
+
+// Fewest moves to reach every order of a chain, each move sends one filter to either end
+static std::map<std::vector<uint64_t>, size_t> Distances(const std::vector<uint64_t>& start)
+{
+	std::map<std::vector<uint64_t>, size_t> distances = {{start, 0}};
+	std::queue<std::vector<uint64_t>>       pending;
+	pending.push(start);
+	while (!pending.empty()) {
+		std::vector<uint64_t> order = pending.front();
+		pending.pop();
+		for (uint64_t filter : order) {
+			for (auto action : {FilterChainPlan::Action::MoveToFront, FilterChainPlan::Action::MoveToBack}) {
+				std::vector<uint64_t> next = order;
+				FilterChainPlan::Apply({action, filter}, next);
+				if (distances.emplace(next, distances[order] + 1).second)
+					pending.push(next);
+			}
+		}
+	}
+	return distances;
+}
+
+static void TestMinimal()
+{
+	std::vector<uint64_t> current = {1, 2, 3, 4, 5, 6};
+	auto                  distances = Distances(current);
+	CHECK(distances.size() == 720);
+
+	for (auto& entry : distances) {
+		std::vector<FilterChainPlan::Step> steps;
+		CHECK(FilterChainPlan::Make(current, entry.first, steps));
+		CHECK(Replay(current, steps) == entry.first);
+		CHECK(steps.size() == entry.second);
+	}
+}
+
+static void TestRandom()
+{
+	std::mt19937 random(48);
+	for (int round = 0; round < 500; round++) {
+		std::vector<uint64_t> current, desired;
+		for (uint64_t filter = 1; filter <= 20; filter++) {
+			if (random() % 4)
+				current.push_back(filter);
+			if (random() % 4)
+				desired.push_back(filter);
+		}
+		std::shuffle(current.begin(), current.end(), random);
+		std::shuffle(desired.begin(), desired.end(), random);
+
+		std::vector<FilterChainPlan::Step> steps;
+		CHECK(FilterChainPlan::Make(current, desired, steps));
+		CHECK(Replay(current, steps) == desired);
+	}
+}
+
+int main()
+{
+	TestUnchanged();
+	TestSingleMove();
+	TestAddRemove();
+	TestDuplicates();
+	TestMinimal();
+	TestRandom();
+
+	return CheckResult("filter chain plan");
+}
@@ -0,0 +1,139 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Versioned hotkey list behind OBS_API_QueryHotkeysSince, fed with the
+// snapshots the server would enumerate.
+
+#include <algorithm>
+#include "hotkey-registry.h"
+#include "check.hpp"
+
+
+static HotkeyRegistry::Hotkey Hotkey(uint64_t id, const std::string& objectName, const std::string& hotkeyName)
+{
+	HotkeyRegistry::Hotkey hotkey = {};
+	hotkey.id                     = id;
+	hotkey.objectType             = 1;
+	hotkey.objectName             = objectName;
+	hotkey.hotkeyName             = hotkeyName;
+	hotkey.hotkeyDesc             = hotkeyName;
+	return hotkey;
+}
+
+static bool Contains(const std::vector<HotkeyRegistry::Hotkey>& hotkeys, uint64_t id)
+{
+	return std::any_of(hotkeys.begin(), hotkeys.end(), [id](const HotkeyRegistry::Hotkey& hotkey) {
+		return hotkey.id == id;
+	});
+}
+
+static void TestDirty()
+{
+	HotkeyRegistry registry;
+	CHECK(registry.ConsumeDirty());
+	CHECK(!registry.ConsumeDirty());
+	registry.MarkDirty();
+	CHECK(registry.ConsumeDirty());
+}
+
+static void TestDeltas()
+{
+	HotkeyRegistry        registry;
+	HotkeyRegistry::Delta delta;
+
+	registry.Update({Hotkey(1, "Mic", "MUTE"), Hotkey(2, "Mic", "UNMUTE"), Hotkey(3, "Scene", "SHOW")});
+	registry.Since(0, delta);
+	CHECK(delta.full);
+	CHECK(delta.changed.size() == 3);
+	uint64_t version = delta.version;
+
+	// Nothing changed
+	registry.Update({Hotkey(1, "Mic", "MUTE"), Hotkey(2, "Mic", "UNMUTE"), Hotkey(3, "Scene", "SHOW")});
+	registry.Since(version, delta);
+	CHECK(!delta.full);
+	CHECK(delta.version == version);
+	CHECK(delta.changed.empty() && delta.removed.empty());
+
+	// One added, one removed, one renamed
+	registry.Update({Hotkey(1, "Microphone", "MUTE"), Hotkey(3, "Scene", "SHOW"), Hotkey(4, "Cam", "SHOW")});
+	registry.Since(version, delta);
+	CHECK(!delta.full);
+	CHECK(delta.version > version);
+	CHECK(delta.changed.size() == 2 && Contains(delta.changed, 1) && Contains(delta.changed, 4));
+	CHECK(delta.removed.size() == 1 && delta.removed[0] == 2);
+
+	// Up to date client
+	uint64_t latest = delta.version;
+	registry.Since(latest, delta);
+	CHECK(delta.changed.empty() && delta.removed.empty());
+
+	// A version from another server instance gets everything
+	registry.Since(latest + 100, delta);
+	CHECK(delta.full && delta.changed.size() == 3);
+}
+
+static void TestForgottenRemovals()
+{
+	HotkeyRegistry                      registry;
+	HotkeyRegistry::Delta               delta;
+	std::vector<HotkeyRegistry::Hotkey> hotkeys;
+
+	for (uint64_t id = 1; id <= 5000; id++)
+		hotkeys.push_back(Hotkey(id, "Source " + std::to_string(id), "SHOW"));
+	registry.Update(hotkeys);
+	registry.Since(0, delta);
+	uint64_t version = delta.version;
+
+	registry.Update({Hotkey(1, "Source 1", "SHOW")});
+	registry.Since(version, delta);
+	CHECK(delta.full);
+	CHECK(delta.changed.size() == 1);
+	CHECK(delta.removed.empty());
+
+	// Recent removals are still known
+	uint64_t latest = delta.version;
+	registry.Update({});
+	registry.Since(latest, delta);
+	CHECK(!delta.full);
+	CHECK(delta.removed.size() == 1 && delta.removed[0] == 1);
+}
+
+static void TestClear()
+{
+	HotkeyRegistry        registry;
+	HotkeyRegistry::Delta delta;
+
+	registry.ConsumeDirty();
+	registry.Update({Hotkey(1, "Mic", "MUTE")});
+	registry.Since(0, delta);
+	registry.Clear();
+	CHECK(registry.ConsumeDirty());
+
+	registry.Since(delta.version - 1, delta);
+	CHECK(delta.full && delta.changed.empty());
+}
+
+int main()
+{
+	TestDirty();
+	TestDeltas();
+	TestForgottenRemovals();
+	TestClear();
+
+	return CheckResult("hotkey registry");
+}
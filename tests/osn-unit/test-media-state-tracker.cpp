@@ -0,0 +1,159 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+// Media state changes reported by MediaStateTracker, with a map of samples
+// standing in for the media sources.
+
+#include "media-state-tracker.h"
+#include "check.hpp"
+
+// Values of obs_media_state
+static const uint32_t Playing = 1;
+static const uint32_t Paused  = 4;
+static const uint32_t Ended   = 6;
+
+struct StubMedia
+{
+	std::map<uint64_t, MediaStateTracker::Sample> sources;
+
+	MediaStateTracker::Reader Reader()
+	{
+		return [this](uint64_t source, MediaStateTracker::Sample& sample) {
+			auto found = sources.find(source);
+			if (found == sources.end())
+				return false;
+			sample = found->second;
+			return true;
+		};
+	}
+};
+
+static std::vector<MediaStateTracker::Change> Poll(MediaStateTracker& tracker)
+{
+	std::vector<MediaStateTracker::Change> changes;
+	tracker.Poll(changes);
+	return changes;
+}
+
+static void TestFirstPoll()
+{
+	StubMedia         media;
+	MediaStateTracker tracker(media.Reader());
+	media.sources[1] = {Playing, 0, 10000};
+	media.sources[2] = {Paused, 500, 20000};
+
+	CHECK(Poll(tracker).empty());
+
+	tracker.Watch(1, 1000);
+	tracker.Watch(2, 1000);
+	auto changes = Poll(tracker);
+	CHECK(changes.size() == 2);
+	CHECK(changes[0].first == 1 && changes[0].second == media.sources[1]);
+	CHECK(changes[1].first == 2 && changes[1].second == media.sources[2]);
+
+	// Nothing moved
+	CHECK(Poll(tracker).empty());
+}
+
+static void TestGranularity()
+{
+	StubMedia         media;
+	MediaStateTracker tracker(media.Reader());
+	media.sources[1] = {Playing, 0, 10000};
+	media.sources[2] = {Playing, 0, 10000};
+	tracker.Watch(1, 1000);
+	tracker.Watch(2, 50);
+	Poll(tracker);
+
+	// A 50ms query interval, the fine grained source is reported every time
+	size_t coarse = 0, fine = 0;
+	for (int64_t time = 50; time <= 3000; time += 50) {
+		media.sources[1].time = media.sources[2].time = time;
+		for (auto& change : Poll(tracker))
+			(change.first == 1 ? coarse : fine)++;
+	}
+	CHECK(coarse == 3);
+	CHECK(fine == 60);
+
+	// Seeking back counts as moving
+	media.sources[1].time = 0;
+	auto changes          = Poll(tracker);
+	CHECK(changes.size() == 1 && changes[0].first == 1 && changes[0].second.time == 0);
+}
+
+static void TestStateChanges()
+{
+	StubMedia         media;
+	MediaStateTracker tracker(media.Reader());
+	media.sources[1] = {Playing, 9900, 10000};
+	tracker.Watch(1, 1000);
+	Poll(tracker);
+
+	// State and duration are reported right away, whatever the position did
+	media.sources[1] = {Ended, 10000, 10000};
+	auto changes     = Poll(tracker);
+	CHECK(changes.size() == 1 && changes[0].second.state == Ended);
+
+	media.sources[1].duration = 12000;
+	changes                   = Poll(tracker);
+	CHECK(changes.size() == 1 && changes[0].second.duration == 12000);
+
+	// Watching again reports the current state
+	tracker.Watch(1, 1000);
+	CHECK(Poll(tracker).size() == 1);
+}
+
+static void TestGoneAndUnwatched()
+{
+	StubMedia         media;
+	MediaStateTracker tracker(media.Reader());
+	media.sources[1] = {Playing, 0, 10000};
+	media.sources[2] = {Playing, 0, 10000};
+	tracker.Watch(1, 0);
+	tracker.Watch(2, 0);
+	tracker.Watch(3, 0);
+	CHECK(Poll(tracker).size() == 2);
+
+	tracker.Unwatch(2);
+	media.sources[1].time = media.sources[2].time = 100;
+	auto changes                                  = Poll(tracker);
+	CHECK(changes.size() == 1 && changes[0].first == 1);
+
+	// A gone source isn't sampled again, even if the id comes back
+	media.sources[3] = {Playing, 0, 10000};
+	CHECK(Poll(tracker).empty());
+
+	MediaStateTracker::Stats stats = tracker.GetStats();
+	CHECK(stats.samples == 4);
+	CHECK(stats.reported == 3);
+
+	tracker.Clear();
+	media.sources[1].time = 200;
+	CHECK(Poll(tracker).empty());
+}
+
+int main()
+{
+	TestFirstPoll();
+	TestGranularity();
+	TestStateChanges();
+	TestGoneAndUnwatched();
+
+	return CheckResult("media state tracker");
+}
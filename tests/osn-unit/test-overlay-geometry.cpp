@@ -0,0 +1,217 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Geometry generated for the selection overlay of a display, checked on the
+// CPU without a graphics device.
+
+#include <cmath>
+#include "gs-overlay.h"
+#include "check.hpp"
+
+static bool Close(float a, float b)
+{
+	return std::fabs(a - b) <= 0.001f;
+}
+
+static GS::OverlayStyle DefaultStyle(bool guidelines)
+{
+	GS::OverlayStyle style;
+	style.outlineColor     = 0xFFA8E61A;
+	style.guidelineColor   = 0xFF0000FF;
+	style.resizeOuterColor = 0xFF7E7E7E;
+	style.resizeInnerColor = 0xFFFFFFFF;
+	style.handleRadiusX    = 5.0f;
+	style.handleRadiusY    = 5.0f;
+	style.glyphSize        = 8.0f;
+	style.sceneWidth       = 1920.0f;
+	style.sceneHeight      = 1080.0f;
+	style.drawGuideLines   = guidelines;
+	return style;
+}
+
+static GS::OverlayTransform Box(float x, float y, float width, float height)
+{
+	return {x, y, width, 0.0f, 0.0f, height};
+}
+
+static bool HasLine(const std::vector<GS::OverlayVertex>& lines, float x0, float y0, float x1, float y1)
+{
+	for (size_t n = 0; n + 1 < lines.size(); n += 2) {
+		if (Close(lines[n].x, x0) && Close(lines[n].y, y0) && Close(lines[n + 1].x, x1) && Close(lines[n + 1].y, y1))
+			return true;
+	}
+	return false;
+}
+
+static void TestOutlineAndHandles()
+{
+	GS::OverlayGeometry overlay;
+	overlay.Reset(DefaultStyle(false));
+	overlay.AddItem(Box(100, 50, 200, 100));
+
+	CHECK(overlay.Triangles().size() == GS::OverlayGeometry::TriangleVerticesPerItem);
+	CHECK(overlay.Lines().size() == 4 * 2 + GS::OverlayGeometry::HandleCount * 4 * 2);
+	CHECK(overlay.Glyphs().empty());
+
+	// Outline comes first, in item space order
+	auto& lines = overlay.Lines();
+	CHECK(HasLine(lines, 100, 50, 300, 50));
+	CHECK(HasLine(lines, 300, 50, 300, 150));
+	CHECK(HasLine(lines, 300, 150, 100, 150));
+	CHECK(HasLine(lines, 100, 150, 100, 50));
+	for (size_t n = 0; n < 8; n++)
+		CHECK(lines[n].color == 0xFFA8E61A);
+
+	// Handle on the top left corner is a 10x10 square centered on it
+	auto& tris = overlay.Triangles();
+	CHECK(Close(tris[0].x, 95) && Close(tris[0].y, 45));
+	CHECK(Close(tris[5].x, 105) && Close(tris[5].y, 55));
+	CHECK(tris[0].color == 0xFFFFFFFF);
+	CHECK(HasLine(lines, 95, 45, 105, 45));
+
+	// Handle on the bottom edge center
+	bool found = false;
+	for (size_t n = 0; n < tris.size(); n += 6)
+		found |= Close(tris[n].x, 195) && Close(tris[n].y, 145) && Close(tris[n + 5].x, 205) && Close(tris[n + 5].y, 155);
+	CHECK(found);
+}
+
+static void TestGuidelinesAndLabels()
+{
+	GS::OverlayGeometry overlay;
+	overlay.Reset(DefaultStyle(true));
+	overlay.AddItem(Box(100, 50, 200, 100));
+
+	auto& lines = overlay.Lines();
+	CHECK(lines.size() == GS::OverlayGeometry::LineVerticesPerItem);
+
+	// From each edge center to the scene border facing away from the item
+	CHECK(HasLine(lines, 100, 100, 0, 100));
+	CHECK(HasLine(lines, 200, 50, 200, 0));
+	CHECK(HasLine(lines, 300, 100, 1920, 100));
+	CHECK(HasLine(lines, 200, 150, 200, 1080));
+
+	// "100 px", "50 px", "1620 px" and "930 px", spaces produce no quad
+	auto& glyphs = overlay.Glyphs();
+	CHECK(glyphs.size() == (5 + 4 + 6 + 5) * 6);
+
+	// Left label is centered between the scene border and the item
+	CHECK(Close(glyphs[0].x, 100 / 2 - 8 * 6 / 2.0f));
+	CHECK(Close(glyphs[0].y, 100 - 16));
+	CHECK(Close(glyphs[0].u, 0) && Close(glyphs[0].v, 0));
+	CHECK(Close(glyphs[5].x, glyphs[0].x + 8) && Close(glyphs[5].y, glyphs[0].y + 16));
+	CHECK(glyphs[0].color == 0xFF0000FF);
+
+	// '0' is the second glyph of the third row
+	CHECK(Close(glyphs[6].u, 0.25f) && Close(glyphs[6].v, 0.5f));
+}
+
+static void TestClippedToScene()
+{
+	GS::OverlayGeometry overlay;
+	overlay.Reset(DefaultStyle(true));
+	overlay.AddItem(Box(-50, 10, 100, 100));
+
+	// The left guideline would lie outside of the scene
+	auto& lines = overlay.Lines();
+	CHECK(lines.size() == GS::OverlayGeometry::LineVerticesPerItem - 2);
+	CHECK(HasLine(lines, 0, 10, 0, 0));
+	CHECK(HasLine(lines, 50, 60, 1920, 60));
+
+	for (auto& vertex : lines) {
+		if (vertex.color != 0xFF0000FF)
+			continue;
+		CHECK(vertex.x >= 0 && vertex.x <= 1920);
+		CHECK(vertex.y >= 0 && vertex.y <= 1080);
+	}
+}
+
+static void TestRotatedItem()
+{
+	GS::OverlayGeometry overlay;
+	overlay.Reset(DefaultStyle(true));
+
+	// Rotated by 90 degrees around its origin
+	overlay.AddItem({500, 500, 0, 100, -100, 0});
+
+	auto& lines = overlay.Lines();
+	CHECK(lines.size() == GS::OverlayGeometry::LineVerticesPerItem);
+	for (size_t n = lines.size() - 8; n < lines.size(); n += 2) {
+		CHECK(lines[n].color == 0xFF0000FF);
+		CHECK(Close(lines[n].x, lines[n + 1].x) || Close(lines[n].y, lines[n + 1].y));
+	}
+	CHECK(HasLine(lines, 450, 500, 450, 0));
+	CHECK(HasLine(lines, 450, 600, 450, 1080));
+}
+
+static void TestBatching()
+{
+	GS::OverlayGeometry overlay;
+	overlay.Reset(DefaultStyle(true));
+	for (int n = 0; n < 50; n++)
+		overlay.AddItem(Box(100.0f + n * 10, 100.0f + n * 5, 200, 100));
+
+	CHECK(overlay.Triangles().size() == 50 * GS::OverlayGeometry::TriangleVerticesPerItem);
+	CHECK(overlay.Lines().size() == 50 * GS::OverlayGeometry::LineVerticesPerItem);
+	CHECK(overlay.Triangles().size() % 3 == 0);
+	CHECK(overlay.Lines().size() % 2 == 0);
+	CHECK(overlay.Glyphs().size() % 6 == 0);
+
+	// A new frame starts empty
+	overlay.Reset(DefaultStyle(false));
+	CHECK(overlay.Triangles().empty());
+	CHECK(overlay.Lines().empty());
+	CHECK(overlay.Glyphs().empty());
+}
+
+static void TestSignature()
+{
+	GS::OverlayGeometry first, second;
+	first.Reset(DefaultStyle(true));
+	first.AddItem(Box(100, 50, 200, 100));
+	second.Reset(DefaultStyle(true));
+	second.AddItem(Box(100, 50, 200, 100));
+	CHECK(first.Signature() == second.Signature());
+
+	// Moving the item by a pixel or changing a color invalidates cached overlays
+	second.Reset(DefaultStyle(true));
+	second.AddItem(Box(101, 50, 200, 100));
+	CHECK(first.Signature() != second.Signature());
+
+	GS::OverlayStyle style = DefaultStyle(true);
+	style.outlineColor     = 0xFF000000;
+	second.Reset(style);
+	second.AddItem(Box(100, 50, 200, 100));
+	CHECK(first.Signature() != second.Signature());
+
+	second.Reset(DefaultStyle(true));
+	CHECK(second.Empty());
+	CHECK(first.Signature() != second.Signature());
+}
+
+int main()
+{
+	TestOutlineAndHandles();
+	TestGuidelinesAndLabels();
+	TestClippedToScene();
+	TestRotatedItem();
+	TestBatching();
+	TestSignature();
+
+	return CheckResult("overlay geometry");
+}
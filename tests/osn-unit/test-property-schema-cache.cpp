@@ -0,0 +1,159 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Property schemas shared by the sources of a type, with only the values kept
+// per source.
+
+#include "property-schema-cache.hpp"
+#include "check.hpp"
+
+// What the server sends for a browser source showing url
+static obs::PropertySchema::List Browser(const std::string& url, bool local = false)
+{
+	obs::PropertySchema::List props;
+
+	auto isLocal         = std::make_shared<obs::BooleanProperty>();
+	isLocal->name        = "is_local_file";
+	isLocal->description = "Local file";
+	isLocal->value       = local;
+	props.push_back(isLocal);
+
+	auto text         = std::make_shared<obs::TextProperty>();
+	text->name        = "url";
+	text->description = "URL";
+	text->field_type  = obs::TextProperty::TextType::Default;
+	text->value       = url;
+	props.push_back(text);
+
+	// Dynamic property, only there for local files
+	if (local) {
+		auto path         = std::make_shared<obs::PathProperty>();
+		path->name        = "local_file";
+		path->description = "Local file";
+		path->field_type  = obs::PathProperty::PathType::File;
+		path->filter      = "*.html";
+		props.push_back(path);
+	}
+
+	auto width         = std::make_shared<obs::IntegerProperty>();
+	width->name        = "width";
+	width->description = "Width";
+	width->maximum     = 4096;
+	width->step        = 1;
+	width->value       = 800;
+	props.push_back(width);
+
+	return props;
+}
+
+static std::string Url(const obs::PropertySchema::List& props)
+{
+	return std::static_pointer_cast<obs::TextProperty>(props[1])->value;
+}
+
+static void TestSharedSchema()
+{
+	PropertySchemaCache       cache;
+	obs::PropertySchema::List props;
+	std::vector<char>         blob, first, second;
+
+	CHECK(cache.KnownHash("browser_source") == 0);
+	uint64_t hash = obs::PropertySchema::encode(Browser("https://a"), blob);
+	CHECK(cache.Store("browser_source", blob, props, first) == hash);
+	CHECK(Url(props) == "https://a");
+	CHECK(first.size() < blob.size());
+
+	// The second source of the type only gets its values
+	CHECK(cache.KnownHash("browser_source") == hash);
+	CHECK(obs::PropertySchema::encode(Browser("https://b"), blob, hash) == hash);
+	CHECK(cache.Store("browser_source", blob, props, second) == hash);
+	CHECK(Url(props) == "https://b");
+	CHECK(second == blob);
+
+	// Each source is rebuilt from its own values
+	CHECK(cache.Load("browser_source", hash, first, props));
+	CHECK(Url(props) == "https://a");
+	CHECK(cache.Load("browser_source", hash, second, props));
+	CHECK(Url(props) == "https://b");
+
+	PropertySchemaCache::Stats stats = cache.GetStats();
+	CHECK(stats.misses == 1);
+	CHECK(stats.hits == 3);
+	CHECK(stats.schemas == 1);
+
+	// Same schema under another type is a separate entry
+	CHECK(!cache.Load("text_gdiplus", hash, first, props));
+}
+
+static void TestDynamicSchema()
+{
+	PropertySchemaCache       cache;
+	obs::PropertySchema::List props;
+	std::vector<char>         blob, remote, local;
+
+	uint64_t remoteHash = obs::PropertySchema::encode(Browser("https://a"), blob);
+	cache.Store("browser_source", blob, props, remote);
+
+	// Settings that change the properties give another schema of the same type
+	uint64_t localHash = obs::PropertySchema::encode(Browser("", true), blob, remoteHash);
+	CHECK(localHash != remoteHash);
+	CHECK(cache.Store("browser_source", blob, props, local) == localHash);
+	CHECK(props.size() == 4);
+	CHECK(cache.KnownHash("browser_source") == localHash);
+	CHECK(cache.GetStats().schemas == 2);
+
+	CHECK(cache.Load("browser_source", remoteHash, remote, props));
+	CHECK(props.size() == 3 && Url(props) == "https://a");
+
+	// Values of one schema don't fit the other
+	CHECK(!cache.Load("browser_source", localHash, remote, props));
+}
+
+static void TestEviction()
+{
+	PropertySchemaCache       cache;
+	obs::PropertySchema::List props;
+	std::vector<char>         blob, values;
+
+	for (size_t n = 0; n < PropertySchemaCache::MaxSchemas; n++) {
+		obs::PropertySchema::encode(Browser("https://a"), blob);
+		cache.Store("type_" + std::to_string(n), blob, props, values);
+	}
+	CHECK(cache.GetStats().schemas == PropertySchemaCache::MaxSchemas);
+
+	uint64_t hash = obs::PropertySchema::encode(Browser("https://a"), blob);
+	cache.Store("browser_source", blob, props, values);
+	CHECK(cache.GetStats().schemas == 1);
+	CHECK(cache.KnownHash("type_0") == 0);
+
+	// A values-only blob for an evicted schema can't be used, the caller asks again
+	obs::PropertySchema::encode(Browser("https://b"), blob, hash);
+	CHECK(cache.Store("type_0", blob, props, values) == 0);
+
+	cache.Clear();
+	CHECK(cache.KnownHash("browser_source") == 0);
+}
+
+int main()
+{
+	TestSharedSchema();
+	TestDynamicSchema();
+	TestEviction();
+
+	return CheckResult("property schema cache");
+}
@@ -0,0 +1,194 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+// Property lists encoded with obs::PropertySchema and decoded back, with and
+// without the schema.
+
+#include "obs-property-schema.hpp"
+#include "check.hpp"
+
+template<typename T>
+static std::shared_ptr<T> Make(const std::string& name, const std::string& description)
+{
+	auto prop              = std::make_shared<T>();
+	prop->name             = name;
+	prop->description      = description;
+	prop->long_description = "";
+	prop->enabled          = true;
+	prop->visible          = true;
+	return prop;
+}
+
+static obs::PropertySchema::List Properties(const std::string& device, int64_t width)
+{
+	obs::PropertySchema::List props;
+
+	auto list        = Make<obs::ListProperty>("device_id", "Device");
+	list->field_type = obs::ListProperty::ListType::List;
+	list->format     = obs::ListProperty::Format::String;
+	list->items.push_back({"Default", true, 0, 0, "default"});
+	list->items.push_back({"Webcam", false, 0, 0, "webcam"});
+	list->current_value_str = device;
+	props.push_back(list);
+
+	auto number        = Make<obs::IntegerProperty>("width", "Width");
+	number->field_type = obs::NumberProperty::NumberType::Slider;
+	number->minimum    = -10;
+	number->maximum    = 4096;
+	number->step       = 2;
+	number->value      = width;
+	props.push_back(number);
+
+	auto decimal        = Make<obs::FloatProperty>("speed", "Speed");
+	decimal->field_type = obs::NumberProperty::NumberType::Scroller;
+	decimal->minimum    = 0.5;
+	decimal->maximum    = 2.0;
+	decimal->step       = 0.1;
+	decimal->value      = 1.25;
+	decimal->visible    = false;
+	props.push_back(decimal);
+
+	auto text        = Make<obs::TextProperty>("text", "Text");
+	text->field_type = obs::TextProperty::TextType::MultiLine;
+	text->value      = "Hello";
+	props.push_back(text);
+
+	auto path          = Make<obs::PathProperty>("file", "File");
+	path->field_type   = obs::PathProperty::PathType::File;
+	path->filter       = "*.png";
+	path->default_path = "C:/";
+	path->value        = "C:/image.png";
+	props.push_back(path);
+
+	auto boolean     = Make<obs::BooleanProperty>("loop", "Loop");
+	boolean->value   = true;
+	boolean->enabled = false;
+	props.push_back(boolean);
+
+	auto font   = Make<obs::FontProperty>("font", "Font");
+	font->face  = "Arial";
+	font->style = "Bold";
+	font->path  = "";
+	font->sizeF = 36;
+	font->flags = 3;
+	props.push_back(font);
+
+	auto files          = Make<obs::EditableListProperty>("files", "Files");
+	files->field_type   = obs::EditableListProperty::ListType::FilesAndURLs;
+	files->filter       = "*.png";
+	files->default_path = "";
+	files->values       = {"a.png", "b.png"};
+	props.push_back(files);
+
+	auto fps = Make<obs::FrameRateProperty>("fps", "Frame Rate");
+	fps->ranges.push_back({{1, 1}, {60, 1}});
+	fps->options.push_back({"native", "Native"});
+	fps->current_numerator   = 30000;
+	fps->current_denominator = 1001;
+	props.push_back(fps);
+
+	auto color        = Make<obs::ColorProperty>("color", "Color");
+	color->field_type = obs::NumberProperty::NumberType::Scroller;
+	color->value      = 0xff00ff00;
+	props.push_back(color);
+
+	props.push_back(Make<obs::ButtonProperty>("refresh", "Refresh"));
+	return props;
+}
+
+static void TestRoundTrip()
+{
+	obs::PropertySchema::List props = Properties("webcam", -4);
+	std::vector<char>         buf;
+	uint64_t                  hash = obs::PropertySchema::encode(props, buf);
+
+	uint64_t peeked    = 0;
+	bool     hasSchema = false;
+	CHECK(obs::PropertySchema::peek(buf, peeked, hasSchema));
+	CHECK(peeked == hash && hasSchema);
+
+	obs::PropertySchema::List decoded;
+	CHECK(obs::PropertySchema::decode(buf, decoded));
+	CHECK(decoded.size() == props.size());
+	if (decoded.size() != props.size())
+		return;
+
+	// Both formats produce the same bytes for equal properties
+	for (size_t idx = 0; idx < props.size(); idx++) {
+		std::vector<char> expected(props[idx]->size()), actual(decoded[idx]->size());
+		CHECK(props[idx]->serialize(expected));
+		CHECK(decoded[idx]->serialize(actual));
+		CHECK(expected == actual);
+	}
+
+	auto list = std::static_pointer_cast<obs::ListProperty>(decoded[0]);
+	CHECK(list->current_value_str == "webcam");
+	CHECK(list->items.size() == 2 && !list->items.back().enabled);
+	CHECK(std::static_pointer_cast<obs::IntegerProperty>(decoded[1])->value == -4);
+	CHECK(!decoded[2]->visible);
+	CHECK(!decoded[5]->enabled);
+}
+
+static void TestKnownSchema()
+{
+	std::vector<char> full, values;
+	uint64_t          hash = obs::PropertySchema::encode(Properties("webcam", 1280), full);
+
+	// Values differ, schema doesn't
+	CHECK(obs::PropertySchema::encode(Properties("default", 1920), values, hash) == hash);
+	CHECK(values.size() < full.size() / 2);
+
+	uint64_t peeked    = 0;
+	bool     hasSchema = true;
+	CHECK(obs::PropertySchema::peek(values, peeked, hasSchema));
+	CHECK(peeked == hash && !hasSchema);
+
+	obs::PropertySchema::List props;
+	CHECK(!obs::PropertySchema::decode(values, props));
+	CHECK(obs::PropertySchema::decode(full, props));
+	CHECK(obs::PropertySchema::decode(values, props));
+	CHECK(std::static_pointer_cast<obs::ListProperty>(props[0])->current_value_str == "default");
+	CHECK(std::static_pointer_cast<obs::IntegerProperty>(props[1])->value == 1920);
+
+	// Another schema, another hash
+	obs::PropertySchema::List other = Properties("webcam", 1280);
+	other[0]->description           = "Camera";
+	CHECK(obs::PropertySchema::encode(other, full, hash) != hash);
+}
+
+static void TestMalformed()
+{
+	std::vector<char> buf;
+	obs::PropertySchema::encode(Properties("webcam", 1280), buf);
+
+	obs::PropertySchema::List props;
+	for (size_t size = 0; size < buf.size(); size++) {
+		std::vector<char> truncated(buf.begin(), buf.begin() + size);
+		CHECK(!obs::PropertySchema::decode(truncated, props));
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestKnownSchema();
+	TestMalformed();
+
+	return CheckResult("property schema");
+}
@@ -0,0 +1,150 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+
+// Ring sizing, eviction and page release of ReplayRingIndex, the packet index of
+// the disk replay buffer.
+
+#include "replay-ring-index.h"
+#include "check.hpp"
+
+static const uint64_t MB = 1024 * 1024;
+
+static ReplayRingIndex::Packet Packet(uint32_t size, int64_t dtsUsec, bool video = true, bool keyframe = false)
+{
+	return {0, size, dtsUsec, dtsUsec, dtsUsec, 1, 1000000, 0, video, keyframe};
+}
+
+static void TestRingSize()
+{
+	// 6000 + 160 kbps over 5 minutes plus a quarter
+	uint64_t bytes = 6160ULL * 1000 / 8 * 300;
+	CHECK(ReplayRingIndex::RingSize(6160, 300, 0, 16 * MB) == bytes + bytes / 4);
+
+	// Never below two memory heads plus some slack
+	CHECK(ReplayRingIndex::RingSize(100, 5, 0, 16 * MB) == 96 * MB);
+
+	// An explicit size wins, still bounded by the minimum
+	CHECK(ReplayRingIndex::RingSize(6160, 30, 1024 * MB, 16 * MB) == 1024 * MB);
+	CHECK(ReplayRingIndex::RingSize(6160, 30, 1 * MB, 16 * MB) == 96 * MB);
+
+	// Nothing to size it from
+	CHECK(ReplayRingIndex::RingSize(0, 30, 0, 16 * MB) == ReplayRingIndex::DefaultSizeMB * MB);
+	CHECK(ReplayRingIndex::RingSize(6160, 0, 0, 16 * MB) == ReplayRingIndex::DefaultSizeMB * MB);
+}
+
+static void TestOverwrite()
+{
+	ReplayRingIndex        index;
+	ReplayRingIndex::Range release;
+	index.Reset(1000, 0, 0);
+
+	// Larger than half the ring
+	ReplayRingIndex::Packet big = Packet(501, 0);
+	CHECK(!index.Append(big, release));
+	CHECK(index.Count() == 0);
+
+	std::vector<ReplayRingIndex::Packet> appended;
+	for (int64_t i = 0; i < 5; i++) {
+		ReplayRingIndex::Packet packet = Packet(300, i, true, i % 2 == 0);
+		CHECK(index.Append(packet, release));
+		CHECK(packet.position == uint64_t(i) * 300);
+		appended.push_back(packet);
+	}
+	CHECK(index.Head() == 1500);
+	CHECK(index.TotalBytes() == 1500);
+
+	// Only the last 1000 bytes are in the ring
+	CHECK(index.Count() == 3);
+	CHECK(index.Overwritten(appended[0]));
+	CHECK(index.Overwritten(appended[1]));
+	CHECK(!index.Overwritten(appended[2]));
+	CHECK(!index.Overwritten(appended[4]));
+
+	// The window starts at the first keyframe still held
+	auto window = index.Window();
+	CHECK(window.size() == 3);
+	CHECK(window.front().position == 600);
+}
+
+static void TestReplayWindow()
+{
+	ReplayRingIndex        index;
+	ReplayRingIndex::Range release;
+	index.Reset(1000000, 10, 0);
+
+	for (int64_t i = 0; i <= 30; i++) {
+		ReplayRingIndex::Packet packet = Packet(10, i, i % 3 != 1, i % 10 == 0);
+		CHECK(index.Append(packet, release));
+	}
+
+	// Packets older than 10 us before the newest one left the window
+	CHECK(index.Count() == 11);
+	auto window = index.Window();
+	CHECK(window.size() == 11);
+	CHECK(window.front().dtsUsec == 20);
+	CHECK(window.back().dtsUsec == 30);
+
+	// No video keyframe, nothing to save
+	index.Reset(1000000, 10, 0);
+	ReplayRingIndex::Packet audio = Packet(10, 0, false, true);
+	CHECK(index.Append(audio, release));
+	CHECK(index.Window().empty());
+}
+
+static void TestRelease()
+{
+	ReplayRingIndex        index;
+	ReplayRingIndex::Range release;
+	index.Reset(10000, 0, 100);
+
+	// Nothing released until two memory heads were written, then all but the last one
+	uint64_t released = 0;
+	for (int i = 0; i < 20; i++) {
+		ReplayRingIndex::Packet packet = Packet(50, i);
+		CHECK(index.Append(packet, release));
+		if (release.size) {
+			CHECK(release.position == released);
+			released = release.position + release.size;
+			CHECK(index.Head() - released == 100);
+		}
+	}
+	CHECK(released == 900);
+
+	// Reading back is released in batches of at least a memory head, never inside it
+	uint64_t readFrom = 0;
+	CHECK(!index.ReleaseRead(readFrom, 50, release));
+	CHECK(index.ReleaseRead(readFrom, 100, release));
+	CHECK(release.position == 0 && release.size == 100);
+	CHECK(readFrom == 100);
+	CHECK(!index.ReleaseRead(readFrom, 950, release));
+	CHECK(readFrom == 100);
+	CHECK(index.ReleaseRead(readFrom, 900, release));
+	CHECK(release.position == 100 && release.size == 800);
+}
+
+int main()
+{
+	TestRingSize();
+	TestOverwrite();
+	TestReplayWindow();
+	TestRelease();
+
+	return CheckResult("replay ring index");
+}
@@ -0,0 +1,145 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+// Scene signals coalesced by SceneEventQueue into the batches handed to the
+// client.
+
+#include "scene-event-queue.h"
+#include "check.hpp"
+
+static std::vector<std::pair<uint64_t, SceneEventQueue::Batch>> Take(SceneEventQueue& queue)
+{
+	std::vector<std::pair<uint64_t, SceneEventQueue::Batch>> batches;
+	queue.Take(batches);
+	return batches;
+}
+
+static void TestConnected()
+{
+	SceneEventQueue queue;
+	queue.ItemAdded(1, 10);
+	queue.Reordered(1);
+	CHECK(Take(queue).empty());
+
+	queue.Connect(1);
+	CHECK(queue.IsConnected(1) && !queue.IsConnected(2));
+	CHECK(Take(queue).empty());
+
+	queue.ItemAdded(1, 10);
+	queue.ItemAdded(2, 20);
+	auto batches = Take(queue);
+	CHECK(batches.size() == 1 && batches[0].first == 1);
+	CHECK(batches[0].second.added == std::vector<int64_t>({10}));
+
+	// Taken once
+	CHECK(Take(queue).empty());
+
+	queue.Disconnect(1);
+	queue.ItemAdded(1, 11);
+	CHECK(Take(queue).empty());
+	CHECK(queue.GetStats().events == 1);
+}
+
+static void TestCoalesced()
+{
+	SceneEventQueue queue;
+	queue.Connect(1);
+
+	// A drag emits a transform per frame
+	for (int n = 0; n < 60; n++)
+		queue.ItemTransformed(1, 5);
+	queue.ItemVisible(1, 6, false);
+	queue.ItemVisible(1, 6, true);
+	queue.ItemVisible(1, 7, false);
+	queue.Reordered(1);
+	queue.Reordered(1);
+
+	auto batches = Take(queue);
+	CHECK(batches.size() == 1);
+	auto& batch = batches[0].second;
+	CHECK(batch.transformed == std::vector<int64_t>({5}));
+	CHECK(batch.visible.size() == 2);
+	CHECK(batch.visible[0].first == 6 && batch.visible[0].second);
+	CHECK(batch.visible[1].first == 7 && !batch.visible[1].second);
+	CHECK(batch.reordered);
+	CHECK(batch.added.empty() && batch.removed.empty());
+
+	SceneEventQueue::Stats stats = queue.GetStats();
+	CHECK(stats.events == 65);
+	CHECK(stats.batches == 1);
+}
+
+static void TestAddedAndRemoved()
+{
+	SceneEventQueue queue;
+	queue.Connect(1);
+
+	// Never seen by the client
+	queue.ItemAdded(1, 1);
+	queue.ItemTransformed(1, 1);
+	queue.ItemRemoved(1, 1);
+
+	// New items are read as a whole, removed ones have nothing left to update
+	queue.ItemAdded(1, 2);
+	queue.ItemVisible(1, 2, false);
+	queue.ItemTransformed(1, 3);
+	queue.ItemRemoved(1, 3);
+
+	auto batches = Take(queue);
+	CHECK(batches.size() == 1);
+	auto& batch = batches[0].second;
+	CHECK(batch.added == std::vector<int64_t>({2}));
+	CHECK(batch.removed == std::vector<int64_t>({3}));
+	CHECK(batch.transformed.empty() && batch.visible.empty());
+	CHECK(!batch.reordered);
+
+	// Only added and removed in between, nothing to tell
+	queue.ItemAdded(1, 4);
+	queue.ItemRemoved(1, 4);
+	CHECK(Take(queue).empty());
+}
+
+static void TestSeveralScenes()
+{
+	SceneEventQueue queue;
+	queue.Connect(1);
+	queue.Connect(2);
+	queue.Connect(3);
+	queue.ItemTransformed(3, 1);
+	queue.Reordered(1);
+
+	auto batches = Take(queue);
+	CHECK(batches.size() == 2);
+	CHECK(batches[0].first == 1 && batches[0].second.reordered);
+	CHECK(batches[1].first == 3 && batches[1].second.transformed.size() == 1);
+
+	queue.Clear();
+	queue.Reordered(1);
+	CHECK(Take(queue).empty());
+}
+
+int main()
+{
+	TestConnected();
+	TestCoalesced();
+	TestAddedAndRemoved();
+	TestSeveralScenes();
+
+	return CheckResult("scene event queue");
+}
@@ -0,0 +1,169 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Picking and snapping queries of the scene item index, checked against a
+// linear scan over the same boxes.
+
+#include <algorithm>
+#include <random>
+#include "util-spatialindex.h"
+#include "check.hpp"
+
+static util::SpatialIndex::Entry Item(uint64_t key, uint32_t order, float x, float y, float width, float height)
+{
+	util::SpatialIndex::Entry entry = {};
+	entry.key                       = key;
+	entry.order                     = order;
+	entry.quad                      = util::SpatialIndex::MakeQuad(x, y, width, 0, 0, height);
+	return entry;
+}
+
+static uint64_t HitKey(util::SpatialIndex& index, float x, float y)
+{
+	const util::SpatialIndex::Entry* entry = index.HitTest(x, y);
+	return entry ? entry->key : 0;
+}
+
+static void TestTopmost()
+{
+	util::SpatialIndex index;
+	index.Build({Item(1, 0, 0, 0, 1920, 1080), Item(2, 1, 100, 100, 200, 200), Item(3, 2, 150, 150, 200, 200)});
+
+	CHECK(index.Size() == 3);
+	CHECK(HitKey(index, 10, 10) == 1);
+	CHECK(HitKey(index, 120, 120) == 2);
+	CHECK(HitKey(index, 200, 200) == 3);
+	CHECK(HitKey(index, 2000, 200) == 0);
+
+	index.Build({});
+	CHECK(index.Size() == 0);
+	CHECK(HitKey(index, 10, 10) == 0);
+}
+
+static void TestRotated()
+{
+	// A 100x100 square rotated by 45 degrees around (500, 500), pointing up
+	util::SpatialIndex index;
+	util::SpatialIndex::Entry entry = {};
+	entry.key                       = 7;
+	entry.quad                      = util::SpatialIndex::MakeQuad(500, 500, 70.71f, -70.71f, 70.71f, 70.71f);
+	index.Build({entry});
+
+	CHECK(HitKey(index, 570, 500) == 7);
+	// Inside the bounds, outside the box
+	CHECK(HitKey(index, 505, 440) == 0);
+
+	// Flipped items wind the other way
+	entry.quad = util::SpatialIndex::MakeQuad(600, 500, -100, 0, 0, 100);
+	index.Build({entry});
+	CHECK(HitKey(index, 550, 550) == 7);
+	CHECK(HitKey(index, 650, 550) == 0);
+}
+
+static void TestUpdate()
+{
+	util::SpatialIndex index;
+	std::vector<util::SpatialIndex::Entry> entries;
+	for (uint32_t n = 0; n < 64; n++)
+		entries.push_back(Item(n + 1, n, float(n % 8) * 100, float(n / 8) * 100, 50, 50));
+	index.Build(entries);
+
+	CHECK(HitKey(index, 10, 10) == 1);
+	CHECK(index.Update(1, util::SpatialIndex::MakeQuad(5000, 5000, 50, 50, 0, 50)));
+	CHECK(HitKey(index, 10, 10) == 0);
+	CHECK(HitKey(index, 5010, 5060) == 1);
+	CHECK(!index.Update(100, util::SpatialIndex::MakeQuad(0, 0, 1, 0, 0, 1)));
+}
+
+static void TestQueries()
+{
+	util::SpatialIndex index;
+	index.Build({Item(1, 0, 0, 0, 100, 100),
+	             Item(2, 1, 105, 0, 100, 100),
+	             Item(3, 2, 300, 0, 100, 100),
+	             Item(4, 3, 0, 110, 50, 50)});
+
+	std::vector<const util::SpatialIndex::Entry*> result;
+	index.QueryRect({50, 50, 150, 60}, result);
+	CHECK(result.size() == 2);
+	CHECK(result.size() == 2 && result[0]->key == 2 && result[1]->key == 1);
+
+	// Within 10 units of item 1: item 2 on its right and item 4 below
+	index.QueryNear(1, 10, result);
+	CHECK(result.size() == 2);
+	CHECK(result.size() == 2 && result[0]->key == 4 && result[1]->key == 2);
+
+	index.QueryNear(3, 10, result);
+	CHECK(result.empty());
+
+	index.QueryNear(42, 10, result);
+	CHECK(result.empty());
+}
+
+static void TestAgainstLinearScan()
+{
+	std::mt19937                          random(1234);
+	std::uniform_real_distribution<float> position(0, 1920), size(10, 300);
+
+	std::vector<util::SpatialIndex::Entry> entries;
+	for (uint32_t n = 0; n < 1000; n++)
+		entries.push_back(Item(n + 1, n, position(random), position(random), size(random), size(random)));
+
+	util::SpatialIndex index;
+	index.Build(entries);
+
+	// Move a tenth of them to exercise the refit
+	for (uint32_t n = 0; n < 1000; n += 10) {
+		entries[n].quad = util::SpatialIndex::MakeQuad(position(random), position(random), size(random), 0, 0, size(random));
+		index.Update(entries[n].key, entries[n].quad);
+	}
+
+	for (size_t probe = 0; probe < 500; probe++) {
+		float    x = position(random), y = position(random);
+		uint64_t expected = 0;
+		for (auto& entry : entries) {
+			const auto& q = entry.quad;
+			if (x >= q.x[0] && x <= q.x[2] && y >= q.y[0] && y <= q.y[2])
+				expected = entry.key;
+		}
+		CHECK(HitKey(index, x, y) == expected);
+	}
+
+	util::SpatialIndex::Rect                     rect = {400, 400, 800, 600};
+	std::vector<const util::SpatialIndex::Entry*> result;
+	index.QueryRect(rect, result);
+	size_t expected = std::count_if(entries.begin(), entries.end(), [&rect](const util::SpatialIndex::Entry& entry) {
+		const auto& q = entry.quad;
+		return q.x[0] <= rect.right && q.x[2] >= rect.left && q.y[0] <= rect.bottom && q.y[2] >= rect.top;
+	});
+	CHECK(result.size() == expected);
+	CHECK(std::is_sorted(result.begin(), result.end(), [](const util::SpatialIndex::Entry* a, const util::SpatialIndex::Entry* b) {
+		return a->order > b->order;
+	}));
+}
+
+int main()
+{
+	TestTopmost();
+	TestRotated();
+	TestUpdate();
+	TestQueries();
+	TestAgainstLinearScan();
+
+	return CheckResult("spatial index");
+}
@@ -0,0 +1,242 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Preparation of transition targets, with a stub transition whose target
+// takes as long to show as a scene opening a media file. Also measures how
+// long Start takes with and without preparing first.
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "transition-preparer.h"
+#include "check.hpp"
+
+using namespace std::chrono;
+
+// A scene whose first show opens its sources, and a transition that shows its target when started
+struct StubScene
+{
+	milliseconds      openCost;
+	milliseconds      firstFrameDelay;
+	std::atomic<int>  showing{0};
+	std::atomic<bool> opened{false};
+	steady_clock::time_point openedAt;
+	std::atomic<int>  releases{0};
+
+	StubScene(milliseconds openCost, milliseconds firstFrameDelay = milliseconds(0))
+	    : openCost(openCost), firstFrameDelay(firstFrameDelay)
+	{}
+
+	void Show()
+	{
+		if (showing++ == 0 && !opened) {
+			std::this_thread::sleep_for(openCost);
+			openedAt = steady_clock::now();
+			opened   = true;
+		}
+	}
+
+	void Hide()
+	{
+		showing--;
+	}
+
+	bool HasFrame()
+	{
+		return opened && steady_clock::now() >= openedAt + firstFrameDelay;
+	}
+
+	TransitionPreparer::Preparation Preparation()
+	{
+		TransitionPreparer::Preparation preparation;
+		preparation.acquire = [this]() { Show(); };
+		preparation.ready   = [this]() { return HasFrame(); };
+		preparation.release = [this](bool acquired) {
+			if (acquired)
+				Hide();
+			releases++;
+		};
+		return preparation;
+	}
+};
+
+static void StartTransition(StubScene& target)
+{
+	target.Show();
+}
+
+static double StartMs(bool prepare)
+{
+	StubScene          scene(milliseconds(40));
+	TransitionPreparer preparer;
+	if (prepare) {
+		preparer.Prepare(1, 2, scene.Preparation(), milliseconds(1000));
+		preparer.Wait(1, milliseconds(1000));
+	}
+
+	auto start = steady_clock::now();
+	StartTransition(scene);
+	double elapsed = duration<double, std::milli>(steady_clock::now() - start).count();
+
+	preparer.Cancel(1);
+	CHECK(scene.showing == 1);
+	return elapsed;
+}
+
+static void TestStartTime()
+{
+	double cold = StartMs(false);
+	double warm = StartMs(true);
+	std::cout << "start: " << cold << "ms unprepared, " << warm << "ms prepared" << std::endl;
+	CHECK(cold >= 40);
+	CHECK(warm < 10);
+}
+
+static void TestReady()
+{
+	StubScene          scene(milliseconds(5), milliseconds(20));
+	TransitionPreparer preparer;
+	uint64_t           target = 0;
+
+	CHECK(preparer.GetState(1, target) == TransitionPreparer::State::None);
+	preparer.Prepare(1, 7, scene.Preparation(), milliseconds(1000));
+	CHECK(preparer.GetState(1, target) == TransitionPreparer::State::Preparing);
+	CHECK(target == 7);
+
+	CHECK(preparer.Wait(1, milliseconds(1000)) == TransitionPreparer::State::Ready);
+	CHECK(scene.HasFrame());
+	CHECK(scene.showing == 1);
+
+	preparer.Cancel(1);
+	CHECK(preparer.GetState(1, target) == TransitionPreparer::State::None);
+	CHECK(scene.showing == 0);
+	CHECK(scene.releases == 1);
+}
+
+static void TestTimeout()
+{
+	StubScene          scene(milliseconds(0), milliseconds(10000));
+	TransitionPreparer preparer;
+
+	preparer.Prepare(1, 7, scene.Preparation(), milliseconds(20));
+	CHECK(preparer.Wait(1, milliseconds(1000)) == TransitionPreparer::State::TimedOut);
+
+	// Released right away, the state stays until the transition starts or is cleared
+	for (int n = 0; n < 100 && scene.releases == 0; n++)
+		std::this_thread::sleep_for(milliseconds(5));
+	CHECK(scene.showing == 0);
+	CHECK(scene.releases == 1);
+
+	uint64_t target = 0;
+	CHECK(preparer.GetState(1, target) == TransitionPreparer::State::TimedOut && target == 7);
+	preparer.Cancel(1);
+	CHECK(scene.releases == 1);
+}
+
+static void TestHold()
+{
+	StubScene          scene(milliseconds(0));
+	TransitionPreparer preparer(milliseconds(5), milliseconds(30));
+
+	preparer.Prepare(1, 7, scene.Preparation(), milliseconds(1000));
+	CHECK(preparer.Wait(1, milliseconds(1000)) == TransitionPreparer::State::Ready);
+	CHECK(scene.showing == 1);
+
+	// Not started within the hold time
+	for (int n = 0; n < 100 && scene.releases == 0; n++)
+		std::this_thread::sleep_for(milliseconds(5));
+	CHECK(scene.showing == 0);
+	CHECK(scene.releases == 1);
+
+	uint64_t target = 0;
+	CHECK(preparer.GetState(1, target) == TransitionPreparer::State::Expired);
+
+	std::vector<TransitionPreparer::Change> changes;
+	preparer.TakeChanges(changes);
+	CHECK(changes.size() == 1);
+	CHECK(changes[0].transition == 1 && changes[0].target == 7);
+	CHECK(changes[0].state == TransitionPreparer::State::Expired);
+
+	changes.clear();
+	preparer.TakeChanges(changes);
+	CHECK(changes.empty());
+}
+
+static void TestCancelSource()
+{
+	StubScene          first(milliseconds(0)), second(milliseconds(0)), third(milliseconds(0));
+	TransitionPreparer preparer;
+
+	preparer.Prepare(1, 7, first.Preparation(), milliseconds(1000));
+	preparer.Prepare(2, 7, second.Preparation(), milliseconds(1000));
+	preparer.Prepare(3, 8, third.Preparation(), milliseconds(1000));
+	CHECK(preparer.Wait(3, milliseconds(1000)) == TransitionPreparer::State::Ready);
+
+	// Releasing the target drops both preparations for it, releasing a transition drops its own
+	preparer.CancelSource(7);
+	CHECK(first.releases == 1 && second.releases == 1);
+	CHECK(third.releases == 0);
+	preparer.CancelSource(3);
+	CHECK(third.releases == 1 && third.showing == 0);
+
+	uint64_t target = 0;
+	CHECK(preparer.GetState(1, target) == TransitionPreparer::State::None);
+	CHECK(preparer.GetState(3, target) == TransitionPreparer::State::None);
+}
+
+static void TestReplace()
+{
+	StubScene          first(milliseconds(30)), second(milliseconds(0));
+	TransitionPreparer preparer;
+	uint64_t           target = 0;
+
+	// Replaced while still being acquired, released as soon as acquire returns
+	preparer.Prepare(1, 7, first.Preparation(), milliseconds(1000));
+	std::this_thread::sleep_for(milliseconds(10));
+	preparer.Prepare(1, 8, second.Preparation(), milliseconds(1000));
+	CHECK(preparer.Wait(1, milliseconds(1000)) == TransitionPreparer::State::Ready);
+	CHECK(preparer.GetState(1, target) == TransitionPreparer::State::Ready && target == 8);
+
+	for (int n = 0; n < 100 && first.releases == 0; n++)
+		std::this_thread::sleep_for(milliseconds(5));
+	CHECK(first.releases == 1);
+	CHECK(first.showing == 0);
+	CHECK(second.showing == 1);
+
+	// Cancelled before the worker got to it, nothing to hide
+	StubScene never(milliseconds(0));
+	preparer.Clear();
+	preparer.Prepare(2, 9, never.Preparation(), milliseconds(1000));
+	preparer.Cancel(2);
+	preparer.Clear();
+	CHECK(never.releases == 1);
+	CHECK(never.showing == 0);
+	CHECK(second.releases == 1 && second.showing == 0);
+}
+
+int main()
+{
+	TestStartTime();
+	TestReady();
+	TestTimeout();
+	TestHold();
+	TestCancelSource();
+	TestReplace();
+
+	return CheckResult("transition preparer");
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Fingerprinting of the source type catalog.
+
+#include "type-catalog.h"
+#include "check.hpp"
+
+static std::vector<TypeCatalog::Entry> Entries()
+{
+	return {{"image_source", 0, "Image", 0x1, "{\"unload\":false}", 0x1234},
+	        {"color_filter", 1, "Color Correction", 0x1, "{\"gamma\":0.0}", 0x5678},
+	        {"fade_transition", 2, "Fade", 0x1, "{}", 0x9abc}};
+}
+
+static void TestFingerprint()
+{
+	TypeCatalog catalog;
+	std::vector<TypeCatalog::Entry> entries;
+	CHECK(catalog.Get(0, entries) == 0);
+	CHECK(entries.empty());
+
+	uint64_t fingerprint = catalog.Set(Entries());
+	CHECK(fingerprint != 0);
+
+	// The same types in another session give the same fingerprint
+	TypeCatalog other;
+	CHECK(other.Set(Entries()) == fingerprint);
+
+	// Any field changes it
+	auto changed = Entries();
+	changed[1].defaults = "{\"gamma\":1.0}";
+	CHECK(other.Set(changed) != fingerprint);
+	changed = Entries();
+	changed[2].propertiesHash++;
+	CHECK(other.Set(changed) != fingerprint);
+	changed = Entries();
+	changed[0].id          = "image_sourc";
+	changed[0].displayName = "eImage";
+	CHECK(other.Set(changed) != fingerprint);
+}
+
+static void TestKnownFingerprint()
+{
+	TypeCatalog catalog;
+	std::vector<TypeCatalog::Entry> entries;
+	uint64_t fingerprint = catalog.Set(Entries());
+
+	CHECK(catalog.Get(0, entries) == fingerprint);
+	CHECK(entries.size() == 3);
+	CHECK(entries[1].id == "color_filter" && entries[1].type == 1);
+
+	// Nothing to send when the client has it
+	CHECK(catalog.Get(fingerprint, entries) == fingerprint);
+	CHECK(entries.empty());
+
+	CHECK(catalog.Get(fingerprint + 1, entries) == fingerprint);
+	CHECK(entries.size() == 3);
+
+	catalog.Clear();
+	CHECK(catalog.Get(fingerprint, entries) == 0);
+	CHECK(entries.empty());
+}
+
+int main()
+{
+	TestFingerprint();
+	TestKnownFingerprint();
+
+	return CheckResult("type catalog");
+}